@@ -5,10 +5,33 @@
 #include "flutter/assets/asset_manager.h"
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/trace_event.h"
 
+#if OS_WIN
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
 namespace flutter {
 
+namespace {
+
+// Touching one byte per page is enough to fault the whole mapping in.
+size_t GetPrefetchPageSize() {
+#if OS_WIN
+  SYSTEM_INFO system_info = {};
+  ::GetSystemInfo(&system_info);
+  const long page_size = system_info.dwPageSize;
+#else
+  const long page_size = ::sysconf(_SC_PAGESIZE);
+#endif
+  return page_size > 0 ? static_cast<size_t>(page_size) : 4096;
+}
+
+}  // namespace
+
 AssetManager::AssetManager() = default;
 
 AssetManager::~AssetManager() = default;
@@ -37,16 +60,151 @@ std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMapping", "name",
                asset_name.c_str());
+  std::unique_ptr<fml::Mapping> mapping;
+  {
+    std::scoped_lock lock(mutex_);
+    // A prefetch that completes after the asset was handed out is dropped.
+    pending_prefetches_.erase(asset_name);
+    auto found = prefetched_assets_.find(asset_name);
+    if (found != prefetched_assets_.end()) {
+      mapping = std::move(found->second);
+      prefetched_assets_.erase(found);
+    }
+  }
+  if (mapping == nullptr) {
+    mapping = ResolveAsMapping(asset_name);
+  }
+  if (mapping == nullptr) {
+    FML_DLOG(WARNING) << "Could not find asset: " << asset_name;
+    return nullptr;
+  }
+  RecordAssetName(asset_name);
+  return mapping;
+}
+
+std::unique_ptr<fml::Mapping> AssetManager::ResolveAsMapping(
+    const std::string& asset_name) const {
   for (const auto& resolver : resolvers_) {
     auto mapping = resolver->GetAsMapping(asset_name);
     if (mapping != nullptr) {
       return mapping;
     }
   }
-  FML_DLOG(WARNING) << "Could not find asset: " << asset_name;
   return nullptr;
 }
 
+void AssetManager::GetAsMappingAsync(
+    const std::string& asset_name,
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker,
+    MappingCallback callback) {
+  FML_DCHECK(worker);
+  FML_DCHECK(callback);
+  worker->PostTask([asset_manager = shared_from_this(), asset_name,
+                    callback = std::move(callback)]() {
+    callback(asset_manager->GetAsMapping(asset_name));
+  });
+}
+
+void AssetManager::Prefetch(std::vector<std::string> asset_names,
+                            std::shared_ptr<fml::ConcurrentTaskRunner> worker) {
+  FML_DCHECK(worker);
+  if (asset_names.empty()) {
+    return;
+  }
+  {
+    std::scoped_lock lock(mutex_);
+    pending_prefetches_.insert(asset_names.begin(), asset_names.end());
+  }
+  worker->PostTask([asset_manager = shared_from_this(),
+                    asset_names = std::move(asset_names)]() {
+    const auto count = std::to_string(asset_names.size());
+    TRACE_EVENT1("flutter", "AssetManager::Prefetch", "count", count.c_str());
+    static const size_t page_size = GetPrefetchPageSize();
+    for (const auto& asset_name : asset_names) {
+      {
+        std::scoped_lock lock(asset_manager->mutex_);
+        if (asset_manager->pending_prefetches_.count(asset_name) == 0) {
+          continue;
+        }
+        if (asset_manager->prefetched_assets_.count(asset_name) != 0) {
+          asset_manager->pending_prefetches_.erase(asset_name);
+          continue;
+        }
+      }
+
+      auto mapping = asset_manager->ResolveAsMapping(asset_name);
+      if (mapping == nullptr) {
+        std::scoped_lock lock(asset_manager->mutex_);
+        asset_manager->pending_prefetches_.erase(asset_name);
+        continue;
+      }
+
+      const uint8_t* data = mapping->GetMapping();
+      const size_t size = mapping->GetSize();
+      uint8_t checksum = 0;
+      for (size_t offset = 0; offset < size; offset += page_size) {
+        checksum ^= static_cast<const volatile uint8_t*>(data)[offset];
+      }
+      (void)checksum;
+
+      std::scoped_lock lock(asset_manager->mutex_);
+      // The asset was handed out while it was being prefetched.
+      if (asset_manager->pending_prefetches_.erase(asset_name) == 0) {
+        continue;
+      }
+      asset_manager->prefetched_assets_.emplace(asset_name,
+                                                std::move(mapping));
+    }
+  });
+}
+
+void AssetManager::ClearPrefetchedAssets() {
+  std::scoped_lock lock(mutex_);
+  pending_prefetches_.clear();
+  prefetched_assets_.clear();
+}
+
+void AssetManager::SetRecordsAssetNames(bool records_asset_names) {
+  std::scoped_lock lock(mutex_);
+  records_asset_names_ = records_asset_names;
+}
+
+std::vector<std::string> AssetManager::TakeRecordedAssetNames() {
+  std::scoped_lock lock(mutex_);
+  std::vector<std::string> asset_names;
+  asset_names.swap(recorded_asset_names_);
+  recorded_asset_names_set_.clear();
+  return asset_names;
+}
+
+void AssetManager::TakeAssetNameRecording(AssetManager& other) {
+  if (&other == this) {
+    return;
+  }
+  std::scoped_lock lock(mutex_, other.mutex_);
+  records_asset_names_ = records_asset_names_ || other.records_asset_names_;
+  for (const auto& asset_name : recorded_asset_names_) {
+    if (other.recorded_asset_names_set_.insert(asset_name).second) {
+      other.recorded_asset_names_.push_back(asset_name);
+    }
+  }
+  recorded_asset_names_.swap(other.recorded_asset_names_);
+  recorded_asset_names_set_.swap(other.recorded_asset_names_set_);
+  other.records_asset_names_ = false;
+  other.recorded_asset_names_.clear();
+  other.recorded_asset_names_set_.clear();
+}
+
+void AssetManager::RecordAssetName(const std::string& asset_name) const {
+  std::scoped_lock lock(mutex_);
+  if (!records_asset_names_) {
+    return;
+  }
+  if (recorded_asset_names_set_.insert(asset_name).second) {
+    recorded_asset_names_.push_back(asset_name);
+  }
+}
+
 // |AssetResolver|
 bool AssetManager::IsValid() const {
   return resolvers_.size() > 0;
@@ -6,17 +6,29 @@
 #define FLUTTER_ASSETS_ASSET_MANAGER_H_
 
 #include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 
 namespace flutter {
 
-class AssetManager final : public AssetResolver {
+// Resolvers must be added before the asset manager is shared with other
+// threads. Lookups (synchronous, asynchronous and prefetches) may then happen
+// concurrently.
+class AssetManager final : public AssetResolver,
+                           public std::enable_shared_from_this<AssetManager> {
  public:
+  using MappingCallback = std::function<void(std::unique_ptr<fml::Mapping>)>;
+
   AssetManager();
 
   ~AssetManager() override;
@@ -32,9 +44,75 @@ class AssetManager final : public AssetResolver {
   std::unique_ptr<fml::Mapping> GetAsMapping(
       const std::string& asset_name) const override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Resolves an asset on a worker instead of the calling thread.
+  ///             The asset manager is kept alive till the lookup completes.
+  ///
+  /// @param[in]  asset_name  The name of the asset.
+  /// @param[in]  worker      The task runner on which to resolve the asset.
+  /// @param[in]  callback    Invoked on the worker with the mapping of the
+  ///                         asset, or null if the asset could not be found.
+  ///                         Callers must re-thread as necessary.
+  ///
+  void GetAsMappingAsync(const std::string& asset_name,
+                         std::shared_ptr<fml::ConcurrentTaskRunner> worker,
+                         MappingCallback callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Resolves the given assets on a worker and faults their pages
+  ///             into memory. Each prefetched mapping is held by the asset
+  ///             manager until the asset is first requested via
+  ///             |GetAsMapping| (which then hands it out without touching the
+  ///             resolvers) or until |ClearPrefetchedAssets| is called.
+  ///             Prefetches of assets that were requested before the
+  ///             prefetch completed are dropped.
+  ///
+  /// @param[in]  asset_names  The assets to prefetch, usually read from a
+  ///                          manifest recorded by a previous run.
+  /// @param[in]  worker       The task runner on which to prefetch.
+  ///
+  void Prefetch(std::vector<std::string> asset_names,
+                std::shared_ptr<fml::ConcurrentTaskRunner> worker);
+
+  void ClearPrefetchedAssets();
+
+  //----------------------------------------------------------------------------
+  /// @brief      While enabled, the names of all assets successfully looked up
+  ///             are recorded in first-access order. These can be collected
+  ///             with |TakeRecordedAssetNames| and used to build a prefetch
+  ///             manifest for subsequent runs.
+  ///
+  void SetRecordsAssetNames(bool records_asset_names);
+
+  std::vector<std::string> TakeRecordedAssetNames();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Continues the recording of asset names of another asset
+  ///             manager that this one replaces. This asset manager records
+  ///             names if |other| did, and the names |other| recorded so far
+  ///             are moved ahead of the ones recorded by this asset manager.
+  ///             |other| stops recording.
+  ///
+  void TakeAssetNameRecording(AssetManager& other);
+
  private:
   std::deque<std::unique_ptr<AssetResolver>> resolvers_;
 
+  mutable std::mutex mutex_;
+  // The assets that are to be prefetched but were neither prefetched nor
+  // requested yet.
+  mutable std::unordered_set<std::string> pending_prefetches_;
+  mutable std::unordered_map<std::string, std::unique_ptr<fml::Mapping>>
+      prefetched_assets_;
+  bool records_asset_names_ = false;
+  mutable std::vector<std::string> recorded_asset_names_;
+  mutable std::unordered_set<std::string> recorded_asset_names_set_;
+
+  std::unique_ptr<fml::Mapping> ResolveAsMapping(
+      const std::string& asset_name) const;
+
+  void RecordAssetName(const std::string& asset_name) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManager);
 };
 
@@ -0,0 +1,258 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/asset_manager.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Serves assets out of memory and counts how often each is resolved.
+class TestAssetResolver final : public AssetResolver {
+ public:
+  explicit TestAssetResolver(std::map<std::string, std::string> assets)
+      : assets_(std::move(assets)) {}
+
+  size_t GetLookupCount(const std::string& asset_name) const {
+    auto found = lookup_counts_.find(asset_name);
+    return found == lookup_counts_.end() ? 0 : found->second.load();
+  }
+
+  // |AssetResolver|
+  bool IsValid() const override { return true; }
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override {
+    auto found = assets_.find(asset_name);
+    if (found == assets_.end()) {
+      return nullptr;
+    }
+    lookup_counts_.at(asset_name)++;
+    return std::make_unique<fml::DataMapping>(found->second);
+  }
+
+ private:
+  const std::map<std::string, std::string> assets_;
+  // Only the counts of assets present are modified, and those are created
+  // up front, so that the map itself is never modified concurrently.
+  mutable std::map<std::string, std::atomic<size_t>> lookup_counts_ =
+      CreateLookupCounts(assets_);
+
+  static std::map<std::string, std::atomic<size_t>> CreateLookupCounts(
+      const std::map<std::string, std::string>& assets) {
+    std::map<std::string, std::atomic<size_t>> counts;
+    for (const auto& asset : assets) {
+      counts[asset.first] = 0;
+    }
+    return counts;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TestAssetResolver);
+};
+
+std::string ToString(const std::unique_ptr<fml::Mapping>& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                     mapping->GetSize());
+}
+
+// Waits until the tasks posted to a single worker so far have run.
+void WaitForWorker(const std::shared_ptr<fml::ConcurrentTaskRunner>& worker) {
+  fml::AutoResetWaitableEvent latch;
+  worker->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+}
+
+}  // namespace
+
+class AssetManagerTest : public ::testing::Test {
+ protected:
+  AssetManagerTest()
+      : loop_(fml::ConcurrentMessageLoop::Create(1)),
+        asset_manager_(std::make_shared<AssetManager>()) {
+    auto resolver = std::make_unique<TestAssetResolver>(
+        std::map<std::string, std::string>{{"a.txt", "a"}, {"b.txt", "b"}});
+    resolver_ = resolver.get();
+    asset_manager_->PushBack(std::move(resolver));
+  }
+
+  std::shared_ptr<fml::ConcurrentTaskRunner> worker() {
+    return loop_->GetTaskRunner();
+  }
+
+  AssetManager& asset_manager() { return *asset_manager_; }
+
+  const TestAssetResolver& resolver() const { return *resolver_; }
+
+ private:
+  std::shared_ptr<fml::ConcurrentMessageLoop> loop_;
+  std::shared_ptr<AssetManager> asset_manager_;
+  TestAssetResolver* resolver_ = nullptr;
+};
+
+TEST_F(AssetManagerTest, ResolvesAssetsAsynchronously) {
+  fml::AutoResetWaitableEvent latch;
+  std::unique_ptr<fml::Mapping> found;
+  std::unique_ptr<fml::Mapping> missing;
+  asset_manager().GetAsMappingAsync(
+      "a.txt", worker(), [&](std::unique_ptr<fml::Mapping> mapping) {
+        found = std::move(mapping);
+      });
+  asset_manager().GetAsMappingAsync(
+      "missing.txt", worker(), [&](std::unique_ptr<fml::Mapping> mapping) {
+        missing = std::move(mapping);
+        latch.Signal();
+      });
+  latch.Wait();
+
+  ASSERT_TRUE(found);
+  ASSERT_EQ(ToString(found), "a");
+  ASSERT_FALSE(missing);
+}
+
+TEST_F(AssetManagerTest, AsynchronousLookupsKeepTheAssetManagerAlive) {
+  auto asset_manager = std::make_shared<AssetManager>();
+  asset_manager->PushBack(std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"a.txt", "a"}}));
+
+  fml::AutoResetWaitableEvent blocker;
+  fml::AutoResetWaitableEvent latch;
+  std::unique_ptr<fml::Mapping> found;
+  worker()->PostTask([&blocker]() { blocker.Wait(); });
+  asset_manager->GetAsMappingAsync(
+      "a.txt", worker(), [&](std::unique_ptr<fml::Mapping> mapping) {
+        found = std::move(mapping);
+        latch.Signal();
+      });
+  asset_manager.reset();
+  blocker.Signal();
+  latch.Wait();
+
+  ASSERT_TRUE(found);
+  ASSERT_EQ(ToString(found), "a");
+}
+
+TEST_F(AssetManagerTest, HandsOutPrefetchedAssetsOnce) {
+  asset_manager().Prefetch({"a.txt", "missing.txt"}, worker());
+  WaitForWorker(worker());
+  ASSERT_EQ(resolver().GetLookupCount("a.txt"), 1u);
+
+  auto prefetched = asset_manager().GetAsMapping("a.txt");
+  ASSERT_TRUE(prefetched);
+  ASSERT_EQ(ToString(prefetched), "a");
+  ASSERT_EQ(resolver().GetLookupCount("a.txt"), 1u);
+
+  auto resolved = asset_manager().GetAsMapping("a.txt");
+  ASSERT_TRUE(resolved);
+  ASSERT_EQ(ToString(resolved), "a");
+  ASSERT_EQ(resolver().GetLookupCount("a.txt"), 2u);
+}
+
+TEST_F(AssetManagerTest, DoesNotPrefetchAssetsTwice) {
+  asset_manager().Prefetch({"a.txt", "a.txt"}, worker());
+  asset_manager().Prefetch({"a.txt"}, worker());
+  WaitForWorker(worker());
+  ASSERT_EQ(resolver().GetLookupCount("a.txt"), 1u);
+}
+
+TEST_F(AssetManagerTest, DropsPrefetchesOfAssetsHandedOutBefore) {
+  fml::AutoResetWaitableEvent blocker;
+  worker()->PostTask([&blocker]() { blocker.Wait(); });
+  asset_manager().Prefetch({"a.txt"}, worker());
+  auto resolved = asset_manager().GetAsMapping("a.txt");
+  ASSERT_TRUE(resolved);
+  blocker.Signal();
+  WaitForWorker(worker());
+  ASSERT_EQ(resolver().GetLookupCount("a.txt"), 1u);
+
+  // Nothing is held for the asset.
+  resolved = asset_manager().GetAsMapping("a.txt");
+  ASSERT_TRUE(resolved);
+  ASSERT_EQ(resolver().GetLookupCount("a.txt"), 2u);
+}
+
+TEST_F(AssetManagerTest, ClearsPrefetchedAssets) {
+  asset_manager().Prefetch({"a.txt"}, worker());
+  WaitForWorker(worker());
+  asset_manager().ClearPrefetchedAssets();
+
+  auto resolved = asset_manager().GetAsMapping("a.txt");
+  ASSERT_TRUE(resolved);
+  ASSERT_EQ(resolver().GetLookupCount("a.txt"), 2u);
+}
+
+TEST_F(AssetManagerTest, RecordsAssetNamesInFirstAccessOrder) {
+  auto unused = asset_manager().GetAsMapping("a.txt");
+  ASSERT_TRUE(asset_manager().TakeRecordedAssetNames().empty());
+
+  asset_manager().SetRecordsAssetNames(true);
+  unused = asset_manager().GetAsMapping("b.txt");
+  unused = asset_manager().GetAsMapping("missing.txt");
+  unused = asset_manager().GetAsMapping("a.txt");
+  unused = asset_manager().GetAsMapping("b.txt");
+  ASSERT_EQ(asset_manager().TakeRecordedAssetNames(),
+            std::vector<std::string>({"b.txt", "a.txt"}));
+  ASSERT_TRUE(asset_manager().TakeRecordedAssetNames().empty());
+
+  unused = asset_manager().GetAsMapping("a.txt");
+  asset_manager().SetRecordsAssetNames(false);
+  unused = asset_manager().GetAsMapping("b.txt");
+  ASSERT_EQ(asset_manager().TakeRecordedAssetNames(),
+            std::vector<std::string>({"a.txt"}));
+}
+
+TEST_F(AssetManagerTest, RecordsPrefetchedAssetsWhenTheyAreUsed) {
+  asset_manager().SetRecordsAssetNames(true);
+  asset_manager().Prefetch({"a.txt", "b.txt"}, worker());
+  WaitForWorker(worker());
+  ASSERT_TRUE(asset_manager().TakeRecordedAssetNames().empty());
+
+  auto unused = asset_manager().GetAsMapping("b.txt");
+  ASSERT_EQ(asset_manager().TakeRecordedAssetNames(),
+            std::vector<std::string>({"b.txt"}));
+}
+
+TEST_F(AssetManagerTest, ReplacementsContinueTheRecording) {
+  asset_manager().SetRecordsAssetNames(true);
+  auto unused = asset_manager().GetAsMapping("b.txt");
+
+  AssetManager replacement;
+  replacement.PushBack(std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"a.txt", "a"}, {"b.txt", "b"}}));
+  replacement.TakeAssetNameRecording(asset_manager());
+  ASSERT_TRUE(asset_manager().TakeRecordedAssetNames().empty());
+
+  unused = asset_manager().GetAsMapping("a.txt");
+  ASSERT_TRUE(asset_manager().TakeRecordedAssetNames().empty());
+
+  unused = replacement.GetAsMapping("a.txt");
+  unused = replacement.GetAsMapping("b.txt");
+  ASSERT_EQ(replacement.TakeRecordedAssetNames(),
+            std::vector<std::string>({"b.txt", "a.txt"}));
+}
+
+TEST_F(AssetManagerTest, ReplacementsOfIdleAssetManagersDoNotRecord) {
+  AssetManager replacement;
+  replacement.PushBack(std::make_unique<TestAssetResolver>(
+      std::map<std::string, std::string>{{"a.txt", "a"}}));
+  replacement.TakeAssetNameRecording(asset_manager());
+
+  auto unused = replacement.GetAsMapping("a.txt");
+  ASSERT_TRUE(replacement.TakeRecordedAssetNames().empty());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "flutter/assets/asset_manager.h"
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/packed_asset_bundle.h"
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+// Creates `count` small assets spread across a handful of subdirectories, the
+// way a typical app with many images and translations is laid out.
+static std::vector<std::string> CreateAssets(const fml::UniqueFD& directory,
+                                             size_t count) {
+  constexpr size_t kDirectoryCount = 8;
+  std::vector<std::string> names;
+  for (size_t i = 0; i < kDirectoryCount; i++) {
+    auto subdirectory =
+        fml::CreateDirectory(directory, {"dir" + std::to_string(i)},
+                             fml::FilePermission::kReadWrite);
+    FML_CHECK(subdirectory.is_valid());
+  }
+  for (size_t i = 0; i < count; i++) {
+    const auto subdirectory = "dir" + std::to_string(i % kDirectoryCount);
+    const auto file_name = "asset_" + std::to_string(i) + ".bin";
+    auto subdirectory_fd =
+        fml::OpenDirectory(directory, subdirectory.c_str(), false,
+                           fml::FilePermission::kReadWrite);
+    FML_CHECK(fml::WriteAtomically(subdirectory_fd, file_name.c_str(),
+                                   fml::DataMapping(std::string(256, 'a'))));
+    names.push_back(subdirectory + "/" + file_name);
+  }
+  return names;
+}
+
+static void LookupAssets(benchmark::State& state,
+                         const AssetResolver& resolver,
+                         const std::vector<std::string>& names) {
+  size_t index = 0;
+  while (state.KeepRunning()) {
+    // Stride through the names so consecutive lookups don't hit neighbouring
+    // index entries or directory entries.
+    index = (index + 7919) % names.size();
+    auto mapping = resolver.GetAsMapping(names[index]);
+    FML_CHECK(mapping);
+    benchmark::DoNotOptimize(mapping->GetMapping());
+  }
+}
+
+static void BM_DirectoryAssetBundleLookup(benchmark::State& state) {
+  fml::ScopedTemporaryDirectory assets_dir;
+  const auto names = CreateAssets(assets_dir.fd(), state.range(0));
+  DirectoryAssetBundle bundle(fml::OpenDirectory(
+      assets_dir.path().c_str(), false, fml::FilePermission::kRead));
+  LookupAssets(state, bundle, names);
+}
+
+BENCHMARK(BM_DirectoryAssetBundleLookup)->Range(64, 4096);
+
+static void PackedAssetBundleLookup(benchmark::State& state, bool compress) {
+  fml::ScopedTemporaryDirectory assets_dir;
+  fml::ScopedTemporaryDirectory pack_dir;
+  const auto names = CreateAssets(assets_dir.fd(), state.range(0));
+  PackedAssetBundleOptions options;
+  options.compress = compress;
+  FML_CHECK(WritePackedAssetBundle(assets_dir.fd(), pack_dir.fd(),
+                                   kPackedAssetBundleFileName, options));
+  PackedAssetBundle bundle(fml::OpenFile(pack_dir.fd(),
+                                         kPackedAssetBundleFileName, false,
+                                         fml::FilePermission::kRead));
+  LookupAssets(state, bundle, names);
+}
+
+static void BM_PackedAssetBundleLookup(benchmark::State& state) {
+  PackedAssetBundleLookup(state, false);
+}
+
+BENCHMARK(BM_PackedAssetBundleLookup)->Range(64, 4096);
+
+static void BM_CompressedPackedAssetBundleLookup(benchmark::State& state) {
+  PackedAssetBundleLookup(state, true);
+}
+
+BENCHMARK(BM_CompressedPackedAssetBundleLookup)->Range(64, 4096);
+
+static void BM_PackedAssetBundleOpen(benchmark::State& state) {
+  fml::ScopedTemporaryDirectory assets_dir;
+  fml::ScopedTemporaryDirectory pack_dir;
+  CreateAssets(assets_dir.fd(), state.range(0));
+  FML_CHECK(WritePackedAssetBundle(assets_dir.fd(), pack_dir.fd(),
+                                   kPackedAssetBundleFileName));
+  while (state.KeepRunning()) {
+    PackedAssetBundle bundle(fml::OpenFile(pack_dir.fd(),
+                                           kPackedAssetBundleFileName, false,
+                                           fml::FilePermission::kRead));
+    FML_CHECK(bundle.GetAssetCount() == static_cast<size_t>(state.range(0)));
+  }
+}
+
+BENCHMARK(BM_PackedAssetBundleOpen)->Range(64, 4096);
+
+}  // namespace flutter
@@ -0,0 +1,451 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/zlib/zlib.h"
+
+namespace flutter {
+
+namespace {
+
+// Layout of a packed asset bundle. All integers are little endian. That is the
+// byte order of every platform the engine runs on, so the structures below are
+// read from and written to the file as they are laid out in memory. Hosts with
+// another byte order refuse to read or write bundles.
+//
+// +------------------+
+// | Header           |
+// +------------------+
+// | Entry 0..N-1     |  Sorted by name hash, then by name.
+// +------------------+
+// | Names            |  Not null terminated.
+// +------------------+
+// | Asset data       |  Each asset is aligned to kDataAlignment and is
+// +------------------+  optionally compressed with raw deflate.
+constexpr char kMagic[8] = {'F', 'L', 'T', 'P', 'A', 'C', 'K', '\0'};
+constexpr uint32_t kVersion = 2;
+constexpr size_t kDataAlignment = 16;
+
+// Compressed input is fed to the decoder in chunks of this size so that only a
+// bounded window of the compressed data is paged in ahead of the decoder.
+constexpr size_t kInflateChunkSize = 64 * 1024;
+
+// Assets are only stored compressed if that saves at least this fraction of
+// their size. Already compressed formats (PNG, JPEG, WebP) usually don't.
+constexpr double kMinCompressionSavings = 0.1;
+
+// Deflate can't compress data by more than this factor. Compressed entries
+// claiming to inflate to more are corrupt, and are rejected before the
+// inflated size is ever allocated.
+constexpr uint64_t kMaxDeflateRatio = 1032;
+
+enum class Compression : uint32_t {
+  kNone = 0,
+  kDeflate = 1,
+};
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t entry_count;
+  uint64_t names_offset;
+  uint64_t names_size;
+};
+
+static_assert(sizeof(Header) == 32, "Header must be tightly packed.");
+
+struct Entry {
+  uint64_t name_hash;
+  uint64_t data_offset;
+  // The number of bytes stored in the bundle.
+  uint64_t data_size;
+  uint64_t uncompressed_size;
+  uint32_t name_offset;
+  uint32_t name_size;
+  Compression compression;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(Entry) == 48, "Entry must be tightly packed.");
+
+// FNV-1a. This is part of the file format and must not change without bumping
+// |kVersion|.
+uint64_t HashAssetName(const char* name, size_t size) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= static_cast<uint8_t>(name[i]);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+bool IsLittleEndianHost() {
+  const uint16_t value = 1;
+  uint8_t first_byte = 0;
+  ::memcpy(&first_byte, &value, 1);
+  return first_byte == 1;
+}
+
+size_t AlignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+std::unique_ptr<fml::Mapping> InflateAsset(const uint8_t* data,
+                                           size_t size,
+                                           size_t uncompressed_size) {
+  TRACE_EVENT0("flutter", "PackedAssetBundle::InflateAsset");
+  std::vector<uint8_t> inflated(uncompressed_size);
+
+  z_stream stream = {};
+  if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+    return nullptr;
+  }
+  stream.next_out = inflated.data();
+  stream.avail_out = inflated.size();
+
+  size_t offset = 0;
+  int result = Z_OK;
+  while (result == Z_OK) {
+    if (stream.avail_in == 0) {
+      if (offset == size) {
+        break;
+      }
+      const size_t chunk = std::min(kInflateChunkSize, size - offset);
+      stream.next_in = const_cast<uint8_t*>(data + offset);
+      stream.avail_in = chunk;
+      offset += chunk;
+    }
+    result = inflate(&stream, Z_NO_FLUSH);
+  }
+
+  const bool success =
+      result == Z_STREAM_END && stream.total_out == uncompressed_size;
+  inflateEnd(&stream);
+
+  if (!success) {
+    FML_LOG(ERROR) << "Could not inflate compressed asset.";
+    return nullptr;
+  }
+
+  return std::make_unique<fml::DataMapping>(std::move(inflated));
+}
+
+bool DeflateAsset(const uint8_t* data,
+                  size_t size,
+                  std::vector<uint8_t>& deflated) {
+  z_stream stream = {};
+  if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    return false;
+  }
+
+  deflated.resize(deflateBound(&stream, size));
+  stream.next_in = const_cast<uint8_t*>(data);
+  stream.avail_in = size;
+  stream.next_out = deflated.data();
+  stream.avail_out = deflated.size();
+
+  const int result = deflate(&stream, Z_FINISH);
+  deflated.resize(stream.total_out);
+  deflateEnd(&stream);
+
+  return result == Z_STREAM_END;
+}
+
+}  // namespace
+
+PackedAssetBundle::PackedAssetBundle(fml::UniqueFD descriptor) {
+  TRACE_EVENT0("flutter", "PackedAssetBundle::PackedAssetBundle");
+  if (!IsLittleEndianHost()) {
+    FML_LOG(ERROR) << "Packed asset bundles are only supported on little "
+                      "endian hosts.";
+    return;
+  }
+
+  auto mapping = fml::FileMapping::CreateReadOnly(descriptor);
+  if (!mapping) {
+    return;
+  }
+
+  const uint8_t* base = mapping->GetMapping();
+  const size_t size = mapping->GetSize();
+
+  if (size < sizeof(Header)) {
+    FML_LOG(ERROR) << "Packed asset bundle is too small.";
+    return;
+  }
+
+  const auto* header = reinterpret_cast<const Header*>(base);
+  if (::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion) {
+    FML_LOG(ERROR) << "Packed asset bundle has an unknown format.";
+    return;
+  }
+
+  const size_t entries_size =
+      static_cast<size_t>(header->entry_count) * sizeof(Entry);
+  if (sizeof(Header) + entries_size > size ||
+      header->names_offset < sizeof(Header) + entries_size ||
+      header->names_offset > size ||
+      header->names_size > size - header->names_offset) {
+    FML_LOG(ERROR) << "Packed asset bundle index is out of bounds.";
+    return;
+  }
+
+  const auto* entries = reinterpret_cast<const Entry*>(base + sizeof(Header));
+  for (size_t i = 0; i < header->entry_count; i++) {
+    const auto& entry = entries[i];
+    if (entry.name_offset > header->names_size ||
+        entry.name_size > header->names_size - entry.name_offset ||
+        entry.data_offset > size ||
+        entry.data_size > size - entry.data_offset) {
+      FML_LOG(ERROR) << "Packed asset bundle entry is out of bounds.";
+      return;
+    }
+    if (entry.compression != Compression::kDeflate &&
+        (entry.compression != Compression::kNone ||
+         entry.uncompressed_size != entry.data_size)) {
+      FML_LOG(ERROR) << "Packed asset bundle entry has an unknown encoding.";
+      return;
+    }
+    if (entry.compression == Compression::kDeflate &&
+        (entry.uncompressed_size / kMaxDeflateRatio > entry.data_size ||
+         entry.uncompressed_size > std::numeric_limits<size_t>::max())) {
+      FML_LOG(ERROR) << "Packed asset bundle entry has an invalid size.";
+      return;
+    }
+  }
+
+  entries_ = entries;
+  entry_count_ = header->entry_count;
+  names_ = reinterpret_cast<const char*>(base + header->names_offset);
+  mapping_ = std::move(mapping);
+  is_valid_ = true;
+}
+
+PackedAssetBundle::~PackedAssetBundle() = default;
+
+size_t PackedAssetBundle::GetAssetCount() const {
+  return entry_count_;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValid() const {
+  return is_valid_;
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetAsMapping(
+    const std::string& asset_name) const {
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return nullptr;
+  }
+
+  const uint64_t hash = HashAssetName(asset_name.data(), asset_name.size());
+  const auto* begin = static_cast<const Entry*>(entries_);
+  const auto* end = begin + entry_count_;
+  const auto* entry = std::lower_bound(
+      begin, end, hash, [](const Entry& candidate, uint64_t value) {
+        return candidate.name_hash < value;
+      });
+
+  for (; entry != end && entry->name_hash == hash; ++entry) {
+    if (entry->name_size != asset_name.size() ||
+        ::memcmp(names_ + entry->name_offset, asset_name.data(),
+                 asset_name.size()) != 0) {
+      continue;
+    }
+
+    const uint8_t* data = mapping_->GetMapping() + entry->data_offset;
+
+    if (entry->compression == Compression::kDeflate) {
+      return InflateAsset(data, entry->data_size, entry->uncompressed_size);
+    }
+
+    // The slice keeps the bundle mapping alive so that it may outlive the
+    // bundle itself.
+    return std::make_unique<fml::NonOwnedMapping>(
+        data, entry->data_size,
+        [mapping = mapping_](const uint8_t*, size_t) {});
+  }
+
+  return nullptr;
+}
+
+namespace {
+
+struct PendingAsset {
+  std::string name;
+  std::unique_ptr<fml::FileMapping> data;
+  std::vector<uint8_t> deflated;
+  bool is_deflated = false;
+  uint64_t name_hash = 0;
+
+  const uint8_t* GetStoredData() const {
+    return is_deflated ? deflated.data() : data->GetMapping();
+  }
+
+  size_t GetStoredSize() const {
+    return is_deflated ? deflated.size() : data->GetSize();
+  }
+};
+
+bool CollectAssets(const fml::UniqueFD& directory,
+                   const std::string& prefix,
+                   const std::string& skip_name,
+                   std::vector<PendingAsset>& assets) {
+  bool success = true;
+  fml::VisitFiles(directory, [&](const fml::UniqueFD& parent,
+                                 const std::string& filename) {
+    auto name = prefix + filename;
+    if (name == skip_name) {
+      return true;
+    }
+
+    if (fml::IsDirectory(parent, filename.c_str())) {
+      auto child = fml::OpenDirectoryReadOnly(parent, filename.c_str());
+      success = child.is_valid() &&
+                CollectAssets(child, name + "/", skip_name, assets);
+      return success;
+    }
+
+    auto data = fml::FileMapping::CreateReadOnly(parent, filename);
+    if (!data) {
+      FML_LOG(ERROR) << "Could not read asset: " << name;
+      success = false;
+      return false;
+    }
+
+    PendingAsset asset;
+    asset.name_hash = HashAssetName(name.data(), name.size());
+    asset.name = std::move(name);
+    asset.data = std::move(data);
+    assets.emplace_back(std::move(asset));
+    return true;
+  });
+  return success;
+}
+
+}  // namespace
+
+bool WritePackedAssetBundle(const fml::UniqueFD& source_directory,
+                            const fml::UniqueFD& destination_directory,
+                            const char* file_name,
+                            const PackedAssetBundleOptions& options) {
+  TRACE_EVENT0("flutter", "WritePackedAssetBundle");
+  if (!IsLittleEndianHost()) {
+    FML_LOG(ERROR) << "Packed asset bundles are only supported on little "
+                      "endian hosts.";
+    return false;
+  }
+  if (!fml::IsDirectory(source_directory) ||
+      !fml::IsDirectory(destination_directory) || file_name == nullptr) {
+    return false;
+  }
+
+  // Don't pack a previously written bundle into the new one.
+  std::vector<PendingAsset> assets;
+  if (!CollectAssets(source_directory, "", file_name, assets)) {
+    return false;
+  }
+
+  if (options.compress) {
+    for (auto& asset : assets) {
+      const size_t size = asset.data->GetSize();
+      if (size == 0 || options.uncompressed_assets.count(asset.name) != 0) {
+        continue;
+      }
+      if (!DeflateAsset(asset.data->GetMapping(), size, asset.deflated)) {
+        FML_LOG(ERROR) << "Could not compress asset: " << asset.name;
+        return false;
+      }
+      asset.is_deflated =
+          asset.deflated.size() < size * (1.0 - kMinCompressionSavings);
+      if (!asset.is_deflated) {
+        asset.deflated.clear();
+      }
+    }
+  }
+
+  std::sort(assets.begin(), assets.end(),
+            [](const PendingAsset& a, const PendingAsset& b) {
+              return std::tie(a.name_hash, a.name) <
+                     std::tie(b.name_hash, b.name);
+            });
+
+  std::string names;
+  for (const auto& asset : assets) {
+    names += asset.name;
+  }
+  // Entries locate their names with 32 bit offsets.
+  if (names.size() > std::numeric_limits<uint32_t>::max() ||
+      assets.size() > std::numeric_limits<uint32_t>::max()) {
+    FML_LOG(ERROR) << "Too many assets to pack into a single bundle.";
+    return false;
+  }
+
+  const size_t names_offset = sizeof(Header) + assets.size() * sizeof(Entry);
+  size_t data_offset = AlignUp(names_offset + names.size(), kDataAlignment);
+
+  std::vector<Entry> entries;
+  entries.reserve(assets.size());
+  size_t name_offset = 0;
+  for (const auto& asset : assets) {
+    Entry entry = {};
+    entry.name_hash = asset.name_hash;
+    entry.name_offset = name_offset;
+    entry.name_size = asset.name.size();
+    entry.data_offset = data_offset;
+    entry.data_size = asset.GetStoredSize();
+    entry.uncompressed_size = asset.data->GetSize();
+    entry.compression =
+        asset.is_deflated ? Compression::kDeflate : Compression::kNone;
+    entries.push_back(entry);
+
+    name_offset += asset.name.size();
+    data_offset = AlignUp(data_offset + entry.data_size, kDataAlignment);
+  }
+
+  std::vector<uint8_t> buffer(data_offset, 0);
+
+  Header header = {};
+  ::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.entry_count = entries.size();
+  header.names_offset = names_offset;
+  header.names_size = names.size();
+  ::memcpy(buffer.data(), &header, sizeof(header));
+
+  if (!entries.empty()) {
+    ::memcpy(buffer.data() + sizeof(Header), entries.data(),
+             entries.size() * sizeof(Entry));
+  }
+  ::memcpy(buffer.data() + names_offset, names.data(), names.size());
+
+  for (size_t i = 0; i < assets.size(); i++) {
+    if (entries[i].data_size == 0) {
+      continue;
+    }
+    ::memcpy(buffer.data() + entries[i].data_offset,
+             assets[i].GetStoredData(), entries[i].data_size);
+  }
+
+  return fml::WriteAtomically(destination_directory, file_name,
+                              fml::DataMapping(std::move(buffer)));
+}
+
+}  // namespace flutter
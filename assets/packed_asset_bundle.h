@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+#define FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace flutter {
+
+// The name of the packed asset bundle file the engine looks for in the
+// application's asset directory.
+constexpr char kPackedAssetBundleFileName[] = "assets.flutterpack";
+
+//------------------------------------------------------------------------------
+/// An asset resolver that serves all assets out of a single file. The file is
+/// mapped once when the bundle is created and contains an index of the assets
+/// sorted by the hash of their names. Lookups are a binary search over this
+/// index and return slices of the mapping without touching the filesystem.
+///
+/// Individual assets may be stored compressed. These are inflated into a new
+/// buffer on lookup, streaming from the mapping. On slow storage, reading fewer
+/// bytes and inflating them is faster than reading the raw asset.
+///
+/// Bundles are produced by |WritePackedAssetBundle|, usually via the
+/// `pack_assets` host tool.
+///
+class PackedAssetBundle : public AssetResolver {
+ public:
+  explicit PackedAssetBundle(fml::UniqueFD descriptor);
+
+  ~PackedAssetBundle() override;
+
+  size_t GetAssetCount() const;
+
+ private:
+  std::shared_ptr<const fml::FileMapping> mapping_;
+  const void* entries_ = nullptr;
+  size_t entry_count_ = 0;
+  const char* names_ = nullptr;
+  bool is_valid_ = false;
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetBundle);
+};
+
+struct PackedAssetBundleOptions {
+  // Whether to compress assets. Assets that don't shrink meaningfully, such as
+  // already compressed images, are always stored uncompressed.
+  bool compress = false;
+
+  // Assets that are stored uncompressed even when compression is enabled.
+  // Frequently used assets should be listed here so that they can be served
+  // directly out of the mapping.
+  std::unordered_set<std::string> uncompressed_assets;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Packs all files under a directory into a single asset bundle
+///             that can be read by |PackedAssetBundle|.
+///
+/// @param[in]  source_directory       The directory containing the assets.
+///                                    Asset names are the paths of the files
+///                                    relative to this directory.
+/// @param[in]  destination_directory  The directory in which to write the
+///                                    bundle.
+/// @param[in]  file_name              The file name of the bundle.
+/// @param[in]  options                Controls how assets are stored.
+///
+/// @return     If the bundle was written successfully.
+///
+bool WritePackedAssetBundle(const fml::UniqueFD& source_directory,
+                            const fml::UniqueFD& destination_directory,
+                            const char* file_name,
+                            const PackedAssetBundleOptions& options = {});
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
@@ -0,0 +1,401 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Offsets of the fields the tests corrupt. These mirror the layout documented
+// in packed_asset_bundle.cc.
+constexpr size_t kHeaderSize = 32;
+constexpr size_t kHeaderVersionOffset = 8;
+constexpr size_t kHeaderEntryCountOffset = 12;
+constexpr size_t kHeaderNamesOffsetOffset = 16;
+constexpr size_t kHeaderNamesSizeOffset = 24;
+constexpr size_t kEntrySize = 48;
+constexpr size_t kEntryDataOffsetOffset = 8;
+constexpr size_t kEntryDataSizeOffset = 16;
+constexpr size_t kEntryUncompressedSizeOffset = 24;
+constexpr size_t kEntryNameOffsetOffset = 32;
+constexpr size_t kEntryNameSizeOffset = 36;
+constexpr size_t kEntryCompressionOffset = 40;
+
+constexpr uint32_t kCompressionNone = 0;
+constexpr uint32_t kCompressionDeflate = 1;
+
+constexpr char kCorruptBundleFileName[] = "corrupt.flutterpack";
+
+// Text compresses well, so it is stored compressed when compression is on.
+std::string CompressibleContents() {
+  std::string contents;
+  for (size_t i = 0; i < 256; i++) {
+    contents += "line " + std::to_string(i) + " of a compressible asset\n";
+  }
+  return contents;
+}
+
+// Bytes from a linear congruential generator don't compress, so they are
+// always stored as they are.
+std::string IncompressibleContents() {
+  std::string contents(4096, '\0');
+  uint32_t state = 1;
+  for (auto& byte : contents) {
+    state = state * 1664525u + 1013904223u;
+    byte = static_cast<char>(state >> 24);
+  }
+  return contents;
+}
+
+std::string ToString(const std::unique_ptr<fml::Mapping>& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                     mapping->GetSize());
+}
+
+// The bundle only implements the resolver interface privately.
+bool IsValid(const AssetResolver& resolver) {
+  return resolver.IsValid();
+}
+
+std::unique_ptr<fml::Mapping> Get(const AssetResolver& resolver,
+                                  const std::string& name) {
+  return resolver.GetAsMapping(name);
+}
+
+template <typename T>
+void Patch(std::vector<uint8_t>& bytes, size_t offset, T value) {
+  ASSERT_LE(offset + sizeof(T), bytes.size());
+  ::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T Read(const std::vector<uint8_t>& bytes, size_t offset) {
+  T value = {};
+  EXPECT_LE(offset + sizeof(T), bytes.size());
+  ::memcpy(&value, bytes.data() + offset, sizeof(T));
+  return value;
+}
+
+}  // namespace
+
+class PackedAssetBundleTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    // Temporary directories are only removed when they are empty.
+    for (const auto& name : asset_names_) {
+      fml::UnlinkFile(assets_directory_.fd(), name.c_str());
+    }
+    for (const auto& name : subdirectory_names_) {
+      fml::UnlinkDirectory(assets_directory_.fd(), name.c_str());
+    }
+    fml::UnlinkFile(bundle_directory_.fd(), kPackedAssetBundleFileName);
+    fml::UnlinkFile(bundle_directory_.fd(), kCorruptBundleFileName);
+  }
+
+  // Adds an asset to the directory that is packed. Assets may be in at most
+  // one subdirectory.
+  void AddAsset(const std::string& name, const std::string& contents) {
+    fml::UniqueFD directory = fml::Duplicate(assets_directory_.fd().get());
+    const size_t separator = name.find('/');
+    if (separator != std::string::npos) {
+      const std::string subdirectory = name.substr(0, separator);
+      directory = fml::CreateDirectory(assets_directory_.fd(), {subdirectory},
+                                       fml::FilePermission::kReadWrite);
+      subdirectory_names_.push_back(subdirectory);
+    }
+    ASSERT_TRUE(directory.is_valid());
+    const std::string file_name =
+        separator == std::string::npos ? name : name.substr(separator + 1);
+    ASSERT_TRUE(fml::WriteAtomically(directory, file_name.c_str(),
+                                     fml::DataMapping(contents)));
+    asset_names_.push_back(name);
+  }
+
+  // Packs the assets and returns the bytes of the bundle.
+  std::vector<uint8_t> Pack(const PackedAssetBundleOptions& options = {}) {
+    EXPECT_TRUE(WritePackedAssetBundle(assets_directory_.fd(),
+                                       bundle_directory_.fd(),
+                                       kPackedAssetBundleFileName, options));
+    auto mapping = fml::FileMapping::CreateReadOnly(bundle_directory_.fd(),
+                                                    kPackedAssetBundleFileName);
+    if (!mapping) {
+      ADD_FAILURE() << "Could not read the packed asset bundle.";
+      return {};
+    }
+    return std::vector<uint8_t>(mapping->GetMapping(),
+                                mapping->GetMapping() + mapping->GetSize());
+  }
+
+  // Writes |bytes| to a file and reads it as a bundle.
+  std::unique_ptr<PackedAssetBundle> Open(const std::vector<uint8_t>& bytes) {
+    EXPECT_TRUE(fml::WriteAtomically(bundle_directory_.fd(),
+                                     kCorruptBundleFileName,
+                                     fml::DataMapping(bytes)));
+    return std::make_unique<PackedAssetBundle>(
+        fml::OpenFile(bundle_directory_.fd(), kCorruptBundleFileName, false,
+                      fml::FilePermission::kRead));
+  }
+
+ private:
+  fml::ScopedTemporaryDirectory assets_directory_;
+  fml::ScopedTemporaryDirectory bundle_directory_;
+  std::vector<std::string> asset_names_;
+  std::vector<std::string> subdirectory_names_;
+};
+
+TEST_F(PackedAssetBundleTest, FindsPackedAssets) {
+  AddAsset("AssetManifest.json", "{}");
+  AddAsset("fonts/Roboto.ttf", "not really a font");
+  AddAsset("images/a.png", "a");
+  AddAsset("b.txt", "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb");
+
+  auto bundle = Open(Pack());
+  ASSERT_TRUE(IsValid(*bundle));
+  ASSERT_EQ(bundle->GetAssetCount(), 4u);
+
+  auto manifest = Get(*bundle, "AssetManifest.json");
+  ASSERT_TRUE(manifest);
+  ASSERT_EQ(ToString(manifest), "{}");
+  auto font = Get(*bundle, "fonts/Roboto.ttf");
+  ASSERT_TRUE(font);
+  ASSERT_EQ(ToString(font), "not really a font");
+  auto image = Get(*bundle, "images/a.png");
+  ASSERT_TRUE(image);
+  ASSERT_EQ(ToString(image), "a");
+  auto text = Get(*bundle, "b.txt");
+  ASSERT_TRUE(text);
+  ASSERT_EQ(ToString(text), std::string(50, 'b'));
+}
+
+TEST_F(PackedAssetBundleTest, MappingsOutliveTheBundle) {
+  AddAsset("a.txt", "contents");
+
+  auto bundle = Open(Pack());
+  ASSERT_TRUE(IsValid(*bundle));
+  auto mapping = Get(*bundle, "a.txt");
+  bundle.reset();
+  ASSERT_TRUE(mapping);
+  ASSERT_EQ(ToString(mapping), "contents");
+}
+
+TEST_F(PackedAssetBundleTest, ReturnsNullForMissingAssets) {
+  AddAsset("a.txt", "a");
+  AddAsset("fonts/b.ttf", "b");
+
+  auto bundle = Open(Pack());
+  ASSERT_TRUE(IsValid(*bundle));
+  ASSERT_FALSE(Get(*bundle, ""));
+  ASSERT_FALSE(Get(*bundle, "missing.txt"));
+  ASSERT_FALSE(Get(*bundle, "a.tx"));
+  ASSERT_FALSE(Get(*bundle, "a.txt2"));
+  ASSERT_FALSE(Get(*bundle, "fonts"));
+  ASSERT_FALSE(Get(*bundle, "fonts/"));
+  ASSERT_FALSE(Get(*bundle, "b.ttf"));
+  ASSERT_FALSE(Get(*bundle, kPackedAssetBundleFileName));
+}
+
+TEST_F(PackedAssetBundleTest, PacksEmptyDirectories) {
+  auto bundle = Open(Pack());
+  ASSERT_TRUE(IsValid(*bundle));
+  ASSERT_EQ(bundle->GetAssetCount(), 0u);
+  ASSERT_FALSE(Get(*bundle, "a.txt"));
+}
+
+TEST_F(PackedAssetBundleTest, RejectsTruncatedBundles) {
+  AddAsset("a.txt", "contents");
+  const auto bytes = Pack();
+  ASSERT_GT(bytes.size(), kHeaderSize + kEntrySize);
+
+  // Shorter than the header.
+  ASSERT_FALSE(IsValid(*Open({bytes.begin(), bytes.begin() + 16})));
+  // Shorter than the index.
+  ASSERT_FALSE(
+      IsValid(*Open({bytes.begin(), bytes.begin() + kHeaderSize + 8})));
+  // Missing the end of the asset data.
+  ASSERT_FALSE(IsValid(*Open({bytes.begin(), bytes.end() - 16})));
+}
+
+TEST_F(PackedAssetBundleTest, RejectsUnknownFormats) {
+  AddAsset("a.txt", "contents");
+  const auto bytes = Pack();
+  ASSERT_TRUE(IsValid(*Open(bytes)));
+
+  auto bad_magic = bytes;
+  bad_magic[0] = 'X';
+  ASSERT_FALSE(IsValid(*Open(bad_magic)));
+
+  auto bad_version = bytes;
+  Patch<uint32_t>(bad_version, kHeaderVersionOffset,
+                  Read<uint32_t>(bytes, kHeaderVersionOffset) + 1);
+  ASSERT_FALSE(IsValid(*Open(bad_version)));
+
+  auto bad_compression = bytes;
+  Patch<uint32_t>(bad_compression, kHeaderSize + kEntryCompressionOffset, 7);
+  ASSERT_FALSE(IsValid(*Open(bad_compression)));
+}
+
+TEST_F(PackedAssetBundleTest, RejectsOutOfBoundsIndex) {
+  AddAsset("a.txt", "contents");
+  AddAsset("b.txt", "contents");
+  const auto bytes = Pack();
+  const auto names_offset = Read<uint64_t>(bytes, kHeaderNamesOffsetOffset);
+
+  auto too_many_entries = bytes;
+  Patch<uint32_t>(too_many_entries, kHeaderEntryCountOffset, 0xffffffff);
+  ASSERT_FALSE(IsValid(*Open(too_many_entries)));
+
+  auto names_overlap_entries = bytes;
+  Patch<uint64_t>(names_overlap_entries, kHeaderNamesOffsetOffset,
+                  names_offset - 1);
+  ASSERT_FALSE(IsValid(*Open(names_overlap_entries)));
+
+  auto names_past_end = bytes;
+  Patch<uint64_t>(names_past_end, kHeaderNamesOffsetOffset, bytes.size() + 1);
+  ASSERT_FALSE(IsValid(*Open(names_past_end)));
+
+  auto names_too_large = bytes;
+  Patch<uint64_t>(names_too_large, kHeaderNamesSizeOffset,
+                  bytes.size() - names_offset + 1);
+  ASSERT_FALSE(IsValid(*Open(names_too_large)));
+
+  auto names_overflow = bytes;
+  Patch<uint64_t>(names_overflow, kHeaderNamesSizeOffset, ~0ull);
+  ASSERT_FALSE(IsValid(*Open(names_overflow)));
+}
+
+TEST_F(PackedAssetBundleTest, RejectsOutOfBoundsEntries) {
+  AddAsset("a.txt", "contents");
+  const auto bytes = Pack();
+  const size_t entry = kHeaderSize;
+  const auto names_size = Read<uint64_t>(bytes, kHeaderNamesSizeOffset);
+
+  auto data_past_end = bytes;
+  Patch<uint64_t>(data_past_end, entry + kEntryDataOffsetOffset,
+                  bytes.size() + 1);
+  ASSERT_FALSE(IsValid(*Open(data_past_end)));
+
+  auto data_too_large = bytes;
+  Patch<uint64_t>(data_too_large, entry + kEntryDataSizeOffset, bytes.size());
+  ASSERT_FALSE(IsValid(*Open(data_too_large)));
+
+  auto data_overflow = bytes;
+  Patch<uint64_t>(data_overflow, entry + kEntryDataSizeOffset, ~0ull);
+  ASSERT_FALSE(IsValid(*Open(data_overflow)));
+
+  auto name_past_end = bytes;
+  Patch<uint32_t>(name_past_end, entry + kEntryNameOffsetOffset,
+                  names_size + 1);
+  ASSERT_FALSE(IsValid(*Open(name_past_end)));
+
+  auto name_too_large = bytes;
+  Patch<uint32_t>(name_too_large, entry + kEntryNameSizeOffset,
+                  names_size + 1);
+  ASSERT_FALSE(IsValid(*Open(name_too_large)));
+}
+
+TEST_F(PackedAssetBundleTest, RoundTripsCompressedAndStoredAssets) {
+  AddAsset("compressed.txt", CompressibleContents());
+  AddAsset("kept.txt", CompressibleContents());
+  AddAsset("random.bin", IncompressibleContents());
+
+  PackedAssetBundleOptions options;
+  options.compress = true;
+  options.uncompressed_assets = {"kept.txt"};
+  const auto bytes = Pack(options);
+  auto bundle = Open(bytes);
+  ASSERT_TRUE(IsValid(*bundle));
+  ASSERT_EQ(bundle->GetAssetCount(), 3u);
+
+  // Only the compressible asset that wasn't excluded is stored compressed.
+  size_t compressed_count = 0;
+  for (size_t i = 0; i < bundle->GetAssetCount(); i++) {
+    const size_t entry = kHeaderSize + i * kEntrySize;
+    if (Read<uint32_t>(bytes, entry + kEntryCompressionOffset) ==
+        kCompressionDeflate) {
+      compressed_count++;
+      ASSERT_LT(Read<uint64_t>(bytes, entry + kEntryDataSizeOffset),
+                CompressibleContents().size());
+    }
+  }
+  ASSERT_EQ(compressed_count, 1u);
+
+  auto compressed = Get(*bundle, "compressed.txt");
+  ASSERT_TRUE(compressed);
+  ASSERT_EQ(ToString(compressed), CompressibleContents());
+  auto kept = Get(*bundle, "kept.txt");
+  ASSERT_TRUE(kept);
+  ASSERT_EQ(ToString(kept), CompressibleContents());
+  auto random = Get(*bundle, "random.bin");
+  ASSERT_TRUE(random);
+  ASSERT_EQ(ToString(random), IncompressibleContents());
+}
+
+TEST_F(PackedAssetBundleTest, RejectsCorruptCompressedAssets) {
+  AddAsset("a.txt", CompressibleContents());
+  PackedAssetBundleOptions options;
+  options.compress = true;
+  const auto bytes = Pack(options);
+  const size_t entry = kHeaderSize;
+  ASSERT_EQ(Read<uint32_t>(bytes, entry + kEntryCompressionOffset),
+            kCompressionDeflate);
+  const auto data_offset =
+      Read<uint64_t>(bytes, entry + kEntryDataOffsetOffset);
+  const auto data_size = Read<uint64_t>(bytes, entry + kEntryDataSizeOffset);
+  const auto uncompressed_size =
+      Read<uint64_t>(bytes, entry + kEntryUncompressedSizeOffset);
+
+  // Sizes no deflate stream of this length can inflate to are rejected up
+  // front instead of being allocated on lookup.
+  auto huge = bytes;
+  Patch<uint64_t>(huge, entry + kEntryUncompressedSizeOffset, ~0ull);
+  ASSERT_FALSE(IsValid(*Open(huge)));
+
+  auto too_large = bytes;
+  Patch<uint64_t>(too_large, entry + kEntryUncompressedSizeOffset,
+                  (data_size + 1) * 1032);
+  ASSERT_FALSE(IsValid(*Open(too_large)));
+
+  // Plausible sizes that don't match the inflated data fail the lookup.
+  auto larger = bytes;
+  Patch<uint64_t>(larger, entry + kEntryUncompressedSizeOffset,
+                  uncompressed_size + 1);
+  auto larger_bundle = Open(larger);
+  ASSERT_TRUE(IsValid(*larger_bundle));
+  ASSERT_FALSE(Get(*larger_bundle, "a.txt"));
+
+  auto smaller = bytes;
+  Patch<uint64_t>(smaller, entry + kEntryUncompressedSizeOffset,
+                  uncompressed_size - 1);
+  auto smaller_bundle = Open(smaller);
+  ASSERT_TRUE(IsValid(*smaller_bundle));
+  ASSERT_FALSE(Get(*smaller_bundle, "a.txt"));
+
+  // As does a damaged stream.
+  auto damaged = bytes;
+  for (size_t i = 0; i < data_size; i++) {
+    damaged[data_offset + i] = 0xff;
+  }
+  auto damaged_bundle = Open(damaged);
+  ASSERT_TRUE(IsValid(*damaged_bundle));
+  ASSERT_FALSE(Get(*damaged_bundle, "a.txt"));
+
+  // Stored entries must not claim another size.
+  auto stored = bytes;
+  Patch<uint32_t>(stored, entry + kEntryCompressionOffset, kCompressionNone);
+  ASSERT_FALSE(IsValid(*Open(stored)));
+}
+
+}  // namespace testing
+}  // namespace flutter
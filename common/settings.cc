@@ -38,6 +38,9 @@ std::string Settings::ToString() const {
   stream << "trace_skia: " << trace_skia << std::endl;
   stream << "trace_startup: " << trace_startup << std::endl;
   stream << "trace_systrace: " << trace_systrace << std::endl;
+  stream << "enable_trace_recorder: " << enable_trace_recorder << std::endl;
+  stream << "trace_recorder_dump_path: " << trace_recorder_dump_path
+         << std::endl;
   stream << "dump_skp_on_shader_compilation: " << dump_skp_on_shader_compilation
          << std::endl;
   stream << "cache_sksl: " << cache_sksl << std::endl;
@@ -50,14 +53,24 @@ std::string Settings::ToString() const {
   stream << "use_test_fonts: " << use_test_fonts << std::endl;
   stream << "enable_software_rendering: " << enable_software_rendering
          << std::endl;
+  stream << "enable_yuv_image_decoding: " << enable_yuv_image_decoding
+         << std::endl;
   stream << "log_tag: " << log_tag << std::endl;
   stream << "icu_initialization_required: " << icu_initialization_required
          << std::endl;
   stream << "icu_data_path: " << icu_data_path << std::endl;
   stream << "assets_dir: " << assets_dir << std::endl;
   stream << "assets_path: " << assets_path << std::endl;
+  stream << "asset_prefetch_manifest_path: " << asset_prefetch_manifest_path
+         << std::endl;
   stream << "frame_rasterized_callback set: " << !!frame_rasterized_callback
          << std::endl;
+  stream << "frame_scheduling_policy: "
+         << static_cast<int>(frame_scheduling_policy) << std::endl;
+  stream << "resample_pointer_events_to_vsync: "
+         << resample_pointer_events_to_vsync << std::endl;
+  stream << "software_raster_thread_count: " << software_raster_thread_count
+         << std::endl;
   stream << "old_gen_heap_size: " << old_gen_heap_size << std::endl;
   return stream.str();
 }
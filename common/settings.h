@@ -51,6 +51,23 @@ using MappingsCallback =
 
 using FrameRasterizedCallback = std::function<void(const FrameTiming&)>;
 
+// How the animator trades off latency against throughput when scheduling the
+// work for a frame.
+enum class FrameSchedulingPolicy {
+  // Start building a frame on vsync and allow the UI thread to work on the next
+  // frame while the previous one is being rasterized.
+  kDefault,
+  // Only allow one frame in flight and delay the start of each frame on vsync
+  // for as long as the recently measured build and raster times allow. This
+  // minimizes the time between the input that went into a frame and the frame
+  // being presented.
+  kLowLatency,
+  // Allow the UI thread to run up to two frames ahead of the raster thread.
+  // This absorbs occasional slow frames on either thread at the cost of
+  // latency.
+  kHighThroughput,
+};
+
 struct Settings {
   Settings();
 
@@ -93,6 +110,13 @@ struct Settings {
   bool trace_skia = false;
   bool trace_startup = false;
   bool trace_systrace = false;
+  // Record trace events into in-memory per-thread ring buffers even when the
+  // timeline is not being recorded. The recording can be retrieved via the
+  // service protocol. See |fml::tracing::TraceRecorder|.
+  bool enable_trace_recorder = false;
+  // If set along with |enable_trace_recorder|, the recording is written to this
+  // directory whenever a frame takes more than twice the frame budget.
+  std::string trace_recorder_dump_path;
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
   bool endless_trace_buffer = false;
@@ -163,6 +187,10 @@ struct Settings {
   UnhandledExceptionCallback unhandled_exception_callback;
   bool enable_software_rendering = false;
   bool skia_deterministic_rendering_on_cpu = false;
+  // Decode JPEG images into separate Y, U and V planes instead of RGBA and
+  // upload the planes individually. The color conversion is then performed by
+  // the GPU when the image is drawn. Has no effect without a GPU context.
+  bool enable_yuv_image_decoding = false;
   bool verbose_logging = false;
   std::string log_tag = "flutter";
 
@@ -178,11 +206,29 @@ struct Settings {
   fml::UniqueFD::element_type assets_dir =
       fml::UniqueFD::traits_type::InvalidValue();
   std::string assets_path;
+  // Path to a manifest of the assets used during startup. If set, the assets
+  // listed in the manifest are prefetched on a worker as soon as the engine is
+  // launched, and the manifest is rewritten with the assets actually used
+  // before the first frame so the next launch can prefetch them.
+  std::string asset_prefetch_manifest_path;
 
   // Callback to handle the timings of a rasterized frame. This is called as
   // soon as a frame is rasterized.
   FrameRasterizedCallback frame_rasterized_callback;
 
+  FrameSchedulingPolicy frame_scheduling_policy =
+      FrameSchedulingPolicy::kDefault;
+
+  // Hold pointer events until vsync and resample the position of moving
+  // pointers to the vsync, regardless of the dispatcher the platform prefers.
+  // See |SmoothPointerDataDispatcher|.
+  bool resample_pointer_events_to_vsync = false;
+
+  // The number of threads the software backend rasterizes frames on. When more
+  // than one, frames are recorded and then rasterized in horizontal bands in
+  // parallel. See |TiledRasterizer|.
+  size_t software_raster_thread_count = 1;
+
   // This data will be available to the isolate immediately on launch via the
   // Window.getPersistentIsolateData callback. This is meant for information
   // that the isolate cannot request asynchronously (platform messages can be
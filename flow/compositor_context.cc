@@ -5,6 +5,7 @@
 #include "flutter/flow/compositor_context.h"
 
 #include "flutter/flow/layers/layer_tree.h"
+#include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 
 namespace flutter {
@@ -16,6 +17,7 @@ CompositorContext::~CompositorContext() = default;
 
 void CompositorContext::BeginFrame(ScopedFrame& frame,
                                    bool enable_instrumentation) {
+  texture_registry_.BeginFrame();
   if (enable_instrumentation) {
     frame_count_.Increment();
     raster_time_.Start();
@@ -24,7 +26,13 @@ void CompositorContext::BeginFrame(ScopedFrame& frame,
 
 void CompositorContext::EndFrame(ScopedFrame& frame,
                                  bool enable_instrumentation) {
-  raster_cache_.SweepAfterFrame();
+  // A frame that reused the preroll of the last one didn't mark the entries
+  // it drew as used, so they must not be swept.
+  if (frame.reused_preroll()) {
+    raster_cache_.EndFrameWithoutSweep();
+  } else {
+    raster_cache_.SweepAfterFrame();
+  }
   if (enable_instrumentation) {
     raster_time_.Stop();
   }
@@ -70,7 +78,23 @@ CompositorContext::ScopedFrame::~ScopedFrame() {
 RasterStatus CompositorContext::ScopedFrame::Raster(
     flutter::LayerTree& layer_tree,
     bool ignore_raster_cache) {
-  bool root_needs_readback = layer_tree.Preroll(*this, ignore_raster_cache);
+  auto& durations = context_.last_raster_phase_durations_;
+  // Drawing the same layer tree again, like when only textures have new
+  // frames, doesn't change anything the preroll computes, and the parts that
+  // don't change are drawn from the raster cache.
+  reused_preroll_ = !ignore_raster_cache && layer_tree.CanReusePreroll(*this);
+  bool root_needs_readback;
+  if (reused_preroll_) {
+    TRACE_EVENT_INSTANT0("flutter", "LayerTree::Preroll (reused)");
+    root_needs_readback = layer_tree.preroll_needs_readback();
+    durations.preroll = fml::TimeDelta::Zero();
+  } else {
+    const auto preroll_start = fml::TimePoint::Now();
+    root_needs_readback = layer_tree.Preroll(*this, ignore_raster_cache);
+    durations.preroll = fml::TimePoint::Now() - preroll_start;
+  }
+  durations.raster_cache = context_.raster_cache_.GetRasterizeTimeThisFrame();
+  durations.paint = fml::TimeDelta::Zero();
   bool needs_save_layer = root_needs_readback && !surface_supports_readback();
   PostPrerollResult post_preroll_result = PostPrerollResult::kSuccess;
   if (view_embedder_ && gpu_thread_merger_) {
@@ -92,10 +116,12 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
     }
     canvas()->clear(SK_ColorTRANSPARENT);
   }
+  const auto paint_start = fml::TimePoint::Now();
   layer_tree.Paint(*this, ignore_raster_cache);
   if (canvas() && needs_save_layer) {
     canvas()->restore();
   }
+  durations.paint = fml::TimePoint::Now() - paint_start;
   return RasterStatus::kSuccess;
 }
 
@@ -10,6 +10,7 @@
 
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/instrumentation.h"
+#include "flutter/flow/layer_profiler.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/texture.h"
 #include "flutter/fml/gpu_thread_merger.h"
@@ -35,6 +36,15 @@ enum class RasterStatus {
   kFailed
 };
 
+// The time spent in each step of rasterizing a frame.
+struct RasterPhaseDurations {
+  // Zero when the preroll of the last frame was reused.
+  fml::TimeDelta preroll;
+  fml::TimeDelta paint;
+  // Time spent populating the raster cache. Included in |preroll|.
+  fml::TimeDelta raster_cache;
+};
+
 class CompositorContext {
  public:
   class ScopedFrame {
@@ -64,6 +74,10 @@ class CompositorContext {
 
     GrContext* gr_context() const { return gr_context_; }
 
+    // Whether |Raster| painted a layer tree again without prerolling it. See
+    // |LayerTree::CanReusePreroll|.
+    bool reused_preroll() const { return reused_preroll_; }
+
     virtual RasterStatus Raster(LayerTree& layer_tree,
                                 bool ignore_raster_cache);
 
@@ -76,6 +90,7 @@ class CompositorContext {
     const bool instrumentation_enabled_;
     const bool surface_supports_readback_;
     fml::RefPtr<fml::GpuThreadMerger> gpu_thread_merger_;
+    bool reused_preroll_ = false;
 
     FML_DISALLOW_COPY_AND_ASSIGN(ScopedFrame);
   };
@@ -107,12 +122,28 @@ class CompositorContext {
 
   Stopwatch& ui_time() { return ui_time_; }
 
+  LayerProfiler& layer_profiler() { return layer_profiler_; }
+
+  // The phase durations of the last frame rastered by a |ScopedFrame|.
+  const RasterPhaseDurations& last_raster_phase_durations() const {
+    return last_raster_phase_durations_;
+  }
+
+  // Called before each frame is drawn so that frames which fail or are
+  // resubmitted before they are rastered don't report the durations of the
+  // frame before them.
+  void ResetRasterPhaseDurations() {
+    last_raster_phase_durations_ = RasterPhaseDurations();
+  }
+
  private:
   RasterCache raster_cache_;
   TextureRegistry texture_registry_;
   Counter frame_count_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
+  LayerProfiler layer_profiler_;
+  RasterPhaseDurations last_raster_phase_durations_;
 
   void BeginFrame(ScopedFrame& frame, bool enable_instrumentation);
 
@@ -0,0 +1,47 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/content_signature.h"
+
+namespace flutter {
+
+void ContentSignature::Add(uint64_t value) {
+  AddBytes(&value, sizeof(value));
+}
+
+void ContentSignature::Add(SkScalar value) {
+  AddBytes(&value, sizeof(value));
+}
+
+void ContentSignature::Add(const SkPoint& point) {
+  Add(point.x());
+  Add(point.y());
+}
+
+void ContentSignature::Add(const SkRect& rect) {
+  AddBytes(&rect, sizeof(rect));
+}
+
+void ContentSignature::Add(const SkRRect& rrect) {
+  Add(rrect.rect());
+  for (int i = 0; i < 4; i++) {
+    Add(rrect.radii(static_cast<SkRRect::Corner>(i)));
+  }
+}
+
+void ContentSignature::Add(const SkMatrix& matrix) {
+  SkScalar values[9];
+  matrix.get9(values);
+  AddBytes(values, sizeof(values));
+}
+
+void ContentSignature::AddBytes(const void* data, size_t size) {
+  constexpr uint64_t kPrime = 0x100000001b3;
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; i++) {
+    value_ = (value_ ^ bytes[i]) * kPrime;
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_CONTENT_SIGNATURE_H_
+#define FLUTTER_FLOW_CONTENT_SIGNATURE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkPoint.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A hash of everything a sequence of layers paints, built up
+///             during Preroll in paint order. Two frames with the same
+///             signature painted the same pixels up to the point the
+///             signature was taken, unless the signature is volatile because
+///             a layer paints content that may change without the layer tree
+///             changing, like textures and platform views.
+///
+///             Layers add the parameters that affect their own painting,
+///             which must not include anything derived from the addresses of
+///             objects that may be freed and reused between frames.
+///
+class ContentSignature {
+ public:
+  void Add(uint64_t value);
+
+  void Add(SkScalar value);
+
+  void Add(const SkPoint& point);
+
+  void Add(const SkRect& rect);
+
+  void Add(const SkRRect& rrect);
+
+  void Add(const SkMatrix& matrix);
+
+  void MarkVolatile() { is_volatile_ = true; }
+
+  bool is_volatile() const { return is_volatile_; }
+
+  uint64_t value() const { return value_; }
+
+ private:
+  // The offset basis of the 64 bit FNV-1a hash.
+  uint64_t value_ = 0xcbf29ce484222325;
+  bool is_volatile_ = false;
+
+  void AddBytes(const void* data, size_t size);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_CONTENT_SIGNATURE_H_
@@ -0,0 +1,56 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/content_signature.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(ContentSignature, EqualContentHasEqualSignatures) {
+  ContentSignature first;
+  ContentSignature second;
+  for (ContentSignature* signature : {&first, &second}) {
+    signature->Add(static_cast<uint64_t>(42));
+    signature->Add(SkRect::MakeWH(10, 20));
+    signature->Add(SkMatrix::MakeScale(2.0f));
+  }
+  ASSERT_EQ(first.value(), second.value());
+  ASSERT_FALSE(first.is_volatile());
+}
+
+TEST(ContentSignature, OrderAndValuesMatter) {
+  ContentSignature base;
+  base.Add(SkRect::MakeWH(10, 20));
+  base.Add(1.0f);
+
+  ContentSignature reordered;
+  reordered.Add(1.0f);
+  reordered.Add(SkRect::MakeWH(10, 20));
+  ASSERT_NE(base.value(), reordered.value());
+
+  ContentSignature moved;
+  moved.Add(SkRect::MakeXYWH(1, 0, 10, 20));
+  moved.Add(1.0f);
+  ASSERT_NE(base.value(), moved.value());
+}
+
+TEST(ContentSignature, RRectsCompareRadii) {
+  ContentSignature square;
+  square.Add(SkRRect::MakeRect(SkRect::MakeWH(10, 10)));
+  ContentSignature round;
+  round.Add(SkRRect::MakeOval(SkRect::MakeWH(10, 10)));
+  ASSERT_NE(square.value(), round.value());
+}
+
+TEST(ContentSignature, StaysVolatile) {
+  ContentSignature signature;
+  signature.MarkVolatile();
+  signature.Add(static_cast<uint64_t>(1));
+  ASSERT_TRUE(signature.is_volatile());
+}
+
+}  // namespace testing
+}  // namespace flutter
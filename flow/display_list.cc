@@ -0,0 +1,1206 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list.h"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkDrawable.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkMaskFilter.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+#include "third_party/skia/include/core/SkRegion.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkVertices.h"
+#include "third_party/skia/src/core/SkDrawShadowInfo.h"
+
+namespace flutter {
+
+namespace {
+
+// The weights of the operations in a display list. They roughly correspond to
+// the microseconds each operation takes to draw on a mobile device, but only
+// their ratios matter once pictures have been measured by the raster cache.
+constexpr double kSimpleOpComplexity = 1.0;
+constexpr double kConvexPathComplexity = 2.0;
+constexpr double kPathComplexity = 6.0;
+constexpr double kTextBlobComplexity = 4.0;
+constexpr double kImageComplexity = 2.0;
+constexpr double kVerticesComplexity = 4.0;
+constexpr double kSaveLayerComplexity = 10.0;
+constexpr double kShadowComplexity = 20.0;
+constexpr double kBlurComplexity = 20.0;
+
+// The number of top level operations in a leaf of the bounding volume
+// hierarchy, and the number of children of the other nodes.
+constexpr uint32_t kIndexBranchFactor = 16;
+
+// Operations are stored at offsets aligned to this.
+constexpr size_t kOpAlignment = 8;
+
+double PaintComplexity(const SkPaint* paint) {
+  return paint != nullptr &&
+                 (paint->getMaskFilter() != nullptr || paint->getImageFilter())
+             ? kBlurComplexity
+             : 0.0;
+}
+
+uint32_t NextUniqueID() {
+  static std::atomic<uint32_t> next_id(1);
+  return next_id++;
+}
+
+#define FOR_EACH_DISPLAY_LIST_OP(V) \
+  V(Save)                           \
+  V(SaveLayer)                      \
+  V(Restore)                        \
+  V(Concat)                         \
+  V(SetMatrix)                      \
+  V(ClipRect)                       \
+  V(ClipRRect)                      \
+  V(ClipPath)                       \
+  V(ClipRegion)                     \
+  V(DrawPaint)                      \
+  V(DrawPoints)                     \
+  V(DrawRect)                       \
+  V(DrawRegion)                     \
+  V(DrawOval)                       \
+  V(DrawArc)                        \
+  V(DrawRRect)                      \
+  V(DrawDRRect)                     \
+  V(DrawPath)                       \
+  V(DrawTextBlob)                   \
+  V(DrawPatch)                      \
+  V(DrawImage)                      \
+  V(DrawImageRect)                  \
+  V(DrawImageNine)                  \
+  V(DrawImageLattice)               \
+  V(DrawVertices)                   \
+  V(DrawAtlas)                      \
+  V(DrawShadowRec)                  \
+  V(DrawPicture)                    \
+  V(DrawAnnotation)                 \
+  V(DrawEdgeAAQuad)                 \
+  V(DrawEdgeAAImageSet)
+
+enum class OpType : uint8_t {
+#define DISPLAY_LIST_OP_TYPE(name) k##name,
+  FOR_EACH_DISPLAY_LIST_OP(DISPLAY_LIST_OP_TYPE)
+#undef DISPLAY_LIST_OP_TYPE
+};
+
+// A paint that operations such as image draws may not have.
+struct OptionalPaint {
+  OptionalPaint(const SkPaint* paint = nullptr) : has_paint(paint != nullptr) {
+    if (paint != nullptr) {
+      this->paint = *paint;
+    }
+  }
+
+  const SkPaint* get() const { return has_paint ? &paint : nullptr; }
+
+  bool has_paint;
+  SkPaint paint;
+};
+
+// The operations are plain structs that replay themselves with a
+// non-virtual |Draw|. The matrix is the one of the canvas when playback
+// started, which |SetMatrix| is relative to.
+
+struct SaveOp {
+  static constexpr OpType kType = OpType::kSave;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const { canvas->save(); }
+};
+
+struct SaveLayerOp {
+  static constexpr OpType kType = OpType::kSaveLayer;
+
+  bool has_bounds;
+  SkRect bounds;
+  OptionalPaint paint;
+  sk_sp<SkImageFilter> backdrop;
+  SkCanvas::SaveLayerFlags flags;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->saveLayer(SkCanvas::SaveLayerRec(has_bounds ? &bounds : nullptr,
+                                             paint.get(), backdrop.get(),
+                                             flags));
+  }
+};
+
+struct RestoreOp {
+  static constexpr OpType kType = OpType::kRestore;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const { canvas->restore(); }
+};
+
+struct ConcatOp {
+  static constexpr OpType kType = OpType::kConcat;
+
+  SkMatrix matrix;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->concat(matrix);
+  }
+};
+
+struct SetMatrixOp {
+  static constexpr OpType kType = OpType::kSetMatrix;
+
+  SkMatrix matrix;
+
+  void Draw(SkCanvas* canvas, const SkMatrix& initial_matrix) const {
+    canvas->setMatrix(SkMatrix::Concat(initial_matrix, matrix));
+  }
+};
+
+struct ClipRectOp {
+  static constexpr OpType kType = OpType::kClipRect;
+
+  SkRect rect;
+  SkClipOp op;
+  bool anti_alias;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->clipRect(rect, op, anti_alias);
+  }
+};
+
+struct ClipRRectOp {
+  static constexpr OpType kType = OpType::kClipRRect;
+
+  SkRRect rrect;
+  SkClipOp op;
+  bool anti_alias;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->clipRRect(rrect, op, anti_alias);
+  }
+};
+
+struct ClipPathOp {
+  static constexpr OpType kType = OpType::kClipPath;
+
+  SkPath path;
+  SkClipOp op;
+  bool anti_alias;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->clipPath(path, op, anti_alias);
+  }
+};
+
+struct ClipRegionOp {
+  static constexpr OpType kType = OpType::kClipRegion;
+
+  SkRegion region;
+  SkClipOp op;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->clipRegion(region, op);
+  }
+};
+
+struct DrawPaintOp {
+  static constexpr OpType kType = OpType::kDrawPaint;
+
+  SkPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawPaint(paint);
+  }
+};
+
+struct DrawPointsOp {
+  static constexpr OpType kType = OpType::kDrawPoints;
+
+  SkCanvas::PointMode mode;
+  std::vector<SkPoint> points;
+  SkPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawPoints(mode, points.size(), points.data(), paint);
+  }
+};
+
+struct DrawRectOp {
+  static constexpr OpType kType = OpType::kDrawRect;
+
+  SkRect rect;
+  SkPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawRect(rect, paint);
+  }
+};
+
+struct DrawRegionOp {
+  static constexpr OpType kType = OpType::kDrawRegion;
+
+  SkRegion region;
+  SkPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawRegion(region, paint);
+  }
+};
+
+struct DrawOvalOp {
+  static constexpr OpType kType = OpType::kDrawOval;
+
+  SkRect oval;
+  SkPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawOval(oval, paint);
+  }
+};
+
+struct DrawArcOp {
+  static constexpr OpType kType = OpType::kDrawArc;
+
+  SkRect oval;
+  SkScalar start_angle;
+  SkScalar sweep_angle;
+  bool use_center;
+  SkPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawArc(oval, start_angle, sweep_angle, use_center, paint);
+  }
+};
+
+struct DrawRRectOp {
+  static constexpr OpType kType = OpType::kDrawRRect;
+
+  SkRRect rrect;
+  SkPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawRRect(rrect, paint);
+  }
+};
+
+struct DrawDRRectOp {
+  static constexpr OpType kType = OpType::kDrawDRRect;
+
+  SkRRect outer;
+  SkRRect inner;
+  SkPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawDRRect(outer, inner, paint);
+  }
+};
+
+struct DrawPathOp {
+  static constexpr OpType kType = OpType::kDrawPath;
+
+  SkPath path;
+  SkPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawPath(path, paint);
+  }
+};
+
+struct DrawTextBlobOp {
+  static constexpr OpType kType = OpType::kDrawTextBlob;
+
+  sk_sp<SkTextBlob> blob;
+  SkScalar x;
+  SkScalar y;
+  SkPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawTextBlob(blob, x, y, paint);
+  }
+};
+
+struct DrawPatchOp {
+  static constexpr OpType kType = OpType::kDrawPatch;
+
+  SkPoint cubics[12];
+  bool has_colors;
+  SkColor colors[4];
+  bool has_tex_coords;
+  SkPoint tex_coords[4];
+  SkBlendMode mode;
+  SkPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawPatch(cubics, has_colors ? colors : nullptr,
+                      has_tex_coords ? tex_coords : nullptr, mode, paint);
+  }
+};
+
+struct DrawImageOp {
+  static constexpr OpType kType = OpType::kDrawImage;
+
+  sk_sp<SkImage> image;
+  SkScalar left;
+  SkScalar top;
+  OptionalPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawImage(image.get(), left, top, paint.get());
+  }
+};
+
+struct DrawImageRectOp {
+  static constexpr OpType kType = OpType::kDrawImageRect;
+
+  sk_sp<SkImage> image;
+  SkRect src;
+  SkRect dst;
+  OptionalPaint paint;
+  SkCanvas::SrcRectConstraint constraint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawImageRect(image.get(), src, dst, paint.get(), constraint);
+  }
+};
+
+struct DrawImageNineOp {
+  static constexpr OpType kType = OpType::kDrawImageNine;
+
+  sk_sp<SkImage> image;
+  SkIRect center;
+  SkRect dst;
+  OptionalPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawImageNine(image.get(), center, dst, paint.get());
+  }
+};
+
+struct DrawImageLatticeOp {
+  static constexpr OpType kType = OpType::kDrawImageLattice;
+
+  sk_sp<SkImage> image;
+  std::vector<int> x_divs;
+  std::vector<int> y_divs;
+  std::vector<SkCanvas::Lattice::RectType> rect_types;
+  std::vector<SkColor> colors;
+  bool has_lattice_bounds;
+  SkIRect lattice_bounds;
+  SkRect dst;
+  OptionalPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    SkCanvas::Lattice lattice;
+    lattice.fXDivs = x_divs.data();
+    lattice.fYDivs = y_divs.data();
+    lattice.fRectTypes = rect_types.empty() ? nullptr : rect_types.data();
+    lattice.fXCount = x_divs.size();
+    lattice.fYCount = y_divs.size();
+    lattice.fBounds = has_lattice_bounds ? &lattice_bounds : nullptr;
+    lattice.fColors = colors.empty() ? nullptr : colors.data();
+    canvas->drawImageLattice(image.get(), lattice, dst, paint.get());
+  }
+};
+
+struct DrawVerticesOp {
+  static constexpr OpType kType = OpType::kDrawVertices;
+
+  sk_sp<SkVertices> vertices;
+  std::vector<SkVertices::Bone> bones;
+  SkBlendMode mode;
+  SkPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawVertices(vertices.get(), bones.data(), bones.size(), mode,
+                         paint);
+  }
+};
+
+struct DrawAtlasOp {
+  static constexpr OpType kType = OpType::kDrawAtlas;
+
+  sk_sp<SkImage> atlas;
+  std::vector<SkRSXform> xforms;
+  std::vector<SkRect> tex;
+  std::vector<SkColor> colors;
+  SkBlendMode mode;
+  bool has_cull;
+  SkRect cull;
+  OptionalPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawAtlas(atlas.get(), xforms.data(), tex.data(),
+                      colors.empty() ? nullptr : colors.data(), xforms.size(),
+                      mode, has_cull ? &cull : nullptr, paint.get());
+  }
+};
+
+struct DrawShadowRecOp {
+  static constexpr OpType kType = OpType::kDrawShadowRec;
+
+  SkPath path;
+  SkDrawShadowRec rec;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->private_draw_shadow_rec(path, rec);
+  }
+};
+
+struct DrawPictureOp {
+  static constexpr OpType kType = OpType::kDrawPicture;
+
+  sk_sp<SkPicture> picture;
+  bool has_matrix;
+  SkMatrix matrix;
+  OptionalPaint paint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawPicture(picture.get(), has_matrix ? &matrix : nullptr,
+                        paint.get());
+  }
+};
+
+struct DrawAnnotationOp {
+  static constexpr OpType kType = OpType::kDrawAnnotation;
+
+  SkRect rect;
+  std::string key;
+  sk_sp<SkData> value;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->drawAnnotation(rect, key.c_str(), value.get());
+  }
+};
+
+struct DrawEdgeAAQuadOp {
+  static constexpr OpType kType = OpType::kDrawEdgeAAQuad;
+
+  SkRect rect;
+  bool has_clip;
+  SkPoint clip[4];
+  SkCanvas::QuadAAFlags aa_flags;
+  SkColor4f color;
+  SkBlendMode mode;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->experimental_DrawEdgeAAQuad(rect, has_clip ? clip : nullptr,
+                                        aa_flags, color, mode);
+  }
+};
+
+struct DrawEdgeAAImageSetOp {
+  static constexpr OpType kType = OpType::kDrawEdgeAAImageSet;
+
+  std::vector<SkCanvas::ImageSetEntry> entries;
+  std::vector<SkPoint> dst_clips;
+  std::vector<SkMatrix> pre_view_matrices;
+  OptionalPaint paint;
+  SkCanvas::SrcRectConstraint constraint;
+
+  void Draw(SkCanvas* canvas, const SkMatrix&) const {
+    canvas->experimental_DrawEdgeAAImageSet(
+        entries.data(), entries.size(),
+        dst_clips.empty() ? nullptr : dst_clips.data(),
+        pre_view_matrices.empty() ? nullptr : pre_view_matrices.data(),
+        paint.get(), constraint);
+  }
+};
+
+// Moves an operation to |to| and destroys it at |from|. Operations hold
+// strings, vectors and regions, which can't be relocated by copying their
+// bytes.
+void MoveOp(OpType type, uint8_t* from, uint8_t* to) {
+  switch (type) {
+#define DISPLAY_LIST_OP_MOVE(name)                \
+  case OpType::k##name: {                         \
+    auto* op = reinterpret_cast<name##Op*>(from); \
+    new (to) name##Op(std::move(*op));            \
+    op->~name##Op();                              \
+    break;                                        \
+  }
+    FOR_EACH_DISPLAY_LIST_OP(DISPLAY_LIST_OP_MOVE)
+#undef DISPLAY_LIST_OP_MOVE
+  }
+}
+
+}  // namespace
+
+DisplayList::DisplayList(const SkRect& cull_rect)
+    : cull_rect_(cull_rect),
+      bounds_(SkRect::MakeEmpty()),
+      unique_id_(NextUniqueID()),
+      complexity_(0.0),
+      needs_save_(false),
+      storage_size_(0) {}
+
+DisplayList::~DisplayList() {
+  for (const auto& info : infos_) {
+    uint8_t* op = storage_.get() + info.offset;
+    switch (static_cast<OpType>(info.type)) {
+#define DISPLAY_LIST_OP_DESTROY(name)             \
+  case OpType::k##name:                           \
+    reinterpret_cast<name##Op*>(op)->~name##Op(); \
+    break;
+      FOR_EACH_DISPLAY_LIST_OP(DISPLAY_LIST_OP_DESTROY)
+#undef DISPLAY_LIST_OP_DESTROY
+    }
+  }
+}
+
+size_t DisplayList::bytes_used() const {
+  return sizeof(DisplayList) + storage_size_ +
+         infos_.capacity() * sizeof(OpInfo) + nodes_.capacity() * sizeof(Node);
+}
+
+void DisplayList::Draw(SkCanvas* canvas) const {
+  SkRect cull_rect;
+  if (!canvas->getLocalClipBounds(&cull_rect)) {
+    return;
+  }
+  Draw(canvas, cull_rect);
+}
+
+void DisplayList::Draw(SkCanvas* canvas, const SkRect& cull_rect) const {
+  if (nodes_.empty() || !SkRect::Intersects(bounds_, cull_rect)) {
+    return;
+  }
+  SkAutoCanvasRestore save(canvas, needs_save_);
+  const SkMatrix initial_matrix = canvas->getTotalMatrix();
+  // The root is the last node.
+  DrawNode(canvas, initial_matrix, cull_rect, nodes_.back());
+}
+
+void DisplayList::DrawNode(SkCanvas* canvas,
+                           const SkMatrix& initial_matrix,
+                           const SkRect& cull_rect,
+                           const Node& node) const {
+  if (!node.always_visit && !SkRect::Intersects(node.bounds, cull_rect)) {
+    return;
+  }
+  if (node.leaf) {
+    DrawOps(canvas, initial_matrix, cull_rect, node.begin, node.end);
+    return;
+  }
+  for (uint32_t i = node.begin; i < node.end; i++) {
+    DrawNode(canvas, initial_matrix, cull_rect, nodes_[i]);
+  }
+}
+
+void DisplayList::DrawOps(SkCanvas* canvas,
+                          const SkMatrix& initial_matrix,
+                          const SkRect& cull_rect,
+                          uint32_t begin,
+                          uint32_t end) const {
+  for (uint32_t i = begin; i < end;) {
+    const OpInfo& info = infos_[i];
+    if (info.skip != 0 && !SkRect::Intersects(info.bounds, cull_rect)) {
+      i = info.skip;
+      continue;
+    }
+    const uint8_t* op = storage_.get() + info.offset;
+    switch (static_cast<OpType>(info.type)) {
+#define DISPLAY_LIST_OP_DRAW(name)                                       \
+  case OpType::k##name:                                                  \
+    reinterpret_cast<const name##Op*>(op)->Draw(canvas, initial_matrix); \
+    break;
+      FOR_EACH_DISPLAY_LIST_OP(DISPLAY_LIST_OP_DRAW)
+#undef DISPLAY_LIST_OP_DRAW
+    }
+    i++;
+  }
+}
+
+void DisplayList::BuildIndex() {
+  // The leaves hold runs of the operations that are not nested in a save.
+  // Saves are kept with everything up to the matching restore.
+  uint32_t items = 0;
+  for (uint32_t i = 0; i < infos_.size();) {
+    const OpInfo& info = infos_[i];
+    const uint32_t next = info.skip == 0 ? i + 1 : info.skip;
+    if (items % kIndexBranchFactor == 0) {
+      nodes_.push_back({SkRect::MakeEmpty(), false, i, next, true});
+    }
+    Node& leaf = nodes_.back();
+    leaf.end = next;
+    if (info.skip == 0) {
+      leaf.always_visit = true;
+    } else {
+      leaf.bounds.join(info.bounds);
+      bounds_.join(info.bounds);
+    }
+    items++;
+    i = next;
+  }
+
+  // Each level groups the nodes of the previous one until there is a single
+  // root.
+  uint32_t level_begin = 0;
+  uint32_t level_end = nodes_.size();
+  while (level_end - level_begin > 1) {
+    for (uint32_t i = level_begin; i < level_end; i += kIndexBranchFactor) {
+      Node parent = {SkRect::MakeEmpty(), false, i,
+                     std::min(i + kIndexBranchFactor, level_end), false};
+      for (uint32_t child = parent.begin; child < parent.end; child++) {
+        parent.bounds.join(nodes_[child].bounds);
+        parent.always_visit |= nodes_[child].always_visit;
+      }
+      nodes_.push_back(parent);
+    }
+    level_begin = level_end;
+    level_end = nodes_.size();
+  }
+
+  if (!bounds_.intersect(cull_rect_)) {
+    bounds_.setEmpty();
+  }
+}
+
+sk_sp<SkPicture> DisplayList::ToSkPicture() const {
+  SkPictureRecorder recorder;
+  Draw(recorder.beginRecording(cull_rect_), cull_rect_);
+  return recorder.finishRecordingAsPicture();
+}
+
+DisplayListRecorder::DisplayListRecorder(const SkRect& cull_rect)
+    : SkCanvasVirtualEnforcer<SkNoDrawCanvas>(cull_rect.roundOut()),
+      list_(new DisplayList(cull_rect)) {}
+
+DisplayListRecorder::~DisplayListRecorder() = default;
+
+sk_sp<DisplayList> DisplayListRecorder::Build() {
+  FML_DCHECK(list_);
+  // Close the saves that were left open, like pictures do.
+  while (!save_stack_.empty()) {
+    willRestore();
+  }
+  // The storage grows by doubling, so most of it may be unused.
+  ResizeStorage(list_->storage_size_);
+  list_->infos_.shrink_to_fit();
+  list_->BuildIndex();
+  return std::move(list_);
+}
+
+void DisplayListRecorder::ResizeStorage(size_t capacity) {
+  DisplayList& list = *list_;
+  if (capacity == storage_capacity_) {
+    return;
+  }
+  FML_DCHECK(capacity >= list.storage_size_);
+  std::unique_ptr<uint8_t[]> storage(capacity > 0 ? new uint8_t[capacity]
+                                                  : nullptr);
+  for (const auto& info : list.infos_) {
+    MoveOp(static_cast<OpType>(info.type), list.storage_.get() + info.offset,
+           storage.get() + info.offset);
+  }
+  list.storage_ = std::move(storage);
+  storage_capacity_ = capacity;
+}
+
+template <typename T, typename... Args>
+T* DisplayListRecorder::Push(const SkRect& bounds,
+                             uint32_t skip,
+                             Args&&... args) {
+  static_assert(alignof(T) <= kOpAlignment, "Operation is overaligned.");
+  const size_t size = (sizeof(T) + kOpAlignment - 1) & ~(kOpAlignment - 1);
+  DisplayList& list = *list_;
+  if (list.storage_size_ + size > storage_capacity_) {
+    ResizeStorage(std::max(storage_capacity_ * 2, 4096 + size));
+  }
+  const uint32_t offset = list.storage_size_;
+  T* op = new (list.storage_.get() + offset) T{std::forward<Args>(args)...};
+  list.storage_size_ += size;
+  list.infos_.push_back(
+      {offset, skip, bounds, static_cast<uint8_t>(T::kType)});
+  return op;
+}
+
+template <typename T, typename... Args>
+void DisplayListRecorder::PushState(Args&&... args) {
+  if (!list_) {
+    return;
+  }
+  if (save_stack_.empty()) {
+    list_->needs_save_ = true;
+  }
+  Push<T>(SkRect::MakeEmpty(), 0, std::forward<Args>(args)...);
+}
+
+template <typename T, typename... Args>
+T* DisplayListRecorder::PushDraw(const SkRect* local_bounds,
+                                 const SkPaint* paint,
+                                 double complexity,
+                                 Args&&... args) {
+  SkRect bounds;
+  if (!list_ || !ComputeDrawBounds(local_bounds, paint, &bounds)) {
+    return nullptr;
+  }
+  T* op = Push<T>(bounds, list_->infos_.size() + 1,
+                  std::forward<Args>(args)...);
+  if (!save_stack_.empty()) {
+    list_->infos_[save_stack_.back().op_index].bounds.join(bounds);
+  }
+  list_->complexity_ += complexity + PaintComplexity(paint);
+  return op;
+}
+
+bool DisplayListRecorder::ComputeDrawBounds(const SkRect* local_bounds,
+                                            const SkPaint* paint,
+                                            SkRect* bounds) const {
+  if (paint != nullptr && paint->nothingToDraw()) {
+    return false;
+  }
+  SkIRect clip_bounds;
+  if (!getDeviceClipBounds(&clip_bounds)) {
+    return false;
+  }
+  if (!save_stack_.empty() && save_stack_.back().unbounded) {
+    *bounds = save_stack_.back().unbounded_bounds;
+    return !bounds->isEmpty();
+  }
+
+  *bounds = SkRect::Make(clip_bounds);
+  const SkMatrix& matrix = getTotalMatrix();
+  if (local_bounds != nullptr && !matrix.hasPerspective() &&
+      (paint == nullptr || paint->canComputeFastBounds())) {
+    SkRect storage;
+    const SkRect& paint_bounds =
+        paint == nullptr ? *local_bounds
+                         : paint->computeFastBounds(*local_bounds, &storage);
+    // Outset by a pixel for anti-aliasing.
+    if (!bounds->intersect(matrix.mapRect(paint_bounds).makeOutset(1, 1))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T, typename... Args>
+void DisplayListRecorder::PushSave(bool unbounded_layer, Args&&... args) {
+  if (!list_) {
+    return;
+  }
+  SaveFrame frame;
+  frame.op_index = list_->infos_.size();
+  frame.unbounded = false;
+  if (!save_stack_.empty() && save_stack_.back().unbounded) {
+    frame.unbounded = true;
+    frame.unbounded_bounds = save_stack_.back().unbounded_bounds;
+  } else if (unbounded_layer) {
+    SkIRect clip_bounds;
+    frame.unbounded = true;
+    frame.unbounded_bounds = getDeviceClipBounds(&clip_bounds)
+                                 ? SkRect::Make(clip_bounds)
+                                 : SkRect::MakeEmpty();
+  }
+  // The bounds of the save grow with the draws until the matching restore,
+  // which also sets where playback skips to when the save is culled.
+  Push<T>(frame.unbounded ? frame.unbounded_bounds : SkRect::MakeEmpty(), 0,
+          std::forward<Args>(args)...);
+  save_stack_.push_back(frame);
+}
+
+void DisplayListRecorder::willSave() {
+  PushSave<SaveOp>(false);
+}
+
+SkCanvas::SaveLayerStrategy DisplayListRecorder::getSaveLayerStrategy(
+    const SaveLayerRec& rec) {
+  // Filters may move content outside of the bounds it was drawn in, backdrop
+  // filters affect everything under the layer, and color filters and blend
+  // modes may affect the whole layer when it is restored.
+  const SkPaint* paint = rec.fPaint;
+  const bool unbounded =
+      rec.fBackdrop != nullptr ||
+      (paint != nullptr &&
+       (paint->getImageFilter() != nullptr ||
+        paint->getColorFilter() != nullptr ||
+        paint->getBlendMode() != SkBlendMode::kSrcOver));
+  PushSave<SaveLayerOp>(unbounded, rec.fBounds != nullptr,
+                        rec.fBounds != nullptr ? *rec.fBounds
+                                               : SkRect::MakeEmpty(),
+                        OptionalPaint(paint), sk_ref_sp(rec.fBackdrop),
+                        rec.fSaveLayerFlags);
+  if (list_) {
+    list_->complexity_ += kSaveLayerComplexity + PaintComplexity(paint) +
+                          (rec.fBackdrop != nullptr ? kBlurComplexity : 0.0);
+  }
+  return kNoLayer_SaveLayerStrategy;
+}
+
+bool DisplayListRecorder::onDoSaveBehind(const SkRect*) {
+  // Only reachable through private Skia APIs that the engine does not use.
+  return false;
+}
+
+void DisplayListRecorder::willRestore() {
+  if (!list_ || save_stack_.empty()) {
+    return;
+  }
+  const SaveFrame frame = save_stack_.back();
+  save_stack_.pop_back();
+  Push<RestoreOp>(SkRect::MakeEmpty(), 0);
+
+  auto& infos = list_->infos_;
+  infos[frame.op_index].skip = infos.size();
+  if (!save_stack_.empty()) {
+    infos[save_stack_.back().op_index].bounds.join(
+        infos[frame.op_index].bounds);
+  }
+}
+
+void DisplayListRecorder::didConcat(const SkMatrix& matrix) {
+  PushState<ConcatOp>(matrix);
+}
+
+void DisplayListRecorder::didSetMatrix(const SkMatrix& matrix) {
+  PushState<SetMatrixOp>(matrix);
+}
+
+// The clips are also applied to the base canvas so that it tracks the clip
+// bounds that draws are culled against.
+
+void DisplayListRecorder::onClipRect(const SkRect& rect,
+                                     SkClipOp op,
+                                     ClipEdgeStyle edge_style) {
+  PushState<ClipRectOp>(rect, op, edge_style == kSoft_ClipEdgeStyle);
+  SkCanvasVirtualEnforcer<SkNoDrawCanvas>::onClipRect(rect, op, edge_style);
+}
+
+void DisplayListRecorder::onClipRRect(const SkRRect& rrect,
+                                      SkClipOp op,
+                                      ClipEdgeStyle edge_style) {
+  PushState<ClipRRectOp>(rrect, op, edge_style == kSoft_ClipEdgeStyle);
+  SkCanvasVirtualEnforcer<SkNoDrawCanvas>::onClipRRect(rrect, op, edge_style);
+}
+
+void DisplayListRecorder::onClipPath(const SkPath& path,
+                                     SkClipOp op,
+                                     ClipEdgeStyle edge_style) {
+  PushState<ClipPathOp>(path, op, edge_style == kSoft_ClipEdgeStyle);
+  SkCanvasVirtualEnforcer<SkNoDrawCanvas>::onClipPath(path, op, edge_style);
+}
+
+void DisplayListRecorder::onClipRegion(const SkRegion& device_region,
+                                       SkClipOp op) {
+  PushState<ClipRegionOp>(device_region, op);
+  SkCanvasVirtualEnforcer<SkNoDrawCanvas>::onClipRegion(device_region, op);
+}
+
+void DisplayListRecorder::onDrawPaint(const SkPaint& paint) {
+  PushDraw<DrawPaintOp>(nullptr, &paint, kSimpleOpComplexity, paint);
+}
+
+void DisplayListRecorder::onDrawBehind(const SkPaint& paint) {
+  // Only reachable through private Skia APIs that the engine does not use.
+}
+
+void DisplayListRecorder::onDrawPoints(PointMode mode,
+                                       size_t count,
+                                       const SkPoint pts[],
+                                       const SkPaint& paint) {
+  SkRect bounds;
+  bounds.setBounds(pts, count);
+  const SkScalar radius = std::max(paint.getStrokeWidth(), 1.0f);
+  bounds.outset(radius, radius);
+  PushDraw<DrawPointsOp>(&bounds, &paint, kSimpleOpComplexity, mode,
+                         std::vector<SkPoint>(pts, pts + count), paint);
+}
+
+void DisplayListRecorder::onDrawRect(const SkRect& rect,
+                                     const SkPaint& paint) {
+  PushDraw<DrawRectOp>(&rect, &paint, kSimpleOpComplexity, rect, paint);
+}
+
+void DisplayListRecorder::onDrawRegion(const SkRegion& region,
+                                       const SkPaint& paint) {
+  const SkRect bounds = SkRect::Make(region.getBounds());
+  PushDraw<DrawRegionOp>(&bounds, &paint, kSimpleOpComplexity, region, paint);
+}
+
+void DisplayListRecorder::onDrawOval(const SkRect& rect,
+                                     const SkPaint& paint) {
+  PushDraw<DrawOvalOp>(&rect, &paint, kSimpleOpComplexity, rect, paint);
+}
+
+void DisplayListRecorder::onDrawArc(const SkRect& rect,
+                                    SkScalar start_angle,
+                                    SkScalar sweep_angle,
+                                    bool use_center,
+                                    const SkPaint& paint) {
+  PushDraw<DrawArcOp>(&rect, &paint, kConvexPathComplexity, rect, start_angle,
+                      sweep_angle, use_center, paint);
+}
+
+void DisplayListRecorder::onDrawRRect(const SkRRect& rrect,
+                                      const SkPaint& paint) {
+  PushDraw<DrawRRectOp>(&rrect.getBounds(), &paint, kSimpleOpComplexity,
+                        rrect, paint);
+}
+
+void DisplayListRecorder::onDrawDRRect(const SkRRect& outer,
+                                       const SkRRect& inner,
+                                       const SkPaint& paint) {
+  PushDraw<DrawDRRectOp>(&outer.getBounds(), &paint, kConvexPathComplexity,
+                         outer, inner, paint);
+}
+
+void DisplayListRecorder::onDrawPath(const SkPath& path,
+                                     const SkPaint& paint) {
+  // Inverse fills cover everything outside of the path.
+  PushDraw<DrawPathOp>(path.isInverseFillType() ? nullptr : &path.getBounds(),
+                       &paint,
+                       path.isConvex() ? kConvexPathComplexity
+                                       : kPathComplexity,
+                       path, paint);
+}
+
+void DisplayListRecorder::onDrawTextBlob(const SkTextBlob* blob,
+                                         SkScalar x,
+                                         SkScalar y,
+                                         const SkPaint& paint) {
+  const SkRect bounds = blob->bounds().makeOffset(x, y);
+  PushDraw<DrawTextBlobOp>(&bounds, &paint, kTextBlobComplexity,
+                           sk_ref_sp(blob), x, y, paint);
+}
+
+void DisplayListRecorder::onDrawPatch(const SkPoint cubics[12],
+                                      const SkColor colors[4],
+                                      const SkPoint tex_coords[4],
+                                      SkBlendMode mode,
+                                      const SkPaint& paint) {
+  SkRect bounds;
+  bounds.setBounds(cubics, 12);
+  auto* op = PushDraw<DrawPatchOp>(&bounds, &paint, kVerticesComplexity);
+  if (op == nullptr) {
+    return;
+  }
+  std::copy(cubics, cubics + 12, op->cubics);
+  op->has_colors = colors != nullptr;
+  if (colors != nullptr) {
+    std::copy(colors, colors + 4, op->colors);
+  }
+  op->has_tex_coords = tex_coords != nullptr;
+  if (tex_coords != nullptr) {
+    std::copy(tex_coords, tex_coords + 4, op->tex_coords);
+  }
+  op->mode = mode;
+  op->paint = paint;
+}
+
+// Bitmaps are recorded as images, which share their pixels.
+
+void DisplayListRecorder::onDrawBitmap(const SkBitmap& bitmap,
+                                       SkScalar left,
+                                       SkScalar top,
+                                       const SkPaint* paint) {
+  if (auto image = SkImage::MakeFromBitmap(bitmap)) {
+    onDrawImage(image.get(), left, top, paint);
+  }
+}
+
+void DisplayListRecorder::onDrawBitmapRect(const SkBitmap& bitmap,
+                                           const SkRect* src,
+                                           const SkRect& dst,
+                                           const SkPaint* paint,
+                                           SrcRectConstraint constraint) {
+  if (auto image = SkImage::MakeFromBitmap(bitmap)) {
+    onDrawImageRect(image.get(), src, dst, paint, constraint);
+  }
+}
+
+void DisplayListRecorder::onDrawBitmapLattice(const SkBitmap& bitmap,
+                                              const Lattice& lattice,
+                                              const SkRect& dst,
+                                              const SkPaint* paint) {
+  if (auto image = SkImage::MakeFromBitmap(bitmap)) {
+    onDrawImageLattice(image.get(), lattice, dst, paint);
+  }
+}
+
+void DisplayListRecorder::onDrawBitmapNine(const SkBitmap& bitmap,
+                                           const SkIRect& center,
+                                           const SkRect& dst,
+                                           const SkPaint* paint) {
+  if (auto image = SkImage::MakeFromBitmap(bitmap)) {
+    onDrawImageNine(image.get(), center, dst, paint);
+  }
+}
+
+void DisplayListRecorder::onDrawImage(const SkImage* image,
+                                      SkScalar left,
+                                      SkScalar top,
+                                      const SkPaint* paint) {
+  const SkRect bounds =
+      SkRect::MakeXYWH(left, top, image->width(), image->height());
+  PushDraw<DrawImageOp>(&bounds, paint, kImageComplexity, sk_ref_sp(image),
+                        left, top, OptionalPaint(paint));
+}
+
+void DisplayListRecorder::onDrawImageRect(const SkImage* image,
+                                          const SkRect* src,
+                                          const SkRect& dst,
+                                          const SkPaint* paint,
+                                          SrcRectConstraint constraint) {
+  PushDraw<DrawImageRectOp>(
+      &dst, paint, kImageComplexity, sk_ref_sp(image),
+      src != nullptr ? *src : SkRect::MakeIWH(image->width(), image->height()),
+      dst, OptionalPaint(paint), constraint);
+}
+
+void DisplayListRecorder::onDrawImageNine(const SkImage* image,
+                                          const SkIRect& center,
+                                          const SkRect& dst,
+                                          const SkPaint* paint) {
+  PushDraw<DrawImageNineOp>(&dst, paint, kImageComplexity, sk_ref_sp(image),
+                            center, dst, OptionalPaint(paint));
+}
+
+void DisplayListRecorder::onDrawImageLattice(const SkImage* image,
+                                             const Lattice& lattice,
+                                             const SkRect& dst,
+                                             const SkPaint* paint) {
+  auto* op = PushDraw<DrawImageLatticeOp>(&dst, paint, kImageComplexity,
+                                          sk_ref_sp(image));
+  if (op == nullptr) {
+    return;
+  }
+  op->x_divs.assign(lattice.fXDivs, lattice.fXDivs + lattice.fXCount);
+  op->y_divs.assign(lattice.fYDivs, lattice.fYDivs + lattice.fYCount);
+  const int cell_count = (lattice.fXCount + 1) * (lattice.fYCount + 1);
+  if (lattice.fRectTypes != nullptr) {
+    op->rect_types.assign(lattice.fRectTypes, lattice.fRectTypes + cell_count);
+  }
+  if (lattice.fColors != nullptr) {
+    op->colors.assign(lattice.fColors, lattice.fColors + cell_count);
+  }
+  op->has_lattice_bounds = lattice.fBounds != nullptr;
+  if (lattice.fBounds != nullptr) {
+    op->lattice_bounds = *lattice.fBounds;
+  }
+  op->dst = dst;
+  op->paint = OptionalPaint(paint);
+}
+
+void DisplayListRecorder::onDrawVerticesObject(const SkVertices* vertices,
+                                               const SkVertices::Bone bones[],
+                                               int bone_count,
+                                               SkBlendMode mode,
+                                               const SkPaint& paint) {
+  PushDraw<DrawVerticesOp>(
+      &vertices->bounds(), &paint, kVerticesComplexity, sk_ref_sp(vertices),
+      std::vector<SkVertices::Bone>(bones, bones + bone_count), mode, paint);
+}
+
+void DisplayListRecorder::onDrawAtlas(const SkImage* atlas,
+                                      const SkRSXform xform[],
+                                      const SkRect tex[],
+                                      const SkColor colors[],
+                                      int count,
+                                      SkBlendMode mode,
+                                      const SkRect* cull,
+                                      const SkPaint* paint) {
+  PushDraw<DrawAtlasOp>(
+      cull, paint, kVerticesComplexity, sk_ref_sp(atlas),
+      std::vector<SkRSXform>(xform, xform + count),
+      std::vector<SkRect>(tex, tex + count),
+      colors != nullptr ? std::vector<SkColor>(colors, colors + count)
+                        : std::vector<SkColor>(),
+      mode, cull != nullptr, cull != nullptr ? *cull : SkRect::MakeEmpty(),
+      OptionalPaint(paint));
+}
+
+void DisplayListRecorder::onDrawShadowRec(const SkPath& path,
+                                          const SkDrawShadowRec& rec) {
+  // Shadows extend past their path by an amount that depends on the light,
+  // so they are bounded by the clip.
+  PushDraw<DrawShadowRecOp>(nullptr, nullptr, kShadowComplexity, path, rec);
+}
+
+void DisplayListRecorder::onDrawPicture(const SkPicture* picture,
+                                        const SkMatrix* matrix,
+                                        const SkPaint* paint) {
+  const auto bounds = matrix == nullptr ? picture->cullRect()
+                                        : matrix->mapRect(picture->cullRect());
+  PushDraw<DrawPictureOp>(
+      &bounds, paint, picture->approximateOpCount() * kSimpleOpComplexity,
+      sk_ref_sp(picture), matrix != nullptr,
+      matrix != nullptr ? *matrix : SkMatrix::I(), OptionalPaint(paint));
+}
+
+void DisplayListRecorder::onDrawDrawable(SkDrawable* drawable,
+                                         const SkMatrix* matrix) {
+  // Drawables are recorded as a snapshot of what they currently draw.
+  sk_sp<SkPicture> picture(drawable->newPictureSnapshot());
+  if (picture) {
+    onDrawPicture(picture.get(), matrix, nullptr);
+  }
+}
+
+void DisplayListRecorder::onDrawAnnotation(const SkRect& rect,
+                                           const char key[],
+                                           SkData* value) {
+  PushDraw<DrawAnnotationOp>(&rect, nullptr, 0.0, rect, std::string(key),
+                             sk_ref_sp(value));
+}
+
+void DisplayListRecorder::onDrawEdgeAAQuad(const SkRect& rect,
+                                           const SkPoint clip[4],
+                                           SkCanvas::QuadAAFlags aa_flags,
+                                           const SkColor4f& color,
+                                           SkBlendMode mode) {
+  auto* op = PushDraw<DrawEdgeAAQuadOp>(&rect, nullptr, kSimpleOpComplexity,
+                                        rect, clip != nullptr);
+  if (op == nullptr) {
+    return;
+  }
+  if (clip != nullptr) {
+    std::copy(clip, clip + 4, op->clip);
+  }
+  op->aa_flags = aa_flags;
+  op->color = color;
+  op->mode = mode;
+}
+
+void DisplayListRecorder::onDrawEdgeAAImageSet(const ImageSetEntry set[],
+                                               int count,
+                                               const SkPoint dst_clips[],
+                                               const SkMatrix matrices[],
+                                               const SkPaint* paint,
+                                               SrcRectConstraint constraint) {
+  auto* op = PushDraw<DrawEdgeAAImageSetOp>(
+      nullptr, paint, count * kImageComplexity,
+      std::vector<ImageSetEntry>(set, set + count));
+  if (op == nullptr) {
+    return;
+  }
+  int clip_count = 0;
+  int matrix_count = 0;
+  for (int i = 0; i < count; i++) {
+    clip_count += set[i].fHasClip ? 4 : 0;
+    matrix_count = std::max(matrix_count, set[i].fMatrixIndex + 1);
+  }
+  if (dst_clips != nullptr) {
+    op->dst_clips.assign(dst_clips, dst_clips + clip_count);
+  }
+  if (matrices != nullptr) {
+    op->pre_view_matrices.assign(matrices, matrices + matrix_count);
+  }
+  op->paint = OptionalPaint(paint);
+  op->constraint = constraint;
+}
+
+void DisplayListRecorder::onFlush() {}
+
+}  // namespace flutter
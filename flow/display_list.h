@@ -0,0 +1,382 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DISPLAY_LIST_H_
+#define FLUTTER_FLOW_DISPLAY_LIST_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkCanvasVirtualEnforcer.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+#include "third_party/skia/include/core/SkVertices.h"
+#include "third_party/skia/include/utils/SkNoDrawCanvas.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      An immutable list of canvas operations recorded by a
+///             |DisplayListRecorder|. It plays the role of an |SkPicture| for
+///             the pictures the framework records, but unlike one it keeps the
+///             bounds of each of its operations so that playback only draws
+///             the operations that intersect the area being drawn.
+///
+///             The operations are stored back to back in a single buffer.
+///             Their bounds are kept in a separate array along with a
+///             hierarchy of the bounds of consecutive operations, so that
+///             culling rarely touches the operations themselves.
+///
+class DisplayList : public SkRefCnt {
+ public:
+  ~DisplayList() override;
+
+  // The bounds the list was recorded with.
+  const SkRect& cull_rect() const { return cull_rect_; }
+
+  // The bounds of what the operations actually draw, within |cull_rect|.
+  // Empty if the list draws nothing.
+  const SkRect& bounds() const { return bounds_; }
+
+  // Unique among the display lists created by the process.
+  uint32_t unique_id() const { return unique_id_; }
+
+  size_t op_count() const { return infos_.size(); }
+
+  size_t bytes_used() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The estimated cost of drawing the list. Paths, text, images,
+  ///             layers and blurs weigh more than simple shapes. The unit is
+  ///             arbitrary but roughly corresponds to microseconds on a
+  ///             mobile device.
+  ///
+  double complexity() const { return complexity_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Draws the operations that intersect the clip of the canvas.
+  ///
+  void Draw(SkCanvas* canvas) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Draws the operations that intersect |cull_rect|, which is in
+  ///             the coordinates the list was recorded in.
+  ///
+  void Draw(SkCanvas* canvas, const SkRect& cull_rect) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the list into a picture, for the Skia APIs that only
+  ///             accept pictures.
+  ///
+  sk_sp<SkPicture> ToSkPicture() const;
+
+ private:
+  friend class DisplayListRecorder;
+
+  struct OpInfo {
+    // The offset of the operation in |storage_|.
+    uint32_t offset;
+    // The index of the operation that follows this one when it is culled: the
+    // next one for draws and the one after the matching restore for saves.
+    // Zero for the other state changes, which are never culled.
+    uint32_t skip;
+    // The bounds of the draw or of all the draws up to the matching restore,
+    // in the coordinates the list was recorded in.
+    SkRect bounds;
+    uint8_t type;
+  };
+
+  // A node of the bounding volume hierarchy over the operations that are not
+  // nested in a save. The children of a node, and the operations of a leaf,
+  // are consecutive, so that searching the hierarchy preserves the order of
+  // the operations.
+  struct Node {
+    SkRect bounds;
+    // Nodes that contain state changes at the top level are always visited.
+    bool always_visit;
+    // The range of children in |nodes_|, or of operations for leaves.
+    uint32_t begin;
+    uint32_t end;
+    bool leaf;
+  };
+
+  SkRect cull_rect_;
+  SkRect bounds_;
+  uint32_t unique_id_;
+  double complexity_;
+  // Whether playback changes the matrix or the clip outside of a save, in
+  // which case it is wrapped in one.
+  bool needs_save_;
+  std::unique_ptr<uint8_t[]> storage_;
+  size_t storage_size_;
+  std::vector<OpInfo> infos_;
+  std::vector<Node> nodes_;
+
+  explicit DisplayList(const SkRect& cull_rect);
+
+  void BuildIndex();
+
+  void DrawNode(SkCanvas* canvas,
+                const SkMatrix& initial_matrix,
+                const SkRect& cull_rect,
+                const Node& node) const;
+
+  void DrawOps(SkCanvas* canvas,
+               const SkMatrix& initial_matrix,
+               const SkRect& cull_rect,
+               uint32_t begin,
+               uint32_t end) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayList);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A canvas that records what is drawn into it in a
+///             |DisplayList|. Operations that fall entirely outside of the
+///             clip are dropped as they are recorded.
+///
+class DisplayListRecorder final
+    : public SkCanvasVirtualEnforcer<SkNoDrawCanvas> {
+ public:
+  explicit DisplayListRecorder(const SkRect& cull_rect);
+
+  ~DisplayListRecorder() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the list of what was drawn so far. The recorder must
+  ///             not be used afterwards.
+  ///
+  sk_sp<DisplayList> Build();
+
+ private:
+  struct SaveFrame {
+    // The index of the save operation.
+    uint32_t op_index;
+    // Draws in layers that cannot be bounded, such as the ones with image
+    // filters or backdrops, take the bounds of the clip the outermost such
+    // layer was saved with.
+    bool unbounded;
+    SkRect unbounded_bounds;
+  };
+
+  sk_sp<DisplayList> list_;
+  size_t storage_capacity_ = 0;
+  std::vector<SaveFrame> save_stack_;
+
+  // Moves the operations recorded so far into storage of |capacity| bytes.
+  void ResizeStorage(size_t capacity);
+
+  template <typename T, typename... Args>
+  T* Push(const SkRect& bounds, uint32_t skip, Args&&... args);
+
+  // Records a change of the matrix or the clip.
+  template <typename T, typename... Args>
+  void PushState(Args&&... args);
+
+  // Records a save or a save layer. |unbounded_layer| is true for layers
+  // whose draws cannot be bounded.
+  template <typename T, typename... Args>
+  void PushSave(bool unbounded_layer, Args&&... args);
+
+  // Records a draw of |local_bounds|, or of the whole clip if it is null,
+  // unless it falls outside of the clip. |paint| may be null. Returns null if
+  // the draw was dropped.
+  template <typename T, typename... Args>
+  T* PushDraw(const SkRect* local_bounds,
+              const SkPaint* paint,
+              double complexity,
+              Args&&... args);
+
+  bool ComputeDrawBounds(const SkRect* local_bounds,
+                         const SkPaint* paint,
+                         SkRect* bounds) const;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void willSave() override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  bool onDoSaveBehind(const SkRect*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void willRestore() override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void didConcat(const SkMatrix&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void didSetMatrix(const SkMatrix&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawDRRect(const SkRRect&, const SkRRect&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawTextBlob(const SkTextBlob* blob,
+                      SkScalar x,
+                      SkScalar y,
+                      const SkPaint& paint) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPatch(const SkPoint cubics[12],
+                   const SkColor colors[4],
+                   const SkPoint texCoords[4],
+                   SkBlendMode,
+                   const SkPaint& paint) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPaint(const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawBehind(const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPoints(PointMode,
+                    size_t count,
+                    const SkPoint pts[],
+                    const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawRect(const SkRect&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawRegion(const SkRegion&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawOval(const SkRect&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawArc(const SkRect&,
+                 SkScalar,
+                 SkScalar,
+                 bool,
+                 const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawRRect(const SkRRect&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPath(const SkPath&, const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawBitmap(const SkBitmap&,
+                    SkScalar left,
+                    SkScalar top,
+                    const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawBitmapRect(const SkBitmap&,
+                        const SkRect* src,
+                        const SkRect& dst,
+                        const SkPaint*,
+                        SrcRectConstraint) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawImage(const SkImage*,
+                   SkScalar left,
+                   SkScalar top,
+                   const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawImageRect(const SkImage*,
+                       const SkRect* src,
+                       const SkRect& dst,
+                       const SkPaint*,
+                       SrcRectConstraint) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawBitmapLattice(const SkBitmap&,
+                           const Lattice&,
+                           const SkRect&,
+                           const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawImageLattice(const SkImage*,
+                          const Lattice&,
+                          const SkRect&,
+                          const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawImageNine(const SkImage*,
+                       const SkIRect& center,
+                       const SkRect& dst,
+                       const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawBitmapNine(const SkBitmap&,
+                        const SkIRect& center,
+                        const SkRect& dst,
+                        const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawVerticesObject(const SkVertices*,
+                            const SkVertices::Bone bones[],
+                            int boneCount,
+                            SkBlendMode,
+                            const SkPaint&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawAtlas(const SkImage*,
+                   const SkRSXform[],
+                   const SkRect[],
+                   const SkColor[],
+                   int,
+                   SkBlendMode,
+                   const SkRect*,
+                   const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawShadowRec(const SkPath&, const SkDrawShadowRec&) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onClipRect(const SkRect&, SkClipOp, ClipEdgeStyle) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onClipRRect(const SkRRect&, SkClipOp, ClipEdgeStyle) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onClipPath(const SkPath&, SkClipOp, ClipEdgeStyle) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onClipRegion(const SkRegion&, SkClipOp) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawPicture(const SkPicture*,
+                     const SkMatrix*,
+                     const SkPaint*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawDrawable(SkDrawable*, const SkMatrix*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawAnnotation(const SkRect&, const char[], SkData*) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawEdgeAAQuad(const SkRect&,
+                        const SkPoint[4],
+                        SkCanvas::QuadAAFlags,
+                        const SkColor4f&,
+                        SkBlendMode) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onDrawEdgeAAImageSet(const ImageSetEntry[],
+                            int count,
+                            const SkPoint[],
+                            const SkMatrix[],
+                            const SkPaint*,
+                            SrcRectConstraint) override;
+
+  // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
+  void onFlush() override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListRecorder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DISPLAY_LIST_H_
@@ -0,0 +1,163 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/display_list.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkBBHFactory.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace flutter {
+
+static constexpr int kWidth = 1080;
+static constexpr int kHeight = 1920;
+static constexpr int kRowHeight = 160;
+
+// Draws rows of typical widget content: a card with an avatar, a title, a
+// subtitle and an icon, each row in a save like the framework's transforms.
+static void DrawRows(SkCanvas* canvas,
+                     int row_count,
+                     const sk_sp<SkTextBlob>& title) {
+  SkPaint card_paint;
+  card_paint.setAntiAlias(true);
+  card_paint.setColor(SkColorSetRGB(250, 250, 250));
+  SkPaint avatar_paint;
+  avatar_paint.setAntiAlias(true);
+  avatar_paint.setColor(SkColorSetRGB(33, 150, 243));
+  SkPaint text_paint;
+  text_paint.setAntiAlias(true);
+  text_paint.setColor(SK_ColorBLACK);
+  SkPaint icon_paint;
+  icon_paint.setAntiAlias(true);
+  icon_paint.setStyle(SkPaint::kStroke_Style);
+  icon_paint.setStrokeWidth(4);
+  SkPath icon;
+  icon.moveTo(0, 0);
+  icon.lineTo(24, 24);
+  icon.lineTo(48, 0);
+
+  for (int i = 0; i < row_count; i++) {
+    canvas->save();
+    canvas->translate(0, i * kRowHeight);
+    canvas->drawRRect(
+        SkRRect::MakeRectXY(
+            SkRect::MakeXYWH(16, 8, kWidth - 32, kRowHeight - 16), 8, 8),
+        card_paint);
+    canvas->drawCircle(kRowHeight / 2, kRowHeight / 2, kRowHeight / 3,
+                       avatar_paint);
+    canvas->drawTextBlob(title, kRowHeight + 16, kRowHeight / 2 - 8,
+                         text_paint);
+    canvas->drawRect(
+        SkRect::MakeXYWH(kRowHeight + 16, kRowHeight / 2 + 16, kWidth / 3, 16),
+        text_paint);
+    canvas->translate(kWidth - 96, kRowHeight / 2 - 12);
+    canvas->drawPath(icon, icon_paint);
+    canvas->restore();
+  }
+}
+
+static sk_sp<SkTextBlob> MakeTitle() {
+  SkFont font;
+  font.setSize(32);
+  return SkTextBlob::MakeFromString("Lorem ipsum dolor sit amet", font);
+}
+
+static SkRect ContentBounds(int row_count) {
+  return SkRect::MakeWH(kWidth, row_count * kRowHeight);
+}
+
+static sk_sp<SkPicture> RecordPicture(int row_count,
+                                      const sk_sp<SkTextBlob>& title) {
+  // Like the pictures the framework used to record.
+  SkRTreeFactory rtree_factory;
+  SkPictureRecorder recorder;
+  DrawRows(recorder.beginRecording(ContentBounds(row_count), &rtree_factory),
+           row_count, title);
+  return recorder.finishRecordingAsPicture();
+}
+
+static sk_sp<DisplayList> RecordDisplayList(int row_count,
+                                            const sk_sp<SkTextBlob>& title) {
+  DisplayListRecorder recorder(ContentBounds(row_count));
+  DrawRows(&recorder, row_count, title);
+  return recorder.Build();
+}
+
+// Arguments:
+//   0: The number of rows.
+static void BM_SkPictureRecord(benchmark::State& state) {
+  const auto title = MakeTitle();
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(RecordPicture(state.range(0), title));
+  }
+}
+
+// Arguments:
+//   0: The number of rows.
+static void BM_DisplayListRecord(benchmark::State& state) {
+  const auto title = MakeTitle();
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(RecordDisplayList(state.range(0), title));
+  }
+}
+
+// Draws the part of the rows that a screen shows as the rows scroll by, so
+// that most of the content is culled.
+//
+// Arguments:
+//   0: The number of rows.
+template <typename DrawFunction>
+static void ScrollThroughRows(benchmark::State& state,
+                              const DrawFunction& draw) {
+  const int row_count = state.range(0);
+  auto surface = SkSurface::MakeRasterN32Premul(kWidth, kHeight);
+  FML_CHECK(surface);
+  SkCanvas* canvas = surface->getCanvas();
+  const int scroll_extent = std::max(row_count * kRowHeight - kHeight, 1);
+
+  int frame = 0;
+  while (state.KeepRunning()) {
+    canvas->clear(SK_ColorWHITE);
+    canvas->save();
+    canvas->translate(0, -((frame * 97) % scroll_extent));
+    draw(canvas);
+    canvas->restore();
+    canvas->flush();
+    frame++;
+  }
+}
+
+static void BM_SkPicturePlayback(benchmark::State& state) {
+  const auto picture = RecordPicture(state.range(0), MakeTitle());
+  ScrollThroughRows(state,
+                    [&](SkCanvas* canvas) { canvas->drawPicture(picture); });
+}
+
+static void BM_DisplayListPlayback(benchmark::State& state) {
+  const auto display_list = RecordDisplayList(state.range(0), MakeTitle());
+  ScrollThroughRows(state,
+                    [&](SkCanvas* canvas) { display_list->Draw(canvas); });
+}
+
+BENCHMARK(BM_SkPictureRecord)->Arg(12)->Arg(100)->Arg(1000);
+BENCHMARK(BM_DisplayListRecord)->Arg(12)->Arg(100)->Arg(1000);
+BENCHMARK(BM_SkPicturePlayback)
+    ->Arg(12)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DisplayListPlayback)
+    ->Arg(12)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -0,0 +1,373 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/display_list.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "flutter/testing/mock_canvas.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkMaskFilter.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkPoint3.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
+#include "third_party/skia/include/utils/SkNoDrawCanvas.h"
+#include "third_party/skia/include/utils/SkShadowUtils.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Collects the keys of the annotations drawn into it.
+class AnnotationCanvas final : public SkNoDrawCanvas {
+ public:
+  AnnotationCanvas() : SkNoDrawCanvas(100, 100) {}
+
+  const std::vector<std::string>& keys() const { return keys_; }
+
+ protected:
+  void onDrawAnnotation(const SkRect&, const char key[], SkData*) override {
+    keys_.push_back(key);
+  }
+
+ private:
+  std::vector<std::string> keys_;
+};
+
+constexpr int kCanvasSize = 100;
+constexpr SkRect kCanvasBounds = SkRect::MakeWH(kCanvasSize, kCanvasSize);
+
+using DrawCallback = std::function<void(SkCanvas*)>;
+
+sk_sp<DisplayList> RecordDisplayList(const DrawCallback& draw) {
+  DisplayListRecorder recorder(kCanvasBounds);
+  draw(&recorder);
+  return recorder.Build();
+}
+
+sk_sp<SkPicture> RecordPicture(const DrawCallback& draw) {
+  SkPictureRecorder recorder;
+  draw(recorder.beginRecording(kCanvasBounds));
+  return recorder.finishRecordingAsPicture();
+}
+
+SkBitmap Render(const SkRect& clip, const DrawCallback& playback) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(kCanvasSize, kCanvasSize);
+  SkCanvas canvas(bitmap);
+  canvas.clear(SK_ColorWHITE);
+  canvas.clipRect(clip);
+  playback(&canvas);
+  return bitmap;
+}
+
+// Plays the display list and the picture back into |clip| and compares the
+// pixels. The display list culls what it draws to the clip while the picture
+// is played back in full, so operations that draw outside of their bounds
+// must not be culled.
+::testing::AssertionResult RendersLikePicture(
+    const sk_sp<DisplayList>& display_list,
+    const sk_sp<SkPicture>& picture,
+    const SkRect& clip) {
+  const SkBitmap expected =
+      Render(clip, [&](SkCanvas* canvas) { picture->playback(canvas); });
+  const SkBitmap actual =
+      Render(clip, [&](SkCanvas* canvas) { display_list->Draw(canvas); });
+  for (int y = 0; y < kCanvasSize; y++) {
+    for (int x = 0; x < kCanvasSize; x++) {
+      if (actual.getColor(x, y) != expected.getColor(x, y)) {
+        return ::testing::AssertionFailure()
+               << "Pixel (" << x << ", " << y << ") is " << std::hex
+               << actual.getColor(x, y) << " instead of "
+               << expected.getColor(x, y);
+      }
+    }
+  }
+  return ::testing::AssertionSuccess();
+}
+
+::testing::AssertionResult DrawsLikePicture(const DrawCallback& draw,
+                                            const SkRect& clip) {
+  return RendersLikePicture(RecordDisplayList(draw), RecordPicture(draw),
+                            clip);
+}
+
+// A layer whose color filter turns the transparent pixels of the layer green,
+// so that it covers the whole clip even though it only draws a small rect.
+void DrawColorFilterLayer(SkCanvas* canvas) {
+  SkPaint layer_paint;
+  layer_paint.setColorFilter(
+      SkColorFilters::Blend(SK_ColorGREEN, SkBlendMode::kDstOver));
+  canvas->saveLayer(nullptr, &layer_paint);
+  canvas->drawRect(SkRect::MakeLTRB(10, 10, 20, 20), SkPaint());
+  canvas->restore();
+}
+
+}  // namespace
+
+TEST(DisplayList, PlaysBackOperationsInOrder) {
+  const SkRect rect = SkRect::MakeLTRB(10, 10, 20, 20);
+  const SkRect clip_rect = SkRect::MakeLTRB(0, 0, 15, 15);
+  SkPath path;
+  path.addCircle(30, 30, 5);
+
+  DisplayListRecorder recorder(SkRect::MakeWH(64, 64));
+  recorder.save();
+  recorder.translate(2, 3);
+  recorder.clipRect(clip_rect);
+  recorder.drawRect(rect, SkPaint());
+  recorder.restore();
+  recorder.drawPath(path, SkPaint());
+  auto display_list = recorder.Build();
+  EXPECT_EQ(display_list->op_count(), 6u);
+
+  MockCanvas canvas;
+  display_list->Draw(&canvas);
+  auto expected_draw_calls = std::vector(
+      {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+       MockCanvas::DrawCall{
+           1, MockCanvas::ConcatMatrixData{SkMatrix::MakeTrans(2, 3)}},
+       MockCanvas::DrawCall{
+           1, MockCanvas::ClipRectData{clip_rect, SkClipOp::kIntersect,
+                                       MockCanvas::kHard_ClipEdgeStyle}},
+       MockCanvas::DrawCall{1, MockCanvas::DrawRectData{rect, SkPaint()}},
+       MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}},
+       MockCanvas::DrawCall{0, MockCanvas::DrawPathData{path, SkPaint()}}});
+  EXPECT_EQ(canvas.draw_calls(), expected_draw_calls);
+}
+
+TEST(DisplayList, BoundsCoverWhatIsDrawn) {
+  DisplayListRecorder recorder(SkRect::MakeWH(100, 100));
+  recorder.drawRect(SkRect::MakeLTRB(10, 10, 20, 20), SkPaint());
+  recorder.translate(50, 50);
+  recorder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10), SkPaint());
+  auto display_list = recorder.Build();
+
+  EXPECT_EQ(display_list->cull_rect(), SkRect::MakeWH(100, 100));
+  // Outset by a pixel for anti-aliasing.
+  EXPECT_EQ(display_list->bounds(), SkRect::MakeLTRB(9, 9, 61, 61));
+}
+
+TEST(DisplayList, DropsOperationsOutsideOfTheClip) {
+  DisplayListRecorder recorder(SkRect::MakeWH(100, 100));
+  recorder.clipRect(SkRect::MakeWH(10, 10));
+  recorder.drawRect(SkRect::MakeLTRB(50, 50, 60, 60), SkPaint());
+  auto display_list = recorder.Build();
+
+  // Only the clip was recorded.
+  EXPECT_EQ(display_list->op_count(), 1u);
+  EXPECT_TRUE(display_list->bounds().isEmpty());
+}
+
+TEST(DisplayList, OnlyDrawsOperationsInTheCullRect) {
+  // Enough rows for the index to have several levels.
+  constexpr int kRowCount = 1000;
+  DisplayListRecorder recorder(SkRect::MakeWH(100, kRowCount * 10));
+  for (int i = 0; i < kRowCount; i++) {
+    recorder.drawRect(SkRect::MakeXYWH(0, i * 10, 50, 8), SkPaint());
+  }
+  auto display_list = recorder.Build();
+
+  MockCanvas canvas;
+  display_list->Draw(&canvas, SkRect::MakeLTRB(0, 5002, 10, 5004));
+  auto expected_draw_calls = std::vector({MockCanvas::DrawCall{
+      0, MockCanvas::DrawRectData{SkRect::MakeXYWH(0, 5000, 50, 8),
+                                  SkPaint()}}});
+  EXPECT_EQ(canvas.draw_calls(), expected_draw_calls);
+}
+
+TEST(DisplayList, SkipsSavesOutsideOfTheCullRect) {
+  DisplayListRecorder recorder(SkRect::MakeWH(200, 100));
+  recorder.save();
+  recorder.translate(100, 0);
+  recorder.drawRect(SkRect::MakeWH(10, 10), SkPaint());
+  recorder.restore();
+  auto display_list = recorder.Build();
+
+  MockCanvas canvas;
+  display_list->Draw(&canvas, SkRect::MakeWH(50, 50));
+  EXPECT_TRUE(canvas.draw_calls().empty());
+
+  display_list->Draw(&canvas, SkRect::MakeXYWH(100, 0, 50, 50));
+  EXPECT_EQ(canvas.draw_calls().size(), 4u);
+}
+
+TEST(DisplayList, DrawsEverythingInLayersWithImageFilters) {
+  DisplayListRecorder recorder(SkRect::MakeWH(100, 100));
+  SkPaint layer_paint;
+  layer_paint.setImageFilter(SkImageFilters::Blur(20, 20, nullptr));
+  recorder.saveLayer(nullptr, &layer_paint);
+  recorder.drawRect(SkRect::MakeWH(10, 10), SkPaint());
+  recorder.restore();
+  auto display_list = recorder.Build();
+
+  // The blur may spread the rect into the cull rect.
+  MockCanvas canvas;
+  display_list->Draw(&canvas, SkRect::MakeLTRB(50, 50, 60, 60));
+  EXPECT_EQ(canvas.draw_calls().size(), 3u);
+}
+
+TEST(DisplayList, SetMatrixIsRelativeToTheCanvas) {
+  DisplayListRecorder recorder(SkRect::MakeWH(64, 64));
+  recorder.setMatrix(SkMatrix::MakeScale(2));
+  recorder.drawRect(SkRect::MakeWH(10, 10), SkPaint());
+  auto display_list = recorder.Build();
+
+  MockCanvas canvas;
+  canvas.translate(10, 0);
+  display_list->Draw(&canvas);
+  auto expected_draw_calls = std::vector(
+      {MockCanvas::DrawCall{
+           0, MockCanvas::ConcatMatrixData{SkMatrix::MakeTrans(10, 0)}},
+       MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+       MockCanvas::DrawCall{
+           1, MockCanvas::SetMatrixData{SkMatrix::Concat(
+                  SkMatrix::MakeTrans(10, 0), SkMatrix::MakeScale(2))}},
+       MockCanvas::DrawCall{
+           1, MockCanvas::DrawRectData{SkRect::MakeWH(10, 10), SkPaint()}},
+       MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}});
+  EXPECT_EQ(canvas.draw_calls(), expected_draw_calls);
+}
+
+TEST(DisplayList, ComplexOperationsWeighMore) {
+  DisplayListRecorder simple_recorder(SkRect::MakeWH(100, 100));
+  simple_recorder.drawRect(SkRect::MakeXYWH(10, 10, 80, 80), SkPaint());
+  const auto simple = simple_recorder.Build()->complexity();
+
+  DisplayListRecorder complex_recorder(SkRect::MakeWH(100, 100));
+  SkPaint paint;
+  paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 5));
+  SkPath path;
+  path.moveTo(0, 0);
+  path.lineTo(100, 100);
+  path.lineTo(100, 0);
+  path.lineTo(0, 100);
+  for (int i = 0; i < 10; i++) {
+    complex_recorder.drawPath(path, paint);
+  }
+  const auto complex = complex_recorder.Build()->complexity();
+
+  ASSERT_GT(simple, 0.0);
+  // Ten paths with blurs are far more than ten times as complex as a rect.
+  ASSERT_GT(complex, simple * 10 * 10);
+}
+
+TEST(DisplayList, KeepsOperationsWhenStorageGrows) {
+  // Short keys are stored inside of the strings of the operations.
+  std::vector<std::string> keys;
+  for (int i = 0; i < 200; i++) {
+    keys.push_back(i % 2 == 0 ? std::to_string(i)
+                              : "a key too long to be stored inline " +
+                                    std::to_string(i));
+  }
+  DisplayListRecorder recorder(SkRect::MakeWH(100, 100));
+  for (const auto& key : keys) {
+    recorder.drawAnnotation(SkRect::MakeWH(10, 10), key.c_str(), nullptr);
+  }
+  auto display_list = recorder.Build();
+
+  AnnotationCanvas canvas;
+  display_list->Draw(&canvas);
+  EXPECT_EQ(canvas.keys(), keys);
+}
+
+TEST(DisplayList, StorageFitsItsOperations) {
+  DisplayListRecorder recorder(SkRect::MakeWH(100, 100));
+  recorder.drawRect(SkRect::MakeWH(10, 10), SkPaint());
+  auto display_list = recorder.Build();
+
+  // The storage starts out larger while recording.
+  EXPECT_LT(display_list->bytes_used(), 1024u);
+}
+
+TEST(DisplayList, DrawsBackdropLayersLikePictures) {
+  EXPECT_TRUE(DrawsLikePicture(
+      [](SkCanvas* canvas) {
+        canvas->drawRect(SkRect::MakeLTRB(0, 0, 100, 50),
+                         SkPaint(SkColors::kRed));
+        auto backdrop = SkImageFilters::Blur(10, 10, nullptr);
+        canvas->saveLayer(
+            SkCanvas::SaveLayerRec(nullptr, nullptr, backdrop.get(), 0));
+        canvas->drawRect(SkRect::MakeLTRB(90, 90, 95, 95), SkPaint());
+        canvas->restore();
+      },
+      SkRect::MakeLTRB(0, 45, 50, 70)));
+}
+
+TEST(DisplayList, DrawsColorFilterLayersLikePictures) {
+  EXPECT_TRUE(DrawsLikePicture(DrawColorFilterLayer,
+                               SkRect::MakeLTRB(50, 50, 100, 100)));
+}
+
+TEST(DisplayList, DrawsBlendModeLayersLikePictures) {
+  EXPECT_TRUE(DrawsLikePicture(
+      [](SkCanvas* canvas) {
+        canvas->drawRect(kCanvasBounds, SkPaint(SkColors::kRed));
+        SkPaint layer_paint;
+        layer_paint.setBlendMode(SkBlendMode::kSrc);
+        canvas->saveLayer(nullptr, &layer_paint);
+        canvas->drawRect(SkRect::MakeLTRB(10, 10, 20, 20), SkPaint());
+        canvas->restore();
+      },
+      SkRect::MakeLTRB(50, 50, 100, 100)));
+}
+
+TEST(DisplayList, DrawsInverseFillsLikePictures) {
+  EXPECT_TRUE(DrawsLikePicture(
+      [](SkCanvas* canvas) {
+        SkPath path;
+        path.addCircle(20, 20, 10);
+        path.setFillType(SkPathFillType::kInverseWinding);
+        canvas->drawPath(path, SkPaint(SkColors::kGreen));
+      },
+      SkRect::MakeLTRB(50, 50, 100, 100)));
+}
+
+TEST(DisplayList, DrawsShadowsLikePictures) {
+  EXPECT_TRUE(DrawsLikePicture(
+      [](SkCanvas* canvas) {
+        const SkPath path = SkPath().addRect(SkRect::MakeLTRB(10, 10, 40, 40));
+        SkShadowUtils::DrawShadow(canvas, path, SkPoint3::Make(0, 0, 20),
+                                  SkPoint3::Make(50, 0, 600), 800,
+                                  SK_ColorBLACK, SK_ColorBLACK, 0);
+      },
+      SkRect::MakeLTRB(40, 10, 70, 60)));
+}
+
+TEST(DisplayList, DrawsNestedDisplayListsLikePictures) {
+  // Like |Canvas::drawPicture|, which draws the display list of the picture
+  // into the recorder of the canvas.
+  auto inner_display_list = RecordDisplayList(DrawColorFilterLayer);
+  auto inner_picture = RecordPicture(DrawColorFilterLayer);
+  auto display_list = RecordDisplayList([&](SkCanvas* canvas) {
+    canvas->translate(10, 10);
+    inner_display_list->Draw(canvas);
+  });
+  auto picture = RecordPicture([&](SkCanvas* canvas) {
+    canvas->translate(10, 10);
+    canvas->drawPicture(inner_picture);
+  });
+  EXPECT_TRUE(RendersLikePicture(display_list, picture,
+                                 SkRect::MakeLTRB(50, 50, 100, 100)));
+}
+
+TEST(DisplayList, ConvertsToPicture) {
+  DisplayListRecorder recorder(SkRect::MakeWH(100, 50));
+  recorder.drawRect(SkRect::MakeWH(10, 10), SkPaint());
+  auto display_list = recorder.Build();
+  auto picture = display_list->ToSkPicture();
+
+  ASSERT_TRUE(picture);
+  EXPECT_EQ(picture->cullRect(), SkRect::MakeWH(100, 50));
+  EXPECT_EQ(picture->approximateOpCount(), 1);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_profiler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/flow/layers/layer.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+// Enough for the layers of several frames of a complex app.
+static constexpr size_t kMaxTrackedLayerCount = 8192;
+
+LayerProfiler::LayerProfiler() = default;
+
+LayerProfiler::~LayerProfiler() = default;
+
+void LayerProfiler::Reset() {
+  FML_DCHECK(scopes_.empty());
+  layers_.clear();
+  frame_count_ = 0;
+  paint_time_ = fml::TimeDelta::Zero();
+  total_overdraw_ = 0.0;
+  max_overdraw_ = 0.0;
+}
+
+void LayerProfiler::BeginFrame(const SkISize& frame_size) {
+  FML_DCHECK(scopes_.empty());
+  frame_start_ = fml::TimePoint::Now();
+  frame_pixel_count_ =
+      static_cast<uint64_t>(frame_size.width()) * frame_size.height();
+  frame_painted_pixel_count_ = 0;
+}
+
+void LayerProfiler::EndFrame() {
+  FML_DCHECK(scopes_.empty());
+  frame_count_++;
+  paint_time_ = paint_time_ + (fml::TimePoint::Now() - frame_start_);
+  if (frame_pixel_count_ > 0) {
+    const double overdraw =
+        static_cast<double>(frame_painted_pixel_count_) / frame_pixel_count_;
+    total_overdraw_ += overdraw;
+    max_overdraw_ = std::max(max_overdraw_, overdraw);
+    FML_TRACE_COUNTER("flutter", "LayerProfiler",
+                      reinterpret_cast<int64_t>(this),  //
+                      "OverdrawPercent", overdraw * 100);
+  }
+  SweepLayers();
+}
+
+void LayerProfiler::RecordPicture(const DisplayList& display_list) {
+  if (scopes_.empty()) {
+    return;
+  }
+  LayerStats* stats = scopes_.back().stats;
+  stats->picture_id = display_list.unique_id();
+  stats->picture_op_count = display_list.op_count();
+}
+
+LayerProfiler::Report LayerProfiler::GetReport(size_t max_layer_count) const {
+  Report report;
+  report.frame_count = frame_count_;
+  report.paint_time = paint_time_;
+  if (frame_count_ > 0) {
+    report.average_overdraw = total_overdraw_ / frame_count_;
+  }
+  report.max_overdraw = max_overdraw_;
+
+  report.layers.reserve(layers_.size());
+  for (const auto& entry : layers_) {
+    report.layers.push_back(entry.second);
+  }
+  const auto by_self_time = [](const LayerStats& a, const LayerStats& b) {
+    return a.self_time > b.self_time;
+  };
+  if (report.layers.size() > max_layer_count) {
+    std::partial_sort(report.layers.begin(),
+                      report.layers.begin() + max_layer_count,
+                      report.layers.end(), by_self_time);
+    report.layers.resize(max_layer_count);
+  } else {
+    std::sort(report.layers.begin(), report.layers.end(), by_self_time);
+  }
+  return report;
+}
+
+void LayerProfiler::PushLayer(const Layer* layer, uint64_t pixel_count) {
+  if (!scopes_.empty()) {
+    scopes_.back().has_children = true;
+  }
+
+  LayerStats& stats = layers_[layer->unique_id()];
+  stats.layer_id = layer->unique_id();
+  stats.type_name = layer->type_name();
+  scopes_.push_back({&stats, fml::TimePoint::Now(), fml::TimeDelta::Zero(),
+                     pixel_count, false});
+}
+
+void LayerProfiler::PopLayer(SkCanvas* flush_canvas) {
+  FML_DCHECK(!scopes_.empty());
+  const Scope scope = scopes_.back();
+  scopes_.pop_back();
+
+  if (flush_canvas && !scope.has_children) {
+    flush_canvas->flush();
+  }
+  const fml::TimeDelta total_time = fml::TimePoint::Now() - scope.start;
+  const fml::TimeDelta self_time = total_time - scope.children_time;
+
+  LayerStats& stats = *scope.stats;
+  stats.paint_count++;
+  stats.total_time = stats.total_time + total_time;
+  stats.self_time = stats.self_time + self_time;
+  stats.max_self_time = std::max(stats.max_self_time, self_time);
+  stats.pixel_count += scope.pixel_count;
+
+  if (!scope.has_children) {
+    frame_painted_pixel_count_ += scope.pixel_count;
+  }
+  if (!scopes_.empty()) {
+    Scope& parent = scopes_.back();
+    parent.children_time = parent.children_time + total_time;
+  }
+}
+
+void LayerProfiler::SweepLayers() {
+  if (layers_.size() <= kMaxTrackedLayerCount) {
+    return;
+  }
+
+  // Keep the half of the layers with the most self time.
+  std::vector<std::pair<fml::TimeDelta, uint64_t>> layers;
+  layers.reserve(layers_.size());
+  for (const auto& entry : layers_) {
+    layers.emplace_back(entry.second.self_time, entry.first);
+  }
+  auto kept = layers.begin() + layers.size() / 2;
+  std::nth_element(layers.begin(), kept, layers.end());
+  for (auto it = layers.begin(); it != kept; ++it) {
+    layers_.erase(it->second);
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,150 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYER_PROFILER_H_
+#define FLUTTER_FLOW_LAYER_PROFILER_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/flow/display_list.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+class Layer;
+
+//------------------------------------------------------------------------------
+/// @brief      Attributes the time spent painting and the pixels painted to
+///             each layer of the frames painted while profiling is enabled.
+///
+///             Layers are profiled by |Layer::AutoProfileScope|. The time of a
+///             layer is measured on the CPU around its |Paint|. On the
+///             software backend that includes the rasterization. On GPU
+///             backends, the canvas is flushed after each layer that has no
+///             children so that the time it takes to submit its commands is
+///             attributed to it, which makes profiled frames slower than
+///             regular ones. Only the ranking of layers is meaningful then.
+///
+///             The pixels of a layer are the device pixels its paint bounds
+///             cover within the clip. The overdraw of a frame is the number
+///             of pixels the layers without children paint for each pixel of
+///             the frame.
+///
+///             The profiler is only used on the GPU thread.
+///
+class LayerProfiler {
+ public:
+  struct LayerStats {
+    uint64_t layer_id = 0;
+    const char* type_name = "";
+    // The id and the op count of the display list of picture layers, zero for
+    // other layers.
+    uint32_t picture_id = 0;
+    size_t picture_op_count = 0;
+    // The number of frames the layer was painted in.
+    size_t paint_count = 0;
+    // The time spent painting the layer and its children.
+    fml::TimeDelta total_time;
+    // The time spent painting the layer without its children, and the most it
+    // took in a single frame.
+    fml::TimeDelta self_time;
+    fml::TimeDelta max_self_time;
+    // The device pixels the layer painted, summed over the frames.
+    uint64_t pixel_count = 0;
+  };
+
+  struct Report {
+    size_t frame_count = 0;
+    // The time spent painting the profiled frames.
+    fml::TimeDelta paint_time;
+    // The average number of pixels painted for each pixel of a frame.
+    double average_overdraw = 0.0;
+    // The highest overdraw of a single frame.
+    double max_overdraw = 0.0;
+    // The layers that took the most time, ranked by their self time.
+    std::vector<LayerStats> layers;
+  };
+
+  LayerProfiler();
+
+  ~LayerProfiler();
+
+  bool enabled() const { return enabled_; }
+
+  void set_enabled(bool enabled) { enabled_ = enabled; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forgets the profiled frames.
+  ///
+  void Reset();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts profiling a frame of |frame_size| device pixels.
+  ///
+  void BeginFrame(const SkISize& frame_size);
+
+  void EndFrame();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts measuring the painting of |layer|, which covers
+  ///             |pixel_count| device pixels. Layers pushed before it is
+  ///             popped are its children.
+  ///
+  void PushLayer(const Layer* layer, uint64_t pixel_count);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stops measuring the painting of the last layer pushed. If
+  ///             |flush_canvas| is set and the layer had no children, the
+  ///             canvas is flushed first.
+  ///
+  void PopLayer(SkCanvas* flush_canvas);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Attributes |display_list| to the layer being painted.
+  ///
+  void RecordPicture(const DisplayList& display_list);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the stats of the profiled frames, with at most
+  ///             |max_layer_count| layers.
+  ///
+  Report GetReport(size_t max_layer_count) const;
+
+  size_t GetTrackedLayerCount() const { return layers_.size(); }
+
+ private:
+  struct Scope {
+    LayerStats* stats;
+    fml::TimePoint start;
+    fml::TimeDelta children_time;
+    uint64_t pixel_count;
+    bool has_children;
+  };
+
+  bool enabled_ = false;
+  std::unordered_map<uint64_t, LayerStats> layers_;
+  std::vector<Scope> scopes_;
+  size_t frame_count_ = 0;
+  fml::TimeDelta paint_time_;
+  double total_overdraw_ = 0.0;
+  double max_overdraw_ = 0.0;
+  fml::TimePoint frame_start_;
+  uint64_t frame_pixel_count_ = 0;
+  uint64_t frame_painted_pixel_count_ = 0;
+
+  // Forgets the layers with the least self time once too many are tracked,
+  // like the ones the framework creates anew every frame.
+  void SweepLayers();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerProfiler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYER_PROFILER_H_
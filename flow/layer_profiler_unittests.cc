@@ -0,0 +1,148 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/flow/layer_profiler.h"
+
+#include <algorithm>
+
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/testing/mock_layer.h"
+#include "flutter/flow/testing/skia_gpu_object_layer_test.h"
+
+namespace flutter {
+namespace testing {
+
+class LayerProfilerTest : public SkiaGPUObjectLayerTest {
+ public:
+  LayerProfilerTest() { paint_context().layer_profiler = &profiler_; }
+
+  LayerProfiler& profiler() { return profiler_; }
+
+  // Paints |layer| as the root of a frame of the size of the mock canvas.
+  void PaintFrame(Layer* layer) {
+    profiler_.BeginFrame(SkISize::Make(64, 64));
+    {
+      Layer::AutoProfileScope profile(paint_context(), layer);
+      layer->Paint(paint_context());
+    }
+    profiler_.EndFrame();
+  }
+
+ private:
+  LayerProfiler profiler_;
+};
+
+static const LayerProfiler::LayerStats* FindLayer(
+    const LayerProfiler::Report& report,
+    const Layer* layer) {
+  for (const auto& stats : report.layers) {
+    if (stats.layer_id == layer->unique_id()) {
+      return &stats;
+    }
+  }
+  return nullptr;
+}
+
+TEST_F(LayerProfilerTest, AttributesPixelsToEachLayer) {
+  auto first = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(0, 0, 10, 10)));
+  auto second = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(5, 5, 15, 15)));
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(first);
+  root->Add(second);
+  root->Preroll(preroll_context(), SkMatrix());
+
+  PaintFrame(root.get());
+  PaintFrame(root.get());
+  const auto report = profiler().GetReport(10);
+
+  EXPECT_EQ(report.frame_count, 2u);
+  ASSERT_EQ(report.layers.size(), 3u);
+  const auto* root_stats = FindLayer(report, root.get());
+  ASSERT_NE(root_stats, nullptr);
+  EXPECT_STREQ(root_stats->type_name, "ContainerLayer");
+  EXPECT_EQ(root_stats->paint_count, 2u);
+  EXPECT_EQ(root_stats->pixel_count, 2u * 15 * 15);
+  EXPECT_GE(root_stats->total_time, root_stats->self_time);
+  const auto* first_stats = FindLayer(report, first.get());
+  ASSERT_NE(first_stats, nullptr);
+  EXPECT_EQ(first_stats->pixel_count, 2u * 10 * 10);
+  ASSERT_NE(FindLayer(report, second.get()), nullptr);
+
+  // Only the layers without children count towards the overdraw.
+  EXPECT_DOUBLE_EQ(report.average_overdraw, 200.0 / (64 * 64));
+  EXPECT_DOUBLE_EQ(report.max_overdraw, 200.0 / (64 * 64));
+  EXPECT_TRUE(std::is_sorted(
+      report.layers.begin(), report.layers.end(),
+      [](const auto& a, const auto& b) { return a.self_time > b.self_time; }));
+}
+
+TEST_F(LayerProfilerTest, ClipsPixelsToTheCanvas) {
+  auto layer = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(-50, -50, 10, 10)));
+  layer->Preroll(preroll_context(), SkMatrix());
+
+  PaintFrame(layer.get());
+  const auto report = profiler().GetReport(10);
+
+  ASSERT_EQ(report.layers.size(), 1u);
+  EXPECT_EQ(report.layers[0].pixel_count, 10u * 10);
+}
+
+TEST_F(LayerProfilerTest, AttributesPicturesToTheirLayers) {
+  DisplayListRecorder recorder(SkRect::MakeWH(64, 64));
+  recorder.drawRect(SkRect::MakeWH(10, 10), SkPaint());
+  recorder.drawRect(SkRect::MakeXYWH(20, 20, 10, 10), SkPaint());
+  auto display_list = recorder.Build();
+  auto layer = std::make_shared<PictureLayer>(
+      SkPoint::Make(0, 0), SkiaGPUObject(display_list, unref_queue()), false,
+      false);
+  layer->Preroll(preroll_context(), SkMatrix());
+
+  PaintFrame(layer.get());
+  const auto report = profiler().GetReport(10);
+
+  ASSERT_EQ(report.layers.size(), 1u);
+  EXPECT_STREQ(report.layers[0].type_name, "PictureLayer");
+  EXPECT_EQ(report.layers[0].picture_id, display_list->unique_id());
+  EXPECT_EQ(report.layers[0].picture_op_count, 2u);
+}
+
+TEST_F(LayerProfilerTest, ReportsAtMostTheRequestedLayers) {
+  auto root = std::make_shared<ContainerLayer>();
+  for (int i = 0; i < 5; i++) {
+    root->Add(std::make_shared<MockLayer>(
+        SkPath().addRect(SkRect::MakeXYWH(i * 10, 0, 5, 5))));
+  }
+  root->Preroll(preroll_context(), SkMatrix());
+
+  PaintFrame(root.get());
+  EXPECT_EQ(profiler().GetReport(2).layers.size(), 2u);
+  EXPECT_EQ(profiler().GetTrackedLayerCount(), 6u);
+
+  profiler().Reset();
+  const auto report = profiler().GetReport(2);
+  EXPECT_EQ(report.frame_count, 0u);
+  EXPECT_TRUE(report.layers.empty());
+}
+
+TEST_F(LayerProfilerTest, DoesNothingWithoutAProfiler) {
+  auto layer = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeWH(10, 10)));
+  layer->Preroll(preroll_context(), SkMatrix());
+  paint_context().layer_profiler = nullptr;
+
+  {
+    Layer::AutoProfileScope profile(paint_context(), layer.get());
+    layer->Paint(paint_context());
+  }
+  EXPECT_EQ(profiler().GetTrackedLayerCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,26 +4,207 @@
 
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 
+#include <algorithm>
+
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
+
 namespace flutter {
 
-BackdropFilterLayer::BackdropFilterLayer(sk_sp<SkImageFilter> filter)
-    : filter_(std::move(filter)) {}
+namespace {
+
+int GetBlurDownsampleFactor(const SkVector& blur_sigma,
+                            const SkMatrix& matrix) {
+  const SkScalar scale = matrix.getMinScale();
+  if (scale <= 0) {
+    // Perspective or a singular matrix.
+    return 1;
+  }
+  const SkScalar device_sigma =
+      std::min(blur_sigma.x(), blur_sigma.y()) * scale;
+  int factor = 1;
+  while (factor < BackdropFilterLayer::kMaxBlurDownsampleFactor &&
+         device_sigma / (factor * 2) >=
+             BackdropFilterLayer::kMinDownsampledBlurSigma) {
+    factor *= 2;
+  }
+  return factor;
+}
+
+// Applies |filter| to the region of |surface| it reads to produce
+// |device_bounds|, the way SkCanvas applies backdrop filters.
+RasterCacheResult FilterBackdrop(GrContext* gr_context,
+                                 SkSurface* surface,
+                                 const SkImageFilter& filter,
+                                 const SkMatrix& ctm,
+                                 const SkIRect& device_bounds) {
+  TRACE_EVENT0("flutter", "BackdropFilterLayer::FilterBackdrop");
+  SkIRect input_bounds = filter.filterBounds(
+      device_bounds, ctm, SkImageFilter::kReverse_MapDirection);
+  if (!input_bounds.intersect(
+          SkIRect::MakeWH(surface->width(), surface->height()))) {
+    return {};
+  }
+  sk_sp<SkImage> input = surface->makeImageSnapshot(input_bounds);
+  if (!input) {
+    return {};
+  }
+
+  const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
+      device_bounds.width(), device_bounds.height(),
+      surface->getCanvas()->imageInfo().refColorSpace());
+  sk_sp<SkSurface> result =
+      gr_context ? SkSurface::MakeRenderTarget(gr_context, SkBudgeted::kYes,
+                                               image_info)
+                 : SkSurface::MakeRaster(image_info);
+  if (!result) {
+    return {};
+  }
+
+  SkCanvas* canvas = result->getCanvas();
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->translate(-device_bounds.left(), -device_bounds.top());
+  // The input is in device space, so the filter is given the ctm it would
+  // have been applied with.
+  SkPaint paint;
+  paint.setImageFilter(filter.makeWithLocalMatrix(ctm));
+  canvas->drawImage(input, input_bounds.left(), input_bounds.top(), &paint);
+  return {result->makeImageSnapshot(), SkRect::Make(device_bounds)};
+}
+
+}  // namespace
+
+BackdropFilterLayer::BackdropFilterLayer(sk_sp<SkImageFilter> filter,
+                                         const SkVector& blur_sigma)
+    : filter_(std::move(filter)),
+      blur_sigma_(blur_sigma),
+      paint_filter_(filter_) {}
 
 void BackdropFilterLayer::Preroll(PrerollContext* context,
                                   const SkMatrix& matrix) {
+  // The backdrop is everything prerolled so far. Only blurs can be compared
+  // across frames since other filters are only known by their address. The
+  // backdrop is read from the surface, which doesn't hold it when the layer
+  // is painted into a save layer, including the one protecting surfaces that
+  // don't support readback.
+  ContentSignature& signature = context->content_signature;
+  const bool is_blur = filter_ && !blur_sigma_.isZero();
+  backdrop_is_reusable_ = is_blur && context->raster_cache &&
+                          !signature.is_volatile() &&
+                          context->save_layer_depth == 0 &&
+                          context->surface_supports_readback;
+  backdrop_signature_ = signature.value();
+  if (is_blur) {
+    signature.Add(blur_sigma_);
+    signature.Add(matrix);
+  } else if (filter_) {
+    signature.MarkVolatile();
+  }
+
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context, true, bool(filter_));
   ContainerLayer::Preroll(context, matrix);
+
+  // Nothing outside of the cull rect is visible, so there is no need to
+  // filter it.
+  save_layer_bounds_ = paint_bounds();
+  if (!save_layer_bounds_.intersect(context->cull_rect)) {
+    save_layer_bounds_.setEmpty();
+  }
+  signature.Add(save_layer_bounds_);
+
+  if (is_blur) {
+    UpdatePaintFilter(matrix);
+  }
+}
+
+void BackdropFilterLayer::UpdatePaintFilter(const SkMatrix& matrix) {
+  const int factor = GetBlurDownsampleFactor(blur_sigma_, matrix);
+  if (factor == downsample_factor_) {
+    return;
+  }
+  downsample_factor_ = factor;
+  if (factor == 1) {
+    paint_filter_ = filter_;
+    return;
+  }
+
+  // Blurs the backdrop at 1/factor of the resolution with a proportionally
+  // smaller sigma, which is equivalent for blurs this large and touches a
+  // fraction of the pixels.
+  const SkScalar scale = static_cast<SkScalar>(factor);
+  auto downsampled = SkImageFilters::MatrixTransform(
+      SkMatrix::MakeScale(1 / scale), kMedium_SkFilterQuality, nullptr);
+  auto blurred =
+      SkImageFilters::Blur(blur_sigma_.x() / scale, blur_sigma_.y() / scale,
+                           SkTileMode::kClamp, std::move(downsampled));
+  paint_filter_ = SkImageFilters::MatrixTransform(
+      SkMatrix::MakeScale(scale), kLow_SkFilterQuality, std::move(blurred));
 }
 
 void BackdropFilterLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "BackdropFilterLayer::Paint");
   FML_DCHECK(needs_painting());
 
+  if (PaintCachedBackdrop(context)) {
+    // The filtered backdrop is already on the canvas, and the children are
+    // drawn over it the same as they would be within the save layer.
+    PaintChildren(context);
+    return;
+  }
+
   Layer::AutoSaveLayer save = Layer::AutoSaveLayer::Create(
-      context,
-      SkCanvas::SaveLayerRec{&paint_bounds(), nullptr, filter_.get(), 0});
+      context, SkCanvas::SaveLayerRec{&save_layer_bounds_, nullptr,
+                                      paint_filter_.get(), 0});
   PaintChildren(context);
 }
 
+bool BackdropFilterLayer::PaintCachedBackdrop(PaintContext& context) const {
+  if (!backdrop_is_reusable_ || !context.raster_cache) {
+    return false;
+  }
+  // Only surfaces can be read back from.
+  SkCanvas* canvas = context.leaf_nodes_canvas;
+  SkSurface* surface = canvas->getSurface();
+  if (!surface) {
+    return false;
+  }
+
+  const SkMatrix& ctm = canvas->getTotalMatrix();
+  SkIRect device_bounds = RasterCache::GetDeviceBounds(save_layer_bounds_, ctm);
+  if (!device_bounds.intersect(canvas->getDeviceClipBounds())) {
+    return false;
+  }
+
+  ContentSignature id;
+  id.Add(backdrop_signature_);
+  id.Add(blur_sigma_);
+  id.Add(SkRect::Make(device_bounds));
+  SkMatrix key_matrix = ctm;
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+  key_matrix = RasterCache::GetIntegralTransCTM(key_matrix);
+#endif
+  const BackdropRasterCacheKey key(id.value(), key_matrix);
+
+  bool should_cache = false;
+  RasterCacheResult backdrop =
+      context.raster_cache->GetBackdrop(key, &should_cache);
+  if (!backdrop.is_valid()) {
+    if (!should_cache) {
+      return false;
+    }
+    backdrop = FilterBackdrop(context.gr_context, surface, *paint_filter_, ctm,
+                              device_bounds);
+    if (!backdrop.is_valid()) {
+      return false;
+    }
+    context.raster_cache->PutBackdrop(key, backdrop);
+  }
+
+  SkAutoCanvasRestore auto_restore(canvas, true);
+  canvas->resetMatrix();
+  backdrop.draw(*canvas);
+  return true;
+}
+
 }  // namespace flutter
@@ -13,14 +13,40 @@ namespace flutter {
 
 class BackdropFilterLayer : public ContainerLayer {
  public:
-  BackdropFilterLayer(sk_sp<SkImageFilter> filter);
+  // |blur_sigma| is the sigma of |filter| if it is a blur, in which case the
+  // blur may be applied at a lower resolution and its result reused across
+  // frames.
+  BackdropFilterLayer(sk_sp<SkImageFilter> filter,
+                      const SkVector& blur_sigma = SkVector::Make(0, 0));
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
+  const char* type_name() const override { return "BackdropFilterLayer"; }
+
+  // The blur is downsampled by powers of two up to this factor, as long as
+  // the downsampled sigma stays at least |kMinDownsampledBlurSigma| device
+  // pixels. Below that the upsampled result is visibly blockier.
+  static constexpr int kMaxBlurDownsampleFactor = 4;
+  static constexpr SkScalar kMinDownsampledBlurSigma = 2.0f;
 
  private:
   sk_sp<SkImageFilter> filter_;
+  SkVector blur_sigma_;
+  // The filter that is painted, which is |filter_| unless the blur is
+  // downsampled.
+  sk_sp<SkImageFilter> paint_filter_;
+  int downsample_factor_ = 1;
+  // The paint bounds restricted to the cull rect, in which the backdrop is
+  // actually visible.
+  SkRect save_layer_bounds_ = SkRect::MakeEmpty();
+  // The signature of what was painted under the layer, if it can be compared
+  // across frames.
+  bool backdrop_is_reusable_ = false;
+  uint64_t backdrop_signature_ = 0;
+
+  void UpdatePaintFilter(const SkMatrix& matrix);
+  bool PaintCachedBackdrop(PaintContext& context) const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(BackdropFilterLayer);
 };
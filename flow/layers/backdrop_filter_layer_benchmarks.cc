@@ -0,0 +1,162 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/layers/backdrop_filter_layer.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/message_loop.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
+
+namespace flutter {
+
+static constexpr int kWidth = 1080;
+static constexpr int kHeight = 1920;
+static constexpr int kRowHeight = 160;
+static constexpr int kRowCount = 40;
+static constexpr int kHeaderHeight = 320;
+static constexpr SkScalar kBlurSigma = 24.0f;
+
+static sk_sp<DisplayList> RecordRow(int index) {
+  DisplayListRecorder recorder(SkRect::MakeWH(kWidth, kRowHeight));
+  SkCanvas* canvas = &recorder;
+  SkPaint paint;
+  paint.setAntiAlias(true);
+  paint.setColor(SkColorSetRGB((index * 37) % 255, (index * 91) % 255,
+                               (index * 53) % 255));
+  canvas->drawRRect(
+      SkRRect::MakeRectXY(
+          SkRect::MakeXYWH(16, 8, kWidth - 32, kRowHeight - 16), 16, 16),
+      paint);
+  paint.setColor(SK_ColorWHITE);
+  canvas->drawCircle(kRowHeight / 2 + 16, kRowHeight / 2, kRowHeight / 3,
+                     paint);
+  canvas->drawRect(SkRect::MakeXYWH(kRowHeight + 32, kRowHeight / 2 - 12,
+                                    kWidth / 2, 24),
+                   paint);
+  return recorder.Build();
+}
+
+static sk_sp<DisplayList> RecordHeader() {
+  DisplayListRecorder recorder(SkRect::MakeWH(kWidth, kHeaderHeight));
+  SkPaint paint;
+  paint.setColor(SkColorSetARGB(96, 255, 255, 255));
+  recorder.drawRect(SkRect::MakeWH(kWidth, kHeaderHeight), paint);
+  return recorder.Build();
+}
+
+// Paints a list of rows under a blurred header, the way an app bar over a
+// scrolling list does. The rows are retained across frames and only the
+// scroll offset changes, if the list scrolls at all.
+//
+// Arguments:
+//   0: Whether the layer knows the sigma of the blur, which allows it to blur
+//      at a lower resolution and to reuse the blurred backdrop.
+//   1: Whether the list scrolls.
+static void BM_BackdropFilterOverScrollingList(benchmark::State& state) {
+  const bool blur_sigma_is_known = state.range(0) != 0;
+  const bool scrolls = state.range(1) != 0;
+
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto unref_queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      fml::MessageLoop::GetCurrent().GetTaskRunner(), fml::TimeDelta::Zero());
+
+  std::vector<std::shared_ptr<PictureLayer>> rows;
+  for (int i = 0; i < kRowCount; i++) {
+    rows.push_back(std::make_shared<PictureLayer>(
+        SkPoint::Make(0, i * kRowHeight),
+        SkiaGPUObject<DisplayList>(RecordRow(i), unref_queue), false, false));
+  }
+  auto header = std::make_shared<PictureLayer>(
+      SkPoint::Make(0, 0),
+      SkiaGPUObject<DisplayList>(RecordHeader(), unref_queue), false, false);
+  auto blur = SkImageFilters::Blur(kBlurSigma, kBlurSigma, nullptr);
+  const SkVector blur_sigma = blur_sigma_is_known
+                                  ? SkVector::Make(kBlurSigma, kBlurSigma)
+                                  : SkVector::Make(0, 0);
+
+  auto surface = SkSurface::MakeRasterN32Premul(kWidth, kHeight);
+  FML_CHECK(surface);
+  SkCanvas* canvas = surface->getCanvas();
+  RasterCache raster_cache;
+  MutatorsStack mutators_stack;
+  Stopwatch raster_time;
+  Stopwatch ui_time;
+  TextureRegistry texture_registry;
+
+  int frame = 0;
+  while (state.KeepRunning()) {
+    const SkScalar scroll_offset =
+        scrolls ? (frame * 7) % ((kRowCount * kRowHeight) - kHeight) : 0;
+    auto list = std::make_shared<TransformLayer>(
+        SkMatrix::MakeTrans(0, -scroll_offset));
+    for (const auto& row : rows) {
+      list->Add(row);
+    }
+    auto backdrop = std::make_shared<BackdropFilterLayer>(blur, blur_sigma);
+    backdrop->Add(header);
+    auto header_clip = std::make_shared<ClipRectLayer>(
+        SkRect::MakeWH(kWidth, kHeaderHeight), Clip::hardEdge);
+    header_clip->Add(backdrop);
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(list);
+    root->Add(header_clip);
+
+    PrerollContext preroll_context = {
+        &raster_cache,    /* raster_cache */
+        nullptr,          /* gr_context */
+        nullptr,          /* external_view_embedder */
+        mutators_stack,   /* mutators_stack */
+        nullptr,          /* dst_color_space */
+        kGiantRect,       /* cull_rect */
+        false,            /* surface_needs_readback */
+        raster_time,      /* raster_time */
+        ui_time,          /* ui_time */
+        texture_registry, /* texture_registry */
+        false,            /* checkerboard_offscreen_layers */
+        100.0f,           /* frame_physical_depth */
+        1.0f,             /* frame_device_pixel_ratio */
+    };
+    preroll_context.surface_supports_readback = true;
+    root->Preroll(&preroll_context, SkMatrix());
+
+    Layer::PaintContext paint_context = {
+        canvas,           /* internal_nodes_canvas */
+        canvas,           /* leaf_nodes_canvas */
+        nullptr,          /* gr_context */
+        nullptr,          /* external_view_embedder */
+        raster_time,      /* raster_time */
+        ui_time,          /* ui_time */
+        texture_registry, /* texture_registry */
+        &raster_cache,    /* raster_cache */
+        false,            /* checkerboard_offscreen_layers */
+        100.0f,           /* frame_physical_depth */
+        1.0f,             /* frame_device_pixel_ratio */
+    };
+    canvas->clear(SK_ColorWHITE);
+    root->Paint(paint_context);
+    canvas->flush();
+    raster_cache.SweepAfterFrame();
+    frame++;
+  }
+
+  // Lets the unref queue release the pictures.
+  rows.clear();
+  header.reset();
+  fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
+}
+
+BENCHMARK(BM_BackdropFilterOverScrollingList)
+    ->Args({0, 1})
+    ->Args({1, 1})
+    ->Args({0, 0})
+    ->Args({1, 0})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace flutter
@@ -4,11 +4,15 @@
 
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
 #include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/effects/SkImageFilters.h"
 
 namespace flutter {
@@ -213,5 +217,159 @@ TEST_F(BackdropFilterLayerTest, Readback) {
   EXPECT_FALSE(preroll_context()->surface_needs_readback);
 }
 
+TEST_F(BackdropFilterLayerTest, RestrictsSaveLayerToCullRect) {
+  const SkRect child_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  const SkRect cull_rect = SkRect::MakeLTRB(0.0f, 0.0f, 10.0f, 10.0f);
+  const SkPath child_path = SkPath().addRect(child_bounds);
+  const SkPaint child_paint = SkPaint(SkColors::kYellow);
+  auto layer_filter = SkImageFilters::Paint(SkPaint(SkColors::kMagenta));
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto layer = std::make_shared<BackdropFilterLayer>(layer_filter);
+  layer->Add(mock_layer);
+
+  preroll_context()->cull_rect = cull_rect;
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(layer->paint_bounds(), child_bounds);
+
+  layer->Paint(paint_context());
+  EXPECT_EQ(
+      mock_canvas().draw_calls(),
+      std::vector(
+          {MockCanvas::DrawCall{
+               0, MockCanvas::SaveLayerData{SkRect::MakeLTRB(5, 6, 10, 10),
+                                            SkPaint(), layer_filter, 1}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::DrawPathData{child_path, child_paint}},
+           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+}
+
+TEST_F(BackdropFilterLayerTest, LargeBlursAreDownsampled) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(50, 50));
+  auto layer_filter = SkImageFilters::Blur(2.0f, 2.0f, nullptr);
+  auto small_blur_layer = std::make_shared<BackdropFilterLayer>(
+      layer_filter, SkVector::Make(2.0f, 2.0f));
+  small_blur_layer->Add(std::make_shared<MockLayer>(child_path));
+  auto large_blur_layer = std::make_shared<BackdropFilterLayer>(
+      layer_filter, SkVector::Make(2.0f, 2.0f));
+  large_blur_layer->Add(std::make_shared<MockLayer>(child_path));
+
+  // The sigma is only large enough once it is scaled to device pixels.
+  small_blur_layer->Preroll(preroll_context(), SkMatrix());
+  large_blur_layer->Preroll(preroll_context(), SkMatrix::MakeScale(4.0f));
+  small_blur_layer->Paint(paint_context());
+  large_blur_layer->Paint(paint_context());
+
+  std::vector<sk_sp<SkImageFilter>> backdrop_filters;
+  for (const auto& call : mock_canvas().draw_calls()) {
+    if (auto* save_layer = std::get_if<MockCanvas::SaveLayerData>(&call.data)) {
+      backdrop_filters.push_back(save_layer->backdrop_filter);
+    }
+  }
+  ASSERT_EQ(backdrop_filters.size(), 2u);
+  EXPECT_EQ(backdrop_filters[0], layer_filter);
+  EXPECT_NE(backdrop_filters[1], nullptr);
+  EXPECT_NE(backdrop_filters[1], layer_filter);
+}
+
+TEST_F(BackdropFilterLayerTest, ReusesFilteredBackdropOfUnchangedContent) {
+  auto surface = SkSurface::MakeRasterN32Premul(100, 100);
+  SkCanvas* canvas = surface->getCanvas();
+  Stopwatch raster_time;
+  Stopwatch ui_time;
+  TextureRegistry texture_registry;
+  RasterCache raster_cache(2);
+  Layer::PaintContext paint_context = {
+      canvas,           /* internal_nodes_canvas */
+      canvas,           /* leaf_nodes_canvas */
+      nullptr,          /* gr_context */
+      nullptr,          /* external_view_embedder */
+      raster_time,      /* raster_time */
+      ui_time,          /* ui_time */
+      texture_registry, /* texture_registry */
+      &raster_cache,    /* raster_cache */
+      false,            /* checkerboard_offscreen_layers */
+      100.0f,           /* frame_physical_depth */
+      1.0f,             /* frame_device_pixel_ratio */
+  };
+  preroll_context()->raster_cache = &raster_cache;
+  preroll_context()->surface_supports_readback = true;
+
+  // Mock layers don't add to the content signature, so painting them in a
+  // new color under an unchanged signature shows whether the backdrop was
+  // filtered again.
+  auto paint_frame = [&](const SkRect& clip_rect, SkColor color) {
+    SkPaint background_paint;
+    background_paint.setColor(color);
+    auto background =
+        std::make_shared<ClipRectLayer>(clip_rect, Clip::hardEdge);
+    background->Add(std::make_shared<MockLayer>(
+        SkPath().addRect(SkRect::MakeWH(100, 100)), background_paint));
+    auto layer = std::make_shared<BackdropFilterLayer>(
+        SkImageFilters::Blur(2.0f, 2.0f, nullptr), SkVector::Make(2.0f, 2.0f));
+    layer->Add(std::make_shared<MockLayer>(
+        SkPath().addRect(SkRect::MakeWH(50, 50)),
+        SkPaint(SkColors::kTransparent)));
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(background);
+    root->Add(layer);
+
+    preroll_context()->content_signature = ContentSignature();
+    root->Preroll(preroll_context(), SkMatrix());
+    canvas->clear(SK_ColorTRANSPARENT);
+    root->Paint(paint_context);
+    raster_cache.SweepAfterFrame();
+
+    SkPixmap pixmap;
+    EXPECT_TRUE(surface->peekPixels(&pixmap));
+    return pixmap.getColor(25, 25);
+  };
+
+  const SkRect clip_rect = SkRect::MakeWH(100, 100);
+  // The backdrop is filtered on the first frame and cached on the second.
+  EXPECT_EQ(SkColorGetR(paint_frame(clip_rect, SK_ColorRED)), 0xFFu);
+  EXPECT_EQ(SkColorGetR(paint_frame(clip_rect, SK_ColorRED)), 0xFFu);
+  EXPECT_EQ(raster_cache.GetCachedEntriesCount(), 1u);
+
+  // The cached backdrop is reused.
+  EXPECT_EQ(SkColorGetR(paint_frame(clip_rect, SK_ColorBLUE)), 0xFFu);
+
+  // The content changed, so the backdrop is filtered again.
+  EXPECT_EQ(SkColorGetB(paint_frame(SkRect::MakeWH(100, 99), SK_ColorBLUE)),
+            0xFFu);
+}
+
+TEST_F(BackdropFilterLayerTest, DoesNotReuseBackdropOfSurfacesWithoutReadback) {
+  auto surface = SkSurface::MakeRasterN32Premul(100, 100);
+  CompositorContext compositor_context(fml::kDefaultFrameBudget);
+  LayerTree layer_tree(SkISize::Make(100, 100), 100.0f, 1.0f);
+
+  SkPaint background_paint;
+  background_paint.setColor(SK_ColorRED);
+  auto layer = std::make_shared<BackdropFilterLayer>(
+      SkImageFilters::Blur(2.0f, 2.0f, nullptr), SkVector::Make(2.0f, 2.0f));
+  layer->Add(std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeWH(50, 50)),
+      SkPaint(SkColors::kTransparent)));
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeWH(100, 100)), background_paint));
+  root->Add(layer);
+  layer_tree.set_root_layer(root);
+
+  // The frame reads back, so it is painted into a save layer and the surface
+  // keeps what it held before the frame until the save layer is restored.
+  for (int frame = 0; frame < 4; frame++) {
+    surface->getCanvas()->clear(SK_ColorGREEN);
+    auto scoped_frame = compositor_context.AcquireFrame(
+        nullptr, surface->getCanvas(), nullptr, SkMatrix::I(), false,
+        false /* surface_supports_readback */, nullptr);
+    EXPECT_EQ(scoped_frame->Raster(layer_tree, false), RasterStatus::kSuccess);
+
+    SkPixmap pixmap;
+    ASSERT_TRUE(surface->peekPixels(&pixmap));
+    EXPECT_EQ(pixmap.getColor(25, 25), SK_ColorRED);
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -20,6 +20,7 @@ ChildSceneLayer::ChildSceneLayer(zx_koid_t layer_id,
 void ChildSceneLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   TRACE_EVENT0("flutter", "ChildSceneLayer::Preroll");
   set_needs_system_composite(true);
+  context->content_signature.MarkVolatile();
 
   // An alpha "hole punch" is required if the frame behind us is not opaque.
   if (!context->is_opaque) {
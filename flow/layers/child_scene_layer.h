@@ -26,6 +26,7 @@ class ChildSceneLayer : public Layer {
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
+  const char* type_name() const override { return "ChildSceneLayer"; }
 
   void UpdateScene(SceneUpdateContext& context) override;
 
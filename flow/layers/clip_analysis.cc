@@ -0,0 +1,151 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/clip_analysis.h"
+
+namespace flutter {
+
+namespace {
+
+bool IsPixelAligned(const SkRect& rect, const SkMatrix& matrix) {
+  if (!matrix.rectStaysRect()) {
+    return false;
+  }
+  SkRect device_rect;
+  matrix.mapRect(&device_rect, rect);
+  SkRect rounded_rect = SkRect::Make(device_rect.round());
+  return device_rect == rounded_rect;
+}
+
+}  // namespace
+
+ClipAnalysis::ClipAnalysis(Type type, Clip clip_behavior)
+    : type_(type),
+      anti_alias_(clip_behavior != Clip::hardEdge),
+      uses_save_layer_(clip_behavior == Clip::antiAliasWithSaveLayer) {}
+
+ClipAnalysis ClipAnalysis::ForRect(const SkRect& clip_rect,
+                                   Clip clip_behavior,
+                                   const SkRect& children_bounds,
+                                   const SkMatrix& matrix) {
+  if (clip_rect.contains(children_bounds)) {
+    return ClipAnalysis();
+  }
+  ClipAnalysis analysis(Type::kRect, clip_behavior);
+  analysis.rect_ = clip_rect;
+  if (analysis.anti_alias_ && IsPixelAligned(clip_rect, matrix)) {
+    analysis.anti_alias_ = false;
+    analysis.uses_save_layer_ = false;
+  }
+  return analysis;
+}
+
+ClipAnalysis ClipAnalysis::ForRRect(const SkRRect& clip_rrect,
+                                    Clip clip_behavior,
+                                    const SkRect& children_bounds,
+                                    const SkMatrix& matrix) {
+  if (clip_rrect.isRect()) {
+    return ForRect(clip_rrect.rect(), clip_behavior, children_bounds, matrix);
+  }
+  if (clip_rrect.contains(children_bounds)) {
+    return ClipAnalysis();
+  }
+  // The corners only matter if the children reach into them.
+  SkRect inner_bounds = children_bounds;
+  if (inner_bounds.intersect(clip_rrect.rect()) &&
+      clip_rrect.contains(inner_bounds)) {
+    return ForRect(clip_rrect.rect(), clip_behavior, children_bounds, matrix);
+  }
+  ClipAnalysis analysis(Type::kRRect, clip_behavior);
+  analysis.rect_ = clip_rrect.rect();
+  analysis.rrect_ = clip_rrect;
+  return analysis;
+}
+
+ClipAnalysis ClipAnalysis::ForPath(const SkPath& clip_path,
+                                   Clip clip_behavior,
+                                   const SkRect& children_bounds,
+                                   const SkMatrix& matrix) {
+  if (!clip_path.isInverseFillType()) {
+    SkRect rect;
+    SkRRect rrect;
+    if (clip_path.isRect(&rect)) {
+      return ForRect(rect, clip_behavior, children_bounds, matrix);
+    }
+    if (clip_path.isOval(&rect)) {
+      return ForRRect(SkRRect::MakeOval(rect), clip_behavior, children_bounds,
+                      matrix);
+    }
+    if (clip_path.isRRect(&rrect)) {
+      return ForRRect(rrect, clip_behavior, children_bounds, matrix);
+    }
+    if (clip_path.conservativelyContainsRect(children_bounds)) {
+      return ClipAnalysis();
+    }
+    const SkRect& path_bounds = clip_path.getBounds();
+    SkRect inner_bounds = children_bounds;
+    if (inner_bounds.intersect(path_bounds) &&
+        clip_path.conservativelyContainsRect(inner_bounds)) {
+      return ForRect(path_bounds, clip_behavior, children_bounds, matrix);
+    }
+  }
+  ClipAnalysis analysis(Type::kPath, clip_behavior);
+  analysis.rect_ = clip_path.getBounds();
+  analysis.path_ = clip_path;
+  return analysis;
+}
+
+void ClipAnalysis::MergeClipOfOnlyChild(
+    const std::vector<std::shared_ptr<Layer>>& layers) {
+  if (layers.size() != 1) {
+    return;
+  }
+  ClipAnalysis* child = layers[0]->GetClipAnalysis();
+  if (child == nullptr || type_ != Type::kRect || child->type_ != Type::kRect ||
+      anti_alias_ != child->anti_alias_ || uses_save_layer_ ||
+      child->uses_save_layer_) {
+    return;
+  }
+  if (!rect_.intersect(child->rect_)) {
+    rect_.setEmpty();
+  }
+  *child = ClipAnalysis();
+}
+
+SkIRect ClipAnalysis::ClipDeviceBounds(const SkIRect& bounds,
+                                       const SkMatrix& matrix) const {
+  switch (type_) {
+    case Type::kNone:
+      return bounds;
+    case Type::kRect: {
+      SkIRect clipped_bounds = bounds;
+      if (!clipped_bounds.intersect(Layer::MapOpaqueRect(matrix, rect_))) {
+        return SkIRect::MakeEmpty();
+      }
+      return clipped_bounds;
+    }
+    case Type::kRRect:
+    case Type::kPath:
+      return SkIRect::MakeEmpty();
+  }
+  return SkIRect::MakeEmpty();
+}
+
+void ClipAnalysis::Apply(SkCanvas* canvas) const {
+  switch (type_) {
+    case Type::kNone:
+      break;
+    case Type::kRect:
+      canvas->clipRect(rect_, anti_alias_);
+      break;
+    case Type::kRRect:
+      canvas->clipRRect(rrect_, anti_alias_);
+      break;
+    case Type::kPath:
+      canvas->clipPath(path_, anti_alias_);
+      break;
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_CLIP_ANALYSIS_H_
+#define FLUTTER_FLOW_LAYERS_CLIP_ANALYSIS_H_
+
+#include "flutter/flow/layers/layer.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The cheapest clip that has the same effect on the children of a
+///             clip layer as the clip of the layer, determined during Preroll
+///             from the paint bounds of the children.
+///
+///             A clip that contains the children is skipped along with its
+///             save layer. Paths and rounded rects that the children only
+///             cross along straight edges are reduced to rects, and
+///             anti-aliased rects that fall on pixel boundaries are clipped
+///             with hard edges and without a save layer since there is
+///             nothing to anti-alias.
+///
+class ClipAnalysis {
+ public:
+  enum class Type { kNone, kRect, kRRect, kPath };
+
+  ClipAnalysis() = default;
+
+  static ClipAnalysis ForRect(const SkRect& clip_rect,
+                              Clip clip_behavior,
+                              const SkRect& children_bounds,
+                              const SkMatrix& matrix);
+
+  static ClipAnalysis ForRRect(const SkRRect& clip_rrect,
+                               Clip clip_behavior,
+                               const SkRect& children_bounds,
+                               const SkMatrix& matrix);
+
+  static ClipAnalysis ForPath(const SkPath& clip_path,
+                              Clip clip_behavior,
+                              const SkRect& children_bounds,
+                              const SkMatrix& matrix);
+
+  Type type() const { return type_; }
+
+  const SkRect& rect() const { return rect_; }
+
+  bool anti_alias() const { return anti_alias_; }
+
+  bool uses_save_layer() const { return uses_save_layer_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      If the layer has a single child that is a clip layer,
+  ///             intersects this rect clip with the rect clip of the child,
+  ///             which then no longer needs to clip. Does nothing unless both
+  ///             clips are rects that are either both anti-aliased or both
+  ///             hard edged and neither uses a save layer. The rects may
+  ///             differ. Where the anti-aliased edges of both clips cover
+  ///             part of the same pixel, the merged clip covers it by the
+  ///             smaller of the two coverages rather than their product.
+  ///
+  void MergeClipOfOnlyChild(const std::vector<std::shared_ptr<Layer>>& layers);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the device pixels of |bounds| that are inside the
+  ///             clip, with |matrix| being the matrix of the clip. The result
+  ///             is empty for clips that aren't rects.
+  ///
+  SkIRect ClipDeviceBounds(const SkIRect& bounds, const SkMatrix& matrix) const;
+
+  void Apply(SkCanvas* canvas) const;
+
+ private:
+  Type type_ = Type::kNone;
+  SkRect rect_ = SkRect::MakeEmpty();
+  SkRRect rrect_;
+  SkPath path_;
+  bool anti_alias_ = false;
+  bool uses_save_layer_ = false;
+
+  ClipAnalysis(Type type, Clip clip_behavior);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_CLIP_ANALYSIS_H_
@@ -20,7 +20,12 @@ ClipPathLayer::ClipPathLayer(const SkPath& clip_path, Clip clip_behavior)
 void ClipPathLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   TRACE_EVENT0("flutter", "ClipPathLayer::Preroll");
 
+  context->content_signature.Add(
+      static_cast<uint64_t>(clip_path_.getGenerationID()));
+  context->content_signature.Add(static_cast<uint64_t>(clip_behavior_));
+  context->content_signature.Add(matrix);
   SkRect previous_cull_rect = context->cull_rect;
+  clip_analysis_ = ClipAnalysis();
   SkRect clip_path_bounds = clip_path_.getBounds();
   children_inside_clip_ = context->cull_rect.intersect(clip_path_bounds);
   if (children_inside_clip_) {
@@ -31,6 +36,11 @@ void ClipPathLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
     context->mutators_stack.PushClipPath(clip_path_);
     SkRect child_paint_bounds = SkRect::MakeEmpty();
     PrerollChildren(context, matrix, &child_paint_bounds);
+    clip_analysis_ = ClipAnalysis::ForPath(clip_path_, clip_behavior_,
+                                           child_paint_bounds, matrix);
+    clip_analysis_.MergeClipOfOnlyChild(layers());
+    set_opaque_device_bounds(
+        clip_analysis_.ClipDeviceBounds(opaque_device_bounds(), matrix));
 
     if (child_paint_bounds.intersect(clip_path_bounds)) {
       set_paint_bounds(child_paint_bounds);
@@ -62,15 +72,20 @@ void ClipPathLayer::Paint(PaintContext& context) const {
     return;
   }
 
+  if (clip_analysis_.type() == ClipAnalysis::Type::kNone) {
+    TRACE_EVENT_INSTANT0("flutter", "children inside clip, skipping clip");
+    PaintChildren(context);
+    return;
+  }
+
   SkAutoCanvasRestore save(context.internal_nodes_canvas, true);
-  context.internal_nodes_canvas->clipPath(clip_path_,
-                                          clip_behavior_ != Clip::hardEdge);
+  clip_analysis_.Apply(context.internal_nodes_canvas);
 
-  if (UsesSaveLayer()) {
+  if (clip_analysis_.uses_save_layer()) {
     context.internal_nodes_canvas->saveLayer(paint_bounds(), nullptr);
   }
   PaintChildren(context);
-  if (UsesSaveLayer()) {
+  if (clip_analysis_.uses_save_layer()) {
     context.internal_nodes_canvas->restore();
   }
 }
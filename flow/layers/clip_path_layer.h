@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_LAYERS_CLIP_PATH_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_CLIP_PATH_LAYER_H_
 
+#include "flutter/flow/layers/clip_analysis.h"
 #include "flutter/flow/layers/container_layer.h"
 
 namespace flutter {
@@ -16,11 +17,14 @@ class ClipPathLayer : public ContainerLayer {
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
+  const char* type_name() const override { return "ClipPathLayer"; }
 
   bool UsesSaveLayer() const {
     return clip_behavior_ == Clip::antiAliasWithSaveLayer;
   }
 
+  ClipAnalysis* GetClipAnalysis() override { return &clip_analysis_; }
+
 #if defined(OS_FUCHSIA)
   void UpdateScene(SceneUpdateContext& context) override;
 #endif  // defined(OS_FUCHSIA)
@@ -29,6 +33,7 @@ class ClipPathLayer : public ContainerLayer {
   SkPath clip_path_;
   Clip clip_behavior_;
   bool children_inside_clip_ = false;
+  ClipAnalysis clip_analysis_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ClipPathLayer);
 };
@@ -137,17 +137,11 @@ TEST_F(ClipPathLayerTest, FullyContainedChild) {
   EXPECT_EQ(mock_layer->parent_matrix(), initial_matrix);
   EXPECT_EQ(mock_layer->parent_mutators(), std::vector({Mutator(layer_path)}));
 
+  // The clip contains the child, so it is skipped.
   layer->Paint(paint_context());
-  EXPECT_EQ(
-      mock_canvas().draw_calls(),
-      std::vector(
-          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
-           MockCanvas::DrawCall{
-               1, MockCanvas::ClipRectData{layer_bounds, SkClipOp::kIntersect,
-                                           MockCanvas::kHard_ClipEdgeStyle}},
-           MockCanvas::DrawCall{
-               1, MockCanvas::DrawPathData{child_path, child_paint}},
-           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+  EXPECT_EQ(mock_canvas().draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                0, MockCanvas::DrawPathData{child_path, child_paint}}}));
 }
 
 TEST_F(ClipPathLayerTest, PartiallyContainedChild) {
@@ -192,6 +186,46 @@ TEST_F(ClipPathLayerTest, PartiallyContainedChild) {
            MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
 }
 
+TEST_F(ClipPathLayerTest, SkipsClipAndSaveLayerContainingChild) {
+  const SkPath layer_path = SkPath().addOval(SkRect::MakeWH(100.0f, 100.0f));
+  const SkPath child_path =
+      SkPath().addRect(SkRect::MakeLTRB(30.0f, 30.0f, 70.0f, 70.0f));
+  const SkPaint child_paint = SkPaint(SkColors::kYellow);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto layer = std::make_shared<ClipPathLayer>(layer_path,
+                                               Clip::antiAliasWithSaveLayer);
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                0, MockCanvas::DrawPathData{child_path, child_paint}}}));
+}
+
+TEST_F(ClipPathLayerTest, SkipsClipOfPathContainingChild) {
+  // A rect with a notch cut into its top left corner.
+  const SkPath layer_path = SkPath()
+                                .moveTo(10.0f, 0.0f)
+                                .lineTo(100.0f, 0.0f)
+                                .lineTo(100.0f, 100.0f)
+                                .lineTo(0.0f, 100.0f)
+                                .lineTo(0.0f, 10.0f)
+                                .close();
+  const SkPath child_path =
+      SkPath().addRect(SkRect::MakeLTRB(30.0f, 30.0f, 70.0f, 70.0f));
+  const SkPaint child_paint = SkPaint(SkColors::kYellow);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto layer = std::make_shared<ClipPathLayer>(layer_path, Clip::antiAlias);
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                0, MockCanvas::DrawPathData{child_path, child_paint}}}));
+}
+
 static bool ReadbackResult(PrerollContext* context,
                            Clip clip_behavior,
                            std::shared_ptr<Layer> child,
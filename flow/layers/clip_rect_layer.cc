@@ -14,7 +14,11 @@ ClipRectLayer::ClipRectLayer(const SkRect& clip_rect, Clip clip_behavior)
 void ClipRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   TRACE_EVENT0("flutter", "ClipRectLayer::Preroll");
 
+  context->content_signature.Add(clip_rect_);
+  context->content_signature.Add(static_cast<uint64_t>(clip_behavior_));
+  context->content_signature.Add(matrix);
   SkRect previous_cull_rect = context->cull_rect;
+  clip_analysis_ = ClipAnalysis();
   children_inside_clip_ = context->cull_rect.intersect(clip_rect_);
   if (children_inside_clip_) {
     TRACE_EVENT_INSTANT0("flutter", "children inside clip rect");
@@ -24,6 +28,11 @@ void ClipRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
     context->mutators_stack.PushClipRect(clip_rect_);
     SkRect child_paint_bounds = SkRect::MakeEmpty();
     PrerollChildren(context, matrix, &child_paint_bounds);
+    clip_analysis_ = ClipAnalysis::ForRect(clip_rect_, clip_behavior_,
+                                           child_paint_bounds, matrix);
+    clip_analysis_.MergeClipOfOnlyChild(layers());
+    set_opaque_device_bounds(
+        clip_analysis_.ClipDeviceBounds(opaque_device_bounds(), matrix));
 
     if (child_paint_bounds.intersect(clip_rect_)) {
       set_paint_bounds(child_paint_bounds);
@@ -55,15 +64,20 @@ void ClipRectLayer::Paint(PaintContext& context) const {
     return;
   }
 
+  if (clip_analysis_.type() == ClipAnalysis::Type::kNone) {
+    TRACE_EVENT_INSTANT0("flutter", "children inside clip, skipping clip");
+    PaintChildren(context);
+    return;
+  }
+
   SkAutoCanvasRestore save(context.internal_nodes_canvas, true);
-  context.internal_nodes_canvas->clipRect(clip_rect_,
-                                          clip_behavior_ != Clip::hardEdge);
+  clip_analysis_.Apply(context.internal_nodes_canvas);
 
-  if (UsesSaveLayer()) {
+  if (clip_analysis_.uses_save_layer()) {
     context.internal_nodes_canvas->saveLayer(clip_rect_, nullptr);
   }
   PaintChildren(context);
-  if (UsesSaveLayer()) {
+  if (clip_analysis_.uses_save_layer()) {
     context.internal_nodes_canvas->restore();
   }
 }
@@ -135,17 +135,11 @@ TEST_F(ClipRectLayerTest, FullyContainedChild) {
   EXPECT_EQ(mock_layer->parent_mutators(),
             std::vector({Mutator(layer_bounds)}));
 
+  // The clip contains the child, so it is skipped.
   layer->Paint(paint_context());
-  EXPECT_EQ(
-      mock_canvas().draw_calls(),
-      std::vector(
-          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
-           MockCanvas::DrawCall{
-               1, MockCanvas::ClipRectData{layer_bounds, SkClipOp::kIntersect,
-                                           MockCanvas::kHard_ClipEdgeStyle}},
-           MockCanvas::DrawCall{
-               1, MockCanvas::DrawPathData{child_path, child_paint}},
-           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+  EXPECT_EQ(mock_canvas().draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                0, MockCanvas::DrawPathData{child_path, child_paint}}}));
 }
 
 TEST_F(ClipRectLayerTest, PartiallyContainedChild) {
@@ -190,6 +184,89 @@ TEST_F(ClipRectLayerTest, PartiallyContainedChild) {
            MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
 }
 
+TEST_F(ClipRectLayerTest, MergesNestedClips) {
+  const SkRect outer_bounds = SkRect::MakeLTRB(0.0f, 0.0f, 10.0f, 10.0f);
+  const SkRect inner_bounds = SkRect::MakeLTRB(5.0f, 5.0f, 20.0f, 20.0f);
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(30.0f, 30.0f));
+  const SkPaint child_paint = SkPaint(SkColors::kYellow);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto inner = std::make_shared<ClipRectLayer>(inner_bounds, Clip::hardEdge);
+  auto outer = std::make_shared<ClipRectLayer>(outer_bounds, Clip::hardEdge);
+  inner->Add(mock_layer);
+  outer->Add(inner);
+
+  outer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(outer->paint_bounds(), SkRect::MakeLTRB(5.0f, 5.0f, 10.0f, 10.0f));
+
+  // The outer layer applies both clips at once.
+  outer->Paint(paint_context());
+  EXPECT_EQ(
+      mock_canvas().draw_calls(),
+      std::vector(
+          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::ClipRectData{
+                      SkRect::MakeLTRB(5.0f, 5.0f, 10.0f, 10.0f),
+                      SkClipOp::kIntersect, MockCanvas::kHard_ClipEdgeStyle}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::DrawPathData{child_path, child_paint}},
+           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+}
+
+TEST_F(ClipRectLayerTest, MergesNestedAntiAliasedClips) {
+  const SkRect outer_bounds = SkRect::MakeLTRB(0.5f, 0.5f, 10.5f, 10.5f);
+  const SkRect inner_bounds = SkRect::MakeLTRB(5.5f, 5.5f, 20.5f, 20.5f);
+  const SkRect merged_bounds = SkRect::MakeLTRB(5.5f, 5.5f, 10.5f, 10.5f);
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(30.0f, 30.0f));
+  const SkPaint child_paint = SkPaint(SkColors::kYellow);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto inner = std::make_shared<ClipRectLayer>(inner_bounds, Clip::antiAlias);
+  auto outer = std::make_shared<ClipRectLayer>(outer_bounds, Clip::antiAlias);
+  inner->Add(mock_layer);
+  outer->Add(inner);
+
+  outer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(outer->paint_bounds(), merged_bounds);
+
+  // The rects differ, so the outer layer clips to their intersection.
+  outer->Paint(paint_context());
+  EXPECT_EQ(
+      mock_canvas().draw_calls(),
+      std::vector(
+          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::ClipRectData{merged_bounds, SkClipOp::kIntersect,
+                                           MockCanvas::kSoft_ClipEdgeStyle}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::DrawPathData{child_path, child_paint}},
+           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+}
+
+TEST_F(ClipRectLayerTest, PixelAlignedClipSkipsSaveLayer) {
+  const SkRect layer_bounds = SkRect::MakeLTRB(0.5f, 1.0f, 10.5f, 11.0f);
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(30.0f, 30.0f));
+  const SkPaint child_paint = SkPaint(SkColors::kYellow);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto layer = std::make_shared<ClipRectLayer>(layer_bounds,
+                                               Clip::antiAliasWithSaveLayer);
+  layer->Add(mock_layer);
+
+  // The translation puts the clip on pixel boundaries, so there is nothing to
+  // anti-alias.
+  layer->Preroll(preroll_context(), SkMatrix::MakeTrans(0.5f, 0.0f));
+  layer->Paint(paint_context());
+  EXPECT_EQ(
+      mock_canvas().draw_calls(),
+      std::vector(
+          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::ClipRectData{layer_bounds, SkClipOp::kIntersect,
+                                           MockCanvas::kHard_ClipEdgeStyle}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::DrawPathData{child_path, child_paint}},
+           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+}
+
 static bool ReadbackResult(PrerollContext* context,
                            Clip clip_behavior,
                            std::shared_ptr<Layer> child,
@@ -140,17 +140,11 @@ TEST_F(ClipRRectLayerTest, FullyContainedChild) {
   EXPECT_EQ(mock_layer->parent_matrix(), initial_matrix);
   EXPECT_EQ(mock_layer->parent_mutators(), std::vector({Mutator(layer_rrect)}));
 
+  // The clip contains the child, so it is skipped.
   layer->Paint(paint_context());
-  EXPECT_EQ(
-      mock_canvas().draw_calls(),
-      std::vector(
-          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
-           MockCanvas::DrawCall{
-               1, MockCanvas::ClipRectData{layer_bounds, SkClipOp::kIntersect,
-                                           MockCanvas::kHard_ClipEdgeStyle}},
-           MockCanvas::DrawCall{
-               1, MockCanvas::DrawPathData{child_path, child_paint}},
-           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+  EXPECT_EQ(mock_canvas().draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                0, MockCanvas::DrawPathData{child_path, child_paint}}}));
 }
 
 TEST_F(ClipRRectLayerTest, PartiallyContainedChild) {
@@ -195,6 +189,55 @@ TEST_F(ClipRRectLayerTest, PartiallyContainedChild) {
            MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
 }
 
+TEST_F(ClipRRectLayerTest, ReducesToRectClipWhenCornersAreNotReached) {
+  const SkRect layer_bounds = SkRect::MakeWH(100.0f, 100.0f);
+  const SkRRect layer_rrect = SkRRect::MakeRectXY(layer_bounds, 10.0f, 10.0f);
+  // Crosses the top and bottom edges, away from the corners.
+  const SkPath child_path =
+      SkPath().addRect(SkRect::MakeLTRB(20.0f, -10.0f, 80.0f, 110.0f));
+  const SkPaint child_paint = SkPaint(SkColors::kYellow);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto layer = std::make_shared<ClipRRectLayer>(layer_rrect, Clip::hardEdge);
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  layer->Paint(paint_context());
+  EXPECT_EQ(
+      mock_canvas().draw_calls(),
+      std::vector(
+          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::ClipRectData{layer_bounds, SkClipOp::kIntersect,
+                                           MockCanvas::kHard_ClipEdgeStyle}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::DrawPathData{child_path, child_paint}},
+           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+}
+
+TEST_F(ClipRRectLayerTest, KeepsRRectClipWhenCornersAreReached) {
+  const SkRect layer_bounds = SkRect::MakeWH(100.0f, 100.0f);
+  const SkRRect layer_rrect = SkRRect::MakeRectXY(layer_bounds, 10.0f, 10.0f);
+  const SkPath child_path =
+      SkPath().addRect(SkRect::MakeLTRB(-10.0f, -10.0f, 80.0f, 80.0f));
+  const SkPaint child_paint = SkPaint(SkColors::kYellow);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto layer = std::make_shared<ClipRRectLayer>(layer_rrect, Clip::hardEdge);
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  layer->Paint(paint_context());
+  EXPECT_EQ(
+      mock_canvas().draw_calls(),
+      std::vector(
+          {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::ClipRRectData{layer_rrect, SkClipOp::kIntersect,
+                                            MockCanvas::kHard_ClipEdgeStyle}},
+           MockCanvas::DrawCall{
+               1, MockCanvas::DrawPathData{child_path, child_paint}},
+           MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
+}
+
 static bool ReadbackResult(PrerollContext* context,
                            Clip clip_behavior,
                            std::shared_ptr<Layer> child,
@@ -11,9 +11,22 @@ ColorFilterLayer::ColorFilterLayer(sk_sp<SkColorFilter> filter)
 
 void ColorFilterLayer::Preroll(PrerollContext* context,
                                const SkMatrix& matrix) {
+  context->content_signature.Add(unique_id());
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
   ContainerLayer::Preroll(context, matrix);
+  // The filter may make the opaque content of the children translucent.
+  set_opaque_device_bounds(SkIRect::MakeEmpty());
+
+  if (SkRect::Intersects(context->cull_rect, paint_bounds())) {
+    SkMatrix ctm = matrix;
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+    ctm = RasterCache::GetIntegralTransCTM(ctm);
+#endif
+    // The children are cached without the filter so that an animated filter
+    // is applied to the same image on every frame.
+    PrepareChildrenForRasterCache(context, ctm);
+  }
 }
 
 void ColorFilterLayer::Paint(PaintContext& context) const {
@@ -23,9 +36,13 @@ void ColorFilterLayer::Paint(PaintContext& context) const {
   SkPaint paint;
   paint.setColorFilter(filter_);
 
+  if (DrawCachedLayer(context, GetCacheableChild(), &paint)) {
+    return;
+  }
+
   Layer::AutoSaveLayer save =
       Layer::AutoSaveLayer::Create(context, paint_bounds(), &paint);
-  PaintChildren(context);
+  PaintChildrenWithRasterCache(context);
 }
 
 }  // namespace flutter
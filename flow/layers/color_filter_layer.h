@@ -11,13 +11,14 @@
 
 namespace flutter {
 
-class ColorFilterLayer : public ContainerLayer {
+class ColorFilterLayer : public MergedContainerLayer {
  public:
   ColorFilterLayer(sk_sp<SkColorFilter> filter);
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
+  const char* type_name() const override { return "ColorFilterLayer"; }
 
  private:
   sk_sp<SkColorFilter> filter_;
@@ -214,5 +214,21 @@ TEST_F(ColorFilterLayerTest, Readback) {
   EXPECT_FALSE(preroll_context()->surface_needs_readback);
 }
 
+TEST_F(ColorFilterLayerTest, CachesRetainedChild) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  RasterCache raster_cache;
+  preroll_context()->raster_cache = &raster_cache;
+
+  auto layer = std::make_shared<ColorFilterLayer>(
+      SkColorMatrixFilter::MakeLightingFilter(SK_ColorGREEN, SK_ColorYELLOW));
+  layer->Add(mock_layer);
+  EXPECT_EQ(layer->GetCacheableChild(), mock_layer.get());
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(raster_cache.Get(mock_layer.get(), SkMatrix()).is_valid());
+  EXPECT_FALSE(raster_cache.Get(layer.get(), SkMatrix()).is_valid());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,8 +4,37 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/flow/layer_profiler.h"
+
 namespace flutter {
 
+namespace {
+
+// Returns a rect of pixels that are covered by either |a| or |b|: their union
+// if it is a rect, the larger of the two otherwise.
+SkIRect JoinOpaqueBounds(const SkIRect& a, const SkIRect& b) {
+  if (b.isEmpty() || a.contains(b)) {
+    return a;
+  }
+  if (a.isEmpty() || b.contains(a)) {
+    return b;
+  }
+  const bool same_columns = a.left() == b.left() && a.right() == b.right() &&
+                            a.top() <= b.bottom() && b.top() <= a.bottom();
+  const bool same_rows = a.top() == b.top() && a.bottom() == b.bottom() &&
+                         a.left() <= b.right() && b.left() <= a.right();
+  if (same_columns || same_rows) {
+    SkIRect joined = a;
+    joined.join(b);
+    return joined;
+  }
+  const int64_t a_area = static_cast<int64_t>(a.width()) * a.height();
+  const int64_t b_area = static_cast<int64_t>(b.width()) * b.height();
+  return a_area >= b_area ? a : b;
+}
+
+}  // namespace
+
 ContainerLayer::ContainerLayer() {}
 
 void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
@@ -32,14 +61,28 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   // Platform views have no children, so context->has_platform_view should
   // always be false.
   FML_DCHECK(!context->has_platform_view);
+  // Together with what each layer adds, this makes the signatures of
+  // different trees differ.
+  context->content_signature.Add(static_cast<uint64_t>(layers_.size()));
   bool child_has_platform_view = false;
+  bool child_has_texture_layer = false;
+  const bool surface_needs_readback = context->surface_needs_readback;
+  bool child_needs_readback = false;
   for (auto& layer : layers_) {
     // Reset context->has_platform_view to false so that layers aren't treated
     // as if they have a platform view based on one being previously found in a
     // sibling tree.
     context->has_platform_view = false;
+    context->has_texture_layer = false;
+    context->surface_needs_readback = false;
+    layer->set_is_occluded(false);
+    layer->set_opaque_device_bounds(SkIRect::MakeEmpty());
 
     layer->Preroll(context, child_matrix);
+    layer->set_subtree_has_platform_view(context->has_platform_view);
+    layer->set_subtree_reads_surface(context->surface_needs_readback);
+    child_needs_readback =
+        child_needs_readback || context->surface_needs_readback;
 
     if (layer->needs_system_composite()) {
       set_needs_system_composite(true);
@@ -48,9 +91,54 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
 
     child_has_platform_view =
         child_has_platform_view || context->has_platform_view;
+    child_has_texture_layer =
+        child_has_texture_layer || context->has_texture_layer;
   }
 
   context->has_platform_view = child_has_platform_view;
+  context->has_texture_layer = child_has_texture_layer;
+  context->surface_needs_readback =
+      surface_needs_readback || child_needs_readback;
+
+  CullOccludedChildren(child_matrix);
+}
+
+void ContainerLayer::CullOccludedChildren(const SkMatrix& child_matrix) {
+  // Walk the children from the top down, collecting the pixels covered by
+  // opaque content painted after each child.
+  SkIRect covered = SkIRect::MakeEmpty();
+  SkIRect opaque_bounds = SkIRect::MakeEmpty();
+  for (auto it = layers_.rbegin(); it != layers_.rend(); ++it) {
+    Layer* layer = it->get();
+    // Platform views and system composited layers aren't painted in order
+    // with their siblings, so they neither occlude nor get occluded.
+    if (layer->subtree_has_platform_view() ||
+        layer->needs_system_composite()) {
+      covered.setEmpty();
+      continue;
+    }
+    if (!layer->needs_painting()) {
+      continue;
+    }
+    if (!covered.isEmpty() &&
+        covered.contains(child_matrix.mapRect(layer->paint_bounds())
+                             .roundOut())) {
+      TRACE_EVENT_INSTANT0("flutter", "layer occluded, skipping paint");
+      layer->set_is_occluded(true);
+      continue;
+    }
+    // What was painted before a layer that reads it back is visible through
+    // that layer, even where the layer is opaque. A blur samples the pixels
+    // near the edges of the area it covers.
+    if (layer->subtree_reads_surface()) {
+      covered.setEmpty();
+      continue;
+    }
+    covered = JoinOpaqueBounds(covered, layer->opaque_device_bounds());
+    opaque_bounds = JoinOpaqueBounds(opaque_bounds,
+                                     layer->opaque_device_bounds());
+  }
+  set_opaque_device_bounds(opaque_bounds);
 }
 
 void ContainerLayer::PaintChildren(PaintContext& context) const {
@@ -60,6 +148,90 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   // and the trace event on this common function has a small overhead.
   for (auto& layer : layers_) {
     if (layer->needs_painting()) {
+      AutoProfileScope profile(context, layer.get());
+      layer->Paint(context);
+    }
+  }
+}
+
+MergedContainerLayer::MergedContainerLayer() {
+  // Any children will actually be added as children of this empty
+  // ContainerLayer.
+  ContainerLayer::Add(std::make_shared<ContainerLayer>());
+}
+
+void MergedContainerLayer::Add(std::shared_ptr<Layer> layer) {
+  GetChildContainer()->Add(std::move(layer));
+}
+
+ContainerLayer* MergedContainerLayer::GetChildContainer() const {
+  FML_DCHECK(layers().size() == 1);
+
+  return static_cast<ContainerLayer*>(layers()[0].get());
+}
+
+Layer* MergedContainerLayer::GetCacheableChild() const {
+  ContainerLayer* child_container = GetChildContainer();
+  if (child_container->layers().size() == 1) {
+    return child_container->layers()[0].get();
+  }
+  return child_container;
+}
+
+void MergedContainerLayer::PrepareChildrenForRasterCache(
+    PrerollContext* context,
+    const SkMatrix& ctm) {
+  // Textures get new frames without the layer tree changing, which a cached
+  // image wouldn't show.
+  if (!context->raster_cache || context->has_texture_layer) {
+    return;
+  }
+
+  if (!context->has_platform_view) {
+    context->raster_cache->Prepare(context, GetCacheableChild(), ctm);
+    return;
+  }
+
+  for (auto& layer : GetChildContainer()->layers()) {
+    if (!layer->subtree_has_platform_view() && layer->needs_painting()) {
+      context->raster_cache->Prepare(context, layer.get(), ctm);
+    }
+  }
+}
+
+bool MergedContainerLayer::DrawCachedLayer(PaintContext& context,
+                                           Layer* layer,
+                                           const SkPaint* paint) const {
+  if (!context.raster_cache || layer->subtree_has_platform_view()) {
+    return false;
+  }
+
+  SkCanvas* canvas = context.leaf_nodes_canvas;
+  SkMatrix ctm = canvas->getTotalMatrix();
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+  ctm = RasterCache::GetIntegralTransCTM(ctm);
+#endif
+  RasterCacheResult layer_cache = context.raster_cache->Get(layer, ctm);
+  if (!layer_cache.is_valid()) {
+    return false;
+  }
+
+  SkAutoCanvasRestore save(canvas, true);
+  canvas->setMatrix(ctm);
+  layer_cache.draw(*canvas, paint);
+  return true;
+}
+
+void MergedContainerLayer::PaintChildrenWithRasterCache(
+    PaintContext& context) const {
+  FML_DCHECK(needs_painting());
+
+  for (auto& layer : GetChildContainer()->layers()) {
+    if (!layer->needs_painting()) {
+      continue;
+    }
+    AutoProfileScope profile(context, layer.get());
+    if (!DrawCachedLayer(context, layer.get(), nullptr)) {
       layer->Paint(context);
     }
   }
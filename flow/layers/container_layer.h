@@ -18,6 +18,7 @@ class ContainerLayer : public Layer {
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) const override;
+  const char* type_name() const override { return "ContainerLayer"; }
 #if defined(OS_FUCHSIA)
   void UpdateScene(SceneUpdateContext& context) override;
 #endif  // defined(OS_FUCHSIA)
@@ -40,9 +41,58 @@ class ContainerLayer : public Layer {
  private:
   std::vector<std::shared_ptr<Layer>> layers_;
 
+  // Marks the children that are hidden behind the opaque content of the
+  // children painted after them, and sets the opaque device bounds of this
+  // layer to those of its children. Called at the end of |PrerollChildren|.
+  void CullOccludedChildren(const SkMatrix& child_matrix);
+
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
 
+// A container that applies an effect, like an opacity or a filter, to the
+// output of its children. The effect is usually animated while the children
+// stay the same, so the children are cached in the raster cache and drawn with
+// the effect applied instead of being painted into a saveLayer every frame.
+//
+// The raster cache is keyed by the unique id of a layer. The framework creates
+// a new effect layer every frame of an animation but retains its child, so the
+// children are collected into an implicit child |ContainerLayer| and, when
+// there is a single child, that child is the one cached since its id is
+// stable.
+class MergedContainerLayer : public ContainerLayer {
+ public:
+  MergedContainerLayer();
+
+  void Add(std::shared_ptr<Layer> layer) override;
+
+  ContainerLayer* GetChildContainer() const;
+
+  // The layer whose output is cached: the only child if there is one, the
+  // implicit child container otherwise.
+  Layer* GetCacheableChild() const;
+
+ protected:
+  // Prepares the raster cache entries of the children. The cacheable child is
+  // cached as a whole unless its subtree has a platform view, which can't be
+  // drawn into the cache. In that case each child without a platform view is
+  // cached on its own. Nothing is cached if the subtree has a texture layer.
+  void PrepareChildrenForRasterCache(PrerollContext* context,
+                                     const SkMatrix& ctm);
+
+  // Draws the cached output of |layer| with |paint|. Returns false if it isn't
+  // cached, in which case nothing is drawn.
+  bool DrawCachedLayer(PaintContext& context,
+                       Layer* layer,
+                       const SkPaint* paint) const;
+
+  // Paints the children, drawing the ones that are cached from the raster
+  // cache.
+  void PaintChildrenWithRasterCache(PaintContext& context) const;
+
+ private:
+  FML_DISALLOW_COPY_AND_ASSIGN(MergedContainerLayer);
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_FLOW_LAYERS_CONTAINER_LAYER_H_
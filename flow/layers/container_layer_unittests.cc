@@ -4,10 +4,12 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/flow/layers/backdrop_filter_layer.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
+#include "third_party/skia/include/effects/SkImageFilters.h"
 
 namespace flutter {
 namespace testing {
@@ -198,5 +200,144 @@ TEST_F(ContainerLayerTest, NeedsSystemComposite) {
                                                child_path2, child_paint2}}}));
 }
 
+TEST_F(ContainerLayerTest, OccludedChildrenAreNotPainted) {
+  SkPath child_path1;
+  child_path1.addRect(10.0f, 10.0f, 20.0f, 20.0f);
+  SkPath child_path2;
+  child_path2.addRect(0.0f, 0.0f, 50.0f, 50.0f);
+  SkPaint child_paint1(SkColors::kGray);
+  SkPaint child_paint2(SkColors::kGreen);
+
+  auto mock_layer1 = std::make_shared<MockLayer>(child_path1, child_paint1);
+  auto mock_layer2 = std::make_shared<MockLayer>(
+      child_path2, child_paint2, false /* fake_has_platform_view */,
+      false /* fake_needs_system_composite */,
+      false /* fake_reads_surface */, true /* fake_opaque */);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(mock_layer1->is_occluded());
+  EXPECT_FALSE(mock_layer1->needs_painting());
+  EXPECT_FALSE(mock_layer2->is_occluded());
+  EXPECT_EQ(layer->paint_bounds(), child_path2.getBounds());
+  EXPECT_EQ(layer->opaque_device_bounds(), SkIRect::MakeLTRB(0, 0, 50, 50));
+
+  layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                0, MockCanvas::DrawPathData{child_path2, child_paint2}}}));
+}
+
+TEST_F(ContainerLayerTest, OnlyWholePixelsOcclude) {
+  SkPath child_path1;
+  child_path1.addRect(10.0f, 10.0f, 20.0f, 20.0f);
+  SkPath child_path2;
+  child_path2.addRect(0.5f, 0.5f, 20.0f, 20.0f);
+  SkPath child_path3;
+  child_path3.addRect(0.5f, 0.5f, 50.5f, 50.5f);
+  SkPaint child_paint(SkColors::kGreen);
+
+  auto mock_layer1 = std::make_shared<MockLayer>(child_path1, child_paint);
+  auto mock_layer2 = std::make_shared<MockLayer>(child_path2, child_paint);
+  auto mock_layer3 = std::make_shared<MockLayer>(
+      child_path3, child_paint, false /* fake_has_platform_view */,
+      false /* fake_needs_system_composite */,
+      false /* fake_reads_surface */, true /* fake_opaque */);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+  layer->Add(mock_layer3);
+
+  // The anti-aliased edges of the last child don't hide the second child.
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(mock_layer1->is_occluded());
+  EXPECT_FALSE(mock_layer2->is_occluded());
+  EXPECT_EQ(layer->opaque_device_bounds(), SkIRect::MakeLTRB(1, 1, 50, 50));
+}
+
+TEST_F(ContainerLayerTest, ChildrenSeenThroughReadbackAreNotOccluded) {
+  SkPath child_path1;
+  child_path1.addRect(10.0f, 10.0f, 20.0f, 20.0f);
+  SkPath child_path2;
+  child_path2.addRect(0.0f, 0.0f, 100.0f, 100.0f);
+  SkPath child_path3;
+  child_path3.addRect(0.0f, 0.0f, 50.0f, 50.0f);
+  SkPaint child_paint(SkColors::kGreen);
+
+  auto mock_layer1 = std::make_shared<MockLayer>(child_path1, child_paint);
+  auto mock_layer2 = std::make_shared<MockLayer>(
+      child_path2, child_paint, false /* fake_has_platform_view */,
+      false /* fake_needs_system_composite */, true /* fake_reads_surface */);
+  auto mock_layer3 = std::make_shared<MockLayer>(
+      child_path3, child_paint, false /* fake_has_platform_view */,
+      false /* fake_needs_system_composite */,
+      false /* fake_reads_surface */, true /* fake_opaque */);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+  layer->Add(mock_layer3);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(preroll_context()->surface_needs_readback);
+  EXPECT_TRUE(mock_layer2->subtree_reads_surface());
+  EXPECT_FALSE(mock_layer1->is_occluded());
+  EXPECT_FALSE(mock_layer2->is_occluded());
+
+  layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls().size(), 3u);
+}
+
+TEST_F(ContainerLayerTest, ChildrenUnderOpaqueBlurredBackdropsAreNotOccluded) {
+  SkPath child_path1;
+  child_path1.addRect(10.0f, 10.0f, 20.0f, 20.0f);
+  SkPath child_path2;
+  child_path2.addRect(0.0f, 0.0f, 50.0f, 50.0f);
+  SkPaint child_paint(SkColors::kGreen);
+
+  auto mock_layer1 = std::make_shared<MockLayer>(child_path1, child_paint);
+  auto mock_layer2 = std::make_shared<MockLayer>(
+      child_path2, child_paint, false /* fake_has_platform_view */,
+      false /* fake_needs_system_composite */,
+      false /* fake_reads_surface */, true /* fake_opaque */);
+  auto backdrop_layer = std::make_shared<BackdropFilterLayer>(
+      SkImageFilters::Blur(5.0f, 5.0f, nullptr), SkVector::Make(5.0f, 5.0f));
+  backdrop_layer->Add(mock_layer2);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(backdrop_layer);
+
+  // The blur samples the first child even though the second child paints
+  // over it.
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(backdrop_layer->subtree_reads_surface());
+  EXPECT_FALSE(mock_layer1->is_occluded());
+  EXPECT_TRUE(mock_layer1->needs_painting());
+  EXPECT_TRUE(layer->opaque_device_bounds().isEmpty());
+}
+
+TEST_F(ContainerLayerTest, PlatformViewsAreNotOccluded) {
+  SkPath child_path1;
+  child_path1.addRect(10.0f, 10.0f, 20.0f, 20.0f);
+  SkPath child_path2;
+  child_path2.addRect(0.0f, 0.0f, 50.0f, 50.0f);
+  SkPaint child_paint(SkColors::kGreen);
+
+  auto mock_layer1 = std::make_shared<MockLayer>(
+      child_path1, child_paint, true /* fake_has_platform_view */);
+  auto mock_layer2 = std::make_shared<MockLayer>(
+      child_path2, child_paint, false /* fake_has_platform_view */,
+      false /* fake_needs_system_composite */,
+      false /* fake_reads_surface */, true /* fake_opaque */);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_FALSE(mock_layer1->is_occluded());
+  EXPECT_TRUE(mock_layer1->needs_painting());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -11,17 +11,33 @@ ImageFilterLayer::ImageFilterLayer(sk_sp<SkImageFilter> filter)
 
 void ImageFilterLayer::Preroll(PrerollContext* context,
                                const SkMatrix& matrix) {
+  context->content_signature.Add(unique_id());
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
   ContainerLayer::Preroll(context, matrix);
+  // The filter may make the opaque content of the children translucent.
+  set_opaque_device_bounds(SkIRect::MakeEmpty());
 
-  if (!context->has_platform_view && context->raster_cache &&
+  if (context->raster_cache &&
       SkRect::Intersects(context->cull_rect, paint_bounds())) {
     SkMatrix ctm = matrix;
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
     ctm = RasterCache::GetIntegralTransCTM(ctm);
 #endif
-    context->raster_cache->Prepare(context, this, ctm);
+    render_count_++;
+    const bool cacheable =
+        !context->has_platform_view && !context->has_texture_layer;
+    if (cacheable && render_count_ >= kMinimumRendersBeforeCachingFilterLayer) {
+      // The layer has been retained, so the filter is stable and applying it
+      // once is cheaper than on every frame.
+      context->raster_cache->Prepare(context, this, ctm);
+    } else {
+      if (cacheable) {
+        // The preroll of later frames must run for the layer to be cached.
+        context->raster_cache->MarkLayerPending();
+      }
+      PrepareChildrenForRasterCache(context, ctm);
+    }
   }
 }
 
@@ -43,6 +59,17 @@ void ImageFilterLayer::Paint(PaintContext& context) const {
       layer_cache.draw(*context.leaf_nodes_canvas);
       return;
     }
+
+    // The cached children are drawn without the canvas matrix, so the filter
+    // is given the matrix to apply its parameters in the coordinates of the
+    // layer.
+    SkPaint child_paint;
+    if (filter_) {
+      child_paint.setImageFilter(filter_->makeWithLocalMatrix(ctm));
+    }
+    if (DrawCachedLayer(context, GetCacheableChild(), &child_paint)) {
+      return;
+    }
   }
 
   SkPaint paint;
@@ -50,7 +77,7 @@ void ImageFilterLayer::Paint(PaintContext& context) const {
 
   Layer::AutoSaveLayer save_layer =
       Layer::AutoSaveLayer::Create(context, paint_bounds(), &paint);
-  PaintChildren(context);
+  PaintChildrenWithRasterCache(context);
 }
 
 }  // namespace flutter
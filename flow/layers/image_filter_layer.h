@@ -11,16 +11,23 @@
 
 namespace flutter {
 
-class ImageFilterLayer : public ContainerLayer {
+class ImageFilterLayer : public MergedContainerLayer {
  public:
   ImageFilterLayer(sk_sp<SkImageFilter> filter);
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
+  const char* type_name() const override { return "ImageFilterLayer"; }
 
  private:
+  // The number of frames this layer must be prerolled before its filtered
+  // output is cached. Until then only the children are cached, since the
+  // framework creates a new layer every frame while the filter is animated.
+  static constexpr int kMinimumRendersBeforeCachingFilterLayer = 3;
+
   sk_sp<SkImageFilter> filter_;
+  int render_count_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ImageFilterLayer);
 };
@@ -232,5 +232,46 @@ TEST_F(ImageFilterLayerTest, Readback) {
   EXPECT_FALSE(preroll_context()->surface_needs_readback);
 }
 
+TEST_F(ImageFilterLayerTest, CachesChildrenUntilLayerIsRetained) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto layer_filter = SkImageFilter::MakeMatrixFilter(
+      SkMatrix(), SkFilterQuality::kMedium_SkFilterQuality, nullptr);
+  RasterCache raster_cache;
+  preroll_context()->raster_cache = &raster_cache;
+
+  auto layer = std::make_shared<ImageFilterLayer>(layer_filter);
+  layer->Add(mock_layer);
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(raster_cache.Get(mock_layer.get(), SkMatrix()).is_valid());
+  EXPECT_FALSE(raster_cache.Get(layer.get(), SkMatrix()).is_valid());
+
+  // Once the layer itself has been retained its filtered output is cached.
+  layer->Preroll(preroll_context(), SkMatrix());
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(raster_cache.Get(layer.get(), SkMatrix()).is_valid());
+}
+
+TEST_F(ImageFilterLayerTest, IsPendingUntilLayerIsCached) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto layer_filter = SkImageFilter::MakeMatrixFilter(
+      SkMatrix(), SkFilterQuality::kMedium_SkFilterQuality, nullptr);
+  RasterCache raster_cache;
+  preroll_context()->raster_cache = &raster_cache;
+
+  auto layer = std::make_shared<ImageFilterLayer>(layer_filter);
+  layer->Add(mock_layer);
+  for (int frame = 1; frame < 3; frame++) {
+    layer->Preroll(preroll_context(), SkMatrix());
+    EXPECT_EQ(raster_cache.GetPendingEntriesThisFrame(), 1u);
+    raster_cache.SweepAfterFrame();
+  }
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(raster_cache.Get(layer.get(), SkMatrix()).is_valid());
+  EXPECT_EQ(raster_cache.GetPendingEntriesThisFrame(), 0u);
+}
+
 }  // namespace testing
 }  // namespace flutter
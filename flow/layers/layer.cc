@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/layer.h"
 
+#include "flutter/flow/layer_profiler.h"
 #include "flutter/flow/paint_utils.h"
 #include "third_party/skia/include/core/SkColorFilter.h"
 
@@ -11,8 +12,12 @@ namespace flutter {
 
 Layer::Layer()
     : paint_bounds_(SkRect::MakeEmpty()),
+      opaque_device_bounds_(SkIRect::MakeEmpty()),
       unique_id_(NextUniqueID()),
-      needs_system_composite_(false) {}
+      needs_system_composite_(false),
+      subtree_has_platform_view_(false),
+      subtree_reads_surface_(false),
+      is_occluded_(false) {}
 
 Layer::~Layer() = default;
 
@@ -25,7 +30,24 @@ uint64_t Layer::NextUniqueID() {
   return id;
 }
 
-void Layer::Preroll(PrerollContext* context, const SkMatrix& matrix) {}
+void Layer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  // Layers that don't describe what they paint may paint anything.
+  context->content_signature.MarkVolatile();
+}
+
+SkIRect Layer::MapOpaqueRect(const SkMatrix& matrix, const SkRect& rect) {
+  if (!matrix.rectStaysRect()) {
+    return SkIRect::MakeEmpty();
+  }
+  // Only the pixels inside the edges are fully covered when the edges are
+  // anti-aliased.
+  SkIRect device_rect;
+  matrix.mapRect(rect).roundIn(&device_rect);
+  if (device_rect.isEmpty()) {
+    return SkIRect::MakeEmpty();
+  }
+  return device_rect;
+}
 
 Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
     PrerollContext* preroll_context,
@@ -37,6 +59,7 @@ Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
   if (save_layer_is_active_) {
     prev_surface_needs_readback_ = preroll_context_->surface_needs_readback;
     preroll_context_->surface_needs_readback = false;
+    preroll_context_->save_layer_depth++;
   }
 }
 
@@ -52,6 +75,7 @@ Layer::AutoPrerollSaveLayerState::~AutoPrerollSaveLayerState() {
   if (save_layer_is_active_) {
     preroll_context_->surface_needs_readback =
         (prev_surface_needs_readback_ || layer_itself_performs_readback_);
+    preroll_context_->save_layer_depth--;
   }
 }
 
@@ -92,4 +116,33 @@ Layer::AutoSaveLayer::~AutoSaveLayer() {
   paint_context_.internal_nodes_canvas->restore();
 }
 
+Layer::AutoProfileScope::AutoProfileScope(const PaintContext& paint_context,
+                                          const Layer* layer)
+    : paint_context_(paint_context) {
+  if (!paint_context_.layer_profiler) {
+    return;
+  }
+
+  SkCanvas* canvas = paint_context_.leaf_nodes_canvas;
+  SkRect device_bounds;
+  canvas->getTotalMatrix().mapRect(&device_bounds, layer->paint_bounds());
+  SkIRect pixels = device_bounds.roundOut();
+  if (!pixels.intersect(canvas->getDeviceClipBounds())) {
+    pixels.setEmpty();
+  }
+  paint_context_.layer_profiler->PushLayer(
+      layer, static_cast<uint64_t>(pixels.width()) * pixels.height());
+}
+
+Layer::AutoProfileScope::~AutoProfileScope() {
+  if (!paint_context_.layer_profiler) {
+    return;
+  }
+
+  // Submit the GPU commands of layers without children so they are
+  // attributed to them.
+  paint_context_.layer_profiler->PopLayer(
+      paint_context_.gr_context ? paint_context_.leaf_nodes_canvas : nullptr);
+}
+
 }  // namespace flutter
@@ -8,6 +8,7 @@
 #include <memory>
 #include <vector>
 
+#include "flutter/flow/content_signature.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/instrumentation.h"
 #include "flutter/flow/raster_cache.h"
@@ -39,6 +40,9 @@ namespace flutter {
 
 static constexpr SkRect kGiantRect = SkRect::MakeLTRB(-1E9F, -1E9F, 1E9F, 1E9F);
 
+class ClipAnalysis;
+class LayerProfiler;
+
 // This should be an exact copy of the Clip enum in painting.dart.
 enum Clip { none, hardEdge, antiAlias, antiAliasWithSaveLayer };
 
@@ -62,10 +66,22 @@ struct PrerollContext {
   float frame_device_pixel_ratio;
 
   // These allow us to track properties like elevation, opacity, and the
-  // prescence of a platform view during Preroll.
+  // prescence of a platform view or a texture during Preroll.
   float total_elevation = 0.0f;
   bool has_platform_view = false;
+  bool has_texture_layer = false;
   bool is_opaque = true;
+
+  // These allow layers that read back what was painted before them to tell
+  // whether it changed since the last frame. The signature covers the layers
+  // prerolled so far, and the depth counts the save layers they are in.
+  ContentSignature content_signature;
+  int save_layer_depth = 0;
+
+  // Whether what was painted before a layer can be read back from the
+  // surface. When it can't, a frame that reads back is painted into a save
+  // layer, and the surface doesn't hold what was painted so far.
+  bool surface_supports_readback = false;
 };
 
 // Represents a single composited layer. Created on the UI thread but then
@@ -127,6 +143,9 @@ class Layer {
     // These allow us to make use of the scene metrics during Paint.
     float frame_physical_depth;
     float frame_device_pixel_ratio;
+
+    // Set when the layers painted are profiled. See |LayerProfiler|.
+    LayerProfiler* layer_profiler = nullptr;
   };
 
   // Calls SkCanvas::saveLayer and restores the layer upon destruction. Also
@@ -156,6 +175,21 @@ class Layer {
     const SkRect bounds_;
   };
 
+  // Measures the painting of |layer| with the |LayerProfiler| of the
+  // PaintContext from construction to destruction. Does nothing if the
+  // PaintContext has no profiler.
+  class AutoProfileScope {
+   public:
+    AutoProfileScope(const PaintContext& paint_context, const Layer* layer);
+
+    ~AutoProfileScope();
+
+   private:
+    const PaintContext& paint_context_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(AutoProfileScope);
+  };
+
   virtual void Paint(PaintContext& context) const = 0;
 
 #if defined(OS_FUCHSIA)
@@ -176,14 +210,59 @@ class Layer {
     paint_bounds_ = paint_bounds;
   }
 
-  bool needs_painting() const { return !paint_bounds_.isEmpty(); }
+  bool needs_painting() const {
+    return !paint_bounds_.isEmpty() && !is_occluded_;
+  }
+
+  // The device pixels that this layer covers with opaque content. Layers
+  // painted before this one within those pixels can't be seen. This is set
+  // during Preroll and is empty unless the layer knows it paints opaquely.
+  const SkIRect& opaque_device_bounds() const { return opaque_device_bounds_; }
+  void set_opaque_device_bounds(const SkIRect& bounds) {
+    opaque_device_bounds_ = bounds;
+  }
+
+  // Returns the device pixels that are fully covered when |rect| is filled
+  // with |matrix|. The result is empty if the matrix doesn't keep rects axis
+  // aligned.
+  static SkIRect MapOpaqueRect(const SkMatrix& matrix, const SkRect& rect);
+
+  // Whether this layer is hidden behind the opaque content of the siblings
+  // painted after it, in which case it isn't painted. This is set by the
+  // parent |ContainerLayer| during |Preroll|.
+  bool is_occluded() const { return is_occluded_; }
+  void set_is_occluded(bool value) { is_occluded_ = value; }
+
+  // Whether this layer or one of its descendants is a platform view. This is
+  // set by the parent |ContainerLayer| during |Preroll|.
+  bool subtree_has_platform_view() const { return subtree_has_platform_view_; }
+  void set_subtree_has_platform_view(bool value) {
+    subtree_has_platform_view_ = value;
+  }
+
+  // Whether this layer or one of its descendants reads back what was painted
+  // before it, like a backdrop filter. This is set by the parent
+  // |ContainerLayer| during |Preroll|.
+  bool subtree_reads_surface() const { return subtree_reads_surface_; }
+  void set_subtree_reads_surface(bool value) { subtree_reads_surface_ = value; }
 
   uint64_t unique_id() const { return unique_id_; }
 
+  // The name of the type of the layer, used to label it in profiles.
+  virtual const char* type_name() const { return "Layer"; }
+
+  // The clip that clip layers determined to apply to their children during
+  // Preroll, which a parent clip layer may merge into its own.
+  virtual ClipAnalysis* GetClipAnalysis() { return nullptr; }
+
  private:
   SkRect paint_bounds_;
+  SkIRect opaque_device_bounds_;
   uint64_t unique_id_;
   bool needs_system_composite_;
+  bool subtree_has_platform_view_;
+  bool subtree_reads_surface_;
+  bool is_occluded_;
 
   static uint64_t NextUniqueID();
 
@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/layer_tree.h"
 
+#include "flutter/flow/layer_profiler.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
@@ -21,9 +22,12 @@ LayerTree::LayerTree(const SkISize& frame_size,
       checkerboard_raster_cache_images_(false),
       checkerboard_offscreen_layers_(false) {}
 
-void LayerTree::RecordBuildTime(fml::TimePoint start) {
-  build_start_ = start;
+void LayerTree::RecordBuildTime(fml::TimePoint vsync_start,
+                                fml::TimePoint build_start) {
+  build_start_ = vsync_start;
   build_finish_ = fml::TimePoint::Now();
+  vsync_latency_ = vsync_start < build_start ? build_start - vsync_start
+                                             : fml::TimeDelta::Zero();
 }
 
 bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
@@ -54,11 +58,35 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       checkerboard_offscreen_layers_,
       frame_physical_depth_,
       frame_device_pixel_ratio_};
+  context.surface_supports_readback = frame.surface_supports_readback();
 
   root_layer_->Preroll(&context, frame.root_surface_transformation());
+
+  RasterCache& raster_cache = frame.context().raster_cache();
+  preroll_reusable_ = !ignore_raster_cache && !context.has_platform_view &&
+                      raster_cache.GetPendingEntriesThisFrame() == 0;
+  preroll_needs_readback_ = context.surface_needs_readback;
+  preroll_transformation_ = frame.root_surface_transformation();
+  preroll_surface_supports_readback_ = context.surface_supports_readback;
+  preroll_color_space_ = sk_ref_sp(color_space);
+  preroll_raster_cache_clear_count_ = raster_cache.GetClearCount();
   return context.surface_needs_readback;
 }
 
+bool LayerTree::CanReusePreroll(CompositorContext::ScopedFrame& frame) const {
+  if (!root_layer_ || !preroll_reusable_) {
+    return false;
+  }
+  SkColorSpace* color_space =
+      frame.canvas() ? frame.canvas()->imageInfo().colorSpace() : nullptr;
+  return frame.root_surface_transformation() == preroll_transformation_ &&
+         frame.surface_supports_readback() ==
+             preroll_surface_supports_readback_ &&
+         SkColorSpace::Equals(color_space, preroll_color_space_.get()) &&
+         frame.context().raster_cache().GetClearCount() ==
+             preroll_raster_cache_clear_count_;
+}
+
 #if defined(OS_FUCHSIA)
 void LayerTree::UpdateScene(SceneUpdateContext& context,
                             scenic::ContainerNode& container) {
@@ -113,6 +141,7 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
     }
   }
 
+  LayerProfiler& profiler = frame.context().layer_profiler();
   Layer::PaintContext context = {
       (SkCanvas*)&internal_nodes_canvas,
       frame.canvas(),
@@ -124,10 +153,26 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
       ignore_raster_cache ? nullptr : &frame.context().raster_cache(),
       checkerboard_offscreen_layers_,
       frame_physical_depth_,
-      frame_device_pixel_ratio_};
+      frame_device_pixel_ratio_,
+      profiler.enabled() ? &profiler : nullptr};
 
-  if (root_layer_->needs_painting())
+  if (context.layer_profiler) {
+    context.layer_profiler->BeginFrame(canvas_size);
+  }
+  if (root_layer_->needs_painting()) {
+    Layer::AutoProfileScope profile(context, root_layer_.get());
     root_layer_->Paint(context);
+  }
+  if (context.layer_profiler) {
+    context.layer_profiler->EndFrame();
+  }
+
+  // Pictures painted for the first time were measured, which may make them
+  // worth caching when the tree is prerolled again.
+  if (context.raster_cache &&
+      context.raster_cache->GetPendingEntriesThisFrame() > 0) {
+    preroll_reusable_ = false;
+  }
 }
 
 sk_sp<SkPicture> LayerTree::Flatten(const SkRect& bounds) {
@@ -181,6 +226,9 @@ sk_sp<SkPicture> LayerTree::Flatten(const SkRect& bounds) {
       frame_device_pixel_ratio_  // ratio between logical and physical
   };
 
+  // The layers are prerolled without a raster cache.
+  preroll_reusable_ = false;
+
   // Even if we don't have a root layer, we still need to create an empty
   // picture.
   if (root_layer_) {
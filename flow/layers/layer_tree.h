@@ -13,6 +13,8 @@
 #include "flutter/flow/layers/layer.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkSize.h"
 
@@ -34,6 +36,16 @@ class LayerTree {
   bool Preroll(CompositorContext::ScopedFrame& frame,
                bool ignore_raster_cache = false);
 
+  // Whether the tree can be painted into |frame| again without being
+  // prerolled first, reusing the paint bounds and raster cache entries of its
+  // last preroll. That is the case when the frame is prerolled the same way
+  // and the last preroll left nothing for later frames to do: no platform
+  // views to composite and no content waiting to be raster cached.
+  bool CanReusePreroll(CompositorContext::ScopedFrame& frame) const;
+
+  // What the last call to |Preroll| returned.
+  bool preroll_needs_readback() const { return preroll_needs_readback_; }
+
 #if defined(OS_FUCHSIA)
   void UpdateScene(SceneUpdateContext& context,
                    scenic::ContainerNode& container);
@@ -48,16 +60,22 @@ class LayerTree {
 
   void set_root_layer(std::shared_ptr<Layer> root_layer) {
     root_layer_ = std::move(root_layer);
+    preroll_reusable_ = false;
   }
 
   const SkISize& frame_size() const { return frame_size_; }
   float frame_physical_depth() const { return frame_physical_depth_; }
   float frame_device_pixel_ratio() const { return frame_device_pixel_ratio_; }
 
-  void RecordBuildTime(fml::TimePoint begin_start);
+  // Records that the frame was requested at |vsync_start| and that the UI
+  // thread started building it at |build_start|. The build finishes now.
+  void RecordBuildTime(fml::TimePoint vsync_start, fml::TimePoint build_start);
   fml::TimePoint build_start() const { return build_start_; }
   fml::TimePoint build_finish() const { return build_finish_; }
   fml::TimeDelta build_time() const { return build_finish_ - build_start_; }
+  // The time the UI thread took to start building the frame after the vsync.
+  // Included in |build_time|.
+  fml::TimeDelta vsync_latency() const { return vsync_latency_; }
 
   // The number of frame intervals missed after which the compositor must
   // trace the rasterized picture to a trace file. Specify 0 to disable all
@@ -84,12 +102,21 @@ class LayerTree {
   std::shared_ptr<Layer> root_layer_;
   fml::TimePoint build_start_;
   fml::TimePoint build_finish_;
+  fml::TimeDelta vsync_latency_;
   SkISize frame_size_ = SkISize::MakeEmpty();  // Physical pixels.
   float frame_physical_depth_;
   float frame_device_pixel_ratio_ = 1.0f;  // Logical / Physical pixels ratio.
   uint32_t rasterizer_tracing_threshold_;
   bool checkerboard_raster_cache_images_;
   bool checkerboard_offscreen_layers_;
+  // What the last preroll depended on, for |CanReusePreroll|. Also cleared by
+  // |Paint| when it measures pictures that the next preroll may cache.
+  mutable bool preroll_reusable_ = false;
+  bool preroll_needs_readback_ = false;
+  SkMatrix preroll_transformation_;
+  bool preroll_surface_supports_readback_ = false;
+  sk_sp<SkColorSpace> preroll_color_space_;
+  size_t preroll_raster_cache_clear_count_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(LayerTree);
 };
@@ -6,6 +6,7 @@
 
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/image_filter_layer.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/canvas_test.h"
@@ -30,6 +31,7 @@ class LayerTreeTest : public CanvasTest {
                                                        nullptr)) {}
 
   LayerTree& layer_tree() { return layer_tree_; }
+  CompositorContext& compositor_context() { return compositor_context_; }
   CompositorContext::ScopedFrame& frame() { return *scoped_frame_.get(); }
   const SkMatrix& root_transform() { return root_transform_; }
 
@@ -203,5 +205,74 @@ TEST_F(LayerTreeTest, NeedsSystemComposite) {
                                                child_path2, child_paint2}}}));
 }
 
+TEST_F(LayerTreeTest, ReusesPrerollOfUnchangedTree) {
+  const SkPath child_path = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(std::make_shared<MockLayer>(child_path));
+
+  layer_tree().set_root_layer(layer);
+  EXPECT_FALSE(layer_tree().CanReusePreroll(frame()));
+  layer_tree().Preroll(frame());
+  EXPECT_TRUE(layer_tree().CanReusePreroll(frame()));
+  EXPECT_FALSE(layer_tree().preroll_needs_readback());
+
+  // Frames prerolled another way can't reuse it.
+  const SkMatrix other_transform = SkMatrix::MakeScale(2.0f, 2.0f);
+  auto other_frame = compositor_context().AcquireFrame(
+      nullptr, &mock_canvas(), nullptr, other_transform, false, true, nullptr);
+  EXPECT_FALSE(layer_tree().CanReusePreroll(*other_frame));
+  compositor_context().raster_cache().Clear();
+  EXPECT_FALSE(layer_tree().CanReusePreroll(frame()));
+
+  layer_tree().Preroll(frame());
+  EXPECT_TRUE(layer_tree().CanReusePreroll(frame()));
+  layer_tree().Preroll(frame(), true /* ignore_raster_cache */);
+  EXPECT_FALSE(layer_tree().CanReusePreroll(frame()));
+
+  layer_tree().Preroll(frame());
+  layer_tree().set_root_layer(std::make_shared<ContainerLayer>());
+  EXPECT_FALSE(layer_tree().CanReusePreroll(frame()));
+}
+
+TEST_F(LayerTreeTest, DoesNotReusePrerollWithPlatformViews) {
+  const SkPath child_path = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(std::make_shared<MockLayer>(child_path, SkPaint(),
+                                         true /* fake_has_platform_view */));
+
+  layer_tree().set_root_layer(layer);
+  layer_tree().Preroll(frame());
+  EXPECT_FALSE(layer_tree().CanReusePreroll(frame()));
+}
+
+TEST_F(LayerTreeTest, DoesNotReusePrerollOfLayersWaitingToBeCached) {
+  const SkPath child_path = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto layer = std::make_shared<ImageFilterLayer>(
+      SkImageFilter::MakeMatrixFilter(
+          SkMatrix(), SkFilterQuality::kMedium_SkFilterQuality, nullptr));
+  layer->Add(std::make_shared<MockLayer>(child_path));
+
+  // The filter layer is only cached once it has been prerolled in a few
+  // frames.
+  layer_tree().set_root_layer(layer);
+  layer_tree().Preroll(frame());
+  EXPECT_FALSE(layer_tree().CanReusePreroll(frame()));
+}
+
+TEST_F(LayerTreeTest, ResetsRasterPhaseDurations) {
+  const SkPath child_path = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(std::make_shared<MockLayer>(child_path));
+
+  layer_tree().set_root_layer(layer);
+  EXPECT_EQ(frame().Raster(layer_tree(), false), RasterStatus::kSuccess);
+
+  compositor_context().ResetRasterPhaseDurations();
+  const auto& durations = compositor_context().last_raster_phase_durations();
+  EXPECT_EQ(durations.preroll, fml::TimeDelta::Zero());
+  EXPECT_EQ(durations.paint, fml::TimeDelta::Zero());
+  EXPECT_EQ(durations.raster_cache, fml::TimeDelta::Zero());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -15,20 +15,7 @@ namespace flutter {
 constexpr float kOpacityElevationWhenUsingSystemCompositor = 0.01f;
 
 OpacityLayer::OpacityLayer(SkAlpha alpha, const SkPoint& offset)
-    : alpha_(alpha), offset_(offset) {
-  // Ensure OpacityLayer has only one direct child.
-  //
-  // This is needed to ensure that retained rendering can always be applied to
-  // save the costly saveLayer.
-  //
-  // Any children will be actually added as children of this empty
-  // ContainerLayer.
-  ContainerLayer::Add(std::make_shared<ContainerLayer>());
-}
-
-void OpacityLayer::Add(std::shared_ptr<Layer> layer) {
-  GetChildContainer()->Add(std::move(layer));
-}
+    : alpha_(alpha), offset_(offset) {}
 
 void OpacityLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   TRACE_EVENT0("flutter", "OpacityLayer::Preroll");
@@ -36,6 +23,7 @@ void OpacityLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   ContainerLayer* container = GetChildContainer();
   FML_DCHECK(!container->layers().empty());  // OpacityLayer can't be a leaf.
 
+  context->content_signature.Add(static_cast<uint64_t>(alpha_));
   const bool parent_is_opaque = context->is_opaque;
   SkMatrix child_matrix = matrix;
   child_matrix.postTranslate(offset_.fX, offset_.fY);
@@ -49,6 +37,9 @@ void OpacityLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
   ContainerLayer::Preroll(context, child_matrix);
+  if (alpha_ != SK_AlphaOPAQUE) {
+    set_opaque_device_bounds(SkIRect::MakeEmpty());
+  }
   context->mutators_stack.Pop();
   context->mutators_stack.Pop();
   context->is_opaque = parent_is_opaque;
@@ -65,13 +56,14 @@ void OpacityLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 #endif
   {
     set_paint_bounds(paint_bounds().makeOffset(offset_.fX, offset_.fY));
-    if (!context->has_platform_view && context->raster_cache &&
-        SkRect::Intersects(context->cull_rect, paint_bounds())) {
+    if (SkRect::Intersects(context->cull_rect, paint_bounds())) {
       SkMatrix ctm = child_matrix;
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
       ctm = RasterCache::GetIntegralTransCTM(ctm);
 #endif
-      context->raster_cache->Prepare(context, container, ctm);
+      // The children are cached without the opacity so that the same image is
+      // drawn with the new alpha on every frame of a fade.
+      PrepareChildrenForRasterCache(context, ctm);
     }
   }
 }
@@ -91,14 +83,8 @@ void OpacityLayer::Paint(PaintContext& context) const {
       context.leaf_nodes_canvas->getTotalMatrix()));
 #endif
 
-  if (context.raster_cache) {
-    ContainerLayer* container = GetChildContainer();
-    const SkMatrix& ctm = context.leaf_nodes_canvas->getTotalMatrix();
-    RasterCacheResult child_cache = context.raster_cache->Get(container, ctm);
-    if (child_cache.is_valid()) {
-      child_cache.draw(*context.leaf_nodes_canvas, &paint);
-      return;
-    }
+  if (DrawCachedLayer(context, GetCacheableChild(), &paint)) {
+    return;
   }
 
   // Skia may clip the content with saveLayerBounds (although it's not a
@@ -107,9 +93,9 @@ void OpacityLayer::Paint(PaintContext& context) const {
   // matrix. Then we round out the bounds because of our
   // RasterCache::GetIntegralTransCTM optimization.
   //
-  // Note that the following lines are only accessible when the raster cache is
-  // not available (e.g., when we're using the software backend in golden
-  // tests).
+  // Note that the following lines are only accessible when the children are
+  // not cached as a whole (e.g., when there is a platform view in the subtree
+  // or when we're using the software backend in golden tests).
   SkRect saveLayerBounds;
   paint_bounds()
       .makeOffset(-offset_.fX, -offset_.fY)
@@ -117,7 +103,7 @@ void OpacityLayer::Paint(PaintContext& context) const {
 
   Layer::AutoSaveLayer save_layer =
       Layer::AutoSaveLayer::Create(context, saveLayerBounds, &paint);
-  PaintChildren(context);
+  PaintChildrenWithRasterCache(context);
 }
 
 #if defined(OS_FUCHSIA)
@@ -157,10 +143,4 @@ void OpacityLayer::UpdateScene(SceneUpdateContext& context) {
 
 #endif  // defined(OS_FUCHSIA)
 
-ContainerLayer* OpacityLayer::GetChildContainer() const {
-  FML_DCHECK(layers().size() == 1);
-
-  return static_cast<ContainerLayer*>(layers()[0].get());
-}
-
 }  // namespace flutter
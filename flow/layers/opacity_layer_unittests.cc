@@ -327,5 +327,50 @@ TEST_F(OpacityLayerTest, Readback) {
   EXPECT_FALSE(preroll_context()->surface_needs_readback);
 }
 
+TEST_F(OpacityLayerTest, CachesRetainedChildAcrossFrames) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  RasterCache raster_cache;
+  preroll_context()->raster_cache = &raster_cache;
+
+  // The framework creates a new OpacityLayer on every frame of a fade but
+  // retains its child.
+  auto layer1 = std::make_shared<OpacityLayer>(0x80, SkPoint());
+  layer1->Add(mock_layer);
+  layer1->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(raster_cache.Get(mock_layer.get(), SkMatrix()).is_valid());
+  EXPECT_EQ(raster_cache.GetCachedEntriesCount(), 1u);
+  raster_cache.SweepAfterFrame();
+
+  auto layer2 = std::make_shared<OpacityLayer>(0x40, SkPoint());
+  layer2->Add(mock_layer);
+  layer2->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(raster_cache.Get(mock_layer.get(), SkMatrix()).is_valid());
+  EXPECT_EQ(raster_cache.GetCachedEntriesCount(), 1u);
+  EXPECT_EQ(raster_cache.GetRasterizeTimeThisFrame(), fml::TimeDelta::Zero());
+}
+
+TEST_F(OpacityLayerTest, CachesChildrenWithoutPlatformViews) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto platform_view_layer =
+      std::make_shared<MockLayer>(child_path, SkPaint(), true);
+  RasterCache raster_cache;
+  preroll_context()->raster_cache = &raster_cache;
+
+  auto layer = std::make_shared<OpacityLayer>(0x80, SkPoint());
+  layer->Add(mock_layer);
+  layer->Add(platform_view_layer);
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(preroll_context()->has_platform_view);
+  EXPECT_FALSE(mock_layer->subtree_has_platform_view());
+  EXPECT_TRUE(platform_view_layer->subtree_has_platform_view());
+  EXPECT_TRUE(raster_cache.Get(mock_layer.get(), SkMatrix()).is_valid());
+  EXPECT_FALSE(
+      raster_cache.Get(platform_view_layer.get(), SkMatrix()).is_valid());
+  EXPECT_FALSE(
+      raster_cache.Get(layer->GetCacheableChild(), SkMatrix()).is_valid());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -30,6 +30,7 @@ class PerformanceOverlayLayer : public Layer {
                                    const char* font_path = nullptr);
 
   void Paint(PaintContext& context) const override;
+  const char* type_name() const override { return "PerformanceOverlayLayer"; }
 
  private:
   int options_;
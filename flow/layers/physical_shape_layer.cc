@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/physical_shape_layer.h"
 
+#include <algorithm>
+
 #include "flutter/flow/paint_utils.h"
 #include "third_party/skia/include/utils/SkShadowUtils.h"
 
@@ -12,6 +14,32 @@ namespace flutter {
 const SkScalar kLightHeight = 600;
 const SkScalar kLightRadius = 800;
 
+namespace {
+
+SkScalar GetArea(const SkRect& rect) {
+  return rect.isEmpty() ? 0 : rect.width() * rect.height();
+}
+
+// Returns the larger of the rects inside |rrect| that span its full width or
+// its full height.
+SkRect GetInnerRect(const SkRRect& rrect) {
+  const SkRect& rect = rrect.rect();
+  const SkVector upper_left = rrect.radii(SkRRect::kUpperLeft_Corner);
+  const SkVector upper_right = rrect.radii(SkRRect::kUpperRight_Corner);
+  const SkVector lower_right = rrect.radii(SkRRect::kLowerRight_Corner);
+  const SkVector lower_left = rrect.radii(SkRRect::kLowerLeft_Corner);
+  const SkRect wide = SkRect::MakeLTRB(
+      rect.left(), rect.top() + std::max(upper_left.y(), upper_right.y()),
+      rect.right(), rect.bottom() - std::max(lower_left.y(), lower_right.y()));
+  const SkRect tall = SkRect::MakeLTRB(
+      rect.left() + std::max(upper_left.x(), lower_left.x()), rect.top(),
+      rect.right() - std::max(upper_right.x(), lower_right.x()), rect.bottom());
+  const SkRect& inner_rect = GetArea(wide) >= GetArea(tall) ? wide : tall;
+  return inner_rect.isEmpty() ? SkRect::MakeEmpty() : inner_rect;
+}
+
+}  // namespace
+
 PhysicalShapeLayer::PhysicalShapeLayer(SkColor color,
                                        SkColor shadow_color,
                                        float elevation,
@@ -22,6 +50,7 @@ PhysicalShapeLayer::PhysicalShapeLayer(SkColor color,
       elevation_(elevation),
       path_(path),
       isRect_(false),
+      isRRect_(true),
       clip_behavior_(clip_behavior) {
   SkRect rect;
   if (path.isRect(&rect)) {
@@ -34,6 +63,7 @@ PhysicalShapeLayer::PhysicalShapeLayer(SkColor color,
     // as well.
     frameRRect_ = SkRRect::MakeOval(rect);
   } else {
+    isRRect_ = false;
     // Scenic currently doesn't provide an easy way to create shapes from
     // arbitrary paths.
     // For shapes that cannot be represented as a rounded rectangle we
@@ -50,12 +80,30 @@ void PhysicalShapeLayer::Preroll(PrerollContext* context,
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context, UsesSaveLayer());
 
+  ContentSignature& signature = context->content_signature;
+  signature.Add(static_cast<uint64_t>(path_.getGenerationID()));
+  signature.Add(static_cast<uint64_t>(color_));
+  signature.Add(static_cast<uint64_t>(shadow_color_));
+  signature.Add(static_cast<uint64_t>(clip_behavior_));
+  signature.Add(elevation_);
+  signature.Add(context->frame_device_pixel_ratio);
+  signature.Add(matrix);
+
   context->total_elevation += elevation_;
   total_elevation_ = context->total_elevation;
   SkRect child_paint_bounds;
   PrerollChildren(context, matrix, &child_paint_bounds);
   context->total_elevation -= elevation_;
 
+  // The children are painted over the shape, so only the shape is known to
+  // cover what is painted before it.
+  SkIRect opaque_bounds = SkIRect::MakeEmpty();
+  if (SkColorGetA(color_) == SK_AlphaOPAQUE && isRRect_) {
+    opaque_bounds = MapOpaqueRect(
+        matrix, isRect_ ? frameRRect_.rect() : GetInnerRect(frameRRect_));
+  }
+  set_opaque_device_bounds(opaque_bounds);
+
   if (elevation_ == 0) {
     set_paint_bounds(path_.getBounds());
   } else {
@@ -68,10 +116,71 @@ void PhysicalShapeLayer::Preroll(PrerollContext* context,
     // children to it so we don't need to join the child paint bounds.
     set_paint_bounds(ComputeShadowBounds(path_.getBounds(), elevation_,
                                          context->frame_device_pixel_ratio));
+    PrepareShadowForRasterCache(context, matrix);
 #endif  // defined(OS_FUCHSIA)
   }
 }
 
+ShadowRasterCacheKey PhysicalShapeLayer::GetShadowCacheKey(
+    const SkMatrix& ctm,
+    float device_pixel_ratio) const {
+  return ShadowRasterCacheKey(path_, shadow_color_, elevation_,
+                              SkColorGetA(color_) != 0xff, device_pixel_ratio,
+                              ctm);
+}
+
+void PhysicalShapeLayer::PrepareShadowForRasterCache(PrerollContext* context,
+                                                     const SkMatrix& matrix) {
+  if (!context->raster_cache ||
+      !SkRect::Intersects(context->cull_rect, paint_bounds())) {
+    return;
+  }
+
+  // Skia draws the shadows of rects, rounded rects and ovals analytically on
+  // the GPU, which is cheaper than drawing a cached image of them.
+  if (context->gr_context && isRRect_ && matrix.isSimilarity()) {
+    return;
+  }
+
+  SkMatrix ctm = matrix;
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+  ctm = RasterCache::GetIntegralTransCTM(ctm);
+#endif
+  const float dpr = context->frame_device_pixel_ratio;
+  context->raster_cache->Prepare(
+      context->gr_context, GetShadowCacheKey(ctm, dpr), paint_bounds(),
+      context->dst_color_space, [this, &ctm, dpr](SkCanvas* canvas) {
+        const SkMatrix& cache_matrix = canvas->getTotalMatrix();
+        const SkVector light_offset = SkVector::Make(
+            cache_matrix.getTranslateX() - ctm.getTranslateX(),
+            cache_matrix.getTranslateY() - ctm.getTranslateY());
+        DrawShadow(canvas, path_, shadow_color_, elevation_,
+                   SkColorGetA(color_) != 0xff, dpr, light_offset);
+      });
+}
+
+bool PhysicalShapeLayer::DrawCachedShadow(PaintContext& context) const {
+  if (!context.raster_cache) {
+    return false;
+  }
+
+  SkCanvas* canvas = context.leaf_nodes_canvas;
+  SkMatrix ctm = canvas->getTotalMatrix();
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+  ctm = RasterCache::GetIntegralTransCTM(ctm);
+#endif
+  RasterCacheResult shadow_cache = context.raster_cache->Get(
+      GetShadowCacheKey(ctm, context.frame_device_pixel_ratio));
+  if (!shadow_cache.is_valid()) {
+    return false;
+  }
+
+  SkAutoCanvasRestore save(canvas, true);
+  canvas->setMatrix(ctm);
+  shadow_cache.draw(*canvas);
+  return true;
+}
+
 #if defined(OS_FUCHSIA)
 
 void PhysicalShapeLayer::UpdateScene(SceneUpdateContext& context) {
@@ -110,7 +219,7 @@ void PhysicalShapeLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "PhysicalShapeLayer::Paint");
   FML_DCHECK(needs_painting());
 
-  if (elevation_ != 0) {
+  if (elevation_ != 0 && !DrawCachedShadow(context)) {
     DrawShadow(context.leaf_nodes_canvas, path_, shadow_color_, elevation_,
                SkColorGetA(color_) != 0xff, context.frame_device_pixel_ratio);
   }
@@ -201,7 +310,8 @@ void PhysicalShapeLayer::DrawShadow(SkCanvas* canvas,
                                     SkColor color,
                                     float elevation,
                                     bool transparentOccluder,
-                                    SkScalar dpr) {
+                                    SkScalar dpr,
+                                    const SkVector& light_offset) {
   const SkScalar kAmbientAlpha = 0.039f;
   const SkScalar kSpotAlpha = 0.25f;
 
@@ -209,8 +319,8 @@ void PhysicalShapeLayer::DrawShadow(SkCanvas* canvas,
                             ? SkShadowFlags::kTransparentOccluder_ShadowFlag
                             : SkShadowFlags::kNone_ShadowFlag;
   const SkRect& bounds = path.getBounds();
-  SkScalar shadow_x = (bounds.left() + bounds.right()) / 2;
-  SkScalar shadow_y = bounds.top() - 600.0f;
+  SkScalar shadow_x = (bounds.left() + bounds.right()) / 2 + light_offset.x();
+  SkScalar shadow_y = bounds.top() - 600.0f + light_offset.y();
   SkColor inAmbient = SkColorSetA(color, kAmbientAlpha * SkColorGetA(color));
   SkColor inSpot = SkColorSetA(color, kSpotAlpha * SkColorGetA(color));
   SkColor ambientColor, spotColor;
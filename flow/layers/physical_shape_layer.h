@@ -20,16 +20,21 @@ class PhysicalShapeLayer : public ContainerLayer {
   static SkRect ComputeShadowBounds(const SkRect& bounds,
                                     float elevation,
                                     float pixel_ratio);
+  // The light is positioned in device space. |light_offset| moves it when the
+  // shadow is drawn into a canvas whose device space is offset from the one it
+  // will be composited into, like the images of the raster cache.
   static void DrawShadow(SkCanvas* canvas,
                          const SkPath& path,
                          SkColor color,
                          float elevation,
                          bool transparentOccluder,
-                         SkScalar dpr);
+                         SkScalar dpr,
+                         const SkVector& light_offset = SkVector::Make(0, 0));
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
+  const char* type_name() const override { return "PhysicalShapeLayer"; }
 
   bool UsesSaveLayer() const {
     return clip_behavior_ == Clip::antiAliasWithSaveLayer;
@@ -42,12 +47,20 @@ class PhysicalShapeLayer : public ContainerLayer {
   float total_elevation() const { return total_elevation_; }
 
  private:
+  ShadowRasterCacheKey GetShadowCacheKey(const SkMatrix& ctm,
+                                         float device_pixel_ratio) const;
+  void PrepareShadowForRasterCache(PrerollContext* context,
+                                   const SkMatrix& matrix);
+  bool DrawCachedShadow(PaintContext& context) const;
+
   SkColor color_;
   SkColor shadow_color_;
   float elevation_ = 0.0f;
   float total_elevation_ = 0.0f;
   SkPath path_;
   bool isRect_;
+  // Whether the path is a rect, a rounded rect or an oval.
+  bool isRRect_;
   SkRRect frameRRect_;
   Clip clip_behavior_;
 };
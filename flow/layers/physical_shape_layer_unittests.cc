@@ -227,6 +227,47 @@ TEST_F(PhysicalShapeLayerTest, ElevationComplex) {
 #endif
 }
 
+TEST_F(PhysicalShapeLayerTest, OpaqueShapesOccludeLayersBehindThem) {
+  SkPath card_path;
+  card_path.addRRect(
+      SkRRect::MakeRectXY(SkRect::MakeLTRB(0, 0, 100, 100), 10, 10));
+  auto card = std::make_shared<PhysicalShapeLayer>(SK_ColorWHITE, SK_ColorBLACK,
+                                                   0.0f,  // elevation
+                                                   card_path, Clip::none);
+  auto behind_card = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(0, 20, 100, 80)));
+  auto in_corner = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(0, 0, 5, 5)));
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(behind_card);
+  root->Add(in_corner);
+  root->Add(card);
+
+  root->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(card->opaque_device_bounds(), SkIRect::MakeLTRB(0, 10, 100, 90));
+  EXPECT_TRUE(behind_card->is_occluded());
+  // The rounded corners of the card don't cover the corners of its bounds.
+  EXPECT_FALSE(in_corner->is_occluded());
+}
+
+TEST_F(PhysicalShapeLayerTest, TranslucentShapesDontOcclude) {
+  SkPath card_path;
+  card_path.addRect(SkRect::MakeLTRB(0, 0, 100, 100));
+  auto card = std::make_shared<PhysicalShapeLayer>(
+      SkColorSetA(SK_ColorWHITE, 0x80), SK_ColorBLACK,
+      0.0f,  // elevation
+      card_path, Clip::none);
+  auto behind_card = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(20, 20, 80, 80)));
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(behind_card);
+  root->Add(card);
+
+  root->Preroll(preroll_context(), SkMatrix());
+  EXPECT_EQ(card->opaque_device_bounds(), SkIRect::MakeEmpty());
+  EXPECT_FALSE(behind_card->is_occluded());
+}
+
 static bool ReadbackResult(PrerollContext* context,
                            Clip clip_behavior,
                            std::shared_ptr<Layer> child,
@@ -290,5 +331,28 @@ TEST_F(PhysicalShapeLayerTest, Readback) {
   EXPECT_TRUE(ReadbackResult(context, save_layer, reader, true));
 }
 
+#if !defined(OS_FUCHSIA)
+TEST_F(PhysicalShapeLayerTest, ShadowIsCachedAcrossLayers) {
+  constexpr float elevation = 20.0f;
+  RasterCache raster_cache(2);
+  preroll_context()->raster_cache = &raster_cache;
+
+  // Equal shapes on new layers, as when the framework rebuilds them.
+  for (int frame = 0; frame < 2; frame++) {
+    auto layer = std::make_shared<PhysicalShapeLayer>(
+        SK_ColorGREEN, SK_ColorBLACK, elevation,
+        SkPath().addRect(SkRect::MakeWH(8, 8)), Clip::none);
+    layer->Preroll(preroll_context(), SkMatrix());
+    raster_cache.SweepAfterFrame();
+  }
+  EXPECT_EQ(raster_cache.GetCachedEntriesCount(), 1u);
+  EXPECT_TRUE(raster_cache
+                  .Get(ShadowRasterCacheKey(
+                      SkPath().addRect(SkRect::MakeWH(8, 8)), SK_ColorBLACK,
+                      elevation, false, 1.0f, SkMatrix()))
+                  .is_valid());
+}
+#endif
+
 }  // namespace testing
 }  // namespace flutter
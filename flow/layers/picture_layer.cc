@@ -4,22 +4,28 @@
 
 #include "flutter/flow/layers/picture_layer.h"
 
+#include "flutter/flow/layer_profiler.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 
 namespace flutter {
 
 PictureLayer::PictureLayer(const SkPoint& offset,
-                           SkiaGPUObject<SkPicture> picture,
+                           SkiaGPUObject<DisplayList> display_list,
                            bool is_complex,
                            bool will_change)
     : offset_(offset),
-      picture_(std::move(picture)),
+      display_list_(std::move(display_list)),
       is_complex_(is_complex),
       will_change_(will_change) {}
 
 void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   TRACE_EVENT0("flutter", "PictureLayer::Preroll");
-  SkPicture* sk_picture = picture();
+  DisplayList* list = display_list();
+
+  context->content_signature.Add(static_cast<uint64_t>(list->unique_id()));
+  context->content_signature.Add(offset_);
+  context->content_signature.Add(matrix);
 
   if (auto* cache = context->raster_cache) {
     TRACE_EVENT0("flutter", "PictureLayer::RasterCache (Preroll)");
@@ -29,19 +35,25 @@ void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
     ctm = RasterCache::GetIntegralTransCTM(ctm);
 #endif
-    cache->Prepare(context->gr_context, sk_picture, ctm,
-                   context->dst_color_space, is_complex_, will_change_);
+    cache->Prepare(context->gr_context, list, ctm, context->dst_color_space,
+                   is_complex_, will_change_);
   }
 
-  SkRect bounds = sk_picture->cullRect().makeOffset(offset_.x(), offset_.y());
+  // The bounds of what the operations draw rather than the bounds the picture
+  // was recorded with, which are often the size of the whole screen.
+  SkRect bounds = list->bounds().makeOffset(offset_.x(), offset_.y());
   set_paint_bounds(bounds);
 }
 
 void PictureLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "PictureLayer::Paint");
-  FML_DCHECK(picture_.get());
+  FML_DCHECK(display_list_.get());
   FML_DCHECK(needs_painting());
 
+  if (context.layer_profiler) {
+    context.layer_profiler->RecordPicture(*display_list());
+  }
+
   SkAutoCanvasRestore save(context.leaf_nodes_canvas, true);
   context.leaf_nodes_canvas->translate(offset_.x(), offset_.y());
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
@@ -51,7 +63,7 @@ void PictureLayer::Paint(PaintContext& context) const {
 
   if (context.raster_cache) {
     const SkMatrix& ctm = context.leaf_nodes_canvas->getTotalMatrix();
-    RasterCacheResult result = context.raster_cache->Get(*picture(), ctm);
+    RasterCacheResult result = context.raster_cache->Get(*display_list(), ctm);
     if (result.is_valid()) {
       TRACE_EVENT_INSTANT0("flutter", "raster cache hit");
 
@@ -59,7 +71,24 @@ void PictureLayer::Paint(PaintContext& context) const {
       return;
     }
   }
-  context.leaf_nodes_canvas->drawPicture(picture());
+
+  // Canvases that only record the picture, such as the ones of the overlays
+  // of platform views, don't have pixels. The time it takes to draw into them
+  // says nothing about how long the picture takes to rasterize. On GPU
+  // backends the time is only that of recording the GPU commands, see
+  // |RasterCacheCostModel|. Flushing here would measure the GPU work but
+  // stall every frame that draws pictures which aren't cached.
+  const bool measure_raster_time =
+      context.raster_cache &&
+      context.leaf_nodes_canvas->imageInfo().colorType() !=
+          kUnknown_SkColorType;
+  const auto raster_start = fml::TimePoint::Now();
+  // Only the operations that intersect the clip are drawn.
+  display_list()->Draw(context.leaf_nodes_canvas);
+  if (measure_raster_time) {
+    context.raster_cache->RecordPictureRasterTime(
+        *display_list(), fml::TimePoint::Now() - raster_start);
+  }
 }
 
 }  // namespace flutter
@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "flutter/flow/display_list.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/skia_gpu_object.h"
@@ -16,21 +17,22 @@ namespace flutter {
 class PictureLayer : public Layer {
  public:
   PictureLayer(const SkPoint& offset,
-               SkiaGPUObject<SkPicture> picture,
+               SkiaGPUObject<DisplayList> display_list,
                bool is_complex,
                bool will_change);
 
-  SkPicture* picture() const { return picture_.get().get(); }
+  DisplayList* display_list() const { return display_list_.get().get(); }
 
   void Preroll(PrerollContext* frame, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
+  const char* type_name() const override { return "PictureLayer"; }
 
  private:
   SkPoint offset_;
-  // Even though pictures themselves are not GPU resources, they may reference
-  // images that have a reference to a GPU resource.
-  SkiaGPUObject<SkPicture> picture_;
+  // Even though display lists themselves are not GPU resources, they may
+  // reference images that have a reference to a GPU resource.
+  SkiaGPUObject<DisplayList> display_list_;
   bool is_complex_ = false;
   bool will_change_ = false;
 
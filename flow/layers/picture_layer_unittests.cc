@@ -9,7 +9,6 @@
 #include "flutter/flow/testing/skia_gpu_object_layer_test.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
-#include "third_party/skia/include/core/SkPicture.h"
 
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
 #include "flutter/flow/raster_cache.h"
@@ -20,22 +19,27 @@ namespace testing {
 
 using PictureLayerTest = SkiaGPUObjectLayerTest;
 
+static sk_sp<DisplayList> RecordRect(const SkRect& rect) {
+  DisplayListRecorder recorder(SkRect::MakeWH(100, 100));
+  recorder.drawRect(rect, SkPaint());
+  return recorder.Build();
+}
+
 #ifndef NDEBUG
 TEST_F(PictureLayerTest, PaintBeforePrerollInvalidPictureDies) {
   const SkPoint layer_offset = SkPoint::Make(0.0f, 0.0f);
   auto layer = std::make_shared<PictureLayer>(
-      layer_offset, SkiaGPUObject<SkPicture>(), false, false);
+      layer_offset, SkiaGPUObject<DisplayList>(), false, false);
 
   EXPECT_DEATH_IF_SUPPORTED(layer->Paint(paint_context()),
-                            "picture_\\.get\\(\\)");
+                            "display_list_\\.get\\(\\)");
 }
 
 TEST_F(PictureLayerTest, PaintBeforePreollDies) {
   const SkPoint layer_offset = SkPoint::Make(0.0f, 0.0f);
-  const SkRect picture_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
-  auto mock_picture = SkPicture::MakePlaceholder(picture_bounds);
+  auto display_list = RecordRect(SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f));
   auto layer = std::make_shared<PictureLayer>(
-      layer_offset, SkiaGPUObject(mock_picture, unref_queue()), false, false);
+      layer_offset, SkiaGPUObject(display_list, unref_queue()), false, false);
 
   EXPECT_EQ(layer->paint_bounds(), SkRect::MakeEmpty());
   EXPECT_DEATH_IF_SUPPORTED(layer->Paint(paint_context()),
@@ -44,10 +48,9 @@ TEST_F(PictureLayerTest, PaintBeforePreollDies) {
 
 TEST_F(PictureLayerTest, PaintingEmptyLayerDies) {
   const SkPoint layer_offset = SkPoint::Make(0.0f, 0.0f);
-  const SkRect picture_bounds = SkRect::MakeEmpty();
-  auto mock_picture = SkPicture::MakePlaceholder(picture_bounds);
+  auto display_list = DisplayListRecorder(SkRect::MakeWH(100, 100)).Build();
   auto layer = std::make_shared<PictureLayer>(
-      layer_offset, SkiaGPUObject(mock_picture, unref_queue()), false, false);
+      layer_offset, SkiaGPUObject(display_list, unref_queue()), false, false);
 
   layer->Preroll(preroll_context(), SkMatrix());
   EXPECT_EQ(layer->paint_bounds(), SkRect::MakeEmpty());
@@ -62,7 +65,7 @@ TEST_F(PictureLayerTest, PaintingEmptyLayerDies) {
 TEST_F(PictureLayerTest, InvalidPictureDies) {
   const SkPoint layer_offset = SkPoint::Make(0.0f, 0.0f);
   auto layer = std::make_shared<PictureLayer>(
-      layer_offset, SkiaGPUObject<SkPicture>(), false, false);
+      layer_offset, SkiaGPUObject<DisplayList>(), false, false);
 
   // Crashes reading a nullptr.
   EXPECT_DEATH_IF_SUPPORTED(layer->Preroll(preroll_context(), SkMatrix()), "");
@@ -72,15 +75,17 @@ TEST_F(PictureLayerTest, SimplePicture) {
   const SkPoint layer_offset = SkPoint::Make(1.5f, -0.5f);
   const SkMatrix layer_offset_matrix =
       SkMatrix::MakeTrans(layer_offset.fX, layer_offset.fY);
-  const SkRect picture_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
-  auto mock_picture = SkPicture::MakePlaceholder(picture_bounds);
+  const SkRect rect = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  auto display_list = RecordRect(rect);
   auto layer = std::make_shared<PictureLayer>(
-      layer_offset, SkiaGPUObject(mock_picture, unref_queue()), false, false);
+      layer_offset, SkiaGPUObject(display_list, unref_queue()), false, false);
 
   layer->Preroll(preroll_context(), SkMatrix());
-  EXPECT_EQ(layer->paint_bounds(),
-            picture_bounds.makeOffset(layer_offset.fX, layer_offset.fY));
-  EXPECT_EQ(layer->picture(), mock_picture.get());
+  // The bounds of the rect, outset for anti-aliasing, rather than the bounds
+  // the picture was recorded with.
+  EXPECT_EQ(layer->paint_bounds(), rect.makeOutset(1.0f, 1.0f).makeOffset(
+                                       layer_offset.fX, layer_offset.fY));
+  EXPECT_EQ(layer->display_list(), display_list.get());
   EXPECT_TRUE(layer->needs_painting());
   EXPECT_FALSE(layer->needs_system_composite());
 
@@ -94,9 +99,37 @@ TEST_F(PictureLayerTest, SimplePicture) {
            1, MockCanvas::SetMatrixData{RasterCache::GetIntegralTransCTM(
                   layer_offset_matrix)}},
 #endif
+       MockCanvas::DrawCall{1, MockCanvas::DrawRectData{rect, SkPaint()}},
+       MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}});
+  EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
+}
+
+TEST_F(PictureLayerTest, OnlyDrawsOperationsInTheClip) {
+  DisplayListRecorder recorder(SkRect::MakeWH(200, 100));
+  const SkRect visible_rect = SkRect::MakeLTRB(10, 10, 20, 20);
+  recorder.drawRect(visible_rect, SkPaint());
+  // Outside of the 64x64 mock canvas.
+  recorder.drawRect(SkRect::MakeLTRB(150, 10, 160, 20), SkPaint());
+  const SkPoint layer_offset = SkPoint::Make(2.0f, 2.0f);
+  const SkMatrix layer_offset_matrix =
+      SkMatrix::MakeTrans(layer_offset.fX, layer_offset.fY);
+  auto layer = std::make_shared<PictureLayer>(
+      layer_offset, SkiaGPUObject(recorder.Build(), unref_queue()), false,
+      false);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  layer->Paint(paint_context());
+  auto expected_draw_calls = std::vector(
+      {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+       MockCanvas::DrawCall{1,
+                            MockCanvas::ConcatMatrixData{layer_offset_matrix}},
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
        MockCanvas::DrawCall{
-           1, MockCanvas::DrawPictureData{mock_picture->serialize(), SkPaint(),
-                                          SkMatrix()}},
+           1, MockCanvas::SetMatrixData{RasterCache::GetIntegralTransCTM(
+                  layer_offset_matrix)}},
+#endif
+       MockCanvas::DrawCall{1,
+                            MockCanvas::DrawRectData{visible_rect, SkPaint()}},
        MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}});
   EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
 }
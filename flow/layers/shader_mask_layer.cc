@@ -12,9 +12,12 @@ ShaderMaskLayer::ShaderMaskLayer(sk_sp<SkShader> shader,
     : shader_(shader), mask_rect_(mask_rect), blend_mode_(blend_mode) {}
 
 void ShaderMaskLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  context->content_signature.Add(unique_id());
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context);
   ContainerLayer::Preroll(context, matrix);
+  // The mask may make the opaque content of the children translucent.
+  set_opaque_device_bounds(SkIRect::MakeEmpty());
 }
 
 void ShaderMaskLayer::Paint(PaintContext& context) const {
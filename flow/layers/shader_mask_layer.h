@@ -20,6 +20,7 @@ class ShaderMaskLayer : public ContainerLayer {
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
+  const char* type_name() const override { return "ShaderMaskLayer"; }
 
  private:
   sk_sp<SkShader> shader_;
@@ -16,6 +16,9 @@ TextureLayer::TextureLayer(const SkPoint& offset,
 
 void TextureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   TRACE_EVENT0("flutter", "TextureLayer::Preroll");
+  // Textures get new frames without the layer tree changing.
+  context->content_signature.MarkVolatile();
+  context->has_texture_layer = true;
 
   set_paint_bounds(SkRect::MakeXYWH(offset_.x(), offset_.y(), size_.width(),
                                     size_.height()));
@@ -32,6 +35,11 @@ void TextureLayer::Paint(PaintContext& context) const {
   }
   texture->Paint(*context.leaf_nodes_canvas, paint_bounds(), freeze_,
                  context.gr_context);
+  // New frames of frozen textures aren't shown, so they don't need a frame to
+  // be drawn.
+  if (!freeze_) {
+    context.texture_registry.MarkPainted(texture_id_);
+  }
 }
 
 }  // namespace flutter
@@ -20,6 +20,7 @@ class TextureLayer : public Layer {
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) const override;
+  const char* type_name() const override { return "TextureLayer"; }
 
  private:
   SkPoint offset_;
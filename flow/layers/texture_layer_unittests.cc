@@ -53,5 +53,29 @@ TEST_F(TextureLayerTest, PaintingEmptyLayerDies) {
   EXPECT_EQ(mock_canvas().draw_calls(), std::vector<MockCanvas::DrawCall>());
 }
 
+TEST_F(TextureLayerTest, MarksPaintedTextures) {
+  const SkPoint layer_offset = SkPoint::Make(0.0f, 0.0f);
+  const SkSize layer_size = SkSize::Make(8.0f, 8.0f);
+  const int64_t texture_id = 0;
+  auto mock_texture = std::make_shared<MockTexture>(texture_id);
+  auto layer = std::make_shared<TextureLayer>(layer_offset, layer_size,
+                                              texture_id, false);
+  auto frozen_layer = std::make_shared<TextureLayer>(layer_offset, layer_size,
+                                                     texture_id, true);
+  auto& registry = preroll_context()->texture_registry;
+  registry.RegisterTexture(mock_texture);
+
+  layer->Preroll(preroll_context(), SkMatrix());
+  EXPECT_TRUE(preroll_context()->has_texture_layer);
+
+  registry.BeginFrame();
+  frozen_layer->Paint(paint_context());
+  EXPECT_FALSE(registry.MarkNewFrameAvailable(texture_id));
+
+  registry.BeginFrame();
+  layer->Paint(paint_context());
+  EXPECT_TRUE(registry.MarkNewFrameAvailable(texture_id));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -18,6 +18,7 @@ class TransformLayer : public ContainerLayer {
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
+  const char* type_name() const override { return "TransformLayer"; }
 
 #if defined(OS_FUCHSIA)
   void UpdateScene(SceneUpdateContext& context) override;
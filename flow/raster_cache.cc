@@ -12,7 +12,6 @@
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkImage.h"
-#include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
@@ -46,19 +45,19 @@ RasterCache::RasterCache(size_t access_threshold,
 
 RasterCache::~RasterCache() = default;
 
-static bool CanRasterizePicture(SkPicture* picture) {
-  if (picture == nullptr) {
+static bool CanRasterizePicture(DisplayList* display_list) {
+  if (display_list == nullptr) {
     return false;
   }
 
-  const SkRect cull_rect = picture->cullRect();
+  const SkRect& bounds = display_list->bounds();
 
-  if (cull_rect.isEmpty()) {
+  if (bounds.isEmpty()) {
     // No point in ever rasterizing an empty picture.
     return false;
   }
 
-  if (!cull_rect.isFinite()) {
+  if (!bounds.isFinite()) {
     // Cannot attempt to rasterize into an infinitely large surface.
     return false;
   }
@@ -66,30 +65,43 @@ static bool CanRasterizePicture(SkPicture* picture) {
   return true;
 }
 
-static bool IsPictureWorthRasterizing(SkPicture* picture,
+static bool IsPictureWorthRasterizing(DisplayList* display_list,
                                       bool will_change,
-                                      bool is_complex) {
+                                      bool is_complex,
+                                      const SkMatrix& ctm,
+                                      RasterCacheCostModel& cost_model,
+                                      fml::TimeDelta* estimated_saved_time,
+                                      bool* unmeasured) {
+  *unmeasured = false;
   if (will_change) {
     // If the picture is going to change in the future, there is no point in
     // doing to extra work to rasterize.
     return false;
   }
 
-  if (!CanRasterizePicture(picture)) {
+  if (!CanRasterizePicture(display_list)) {
     // No point in deciding whether the picture is worth rasterizing if it
     // cannot be rasterized at all.
     return false;
   }
 
+  // Evaluated even for complex pictures so that the decisions and savings
+  // show up in traces.
+  const auto decision = cost_model.Evaluate(
+      *display_list,
+      RasterCache::GetDeviceBounds(display_list->bounds(), ctm).size());
+  *estimated_saved_time = decision.saved_time;
+  *unmeasured = !decision.measured;
+
   if (is_complex) {
     // The caller seems to have extra information about the picture and thinks
     // the picture is always worth rasterizing.
     return true;
   }
 
-  // TODO(abarth): We should find a better heuristic here that lets us avoid
-  // wasting memory on trivial layers that are easy to re-rasterize every frame.
-  return picture->approximateOpCount() > 5;
+  // Only cache pictures that take long enough to draw for the cached image to
+  // save time and be worth the memory it takes up.
+  return decision.should_cache;
 }
 
 /// @note Procedure doesn't copy all closures.
@@ -128,14 +140,16 @@ static RasterCacheResult Rasterize(
   return {surface->makeImageSnapshot(), logical_rect};
 }
 
-RasterCacheResult RasterizePicture(SkPicture* picture,
+// Only what the picture actually draws is rasterized, which may be much
+// smaller than the bounds it was recorded with.
+RasterCacheResult RasterizePicture(DisplayList* display_list,
                                    GrContext* context,
                                    const SkMatrix& ctm,
                                    SkColorSpace* dst_color_space,
                                    bool checkerboard) {
   return Rasterize(context, ctm, dst_color_space, checkerboard,
-                   picture->cullRect(),
-                   [=](SkCanvas* canvas) { canvas->drawPicture(picture); });
+                   display_list->bounds(),
+                   [=](SkCanvas* canvas) { display_list->Draw(canvas); });
 }
 
 static inline size_t ClampSize(size_t value, size_t min, size_t max) {
@@ -158,6 +172,7 @@ void RasterCache::Prepare(PrerollContext* context,
   entry.access_count = ClampSize(entry.access_count + 1, 0, access_threshold_);
   entry.used_this_frame = true;
   if (!entry.image.is_valid()) {
+    const auto rasterize_start = fml::TimePoint::Now();
     entry.image = Rasterize(
         context->gr_context, ctm, context->dst_color_space,
         checkerboard_images_, layer->paint_bounds(),
@@ -182,23 +197,21 @@ void RasterCache::Prepare(PrerollContext* context,
             layer->Paint(paintContext);
           }
         });
+    rasterize_time_this_frame_ =
+        rasterize_time_this_frame_ + (fml::TimePoint::Now() - rasterize_start);
   }
 }
 
 bool RasterCache::Prepare(GrContext* context,
-                          SkPicture* picture,
+                          DisplayList* display_list,
                           const SkMatrix& transformation_matrix,
                           SkColorSpace* dst_color_space,
                           bool is_complex,
                           bool will_change) {
   if (picture_cached_this_frame_ >= picture_cache_limit_per_frame_) {
+    pending_entries_this_frame_++;
     return false;
   }
-  if (!IsPictureWorthRasterizing(picture, will_change, is_complex)) {
-    // We only deal with pictures that are worthy of rasterization.
-    return false;
-  }
-
   // Decompose the matrix (once) for all subsequent operations. We want to make
   // sure to avoid volumetric distortions while accounting for scaling.
   const MatrixDecomposition matrix(transformation_matrix);
@@ -208,28 +221,89 @@ bool RasterCache::Prepare(GrContext* context,
     return false;
   }
 
-  PictureRasterCacheKey cache_key(picture->uniqueID(), transformation_matrix);
+  fml::TimeDelta estimated_saved_time;
+  bool unmeasured = false;
+  if (!IsPictureWorthRasterizing(display_list, will_change, is_complex,
+                                 transformation_matrix, cost_model_,
+                                 &estimated_saved_time, &unmeasured)) {
+    // We only deal with pictures that are worthy of rasterization. The time
+    // the picture takes to draw is measured when it is painted, which may
+    // make it worth rasterizing in a later frame.
+    if (unmeasured) {
+      unmeasured_pictures_this_frame_.insert(display_list->unique_id());
+    }
+    return false;
+  }
+
+  PictureRasterCacheKey cache_key(display_list->unique_id(),
+                                  transformation_matrix);
 
   Entry& entry = picture_cache_[cache_key];
   entry.access_count = ClampSize(entry.access_count + 1, 0, access_threshold_);
   entry.used_this_frame = true;
 
-  if (entry.access_count < access_threshold_ || access_threshold_ == 0) {
+  if (access_threshold_ == 0) {
+    return false;
+  }
+  if (entry.access_count < access_threshold_) {
     // Frame threshold has not yet been reached.
+    pending_entries_this_frame_++;
     return false;
   }
 
   if (!entry.image.is_valid()) {
-    entry.image = RasterizePicture(picture, context, transformation_matrix,
+    const auto rasterize_start = fml::TimePoint::Now();
+    entry.image = RasterizePicture(display_list, context, transformation_matrix,
                                    dst_color_space, checkerboard_images_);
+    rasterize_time_this_frame_ =
+        rasterize_time_this_frame_ + (fml::TimePoint::Now() - rasterize_start);
     picture_cached_this_frame_++;
   }
+  entry.estimated_saved_time = estimated_saved_time;
   return true;
 }
 
-RasterCacheResult RasterCache::Get(const SkPicture& picture,
+bool RasterCache::Prepare(GrContext* context,
+                          const ShadowRasterCacheKey& key,
+                          const SkRect& bounds,
+                          SkColorSpace* dst_color_space,
+                          const std::function<void(SkCanvas*)>& draw_shadow) {
+  if (bounds.isEmpty() || !bounds.isFinite() ||
+      !MatrixDecomposition(key.matrix()).IsValid()) {
+    return false;
+  }
+
+  Entry& entry = shadow_cache_[key];
+  entry.access_count = ClampSize(entry.access_count + 1, 0, access_threshold_);
+  entry.used_this_frame = true;
+
+  if (access_threshold_ == 0) {
+    return false;
+  }
+  if (entry.access_count < access_threshold_) {
+    // Frame threshold has not yet been reached.
+    pending_entries_this_frame_++;
+    return false;
+  }
+
+  if (!entry.image.is_valid()) {
+    if (shadow_cached_this_frame_ >= picture_cache_limit_per_frame_) {
+      pending_entries_this_frame_++;
+      return false;
+    }
+    const auto rasterize_start = fml::TimePoint::Now();
+    entry.image = Rasterize(context, key.matrix(), dst_color_space,
+                            checkerboard_images_, bounds, draw_shadow);
+    rasterize_time_this_frame_ =
+        rasterize_time_this_frame_ + (fml::TimePoint::Now() - rasterize_start);
+    shadow_cached_this_frame_++;
+  }
+  return entry.image.is_valid();
+}
+
+RasterCacheResult RasterCache::Get(const DisplayList& display_list,
                                    const SkMatrix& ctm) const {
-  PictureRasterCacheKey cache_key(picture.uniqueID(), ctm);
+  PictureRasterCacheKey cache_key(display_list.unique_id(), ctm);
   auto it = picture_cache_.find(cache_key);
   return it == picture_cache_.end() ? RasterCacheResult() : it->second.image;
 }
@@ -240,22 +314,84 @@ RasterCacheResult RasterCache::Get(Layer* layer, const SkMatrix& ctm) const {
   return it == layer_cache_.end() ? RasterCacheResult() : it->second.image;
 }
 
+RasterCacheResult RasterCache::Get(const ShadowRasterCacheKey& key) const {
+  auto it = shadow_cache_.find(key);
+  if (it == shadow_cache_.end() || !it->second.image.is_valid()) {
+    shadow_misses_this_frame_++;
+    return RasterCacheResult();
+  }
+  shadow_hits_this_frame_++;
+  return it->second.image;
+}
+
+RasterCacheResult RasterCache::GetBackdrop(const BackdropRasterCacheKey& key,
+                                           bool* should_cache) const {
+  Entry& entry = backdrop_cache_[key];
+  entry.access_count = ClampSize(entry.access_count + 1, 0, access_threshold_);
+  entry.used_this_frame = true;
+  *should_cache = !entry.image.is_valid() &&
+                  entry.access_count >= access_threshold_ &&
+                  access_threshold_ != 0 &&
+                  backdrop_cached_this_frame_ < picture_cache_limit_per_frame_;
+  return entry.image;
+}
+
+void RasterCache::PutBackdrop(const BackdropRasterCacheKey& key,
+                              const RasterCacheResult& image) const {
+  backdrop_cache_[key].image = image;
+  backdrop_cached_this_frame_++;
+}
+
+void RasterCache::RecordPictureRasterTime(const DisplayList& display_list,
+                                          fml::TimeDelta raster_time) const {
+  cost_model_.RecordRasterTime(display_list, raster_time);
+  if (unmeasured_pictures_this_frame_.count(display_list.unique_id()) > 0) {
+    measured_pictures_this_frame_++;
+  }
+}
+
 void RasterCache::SweepAfterFrame() {
   using PictureCache = PictureRasterCacheKey::Map<Entry>;
   using LayerCache = LayerRasterCacheKey::Map<Entry>;
   SweepOneCacheAfterFrame<PictureCache, PictureCache::iterator>(picture_cache_);
   SweepOneCacheAfterFrame<LayerCache, LayerCache::iterator>(layer_cache_);
-  picture_cached_this_frame_ = 0;
+  using ShadowCache = ShadowRasterCacheKey::Map<Entry>;
+  SweepOneCacheAfterFrame<ShadowCache, ShadowCache::iterator>(shadow_cache_);
+  using BackdropCache = BackdropRasterCacheKey::Map<Entry>;
+  SweepOneCacheAfterFrame<BackdropCache, BackdropCache::iterator>(
+      backdrop_cache_);
+  cost_model_.SweepAfterFrame();
+  ResetFrameStats();
+}
+
+void RasterCache::EndFrameWithoutSweep() {
+  ResetFrameStats();
+}
+
+void RasterCache::ResetFrameStats() {
   TraceStatsToTimeline();
+  picture_cached_this_frame_ = 0;
+  pending_entries_this_frame_ = 0;
+  unmeasured_pictures_this_frame_.clear();
+  measured_pictures_this_frame_ = 0;
+  shadow_cached_this_frame_ = 0;
+  backdrop_cached_this_frame_ = 0;
+  shadow_hits_this_frame_ = 0;
+  shadow_misses_this_frame_ = 0;
+  rasterize_time_this_frame_ = fml::TimeDelta::Zero();
 }
 
 void RasterCache::Clear() {
+  clear_count_++;
   picture_cache_.clear();
   layer_cache_.clear();
+  shadow_cache_.clear();
+  backdrop_cache_.clear();
 }
 
 size_t RasterCache::GetCachedEntriesCount() const {
-  return layer_cache_.size() + picture_cache_.size();
+  return layer_cache_.size() + picture_cache_.size() + shadow_cache_.size() +
+         backdrop_cache_.size();
 }
 
 void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
@@ -277,6 +413,11 @@ void RasterCache::TraceStatsToTimeline() const {
   size_t layer_cache_bytes = 0;
   size_t picture_cache_count = 0;
   size_t picture_cache_bytes = 0;
+  double picture_cache_saved_millis = 0.0;
+  size_t shadow_cache_count = 0;
+  size_t shadow_cache_bytes = 0;
+  size_t backdrop_cache_count = 0;
+  size_t backdrop_cache_bytes = 0;
 
   for (const auto& item : layer_cache_) {
     const auto dimensions = item.second.image.image_dimensions();
@@ -288,14 +429,43 @@ void RasterCache::TraceStatsToTimeline() const {
     const auto dimensions = item.second.image.image_dimensions();
     picture_cache_count++;
     picture_cache_bytes += dimensions.width() * dimensions.height() * 4;
+    if (item.second.image.is_valid()) {
+      picture_cache_saved_millis +=
+          item.second.estimated_saved_time.ToMillisecondsF();
+    }
   }
 
+  for (const auto& item : shadow_cache_) {
+    const auto dimensions = item.second.image.image_dimensions();
+    shadow_cache_count++;
+    shadow_cache_bytes += dimensions.width() * dimensions.height() * 4;
+  }
+
+  for (const auto& item : backdrop_cache_) {
+    const auto dimensions = item.second.image.image_dimensions();
+    backdrop_cache_count++;
+    backdrop_cache_bytes += dimensions.width() * dimensions.height() * 4;
+  }
+
+  const size_t shadow_draws =
+      shadow_hits_this_frame_ + shadow_misses_this_frame_;
+  const double shadow_hit_rate =
+      shadow_draws == 0 ? 0.0
+                        : static_cast<double>(shadow_hits_this_frame_) /
+                              shadow_draws;
+
   FML_TRACE_COUNTER("flutter", "RasterCache",
-                    reinterpret_cast<int64_t>(this),             //
-                    "LayerCount", layer_cache_count,             //
-                    "LayerMBytes", layer_cache_bytes * 1e-6,     //
-                    "PictureCount", picture_cache_count,         //
-                    "PictureMBytes", picture_cache_bytes * 1e-6  //
+                    reinterpret_cast<int64_t>(this),                   //
+                    "LayerCount", layer_cache_count,                   //
+                    "LayerMBytes", layer_cache_bytes * 1e-6,           //
+                    "PictureCount", picture_cache_count,               //
+                    "PictureMBytes", picture_cache_bytes * 1e-6,       //
+                    "PictureSavedMillis", picture_cache_saved_millis,  //
+                    "ShadowCount", shadow_cache_count,                 //
+                    "ShadowMBytes", shadow_cache_bytes * 1e-6,         //
+                    "ShadowHitRate", shadow_hit_rate,                  //
+                    "BackdropCount", backdrop_cache_count,             //
+                    "BackdropMBytes", backdrop_cache_bytes * 1e-6      //
   );
 
 #endif  // !FLUTTER_RELEASE
@@ -5,10 +5,14 @@
 #ifndef FLUTTER_FLOW_RASTER_CACHE_H_
 #define FLUTTER_FLOW_RASTER_CACHE_H_
 
+#include <functional>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 
+#include "flutter/flow/display_list.h"
 #include "flutter/flow/instrumentation.h"
+#include "flutter/flow/raster_cache_cost_model.h"
 #include "flutter/flow/raster_cache_key.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
@@ -76,13 +80,15 @@ class RasterCache {
   // Return true if the cache is generated.
   //
   // We may return false and not generate the cache if
-  // 1. The picture is not worth rasterizing
+  // 1. The picture is not worth rasterizing, either because it will change or
+  //    because the cost model estimates caching it would not save time.
+  //    (See also |RasterCacheCostModel|.)
   // 2. The matrix is singular
   // 3. The picture is accessed too few times
   // 4. There are too many pictures to be cached in the current frame.
   //    (See also kDefaultPictureCacheLimitPerFrame.)
   bool Prepare(GrContext* context,
-               SkPicture* picture,
+               DisplayList* display_list,
                const SkMatrix& transformation_matrix,
                SkColorSpace* dst_color_space,
                bool is_complex,
@@ -90,23 +96,93 @@ class RasterCache {
 
   void Prepare(PrerollContext* context, Layer* layer, const SkMatrix& ctm);
 
-  RasterCacheResult Get(const SkPicture& picture, const SkMatrix& ctm) const;
+  // Return true if the image of the shadow is cached. |draw_shadow| draws the
+  // shadow within |bounds| into a canvas with the ctm of the key.
+  //
+  // Like pictures, shadows are only cached once they have been drawn in
+  // |access_threshold| consecutive frames, and only up to the same number of
+  // new images per frame.
+  bool Prepare(GrContext* context,
+               const ShadowRasterCacheKey& key,
+               const SkRect& bounds,
+               SkColorSpace* dst_color_space,
+               const std::function<void(SkCanvas*)>& draw_shadow);
+
+  RasterCacheResult Get(const DisplayList& display_list,
+                        const SkMatrix& ctm) const;
 
   RasterCacheResult Get(Layer* layer, const SkMatrix& ctm) const;
 
+  // Counts a hit or a miss for the hit rate of the shadow images, which is
+  // traced after each frame.
+  RasterCacheResult Get(const ShadowRasterCacheKey& key) const;
+
+  // Filtered backdrops can only be cached while painting, once the content
+  // under them has been drawn, so unlike other entries they are looked up and
+  // added while the cache is otherwise read-only. Like pictures, a backdrop is
+  // only worth caching once it has been looked up in |access_threshold|
+  // consecutive frames, and only up to the same number of new images per
+  // frame. |should_cache| is set when the backdrop is not cached yet but
+  // should be.
+  RasterCacheResult GetBackdrop(const BackdropRasterCacheKey& key,
+                                bool* should_cache) const;
+
+  void PutBackdrop(const BackdropRasterCacheKey& key,
+                   const RasterCacheResult& image) const;
+
+  // Records the time it took to draw a picture that was not cached, which the
+  // cost model uses in later frames to decide whether to cache the picture.
+  // This is called while painting, when the cache is otherwise read-only.
+  void RecordPictureRasterTime(const DisplayList& display_list,
+                               fml::TimeDelta raster_time) const;
+
+  // Counts a layer whose caching its preroll left to a later frame, like an
+  // image filter layer that has not been rendered in enough frames yet.
+  // Entries prepared with |Prepare| for a layer are rasterized right away, so
+  // they are never pending.
+  void MarkLayerPending() { pending_entries_this_frame_++; }
+
   void SweepAfterFrame();
 
+  // Ends a frame that painted a layer tree again without prerolling it, so
+  // none of the entries it drew were prepared. Unlike |SweepAfterFrame|, all
+  // the entries are kept for the following frames.
+  void EndFrameWithoutSweep();
+
   void Clear();
 
+  // The number of times the cache was cleared, which invalidates what earlier
+  // prerolls decided to draw from it.
+  size_t GetClearCount() const { return clear_count_; }
+
+  // The number of pictures, shadows and layers whose caching the prerolls
+  // since the last call to |SweepAfterFrame| left to later frames, because
+  // they weren't used in enough frames yet or too many were cached in this
+  // one. Pictures whose draw time wasn't measured yet are only counted once
+  // they have been painted, which measures them, since pictures that are not
+  // painted would otherwise stay pending forever.
+  size_t GetPendingEntriesThisFrame() const {
+    return pending_entries_this_frame_ + measured_pictures_this_frame_;
+  }
+
   void SetCheckboardCacheImages(bool checkerboard);
 
   size_t GetCachedEntriesCount() const;
 
+  // The time spent rasterizing new cache entries since the last call to
+  // |SweepAfterFrame|.
+  fml::TimeDelta GetRasterizeTimeThisFrame() const {
+    return rasterize_time_this_frame_;
+  }
+
  private:
   struct Entry {
     bool used_this_frame = false;
     size_t access_count = 0;
     RasterCacheResult image;
+    // The time the cost model estimates the image saves each frame. Only set
+    // for pictures.
+    fml::TimeDelta estimated_saved_time;
   };
 
   template <class Cache, class Iterator>
@@ -129,13 +205,29 @@ class RasterCache {
   const size_t access_threshold_;
   const size_t picture_cache_limit_per_frame_;
   size_t picture_cached_this_frame_ = 0;
+  size_t shadow_cached_this_frame_ = 0;
+  size_t pending_entries_this_frame_ = 0;
+  // The pictures prepared this frame whose draw time wasn't measured yet, and
+  // the number of them that were measured while painting.
+  std::unordered_set<uint32_t> unmeasured_pictures_this_frame_;
+  mutable size_t measured_pictures_this_frame_ = 0;
+  size_t clear_count_ = 0;
+  mutable size_t shadow_hits_this_frame_ = 0;
+  mutable size_t shadow_misses_this_frame_ = 0;
+  fml::TimeDelta rasterize_time_this_frame_;
   PictureRasterCacheKey::Map<Entry> picture_cache_;
   LayerRasterCacheKey::Map<Entry> layer_cache_;
+  ShadowRasterCacheKey::Map<Entry> shadow_cache_;
+  mutable BackdropRasterCacheKey::Map<Entry> backdrop_cache_;
+  mutable size_t backdrop_cached_this_frame_ = 0;
+  mutable RasterCacheCostModel cost_model_;
   bool checkerboard_images_;
   fml::WeakPtrFactory<RasterCache> weak_factory_;
 
   void TraceStatsToTimeline() const;
 
+  void ResetFrameStats();
+
   FML_DISALLOW_COPY_AND_ASSIGN(RasterCache);
 };
 
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_cost_model.h"
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+fml::TimeDelta MicrosecondsToDelta(double micros) {
+  return fml::TimeDelta::FromNanoseconds(static_cast<int64_t>(micros * 1e3));
+}
+
+}  // namespace
+
+RasterCacheCostModel::RasterCacheCostModel()
+    : RasterCacheCostModel(Options{}) {}
+
+RasterCacheCostModel::RasterCacheCostModel(const Options& options)
+    : options_(options),
+      micros_per_complexity_unit_(
+          options.initial_time_per_complexity_unit.ToMicrosecondsF()) {}
+
+RasterCacheCostModel::~RasterCacheCostModel() = default;
+
+RasterCacheCostModel::Entry& RasterCacheCostModel::GetEntry(
+    const DisplayList& display_list) {
+  Entry& entry = entries_[display_list.unique_id()];
+  entry.used_this_frame = true;
+  // Display lists estimate their complexity as they are recorded.
+  entry.complexity = display_list.complexity();
+  return entry;
+}
+
+RasterCacheCostModel::Decision RasterCacheCostModel::Evaluate(
+    const DisplayList& display_list,
+    const SkISize& cache_size) {
+  const Entry& entry = GetEntry(display_list);
+
+  Decision decision;
+  decision.measured = entry.measured;
+  decision.raster_time =
+      entry.measured
+          ? entry.raster_time
+          : MicrosecondsToDelta(entry.complexity * micros_per_complexity_unit_);
+
+  const double pixels =
+      static_cast<double>(cache_size.width()) * cache_size.height();
+  decision.cached_draw_time = MicrosecondsToDelta(
+      pixels * 1e-6 *
+      options_.cached_draw_time_per_megapixel.ToMicrosecondsF());
+  decision.saved_time = decision.raster_time - decision.cached_draw_time;
+
+  // Assumes 4 bytes per pixel like the images of the raster cache.
+  const double megabytes = pixels * 4 * 1e-6;
+  const auto memory_cost = MicrosecondsToDelta(
+      megabytes * options_.min_saved_time_per_megabyte.ToMicrosecondsF());
+  decision.should_cache = decision.saved_time > memory_cost;
+
+  FML_TRACE_EVENT("flutter", "RasterCacheCostModel::Evaluate",     //
+                  "PictureID", display_list.unique_id(),              //
+                  "Cache", decision.should_cache ? "true" : "false",  //
+                  "Measured", decision.measured ? "true" : "false",   //
+                  "SavedMicros", decision.saved_time.ToMicroseconds()  //
+  );
+
+  return decision;
+}
+
+void RasterCacheCostModel::RecordRasterTime(const DisplayList& display_list,
+                                            fml::TimeDelta raster_time) {
+  Entry& entry = GetEntry(display_list);
+  if (entry.measured) {
+    const double weight = options_.measurement_weight;
+    entry.raster_time = MicrosecondsToDelta(
+        entry.raster_time.ToMicrosecondsF() * (1.0 - weight) +
+        raster_time.ToMicrosecondsF() * weight);
+  } else {
+    entry.measured = true;
+    entry.raster_time = raster_time;
+  }
+
+  // Calibrate the estimates of the pictures that have not been measured yet.
+  if (entry.complexity > 0.0) {
+    const double weight = options_.measurement_weight;
+    micros_per_complexity_unit_ =
+        micros_per_complexity_unit_ * (1.0 - weight) +
+        raster_time.ToMicrosecondsF() / entry.complexity * weight;
+  }
+}
+
+void RasterCacheCostModel::SweepAfterFrame() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.used_this_frame) {
+      it->second.used_this_frame = false;
+      ++it;
+    } else {
+      it = entries_.erase(it);
+    }
+  }
+}
+
+size_t RasterCacheCostModel::GetTrackedPictureCount() const {
+  return entries_.size();
+}
+
+}  // namespace flutter
@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_RASTER_CACHE_COST_MODEL_H_
+#define FLUTTER_FLOW_RASTER_CACHE_COST_MODEL_H_
+
+#include <unordered_map>
+
+#include "flutter/flow/display_list.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Decides whether caching a picture saves raster time. Caching
+///             pays off when drawing the picture takes longer than drawing
+///             its cached image, by a margin that grows with the memory the
+///             image takes up.
+///
+///             The time it takes to draw a picture is measured whenever the
+///             picture is drawn without being cached and averaged across
+///             frames. Pictures that have not been measured yet are
+///             estimated from the complexity of their display lists, using the
+///             ratio of measured times to estimates of the pictures that have
+///             been measured.
+///
+///             The times are measured on the CPU around the draw. On the
+///             software backend that includes the rasterization. On GPU
+///             backends the canvas is not flushed, so only the time it takes
+///             to record the commands of the picture is measured. That time
+///             is a proxy for the cost of submitting the picture, which grows
+///             with its complexity, but not for the GPU time it takes. The
+///             cached draw times in |Options| are to be calibrated on the same
+///             terms.
+///
+class RasterCacheCostModel {
+ public:
+  struct Options {
+    // The estimated time it takes to draw a cached image of a million pixels.
+    fml::TimeDelta cached_draw_time_per_megapixel =
+        fml::TimeDelta::FromMicroseconds(100);
+    // How much time caching must save per frame for each megabyte of cached
+    // image to be worth the memory.
+    fml::TimeDelta min_saved_time_per_megabyte =
+        fml::TimeDelta::FromMicroseconds(25);
+    // The time one unit of complexity is assumed to take before any picture
+    // has been measured.
+    fml::TimeDelta initial_time_per_complexity_unit =
+        fml::TimeDelta::FromMicroseconds(1);
+    // The weight of a new measurement in the moving averages of raster times.
+    double measurement_weight = 0.25;
+  };
+
+  struct Decision {
+    bool should_cache = false;
+    // Whether |raster_time| was measured or estimated.
+    bool measured = false;
+    // The time it takes to draw the picture without caching it.
+    fml::TimeDelta raster_time;
+    // The time it takes to draw the cached image of the picture.
+    fml::TimeDelta cached_draw_time;
+    // The time caching the picture saves each frame. Negative if drawing the
+    // cached image is slower than drawing the picture.
+    fml::TimeDelta saved_time;
+  };
+
+  RasterCacheCostModel();
+
+  explicit RasterCacheCostModel(const Options& options);
+
+  ~RasterCacheCostModel();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Decides whether to cache a picture and traces the decision.
+  ///
+  /// @param[in]  display_list  The display list of the picture.
+  /// @param[in]  cache_size    The size of the image the picture would be
+  ///                           cached in.
+  ///
+  Decision Evaluate(const DisplayList& display_list,
+                    const SkISize& cache_size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records how long it took to draw a picture that was not
+  ///             cached.
+  ///
+  void RecordRasterTime(const DisplayList& display_list,
+                        fml::TimeDelta raster_time);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forgets the pictures that were neither evaluated nor measured
+  ///             since the last call.
+  ///
+  void SweepAfterFrame();
+
+  size_t GetTrackedPictureCount() const;
+
+ private:
+  struct Entry {
+    bool used_this_frame = false;
+    double complexity = 0.0;
+    bool measured = false;
+    fml::TimeDelta raster_time;
+  };
+
+  const Options options_;
+  std::unordered_map<uint32_t, Entry> entries_;
+  // The average ratio of measured raster times to complexity estimates, in
+  // microseconds per unit.
+  double micros_per_complexity_unit_;
+
+  Entry& GetEntry(const DisplayList& display_list);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheCostModel);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_RASTER_CACHE_COST_MODEL_H_
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_cost_model.h"
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkMaskFilter.h"
+#include "third_party/skia/include/core/SkPath.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+sk_sp<DisplayList> GetRectPicture() {
+  DisplayListRecorder recorder(SkRect::MakeWH(100, 100));
+  recorder.drawRect(SkRect::MakeXYWH(10, 10, 80, 80), SkPaint());
+  return recorder.Build();
+}
+
+sk_sp<DisplayList> GetBlurredPathsPicture() {
+  DisplayListRecorder recorder(SkRect::MakeWH(100, 100));
+  SkPaint paint;
+  paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 5));
+  SkPath path;
+  path.moveTo(0, 0);
+  path.lineTo(100, 100);
+  path.lineTo(100, 0);
+  path.lineTo(0, 100);
+  for (int i = 0; i < 10; i++) {
+    recorder.drawPath(path, paint);
+  }
+  return recorder.Build();
+}
+
+}  // namespace
+
+TEST(RasterCacheCostModel, SimplePicturesAreNotWorthCaching) {
+  RasterCacheCostModel model;
+  auto picture = GetRectPicture();
+  const auto decision = model.Evaluate(*picture, SkISize::Make(100, 100));
+  ASSERT_FALSE(decision.should_cache);
+  ASSERT_FALSE(decision.measured);
+}
+
+TEST(RasterCacheCostModel, ComplexPicturesAreWorthCaching) {
+  RasterCacheCostModel model;
+  auto picture = GetBlurredPathsPicture();
+  const auto decision = model.Evaluate(*picture, SkISize::Make(100, 100));
+  ASSERT_TRUE(decision.should_cache);
+  ASSERT_GT(decision.saved_time, fml::TimeDelta::Zero());
+}
+
+TEST(RasterCacheCostModel, MeasurementsOverrideEstimates) {
+  RasterCacheCostModel model;
+  auto picture = GetRectPicture();
+  const auto size = SkISize::Make(100, 100);
+  ASSERT_FALSE(model.Evaluate(*picture, size).should_cache);
+
+  // The picture turns out to be slow to draw.
+  model.RecordRasterTime(*picture, fml::TimeDelta::FromMilliseconds(2));
+  const auto decision = model.Evaluate(*picture, size);
+  ASSERT_TRUE(decision.measured);
+  ASSERT_EQ(decision.raster_time, fml::TimeDelta::FromMilliseconds(2));
+  ASSERT_TRUE(decision.should_cache);
+}
+
+TEST(RasterCacheCostModel, LargeCachedImagesMustSaveMoreTime) {
+  RasterCacheCostModel model;
+  auto picture = GetRectPicture();
+  model.RecordRasterTime(*picture, fml::TimeDelta::FromMicroseconds(500));
+  ASSERT_TRUE(model.Evaluate(*picture, SkISize::Make(100, 100)).should_cache);
+  ASSERT_FALSE(
+      model.Evaluate(*picture, SkISize::Make(2000, 2000)).should_cache);
+}
+
+TEST(RasterCacheCostModel, MeasurementsCalibrateEstimates) {
+  RasterCacheCostModel model;
+  auto measured_picture = GetRectPicture();
+  auto other_picture = GetRectPicture();
+  const auto size = SkISize::Make(10, 10);
+  const auto estimate = model.Evaluate(*other_picture, size).raster_time;
+
+  for (int i = 0; i < 10; i++) {
+    model.RecordRasterTime(*measured_picture,
+                           fml::TimeDelta::FromMilliseconds(1));
+  }
+
+  // Similar pictures are now estimated to be slower as well.
+  ASSERT_GT(model.Evaluate(*other_picture, size).raster_time, estimate);
+}
+
+TEST(RasterCacheCostModel, SweepForgetsUnusedPictures) {
+  RasterCacheCostModel model;
+  auto first = GetRectPicture();
+  auto second = GetRectPicture();
+  model.Evaluate(*first, SkISize::Make(10, 10));
+  model.RecordRasterTime(*second, fml::TimeDelta::FromMicroseconds(10));
+  ASSERT_EQ(model.GetTrackedPictureCount(), 2u);
+
+  model.SweepAfterFrame();
+  model.Evaluate(*first, SkISize::Make(10, 10));
+  model.SweepAfterFrame();
+  ASSERT_EQ(model.GetTrackedPictureCount(), 1u);
+  model.SweepAfterFrame();
+  ASSERT_EQ(model.GetTrackedPictureCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
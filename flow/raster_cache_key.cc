@@ -4,8 +4,55 @@
 
 #include "flutter/flow/raster_cache_key.h"
 
+#include <functional>
+
 namespace flutter {
 
-//
+namespace {
+
+template <typename T>
+void HashCombine(size_t* hash, const T& value) {
+  *hash = *hash * 31 + std::hash<T>()(value);
+}
+
+}  // namespace
+
+ShadowRasterCacheKey::ShadowRasterCacheKey(const SkPath& path,
+                                           SkColor color,
+                                           float elevation,
+                                           bool transparent_occluder,
+                                           float device_pixel_ratio,
+                                           const SkMatrix& ctm)
+    : path_(path),
+      color_(color),
+      elevation_(elevation),
+      transparent_occluder_(transparent_occluder),
+      device_pixel_ratio_(device_pixel_ratio),
+      matrix_(ctm),
+      hash_(0) {
+  // Comparing the paths themselves is left to |Equal|, the hash only uses
+  // what is cheap to get from them.
+  const SkRect& bounds = path.getBounds();
+  HashCombine(&hash_, bounds.left());
+  HashCombine(&hash_, bounds.top());
+  HashCombine(&hash_, bounds.right());
+  HashCombine(&hash_, bounds.bottom());
+  HashCombine(&hash_, path.countPoints());
+  HashCombine(&hash_, color);
+  HashCombine(&hash_, elevation);
+  HashCombine(&hash_, device_pixel_ratio);
+  HashCombine(&hash_, ctm.getTranslateX());
+  HashCombine(&hash_, ctm.getTranslateY());
+}
+
+bool ShadowRasterCacheKey::Equal::operator()(
+    const ShadowRasterCacheKey& lhs,
+    const ShadowRasterCacheKey& rhs) const {
+  return lhs.hash_ == rhs.hash_ && lhs.color_ == rhs.color_ &&
+         lhs.elevation_ == rhs.elevation_ &&
+         lhs.transparent_occluder_ == rhs.transparent_occluder_ &&
+         lhs.device_pixel_ratio_ == rhs.device_pixel_ratio_ &&
+         lhs.matrix_ == rhs.matrix_ && lhs.path_ == rhs.path_;
+}
 
 }  // namespace flutter
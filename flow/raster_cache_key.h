@@ -8,6 +8,8 @@
 #include <unordered_map>
 #include "flutter/flow/matrix_decomposition.h"
 #include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkColor.h"
+#include "third_party/skia/include/core/SkPath.h"
 
 namespace flutter {
 
@@ -59,6 +61,49 @@ class Layer;
 // The ID is the uint64_t layer unique_id
 using LayerRasterCacheKey = RasterCacheKey<uint64_t>;
 
+// The ID is a hash of the content under a backdrop filter layer, the filter
+// and the device bounds of the layer.
+using BackdropRasterCacheKey = RasterCacheKey<uint64_t>;
+
+// Identifies the image of a shadow by the shape and lighting it is drawn with,
+// so that layers with the same shape and elevation share the image, even when
+// they are new layers with new paths. Skia positions the light in device space,
+// so unlike the keys above this one keeps the integral translation of the ctm.
+class ShadowRasterCacheKey {
+ public:
+  ShadowRasterCacheKey(const SkPath& path,
+                       SkColor color,
+                       float elevation,
+                       bool transparent_occluder,
+                       float device_pixel_ratio,
+                       const SkMatrix& ctm);
+
+  const SkMatrix& matrix() const { return matrix_; }
+
+  struct Hash {
+    size_t operator()(const ShadowRasterCacheKey& key) const {
+      return key.hash_;
+    }
+  };
+
+  struct Equal {
+    bool operator()(const ShadowRasterCacheKey& lhs,
+                    const ShadowRasterCacheKey& rhs) const;
+  };
+
+  template <class Value>
+  using Map = std::unordered_map<ShadowRasterCacheKey, Value, Hash, Equal>;
+
+ private:
+  SkPath path_;
+  SkColor color_;
+  float elevation_;
+  bool transparent_occluder_;
+  float device_pixel_ratio_;
+  SkMatrix matrix_;
+  size_t hash_;
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_FLOW_RASTER_CACHE_KEY_H_
@@ -5,21 +5,18 @@
 #include "flutter/flow/raster_cache.h"
 
 #include "gtest/gtest.h"
-#include "third_party/skia/include/core/SkPicture.h"
-#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkCanvas.h"
 
 namespace flutter {
 namespace testing {
 namespace {
 
-sk_sp<SkPicture> GetSamplePicture() {
-  SkPictureRecorder recorder;
-  recorder.beginRecording(SkRect::MakeWH(150, 100));
+sk_sp<DisplayList> GetSamplePicture() {
+  DisplayListRecorder recorder(SkRect::MakeWH(150, 100));
   SkPaint paint;
   paint.setColor(SK_ColorRED);
-  recorder.getRecordingCanvas()->drawRect(SkRect::MakeXYWH(10, 10, 80, 80),
-                                          paint);
-  return recorder.finishRecordingAsPicture();
+  recorder.drawRect(SkRect::MakeXYWH(10, 10, 80, 80), paint);
+  return recorder.Build();
 }
 
 }  // namespace
@@ -101,5 +98,146 @@ TEST(RasterCache, SweepsRemoveUnusedFrames) {
                              false));  // 5
 }
 
+TEST(RasterCache, CountsPendingEntries) {
+  size_t threshold = 2;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_FALSE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                             false));  // 1
+  ASSERT_EQ(cache.GetPendingEntriesThisFrame(), 1u);
+  cache.SweepAfterFrame();
+  ASSERT_EQ(cache.GetPendingEntriesThisFrame(), 0u);
+  ASSERT_TRUE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                            false));  // 2
+  ASSERT_EQ(cache.GetPendingEntriesThisFrame(), 0u);
+  cache.SweepAfterFrame();
+
+  // Pictures that will change are never cached.
+  ASSERT_FALSE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                             true));
+  ASSERT_EQ(cache.GetPendingEntriesThisFrame(), 0u);
+}
+
+TEST(RasterCache, CountsUnmeasuredPicturesOncePainted) {
+  flutter::RasterCache cache;
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  // The picture is too simple to be worth caching from its estimate alone.
+  ASSERT_FALSE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), false,
+                             false));
+  // Pictures that are not painted are never measured, so they would stay
+  // pending in every frame.
+  ASSERT_EQ(cache.GetPendingEntriesThisFrame(), 0u);
+  cache.RecordPictureRasterTime(*picture, fml::TimeDelta::FromMicroseconds(1));
+  ASSERT_EQ(cache.GetPendingEntriesThisFrame(), 1u);
+  cache.SweepAfterFrame();
+  ASSERT_EQ(cache.GetPendingEntriesThisFrame(), 0u);
+
+  // Measured pictures are not pending on their measurement anymore.
+  ASSERT_FALSE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), false,
+                             false));
+  cache.RecordPictureRasterTime(*picture, fml::TimeDelta::FromMicroseconds(1));
+  ASSERT_EQ(cache.GetPendingEntriesThisFrame(), 0u);
+}
+
+TEST(RasterCache, CountsPendingLayers) {
+  flutter::RasterCache cache;
+
+  cache.MarkLayerPending();
+  ASSERT_EQ(cache.GetPendingEntriesThisFrame(), 1u);
+  cache.SweepAfterFrame();
+  ASSERT_EQ(cache.GetPendingEntriesThisFrame(), 0u);
+}
+
+TEST(RasterCache, FramesWithoutSweepKeepEntries) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto picture = GetSamplePicture();
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  ASSERT_TRUE(cache.Prepare(NULL, picture.get(), matrix, srgb.get(), true,
+                            false));
+  cache.SweepAfterFrame();
+  // Frames that reuse the last preroll don't prepare anything.
+  cache.EndFrameWithoutSweep();
+  cache.EndFrameWithoutSweep();
+  ASSERT_TRUE(cache.Get(*picture, matrix).is_valid());
+  cache.SweepAfterFrame();
+  ASSERT_FALSE(cache.Get(*picture, matrix).is_valid());
+
+  const size_t clear_count = cache.GetClearCount();
+  cache.Clear();
+  ASSERT_EQ(cache.GetClearCount(), clear_count + 1);
+}
+
+TEST(RasterCache, ShadowsWithEqualShapesShareAnImage) {
+  flutter::RasterCache cache(2);
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  auto draw_shadow = [](SkCanvas* canvas) {
+    canvas->drawRect(SkRect::MakeWH(10, 10), SkPaint());
+  };
+  const SkRect bounds = SkRect::MakeWH(20, 20);
+
+  // Layers are created with new paths on every frame.
+  auto make_key = [](const SkMatrix& ctm) {
+    return ShadowRasterCacheKey(SkPath().addRect(SkRect::MakeWH(10, 10)),
+                                SK_ColorBLACK, 4.0f, false, 1.0f, ctm);
+  };
+
+  ASSERT_FALSE(cache.Prepare(NULL, make_key(SkMatrix::I()), bounds, srgb.get(),
+                             draw_shadow));  // 1
+  ASSERT_FALSE(cache.Get(make_key(SkMatrix::I())).is_valid());
+  cache.SweepAfterFrame();
+  ASSERT_TRUE(cache.Prepare(NULL, make_key(SkMatrix::I()), bounds, srgb.get(),
+                            draw_shadow));  // 2
+  ASSERT_TRUE(cache.Get(make_key(SkMatrix::I())).is_valid());
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 1u);
+
+  // The light is positioned in device space, so shadows at other positions
+  // look different.
+  ASSERT_FALSE(cache.Get(make_key(SkMatrix::MakeTrans(10, 0))).is_valid());
+
+  cache.SweepAfterFrame();
+  cache.SweepAfterFrame();
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 0u);
+}
+
+TEST(RasterCache, ShadowKeysCompareShapesAndLighting) {
+  const SkPath path = SkPath().addRect(SkRect::MakeWH(10, 10));
+  const SkPath other_path = SkPath().addOval(SkRect::MakeWH(10, 10));
+  ShadowRasterCacheKey::Equal equal;
+  const ShadowRasterCacheKey key(path, SK_ColorBLACK, 4.0f, false, 1.0f,
+                                 SkMatrix::I());
+
+  ASSERT_TRUE(equal(key, ShadowRasterCacheKey(SkPath(path), SK_ColorBLACK,
+                                              4.0f, false, 1.0f,
+                                              SkMatrix::I())));
+  ASSERT_FALSE(equal(key, ShadowRasterCacheKey(other_path, SK_ColorBLACK, 4.0f,
+                                               false, 1.0f, SkMatrix::I())));
+  ASSERT_FALSE(equal(key, ShadowRasterCacheKey(path, SK_ColorRED, 4.0f, false,
+                                               1.0f, SkMatrix::I())));
+  ASSERT_FALSE(equal(key, ShadowRasterCacheKey(path, SK_ColorBLACK, 8.0f,
+                                               false, 1.0f, SkMatrix::I())));
+  ASSERT_FALSE(equal(key, ShadowRasterCacheKey(path, SK_ColorBLACK, 4.0f, true,
+                                               1.0f, SkMatrix::I())));
+  ASSERT_FALSE(equal(key, ShadowRasterCacheKey(path, SK_ColorBLACK, 4.0f,
+                                               false, 2.0f, SkMatrix::I())));
+  ASSERT_FALSE(equal(key, ShadowRasterCacheKey(path, SK_ColorBLACK, 4.0f,
+                                               false, 1.0f,
+                                               SkMatrix::MakeScale(2))));
+}
+
 }  // namespace testing
 }  // namespace flutter
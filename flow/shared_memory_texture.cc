@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/shared_memory_texture.h"
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+
+namespace flutter {
+
+SharedMemoryTexture::SharedMemoryTexture(int64_t id) : Texture(id) {}
+
+SharedMemoryTexture::~SharedMemoryTexture() {
+  // Nothing else reads the pixels of a pending frame.
+  if (auto frame = TakePendingFrame()) {
+    frame->release();
+  }
+}
+
+void SharedMemoryTexture::PushFrame(const SkPixmap& pixels,
+                                    ReleaseCallback release) {
+  std::optional<Frame> replaced_frame;
+  {
+    std::scoped_lock lock(mutex_);
+    replaced_frame = std::move(pending_frame_);
+    pending_frame_ = Frame{pixels, std::move(release)};
+  }
+  if (replaced_frame) {
+    TRACE_EVENT_INSTANT0("flutter", "SharedMemoryTexture frame dropped");
+    replaced_frame->release();
+  }
+}
+
+std::optional<SharedMemoryTexture::Frame>
+SharedMemoryTexture::TakePendingFrame() {
+  std::scoped_lock lock(mutex_);
+  std::optional<Frame> frame = std::move(pending_frame_);
+  pending_frame_.reset();
+  return frame;
+}
+
+// |Texture|
+void SharedMemoryTexture::Paint(SkCanvas& canvas,
+                                const SkRect& bounds,
+                                bool freeze,
+                                GrContext* context) {
+  if (!freeze) {
+    if (auto frame = TakePendingFrame()) {
+      // The image wraps the pixels, which are released once Skia is done with
+      // the image, including any upload to the GPU.
+      auto* release = new ReleaseCallback(std::move(frame->release));
+      image_ = SkImage::MakeFromRaster(
+          frame->pixels,
+          [](const void* pixels, SkImage::ReleaseContext context) {
+            auto* release = static_cast<ReleaseCallback*>(context);
+            (*release)();
+            delete release;
+          },
+          release);
+      if (!image_) {
+        // Skia doesn't take the pixels when they can't be wrapped.
+        FML_LOG(ERROR) << "Could not wrap the pixels of a texture frame.";
+        (*release)();
+        delete release;
+      }
+    }
+  }
+
+  if (!image_) {
+    return;
+  }
+  if (bounds != SkRect::Make(image_->bounds())) {
+    canvas.drawImageRect(image_, bounds, nullptr);
+  } else {
+    canvas.drawImage(image_, bounds.x(), bounds.y());
+  }
+}
+
+// |Texture|
+void SharedMemoryTexture::OnGrContextCreated() {}
+
+// |Texture|
+void SharedMemoryTexture::OnGrContextDestroyed() {}
+
+// |Texture|
+void SharedMemoryTexture::MarkNewFrameAvailable() {}
+
+// |Texture|
+void SharedMemoryTexture::OnTextureUnregistered() {
+  image_.reset();
+  if (auto frame = TakePendingFrame()) {
+    frame->release();
+  }
+}
+
+}  // namespace flutter
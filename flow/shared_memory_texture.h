@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_SHARED_MEMORY_TEXTURE_H_
+#define FLUTTER_FLOW_SHARED_MEMORY_TEXTURE_H_
+
+#include <functional>
+#include <mutex>
+#include <optional>
+
+#include "flutter/flow/texture.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A texture whose frames are pixels in memory shared with their
+///             producer, like a software video decoder writing into mapped
+///             buffers. The pixels are drawn where they are, without being
+///             copied, so the producer must not write into the pixels of a
+///             frame until the texture releases them.
+///
+///             Frames are pushed from any thread, after which the platform
+///             marks that the texture has a new frame available as usual. A
+///             frame pushed before the previous one was painted replaces it,
+///             and the previous one is released unseen.
+///
+class SharedMemoryTexture : public Texture {
+ public:
+  // Called once the texture no longer reads the pixels of a frame. Called on
+  // the GPU thread, or on the thread pushing a frame that replaces one that
+  // wasn't painted.
+  using ReleaseCallback = std::function<void()>;
+
+  explicit SharedMemoryTexture(int64_t id);
+
+  ~SharedMemoryTexture() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Makes |pixels| the next frame painted. Called from any
+  ///             thread.
+  ///
+  /// @param[in]  pixels   The pixels of the frame, which must stay valid and
+  ///                      unchanged until |release| is called.
+  /// @param[in]  release  Called once the pixels are no longer read.
+  ///
+  void PushFrame(const SkPixmap& pixels, ReleaseCallback release);
+
+  // |Texture|
+  void Paint(SkCanvas& canvas,
+             const SkRect& bounds,
+             bool freeze,
+             GrContext* context) override;
+
+  // |Texture|
+  void OnGrContextCreated() override;
+
+  // |Texture|
+  void OnGrContextDestroyed() override;
+
+  // |Texture|
+  void MarkNewFrameAvailable() override;
+
+  // |Texture|
+  void OnTextureUnregistered() override;
+
+ private:
+  struct Frame {
+    SkPixmap pixels;
+    ReleaseCallback release;
+  };
+
+  std::mutex mutex_;
+  std::optional<Frame> pending_frame_;
+  // The image of the frame painted last, which wraps its pixels. Only used on
+  // the GPU thread.
+  sk_sp<SkImage> image_;
+
+  std::optional<Frame> TakePendingFrame();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SharedMemoryTexture);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_SHARED_MEMORY_TEXTURE_H_
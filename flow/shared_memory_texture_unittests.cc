@@ -0,0 +1,184 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/shared_memory_texture.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// A buffer a producer fills with a single color.
+struct Buffer {
+  explicit Buffer(SkColor color)
+      : pixels(16 * 16, SkPreMultiplyColor(color)) {}
+
+  SkPixmap pixmap() const {
+    return SkPixmap(SkImageInfo::MakeN32Premul(16, 16), pixels.data(),
+                    16 * sizeof(SkPMColor));
+  }
+
+  std::vector<SkPMColor> pixels;
+  std::atomic<int> in_use = 0;
+  std::atomic<int> release_count = 0;
+};
+
+void PushBuffer(SharedMemoryTexture& texture, Buffer& buffer) {
+  ASSERT_EQ(buffer.in_use.fetch_add(1), 0);
+  texture.PushFrame(buffer.pixmap(), [&buffer]() {
+    buffer.release_count++;
+    ASSERT_EQ(buffer.in_use.fetch_sub(1), 1);
+  });
+}
+
+// Paints |texture| on a surface of the size of its frames and returns the
+// color painted.
+SkColor PaintTexture(SharedMemoryTexture& texture, bool freeze = false) {
+  auto surface = SkSurface::MakeRasterN32Premul(16, 16);
+  surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+  texture.Paint(*surface->getCanvas(), SkRect::MakeWH(16, 16), freeze,
+                nullptr);
+  SkPixmap pixmap;
+  EXPECT_TRUE(surface->peekPixels(&pixmap));
+  return pixmap.getColor(8, 8);
+}
+
+}  // namespace
+
+TEST(SharedMemoryTextureTest, PaintsPushedFramesWithoutCopying) {
+  Buffer red(SK_ColorRED);
+  Buffer blue(SK_ColorBLUE);
+  SharedMemoryTexture texture(0);
+  ASSERT_EQ(PaintTexture(texture), SK_ColorTRANSPARENT);
+
+  PushBuffer(texture, red);
+  ASSERT_EQ(PaintTexture(texture), SK_ColorRED);
+  ASSERT_EQ(PaintTexture(texture), SK_ColorRED);
+  // The pixels are in use until the next frame is painted.
+  ASSERT_EQ(red.release_count, 0);
+
+  PushBuffer(texture, blue);
+  ASSERT_EQ(red.release_count, 0);
+  ASSERT_EQ(PaintTexture(texture), SK_ColorBLUE);
+  ASSERT_EQ(red.release_count, 1);
+
+  texture.OnTextureUnregistered();
+  ASSERT_EQ(blue.release_count, 1);
+}
+
+TEST(SharedMemoryTextureTest, ReleasesReplacedFrames) {
+  Buffer red(SK_ColorRED);
+  Buffer blue(SK_ColorBLUE);
+  SharedMemoryTexture texture(0);
+
+  PushBuffer(texture, red);
+  PushBuffer(texture, blue);
+  ASSERT_EQ(red.release_count, 1);
+  ASSERT_EQ(PaintTexture(texture), SK_ColorBLUE);
+  ASSERT_EQ(blue.release_count, 0);
+}
+
+TEST(SharedMemoryTextureTest, FrozenTexturesKeepTheirFrame) {
+  Buffer red(SK_ColorRED);
+  Buffer blue(SK_ColorBLUE);
+  SharedMemoryTexture texture(0);
+
+  PushBuffer(texture, red);
+  ASSERT_EQ(PaintTexture(texture), SK_ColorRED);
+  PushBuffer(texture, blue);
+  ASSERT_EQ(PaintTexture(texture, true), SK_ColorRED);
+  ASSERT_EQ(PaintTexture(texture), SK_ColorBLUE);
+}
+
+TEST(SharedMemoryTextureTest, ReleasesPendingFrameWhenDestroyed) {
+  Buffer red(SK_ColorRED);
+  {
+    SharedMemoryTexture texture(0);
+    PushBuffer(texture, red);
+  }
+  ASSERT_EQ(red.release_count, 1);
+}
+
+// Decoders push frames into several textures from their own threads while
+// the frames are painted. Each pushes into a ring of buffers and only reuses
+// a buffer once it was released.
+TEST(SharedMemoryTextureTest, PaintsFramesPushedFromManyThreads) {
+  constexpr size_t kStreamCount = 4;
+  constexpr size_t kFrameCount = 200;
+  const std::array<SkColor, 3> colors = {SK_ColorRED, SK_ColorGREEN,
+                                         SK_ColorBLUE};
+
+  struct Stream {
+    explicit Stream(int64_t id) : texture(id) {}
+
+    // Outlives the texture, which may still read from a buffer.
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    SharedMemoryTexture texture;
+    size_t pushed_count = 0;
+  };
+  std::vector<std::unique_ptr<Stream>> streams;
+  for (size_t i = 0; i < kStreamCount; i++) {
+    auto stream = std::make_unique<Stream>(i);
+    for (SkColor color : colors) {
+      stream->buffers.push_back(std::make_unique<Buffer>(color));
+    }
+    streams.push_back(std::move(stream));
+  }
+
+  std::atomic<size_t> done_count = 0;
+  std::vector<std::thread> producers;
+  for (auto& stream_ptr : streams) {
+    producers.emplace_back([&stream = *stream_ptr, &done_count]() {
+      while (stream.pushed_count < kFrameCount) {
+        Buffer& buffer =
+            *stream.buffers[stream.pushed_count % stream.buffers.size()];
+        if (buffer.in_use != 0) {
+          std::this_thread::yield();
+          continue;
+        }
+        PushBuffer(stream.texture, buffer);
+        stream.pushed_count++;
+      }
+      done_count++;
+    });
+  }
+
+  while (done_count < kStreamCount) {
+    for (auto& stream : streams) {
+      const SkColor color = PaintTexture(stream->texture);
+      EXPECT_TRUE(color == SK_ColorTRANSPARENT ||
+                  std::find(colors.begin(), colors.end(), color) !=
+                      colors.end());
+    }
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  for (auto& stream : streams) {
+    // The last frame pushed is the one painted last.
+    const SkColor last_color = colors[(kFrameCount - 1) % colors.size()];
+    ASSERT_EQ(PaintTexture(stream->texture), last_color);
+    stream->texture.OnTextureUnregistered();
+
+    size_t release_count = 0;
+    for (auto& buffer : stream->buffers) {
+      ASSERT_EQ(buffer->in_use, 0);
+      release_count += buffer->release_count;
+    }
+    ASSERT_EQ(release_count, kFrameCount);
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
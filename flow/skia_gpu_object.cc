@@ -49,4 +49,9 @@ void SkiaUnrefQueue::Drain() {
   }
 }
 
+void SkiaUnrefQueue::UpdateResourceContext(fml::WeakPtr<GrContext> context) {
+  FML_DCHECK(task_runner_->RunsTasksOnCurrentThread());
+  context_ = std::move(context);
+}
+
 }  // namespace flutter
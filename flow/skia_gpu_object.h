@@ -29,6 +29,11 @@ class SkiaUnrefQueue : public fml::RefCountedThreadSafe<SkiaUnrefQueue> {
   // after this call.
   void Drain();
 
+  // Replaces the context signaled after objects are drained. This is used when
+  // the queue is created before the resource context is available. Must be
+  // called on the task runner of the queue.
+  void UpdateResourceContext(fml::WeakPtr<GrContext> context);
+
  private:
   const fml::RefPtr<fml::TaskRunner> task_runner_;
   const fml::TimeDelta drain_delay_;
@@ -11,12 +11,14 @@ MockLayer::MockLayer(SkPath path,
                      SkPaint paint,
                      bool fake_has_platform_view,
                      bool fake_needs_system_composite,
-                     bool fake_reads_surface)
+                     bool fake_reads_surface,
+                     bool fake_opaque)
     : fake_paint_path_(path),
       fake_paint_(paint),
       fake_has_platform_view_(fake_has_platform_view),
       fake_needs_system_composite_(fake_needs_system_composite),
-      fake_reads_surface_(fake_reads_surface) {}
+      fake_reads_surface_(fake_reads_surface),
+      fake_opaque_(fake_opaque) {}
 
 void MockLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   parent_mutators_ = context->mutators_stack;
@@ -31,6 +33,10 @@ void MockLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   if (fake_reads_surface_) {
     context->surface_needs_readback = true;
   }
+  if (fake_opaque_) {
+    set_opaque_device_bounds(
+        MapOpaqueRect(matrix, fake_paint_path_.getBounds()));
+  }
 }
 
 void MockLayer::Paint(PaintContext& context) const {
@@ -20,7 +20,8 @@ class MockLayer : public Layer {
             SkPaint paint = SkPaint(),
             bool fake_has_platform_view = false,
             bool fake_needs_system_composite = false,
-            bool fake_reads_surface = false);
+            bool fake_reads_surface = false,
+            bool fake_opaque = false);
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) const override;
@@ -42,6 +43,7 @@ class MockLayer : public Layer {
   bool fake_has_platform_view_ = false;
   bool fake_needs_system_composite_ = false;
   bool fake_reads_surface_ = false;
+  bool fake_opaque_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(MockLayer);
 };
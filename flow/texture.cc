@@ -13,29 +13,75 @@ Texture::~Texture() = default;
 TextureRegistry::TextureRegistry() = default;
 
 void TextureRegistry::RegisterTexture(std::shared_ptr<Texture> texture) {
-  mapping_[texture->Id()] = texture;
+  const int64_t id = texture->Id();
+  mapping_[id] = {std::move(texture)};
 }
 
 void TextureRegistry::UnregisterTexture(int64_t id) {
-  mapping_[id]->OnTextureUnregistered();
-  mapping_.erase(id);
+  auto it = mapping_.find(id);
+  if (it == mapping_.end()) {
+    return;
+  }
+  it->second.texture->OnTextureUnregistered();
+  mapping_.erase(it);
 }
 
 void TextureRegistry::OnGrContextCreated() {
   for (auto& it : mapping_) {
-    it.second->OnGrContextCreated();
+    it.second.texture->OnGrContextCreated();
   }
 }
 
 void TextureRegistry::OnGrContextDestroyed() {
   for (auto& it : mapping_) {
-    it.second->OnGrContextDestroyed();
+    it.second.texture->OnGrContextDestroyed();
   }
 }
 
 std::shared_ptr<Texture> TextureRegistry::GetTexture(int64_t id) {
   auto it = mapping_.find(id);
-  return it != mapping_.end() ? it->second : nullptr;
+  return it != mapping_.end() ? it->second.texture : nullptr;
+}
+
+bool TextureRegistry::MarkNewFrameAvailable(int64_t id) {
+  auto it = mapping_.find(id);
+  if (it == mapping_.end()) {
+    return false;
+  }
+  Entry& entry = it->second;
+  entry.texture->MarkNewFrameAvailable();
+
+  const fml::TimePoint now = fml::TimePoint::Now();
+  TextureFrameInfo& info = entry.frame_info;
+  if (info.frame_count > 0) {
+    const fml::TimeDelta interval = now - info.last_frame_time;
+    info.average_frame_interval =
+        info.frame_count == 1
+            ? interval
+            : (info.average_frame_interval * 3 + interval) / 4;
+  }
+  info.frame_count++;
+  info.last_frame_time = now;
+
+  return entry.painted;
+}
+
+void TextureRegistry::BeginFrame() {
+  for (auto& it : mapping_) {
+    it.second.painted = false;
+  }
+}
+
+void TextureRegistry::MarkPainted(int64_t id) {
+  auto it = mapping_.find(id);
+  if (it != mapping_.end()) {
+    it->second.painted = true;
+  }
+}
+
+TextureFrameInfo TextureRegistry::GetFrameInfo(int64_t id) const {
+  auto it = mapping_.find(id);
+  return it != mapping_.end() ? it->second.frame_info : TextureFrameInfo();
 }
 
 }  // namespace flutter
@@ -9,6 +9,8 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 
 namespace flutter {
@@ -44,6 +46,15 @@ class Texture {
   FML_DISALLOW_COPY_AND_ASSIGN(Texture);
 };
 
+// The new frames a texture was marked to have, as tracked by the
+// |TextureRegistry|.
+struct TextureFrameInfo {
+  size_t frame_count = 0;
+  fml::TimePoint last_frame_time;
+  // A moving average of the time between new frames.
+  fml::TimeDelta average_frame_interval;
+};
+
 class TextureRegistry {
  public:
   TextureRegistry();
@@ -63,8 +74,31 @@ class TextureRegistry {
   // Called from GPU thread.
   void OnGrContextDestroyed();
 
+  // Called from GPU thread when a texture has a new frame. Returns whether a
+  // frame must be drawn to show it, which is only the case if the texture was
+  // painted in the last frame. Textures that are off screen, hidden or frozen
+  // get new frames without any being drawn.
+  bool MarkNewFrameAvailable(int64_t id);
+
+  // Called from GPU thread when a frame starts being painted.
+  void BeginFrame();
+
+  // Called from GPU thread when a texture is painted in the current frame.
+  void MarkPainted(int64_t id);
+
+  // Called from GPU thread.
+  TextureFrameInfo GetFrameInfo(int64_t id) const;
+
  private:
-  std::map<int64_t, std::shared_ptr<Texture>> mapping_;
+  struct Entry {
+    std::shared_ptr<Texture> texture;
+    TextureFrameInfo frame_info;
+    // Whether the texture was painted in the frame being painted or, between
+    // frames, in the last one.
+    bool painted = false;
+  };
+
+  std::map<int64_t, Entry> mapping_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(TextureRegistry);
 };
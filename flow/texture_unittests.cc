@@ -95,5 +95,47 @@ TEST(TextureRegistryTest, ReuseSameTextureSlot) {
   ASSERT_TRUE(mock_texture2->unregistered());
 }
 
+TEST(TextureRegistryTest, NewFramesOnlyNeedDrawingWhenPainted) {
+  TextureRegistry registry;
+  registry.RegisterTexture(std::make_shared<MockTexture>(0));
+
+  // Not painted yet, like a texture that is off screen.
+  ASSERT_FALSE(registry.MarkNewFrameAvailable(0));
+
+  registry.BeginFrame();
+  registry.MarkPainted(0);
+  ASSERT_TRUE(registry.MarkNewFrameAvailable(0));
+  ASSERT_TRUE(registry.MarkNewFrameAvailable(0));
+
+  // A frame without the texture, like one where it is frozen.
+  registry.BeginFrame();
+  ASSERT_FALSE(registry.MarkNewFrameAvailable(0));
+
+  ASSERT_FALSE(registry.MarkNewFrameAvailable(1));
+  registry.MarkPainted(1);
+  registry.UnregisterTexture(1);
+}
+
+TEST(TextureRegistryTest, TracksNewFrames) {
+  TextureRegistry registry;
+  registry.RegisterTexture(std::make_shared<MockTexture>(0));
+  ASSERT_EQ(registry.GetFrameInfo(0).frame_count, 0u);
+
+  registry.MarkNewFrameAvailable(0);
+  const fml::TimePoint first_frame_time =
+      registry.GetFrameInfo(0).last_frame_time;
+  registry.MarkNewFrameAvailable(0);
+  const TextureFrameInfo info = registry.GetFrameInfo(0);
+  ASSERT_EQ(info.frame_count, 2u);
+  ASSERT_GE(info.last_frame_time, first_frame_time);
+  ASSERT_EQ(info.average_frame_interval,
+            info.last_frame_time - first_frame_time);
+
+  // Registering a texture again starts over.
+  registry.RegisterTexture(std::make_shared<MockTexture>(0));
+  ASSERT_EQ(registry.GetFrameInfo(0).frame_count, 0u);
+  ASSERT_EQ(registry.GetFrameInfo(1).frame_count, 0u);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -21,6 +21,7 @@
 
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_recorder.h"
 
 namespace fml {
 
@@ -72,6 +73,7 @@ void Thread::SetCurrentThreadName(const std::string& name) {
   if (name == "") {
     return;
   }
+  tracing::TraceRecorder::GetInstance().SetCurrentThreadName(name);
 #if OS_MACOSX
   pthread_setname_np(name.c_str());
 #elif OS_LINUX || OS_ANDROID
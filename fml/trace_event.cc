@@ -6,10 +6,12 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cstdlib>
 #include <utility>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_recorder.h"
 
 namespace fml {
 namespace tracing {
@@ -19,12 +21,68 @@ size_t TraceNonce() {
   return ++gLastItem;
 }
 
+static void RecordEvent(TraceRecorder::Phase phase,
+                        TraceArg category_group,
+                        TraceArg name,
+                        TraceIDArg id) {
+  if (TraceRecorder::IsEnabled()) {
+    TraceRecorder::GetInstance().AddEvent(phase, category_group, name, id);
+  }
+}
+
+static void RecordTimelineEvent(TraceArg category_group,
+                                TraceArg name,
+                                TraceIDArg identifier,
+                                Dart_Timeline_Event_Type type,
+                                const std::vector<const char*>& c_names,
+                                const std::vector<std::string>& values) {
+  if (!TraceRecorder::IsEnabled()) {
+    return;
+  }
+
+  auto& recorder = TraceRecorder::GetInstance();
+  switch (type) {
+    case Dart_Timeline_Event_Counter: {
+      const auto argument_count = std::min(c_names.size(), values.size());
+      for (size_t i = 0; i < argument_count; i++) {
+        recorder.AddCounter(category_group, name, identifier, c_names[i],
+                            std::strtod(values[i].c_str(), nullptr));
+      }
+      break;
+    }
+    case Dart_Timeline_Event_Begin:
+      recorder.AddEvent(TraceRecorder::Phase::kBegin, category_group, name,
+                        identifier);
+      break;
+    case Dart_Timeline_Event_End:
+      recorder.AddEvent(TraceRecorder::Phase::kEnd, category_group, name,
+                        identifier);
+      break;
+    case Dart_Timeline_Event_Instant:
+      recorder.AddEvent(TraceRecorder::Phase::kInstant, category_group, name,
+                        identifier);
+      break;
+    case Dart_Timeline_Event_Async_Begin:
+      recorder.AddEvent(TraceRecorder::Phase::kAsyncBegin, category_group,
+                        name, identifier);
+      break;
+    case Dart_Timeline_Event_Async_End:
+      recorder.AddEvent(TraceRecorder::Phase::kAsyncEnd, category_group, name,
+                        identifier);
+      break;
+    default:
+      break;
+  }
+}
+
 void TraceTimelineEvent(TraceArg category_group,
                         TraceArg name,
                         TraceIDArg identifier,
                         Dart_Timeline_Event_Type type,
                         const std::vector<const char*>& c_names,
                         const std::vector<std::string>& values) {
+  RecordTimelineEvent(category_group, name, identifier, type, c_names, values);
+
   const auto argument_count = std::min(c_names.size(), values.size());
 
   std::vector<const char*> c_values;
@@ -46,6 +104,7 @@ void TraceTimelineEvent(TraceArg category_group,
 }
 
 void TraceEvent0(TraceArg category_group, TraceArg name) {
+  RecordEvent(TraceRecorder::Phase::kBegin, category_group, name, 0);
   Dart_TimelineEvent(name,                       // label
                      Dart_TimelineGetMicros(),   // timestamp0
                      0,                          // timestamp1_or_async_id
@@ -60,6 +119,7 @@ void TraceEvent1(TraceArg category_group,
                  TraceArg name,
                  TraceArg arg1_name,
                  TraceArg arg1_val) {
+  RecordEvent(TraceRecorder::Phase::kBegin, category_group, name, 0);
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
   Dart_TimelineEvent(name,                       // label
@@ -78,6 +138,7 @@ void TraceEvent2(TraceArg category_group,
                  TraceArg arg1_val,
                  TraceArg arg2_name,
                  TraceArg arg2_val) {
+  RecordEvent(TraceRecorder::Phase::kBegin, category_group, name, 0);
   const char* arg_names[] = {arg1_name, arg2_name};
   const char* arg_values[] = {arg1_val, arg2_val};
   Dart_TimelineEvent(name,                       // label
@@ -91,6 +152,7 @@ void TraceEvent2(TraceArg category_group,
 }
 
 void TraceEventEnd(TraceArg name) {
+  RecordEvent(TraceRecorder::Phase::kEnd, nullptr, name, 0);
   Dart_TimelineEvent(name,                      // label
                      Dart_TimelineGetMicros(),  // timestamp0
                      0,                         // timestamp1_or_async_id
@@ -111,6 +173,14 @@ void TraceEventAsyncComplete(TraceArg category_group,
     std::swap(begin, end);
   }
 
+  if (TraceRecorder::IsEnabled()) {
+    auto& recorder = TraceRecorder::GetInstance();
+    recorder.AddEvent(TraceRecorder::Phase::kAsyncBegin, category_group, name,
+                      identifier, begin);
+    recorder.AddEvent(TraceRecorder::Phase::kAsyncEnd, category_group, name,
+                      identifier, end);
+  }
+
   Dart_TimelineEvent(name,                                   // label
                      begin.ToEpochDelta().ToMicroseconds(),  // timestamp0
                      identifier,                       // timestamp1_or_async_id
@@ -132,6 +202,7 @@ void TraceEventAsyncComplete(TraceArg category_group,
 void TraceEventAsyncBegin0(TraceArg category_group,
                            TraceArg name,
                            TraceIDArg id) {
+  RecordEvent(TraceRecorder::Phase::kAsyncBegin, category_group, name, id);
   Dart_TimelineEvent(name,                             // label
                      Dart_TimelineGetMicros(),         // timestamp0
                      id,                               // timestamp1_or_async_id
@@ -145,6 +216,7 @@ void TraceEventAsyncBegin0(TraceArg category_group,
 void TraceEventAsyncEnd0(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id) {
+  RecordEvent(TraceRecorder::Phase::kAsyncEnd, category_group, name, id);
   Dart_TimelineEvent(name,                           // label
                      Dart_TimelineGetMicros(),       // timestamp0
                      id,                             // timestamp1_or_async_id
@@ -160,6 +232,7 @@ void TraceEventAsyncBegin1(TraceArg category_group,
                            TraceIDArg id,
                            TraceArg arg1_name,
                            TraceArg arg1_val) {
+  RecordEvent(TraceRecorder::Phase::kAsyncBegin, category_group, name, id);
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
   Dart_TimelineEvent(name,                             // label
@@ -177,6 +250,7 @@ void TraceEventAsyncEnd1(TraceArg category_group,
                          TraceIDArg id,
                          TraceArg arg1_name,
                          TraceArg arg1_val) {
+  RecordEvent(TraceRecorder::Phase::kAsyncEnd, category_group, name, id);
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
   Dart_TimelineEvent(name,                           // label
@@ -190,6 +264,7 @@ void TraceEventAsyncEnd1(TraceArg category_group,
 }
 
 void TraceEventInstant0(TraceArg category_group, TraceArg name) {
+  RecordEvent(TraceRecorder::Phase::kInstant, category_group, name, 0);
   Dart_TimelineEvent(name,                         // label
                      Dart_TimelineGetMicros(),     // timestamp0
                      0,                            // timestamp1_or_async_id
@@ -203,6 +278,7 @@ void TraceEventInstant0(TraceArg category_group, TraceArg name) {
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
                           TraceIDArg id) {
+  RecordEvent(TraceRecorder::Phase::kFlowBegin, category_group, name, id);
   Dart_TimelineEvent(name,                            // label
                      Dart_TimelineGetMicros(),        // timestamp0
                      id,                              // timestamp1_or_async_id
@@ -216,6 +292,7 @@ void TraceEventFlowBegin0(TraceArg category_group,
 void TraceEventFlowStep0(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id) {
+  RecordEvent(TraceRecorder::Phase::kFlowStep, category_group, name, id);
   Dart_TimelineEvent(name,                           // label
                      Dart_TimelineGetMicros(),       // timestamp0
                      id,                             // timestamp1_or_async_id
@@ -227,6 +304,7 @@ void TraceEventFlowStep0(TraceArg category_group,
 }
 
 void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
+  RecordEvent(TraceRecorder::Phase::kFlowEnd, category_group, name, id);
   Dart_TimelineEvent(name,                          // label
                      Dart_TimelineGetMicros(),      // timestamp0
                      id,                            // timestamp1_or_async_id
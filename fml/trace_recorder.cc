@@ -0,0 +1,360 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_recorder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <sstream>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/thread_local.h"
+
+namespace fml {
+namespace tracing {
+
+// Thread local state of the recorder. Caches the interned copies of the names
+// used by the thread so that recording an event only takes the recorder lock
+// the first time a name is seen.
+class TraceRecorder::ThreadState {
+ public:
+  static constexpr size_t kInternCacheSize = 64;
+
+  struct InternCacheEntry {
+    const char* key = nullptr;
+    const char* interned = nullptr;
+  };
+
+  ThreadState() = default;
+
+  ~ThreadState() {
+    if (buffer != nullptr) {
+      TraceRecorder::GetInstance().ReleaseThreadBuffer(buffer);
+    }
+  }
+
+  ThreadBuffer* buffer = nullptr;
+  std::string thread_name;
+  InternCacheEntry intern_cache[kInternCacheSize];
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadState);
+};
+
+std::atomic_bool TraceRecorder::enabled_ = {false};
+
+TraceRecorder& TraceRecorder::GetInstance() {
+  // Intentionally leaked. Threads may still be recording or releasing their
+  // buffers while the process shuts down.
+  static TraceRecorder* recorder = new TraceRecorder();
+  return *recorder;
+}
+
+TraceRecorder::ThreadBuffer::ThreadBuffer(size_t capacity) : events(capacity) {}
+
+TraceRecorder::TraceRecorder() : events_per_thread_(kDefaultEventsPerThread) {}
+
+TraceRecorder::~TraceRecorder() = default;
+
+void TraceRecorder::Enable(size_t events_per_thread,
+                           size_t max_interned_strings) {
+  events_per_thread_.store(events_per_thread);
+  {
+    std::scoped_lock lock(mutex_);
+    max_interned_strings_ = max_interned_strings;
+  }
+  enabled_.store(true);
+}
+
+void TraceRecorder::Disable() {
+  enabled_.store(false);
+}
+
+void TraceRecorder::Clear() {
+  std::scoped_lock lock(mutex_);
+  for (const auto& buffer : buffers_) {
+    buffer->start_index.store(buffer->write_index.load());
+  }
+}
+
+TraceRecorder::ThreadState& TraceRecorder::GetThreadState() {
+  FML_THREAD_LOCAL ThreadLocalUniquePtr<ThreadState> tls_thread_state;
+  auto* state = tls_thread_state.get();
+  if (state == nullptr) {
+    state = new ThreadState();
+    tls_thread_state.reset(state);
+  }
+  return *state;
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::AcquireThreadBuffer(
+    const std::string& thread_name) {
+  std::scoped_lock lock(mutex_);
+  ThreadBuffer* buffer = nullptr;
+  const auto capacity = std::max<size_t>(events_per_thread_.load(), 1);
+  // Reuse the buffers of threads that have exited so that short lived threads
+  // don't grow the recorder without bounds. The events of the exited thread
+  // are discarded as they would otherwise be exported as the events of the
+  // new thread. No thread writes to the buffer and readers hold the lock, so
+  // the indices may be reset.
+  for (const auto& candidate : buffers_) {
+    if (!candidate->in_use && candidate->events.size() == capacity) {
+      buffer = candidate.get();
+      buffer->write_index.store(0);
+      buffer->pending_index.store(0);
+      buffer->start_index.store(0);
+      break;
+    }
+  }
+  if (buffer == nullptr) {
+    buffers_.emplace_back(std::make_unique<ThreadBuffer>(capacity));
+    buffer = buffers_.back().get();
+  }
+  buffer->in_use = true;
+  buffer->thread_id = next_thread_id_++;
+  buffer->thread_name = thread_name;
+  return buffer;
+}
+
+void TraceRecorder::ReleaseThreadBuffer(ThreadBuffer* buffer) {
+  std::scoped_lock lock(mutex_);
+  buffer->in_use = false;
+}
+
+void TraceRecorder::SetCurrentThreadName(const std::string& name) {
+  auto& state = GetThreadState();
+  state.thread_name = name;
+  if (state.buffer != nullptr) {
+    std::scoped_lock lock(mutex_);
+    state.buffer->thread_name = name;
+  }
+}
+
+const char* TraceRecorder::Intern(ThreadState& state, const char* string) {
+  if (string == nullptr) {
+    return nullptr;
+  }
+
+  // Names are almost always string literals, so the pointer is a good cache
+  // key. The contents are compared as well since callers may also pass
+  // temporary strings whose storage gets reused.
+  auto& entry = state.intern_cache[std::hash<const char*>{}(string) %
+                                   ThreadState::kInternCacheSize];
+  if (entry.key == string && ::strcmp(entry.interned, string) == 0) {
+    return entry.interned;
+  }
+
+  const char* interned = nullptr;
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = interned_strings_.find(string);
+    if (found != interned_strings_.end()) {
+      interned = found->c_str();
+    } else if (interned_strings_.size() < max_interned_strings_) {
+      interned = interned_strings_.emplace(string).first->c_str();
+    } else {
+      // Not cached, the name may be interned once the limit is raised.
+      return kDroppedName;
+    }
+  }
+  entry.key = string;
+  entry.interned = interned;
+  return interned;
+}
+
+void TraceRecorder::Append(ThreadState& state, const Event& event) {
+  if (state.buffer == nullptr) {
+    state.buffer = AcquireThreadBuffer(state.thread_name);
+  }
+  auto* buffer = state.buffer;
+  const auto index = buffer->write_index.load(std::memory_order_relaxed);
+  buffer->pending_index.store(index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  buffer->events[index % buffer->events.size()] = event;
+  buffer->write_index.store(index + 1, std::memory_order_release);
+}
+
+void TraceRecorder::AddEvent(Phase phase,
+                             const char* category,
+                             const char* name,
+                             int64_t id,
+                             TimePoint timestamp) {
+  auto& state = GetThreadState();
+  Event event;
+  event.timestamp = timestamp.ToEpochDelta().ToMicroseconds();
+  event.id = id;
+  event.category = Intern(state, category);
+  event.name = Intern(state, name);
+  event.phase = phase;
+  Append(state, event);
+}
+
+void TraceRecorder::AddCounter(const char* category,
+                               const char* name,
+                               int64_t id,
+                               const char* arg_name,
+                               double value) {
+  auto& state = GetThreadState();
+  Event event;
+  event.timestamp = TimePoint::Now().ToEpochDelta().ToMicroseconds();
+  event.id = id;
+  event.category = Intern(state, category);
+  event.name = Intern(state, name);
+  event.arg_name = Intern(state, arg_name);
+  event.value = value;
+  event.phase = Phase::kCounter;
+  Append(state, event);
+}
+
+size_t TraceRecorder::GetEventCount() const {
+  std::scoped_lock lock(mutex_);
+  size_t count = 0;
+  for (const auto& buffer : buffers_) {
+    const auto end = buffer->write_index.load(std::memory_order_acquire);
+    const auto start = buffer->start_index.load();
+    const auto capacity = buffer->events.size();
+    count += std::min<uint64_t>(end - std::min(start, end), capacity);
+  }
+  return count;
+}
+
+size_t TraceRecorder::GetInternedStringCount() const {
+  std::scoped_lock lock(mutex_);
+  return interned_strings_.size();
+}
+
+static void WriteJSONString(std::ostream& stream, const char* string) {
+  stream << '"';
+  for (const char* c = string; *c != '\0'; c++) {
+    switch (*c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      case '\n':
+        stream << "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20) {
+          stream << ' ';
+        } else {
+          stream << *c;
+        }
+        break;
+    }
+  }
+  stream << '"';
+}
+
+std::string TraceRecorder::ExportChromeTraceJSON() const {
+  constexpr int kProcessID = 1;
+  std::ostringstream stream;
+  bool first = true;
+  auto separator = [&]() -> std::ostream& {
+    stream << (first ? "\n" : ",\n");
+    first = false;
+    return stream;
+  };
+
+  stream << "{\"traceEvents\":[";
+
+  std::scoped_lock lock(mutex_);
+  std::vector<Event> events;
+  for (const auto& buffer : buffers_) {
+    const auto capacity = buffer->events.size();
+    const auto end = buffer->write_index.load(std::memory_order_acquire);
+    auto begin = std::max<uint64_t>(buffer->start_index.load(),
+                                    end > capacity ? end - capacity : 0);
+    if (begin >= end) {
+      continue;
+    }
+
+    events.clear();
+    for (auto index = begin; index < end; index++) {
+      events.push_back(buffer->events[index % capacity]);
+    }
+
+    // The owning thread may have kept recording while the events were copied.
+    // Drop the copies of slots it may have overwritten in the meantime.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const auto pending = buffer->pending_index.load(std::memory_order_relaxed);
+    const auto first_valid = pending > capacity ? pending - capacity : 0;
+    const auto skip = first_valid > begin
+                          ? std::min<uint64_t>(first_valid - begin, end - begin)
+                          : 0;
+
+    const auto tid = buffer->thread_id;
+    if (!buffer->thread_name.empty()) {
+      separator() << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":"
+                  << kProcessID << ",\"tid\":" << tid << ",\"args\":{\"name\":";
+      WriteJSONString(stream, buffer->thread_name.c_str());
+      stream << "}}";
+    }
+
+    for (size_t i = skip; i < events.size(); i++) {
+      const auto& event = events[i];
+      separator() << "{\"ph\":\"" << static_cast<char>(event.phase)
+                  << "\",\"pid\":" << kProcessID << ",\"tid\":" << tid
+                  << ",\"ts\":" << event.timestamp;
+      if (event.name != nullptr) {
+        stream << ",\"name\":";
+        WriteJSONString(stream, event.name);
+      }
+      if (event.category != nullptr) {
+        stream << ",\"cat\":";
+        WriteJSONString(stream, event.category);
+      }
+      switch (event.phase) {
+        case Phase::kAsyncBegin:
+        case Phase::kAsyncEnd:
+        case Phase::kFlowBegin:
+        case Phase::kFlowStep:
+          stream << ",\"id\":\"" << event.id << "\"";
+          break;
+        case Phase::kFlowEnd:
+          stream << ",\"id\":\"" << event.id << "\",\"bp\":\"e\"";
+          break;
+        case Phase::kInstant:
+          stream << ",\"s\":\"t\"";
+          break;
+        case Phase::kCounter:
+          if (event.id != 0) {
+            stream << ",\"id\":\"" << event.id << "\"";
+          }
+          stream << ",\"args\":{";
+          WriteJSONString(stream,
+                          event.arg_name != nullptr ? event.arg_name : "value");
+          stream << ":" << (std::isfinite(event.value) ? event.value : 0.0)
+                 << "}";
+          break;
+        case Phase::kBegin:
+        case Phase::kEnd:
+          break;
+      }
+      stream << "}";
+    }
+  }
+
+  stream << "\n]}\n";
+  return stream.str();
+}
+
+bool TraceRecorder::WriteChromeTrace(const UniqueFD& directory,
+                                     const char* file_name) const {
+  auto json = ExportChromeTraceJSON();
+  if (!fml::WriteAtomically(directory, file_name,
+                            fml::DataMapping(json))) {
+    FML_LOG(ERROR) << "Could not write the trace to " << file_name;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,196 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_RECORDER_H_
+#define FLUTTER_FML_TRACE_RECORDER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace fml {
+namespace tracing {
+
+//------------------------------------------------------------------------------
+/// @brief      Records trace events in memory independently of the Dart VM
+///             timeline so that the recent history of the engine can be
+///             inspected after the fact, for instance when a frame misses its
+///             deadline on a device in the field.
+///
+///             Each thread writes into its own fixed size ring buffer. Writes
+///             don't take locks and don't allocate once the buffer for a
+///             thread and the names it uses have been set up. Event names and
+///             categories are interned so that only pointers are stored per
+///             event. Event arguments other than counter values are not
+///             recorded.
+///
+///             When the recorder is disabled, the cost of a trace event is a
+///             single relaxed atomic load.
+///
+class TraceRecorder {
+ public:
+  enum class Phase : char {
+    kBegin = 'B',
+    kEnd = 'E',
+    kInstant = 'i',
+    kAsyncBegin = 'b',
+    kAsyncEnd = 'e',
+    kFlowBegin = 's',
+    kFlowStep = 't',
+    kFlowEnd = 'f',
+    kCounter = 'C',
+  };
+
+  // The number of events retained per thread unless specified otherwise.
+  static constexpr size_t kDefaultEventsPerThread = 8192;
+
+  // The number of distinct names interned unless specified otherwise. Names
+  // are never freed, so this bounds the memory used by names built at runtime
+  // while recording is always on.
+  static constexpr size_t kDefaultMaxInternedStrings = 4096;
+
+  // Recorded in place of names seen after the interned names hit their limit.
+  static constexpr char kDroppedName[] = "(dropped trace name)";
+
+  static TraceRecorder& GetInstance();
+
+  static bool IsEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts recording events.
+  ///
+  /// @param[in]  events_per_thread     The capacity of the ring buffer of each
+  ///                                   thread. Only used for threads that have
+  ///                                   not recorded events before.
+  /// @param[in]  max_interned_strings  The number of distinct names after
+  ///                                   which new names are recorded as
+  ///                                   |kDroppedName|.
+  ///
+  void Enable(size_t events_per_thread = kDefaultEventsPerThread,
+              size_t max_interned_strings = kDefaultMaxInternedStrings);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stops recording events. Events already recorded are retained
+  ///             and can still be exported.
+  ///
+  void Disable();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Discards all events recorded so far.
+  ///
+  void Clear();
+
+  void AddEvent(Phase phase,
+                const char* category,
+                const char* name,
+                int64_t id,
+                TimePoint timestamp = TimePoint::Now());
+
+  void AddCounter(const char* category,
+                  const char* name,
+                  int64_t id,
+                  const char* arg_name,
+                  double value);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Associates a name with the calling thread in exported traces.
+  ///
+  void SetCurrentThreadName(const std::string& name);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Serializes the recorded events in the Chrome trace event JSON
+  ///             format, which can be loaded in chrome://tracing and Perfetto.
+  ///             This may be called on any thread while events are being
+  ///             recorded. Events overwritten while exporting are dropped.
+  ///
+  std::string ExportChromeTraceJSON() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the output of |ExportChromeTraceJSON| to a file.
+  ///
+  /// @return     If the file was written successfully.
+  ///
+  bool WriteChromeTrace(const UniqueFD& directory, const char* file_name) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of events currently held by all threads. Exposed
+  ///             for testing.
+  ///
+  size_t GetEventCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of distinct names interned so far. Exposed for
+  ///             testing.
+  ///
+  size_t GetInternedStringCount() const;
+
+ private:
+  struct Event {
+    int64_t timestamp = 0;
+    int64_t id = 0;
+    const char* category = nullptr;
+    const char* name = nullptr;
+    const char* arg_name = nullptr;
+    double value = 0;
+    Phase phase = Phase::kInstant;
+  };
+
+  struct ThreadBuffer {
+    explicit ThreadBuffer(size_t capacity);
+
+    std::vector<Event> events;
+    // Total number of events written. Only the owning thread writes this.
+    std::atomic<uint64_t> write_index = {0};
+    // Set before an event is written so that readers can tell which slot may
+    // be in the middle of being overwritten.
+    std::atomic<uint64_t> pending_index = {0};
+    // Events before this index have been discarded by |Clear|.
+    std::atomic<uint64_t> start_index = {0};
+    // Guarded by |TraceRecorder::mutex_|.
+    int64_t thread_id = 0;
+    std::string thread_name;
+    bool in_use = true;
+  };
+
+  class ThreadState;
+
+  static std::atomic_bool enabled_;
+
+  mutable std::mutex mutex_;
+  std::atomic<size_t> events_per_thread_;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+  std::unordered_set<std::string> interned_strings_;
+  size_t max_interned_strings_ = kDefaultMaxInternedStrings;
+  int64_t next_thread_id_ = 1;
+
+  TraceRecorder();
+
+  ~TraceRecorder();
+
+  ThreadState& GetThreadState();
+
+  ThreadBuffer* AcquireThreadBuffer(const std::string& thread_name);
+
+  void ReleaseThreadBuffer(ThreadBuffer* buffer);
+
+  const char* Intern(ThreadState& state, const char* string);
+
+  void Append(ThreadState& state, const Event& event);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TraceRecorder);
+};
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_RECORDER_H_
@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_recorder.h"
+
+namespace fml {
+namespace benchmarking {
+
+static void TraceEvents(benchmark::State& state, bool record) {
+  auto& recorder = tracing::TraceRecorder::GetInstance();
+  if (record) {
+    recorder.Enable();
+  }
+  while (state.KeepRunning()) {
+    TRACE_EVENT0("flutter", "TraceRecorderBenchmark");
+  }
+  recorder.Disable();
+  recorder.Clear();
+}
+
+static void BM_TraceEventWithoutRecorder(benchmark::State& state) {
+  TraceEvents(state, false);
+}
+
+BENCHMARK(BM_TraceEventWithoutRecorder);
+
+static void BM_TraceEventWithRecorder(benchmark::State& state) {
+  TraceEvents(state, true);
+}
+
+BENCHMARK(BM_TraceEventWithRecorder);
+
+static void BM_TraceRecorderExport(benchmark::State& state) {
+  auto& recorder = tracing::TraceRecorder::GetInstance();
+  recorder.Enable();
+  for (size_t i = 0; i < tracing::TraceRecorder::kDefaultEventsPerThread; i++) {
+    TRACE_EVENT0("flutter", "TraceRecorderBenchmark");
+  }
+  recorder.Disable();
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(recorder.ExportChromeTraceJSON());
+  }
+  recorder.Clear();
+}
+
+BENCHMARK(BM_TraceRecorderExport)->Unit(benchmark::kMillisecond);
+
+}  // namespace benchmarking
+}  // namespace fml
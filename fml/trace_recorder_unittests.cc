@@ -0,0 +1,162 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <thread>
+
+#include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_recorder.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+class ScopedTraceRecorder {
+ public:
+  explicit ScopedTraceRecorder(
+      size_t events_per_thread = TraceRecorder::kDefaultEventsPerThread) {
+    TraceRecorder::GetInstance().Enable(events_per_thread);
+    TraceRecorder::GetInstance().Clear();
+  }
+
+  ~ScopedTraceRecorder() {
+    TraceRecorder::GetInstance().Disable();
+    TraceRecorder::GetInstance().Clear();
+  }
+
+ private:
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedTraceRecorder);
+};
+
+static bool Contains(const std::string& string, const std::string& substring) {
+  return string.find(substring) != std::string::npos;
+}
+
+TEST(TraceRecorderTest, DoesNotRecordWhenDisabled) {
+  TraceRecorder::GetInstance().Clear();
+  ASSERT_FALSE(TraceRecorder::IsEnabled());
+  { TRACE_EVENT0("flutter", "TraceRecorderTest"); }
+  ASSERT_EQ(TraceRecorder::GetInstance().GetEventCount(), 0u);
+}
+
+TEST(TraceRecorderTest, RecordsTraceEvents) {
+  ScopedTraceRecorder recorder;
+  { TRACE_EVENT0("flutter", "TraceRecorderTest"); }
+  TRACE_EVENT_INSTANT0("flutter", "TraceRecorderInstant");
+  ASSERT_EQ(TraceRecorder::GetInstance().GetEventCount(), 3u);
+}
+
+TEST(TraceRecorderTest, ExportsChromeTraceJSON) {
+  ScopedTraceRecorder recorder;
+  { TRACE_EVENT1("flutter", "TraceRecorderTest", "key", "value"); }
+  FML_TRACE_COUNTER("flutter", "TraceRecorderCounter", 0, "Items", 42);
+  { TraceFlow flow("TraceRecorderFlow"); }
+
+  const auto json = TraceRecorder::GetInstance().ExportChromeTraceJSON();
+  ASSERT_TRUE(Contains(json, "{\"traceEvents\":["));
+  ASSERT_TRUE(Contains(json, "\"ph\":\"B\""));
+  ASSERT_TRUE(Contains(json, "\"ph\":\"E\""));
+  ASSERT_TRUE(Contains(json, "\"name\":\"TraceRecorderTest\""));
+  ASSERT_TRUE(Contains(json, "\"cat\":\"flutter\""));
+  ASSERT_TRUE(Contains(json, "\"args\":{\"Items\":42}"));
+  ASSERT_TRUE(Contains(json, "\"ph\":\"s\""));
+  ASSERT_TRUE(Contains(json, "\"ph\":\"f\""));
+}
+
+TEST(TraceRecorderTest, RingBufferKeepsMostRecentEvents) {
+  ScopedTraceRecorder recorder(4);
+  std::thread thread([] {
+    for (int i = 0; i < 10; i++) {
+      TraceRecorder::GetInstance().AddCounter("flutter", "Counter", 0, "Value",
+                                              i);
+    }
+  });
+  thread.join();
+
+  const auto json = TraceRecorder::GetInstance().ExportChromeTraceJSON();
+  ASSERT_EQ(TraceRecorder::GetInstance().GetEventCount(), 4u);
+  ASSERT_FALSE(Contains(json, "\"Value\":5}"));
+  for (int i = 6; i < 10; i++) {
+    ASSERT_TRUE(Contains(json, "\"Value\":" + std::to_string(i) + "}"));
+  }
+}
+
+TEST(TraceRecorderTest, InternsTemporaryNames) {
+  ScopedTraceRecorder recorder;
+  std::string name = "FirstName";
+  TraceEventInstant0("flutter", name.c_str());
+  name.replace(0, 5, "Other");
+  TraceEventInstant0("flutter", name.c_str());
+
+  const auto json = TraceRecorder::GetInstance().ExportChromeTraceJSON();
+  ASSERT_TRUE(Contains(json, "\"name\":\"FirstName\""));
+  ASSERT_TRUE(Contains(json, "\"name\":\"OtherName\""));
+}
+
+TEST(TraceRecorderTest, ExportsThreadNames) {
+  ScopedTraceRecorder recorder;
+  std::thread thread([] {
+    TraceRecorder::GetInstance().SetCurrentThreadName("recorder.test");
+    TRACE_EVENT_INSTANT0("flutter", "TraceRecorderInstant");
+  });
+  thread.join();
+
+  const auto json = TraceRecorder::GetInstance().ExportChromeTraceJSON();
+  ASSERT_TRUE(Contains(json, "\"args\":{\"name\":\"recorder.test\"}"));
+}
+
+TEST(TraceRecorderTest, ReusedBuffersDropEventsOfExitedThreads) {
+  // No other test uses buffers of this size, so the second thread reuses the
+  // buffer of the first.
+  ScopedTraceRecorder recorder(3);
+  std::thread exited_thread([] {
+    TraceRecorder::GetInstance().SetCurrentThreadName("recorder.exited");
+    TRACE_EVENT_INSTANT0("flutter", "ExitedThreadInstant");
+  });
+  exited_thread.join();
+  std::thread reusing_thread([] {
+    TraceRecorder::GetInstance().SetCurrentThreadName("recorder.reusing");
+    TRACE_EVENT_INSTANT0("flutter", "ReusingThreadInstant");
+  });
+  reusing_thread.join();
+
+  const auto json = TraceRecorder::GetInstance().ExportChromeTraceJSON();
+  ASSERT_EQ(TraceRecorder::GetInstance().GetEventCount(), 1u);
+  ASSERT_TRUE(Contains(json, "\"name\":\"ReusingThreadInstant\""));
+  ASSERT_TRUE(Contains(json, "\"args\":{\"name\":\"recorder.reusing\"}"));
+  ASSERT_FALSE(Contains(json, "ExitedThreadInstant"));
+  ASSERT_FALSE(Contains(json, "recorder.exited"));
+}
+
+TEST(TraceRecorderTest, LimitsInternedNames) {
+  ScopedTraceRecorder recorder;
+  TRACE_EVENT_INSTANT0("flutter", "TraceRecorderInstant");
+  const auto count = TraceRecorder::GetInstance().GetInternedStringCount();
+  TraceRecorder::GetInstance().Enable(TraceRecorder::kDefaultEventsPerThread,
+                                      count + 1);
+
+  std::string name = "InternedName";
+  TraceEventInstant0("flutter", name.c_str());
+  name = "DroppedName";
+  TraceEventInstant0("flutter", name.c_str());
+  // Names interned before the limit was hit are still recorded.
+  TRACE_EVENT_INSTANT0("flutter", "TraceRecorderInstant");
+
+  const auto json = TraceRecorder::GetInstance().ExportChromeTraceJSON();
+  const auto interned_count =
+      TraceRecorder::GetInstance().GetInternedStringCount();
+  TraceRecorder::GetInstance().Enable();
+  ASSERT_LE(interned_count, count + 1);
+  ASSERT_EQ(TraceRecorder::GetInstance().GetEventCount(), 4u);
+  ASSERT_TRUE(Contains(json, "\"name\":\"InternedName\""));
+  ASSERT_TRUE(Contains(json, "\"name\":\"TraceRecorderInstant\""));
+  ASSERT_FALSE(Contains(json, "DroppedName"));
+  ASSERT_TRUE(Contains(json, std::string("\"name\":\"") +
+                                 TraceRecorder::kDroppedName + "\""));
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
@@ -163,7 +163,8 @@ fml::RefPtr<EngineLayer> SceneBuilder::pushImageFilter(
 }
 
 fml::RefPtr<EngineLayer> SceneBuilder::pushBackdropFilter(ImageFilter* filter) {
-  auto layer = std::make_shared<flutter::BackdropFilterLayer>(filter->filter());
+  auto layer = std::make_shared<flutter::BackdropFilterLayer>(
+      filter->filter(), filter->blur_sigma());
   PushLayer(layer);
   return EngineLayer::MakeRetained(layer);
 }
@@ -208,11 +209,9 @@ void SceneBuilder::addPicture(double dx,
                               Picture* picture,
                               int hints) {
   SkPoint offset = SkPoint::Make(dx, dy);
-  SkRect pictureRect = picture->picture()->cullRect();
-  pictureRect.offset(offset.x(), offset.y());
   auto layer = std::make_unique<flutter::PictureLayer>(
-      offset, UIDartState::CreateGPUObject(picture->picture()), !!(hints & 1),
-      !!(hints & 2));
+      offset, UIDartState::CreateGPUObject(picture->display_list()),
+      !!(hints & 1), !!(hints & 2));
   AddLayer(std::move(layer));
 }
 
@@ -347,7 +347,7 @@ void Canvas::drawPicture(Picture* picture) {
   if (!picture)
     Dart_ThrowException(
         ToDart("Canvas.drawPicture called with non-genuine Picture."));
-  canvas_->drawPicture(picture->picture().get());
+  picture->display_list()->Draw(canvas_);
 }
 
 void Canvas::drawPoints(const Paint& paint,
@@ -173,7 +173,7 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
  private:
   explicit Canvas(SkCanvas* canvas);
 
-  // The SkCanvas is supplied by a call to SkPictureRecorder::beginRecording,
+  // The SkCanvas is supplied by a call to PictureRecorder::BeginRecording,
   // which does not transfer ownership.  For this reason, we hold a raw
   // pointer and manually set to null in Clear.
   SkCanvas* canvas_;
@@ -8,6 +8,8 @@
 
 #include "flutter/fml/make_copyable.h"
 #include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/core/SkYUVAIndex.h"
+#include "third_party/skia/include/core/SkYUVASizeInfo.h"
 #include "third_party/skia/src/codec/SkCodecImageGenerator.h"
 
 namespace flutter {
@@ -15,6 +17,20 @@ namespace {
 
 constexpr double kAspectRatioChangedThreshold = 0.01;
 
+using DecodeResult =
+    std::function<void(SkiaGPUObject<SkImage>, fml::tracing::TraceFlow)>;
+
+// The planes of an image decoded into its YUV(A) components on a worker
+// thread. All planes share the same backing allocation.
+struct YUVAPlanes {
+  sk_sp<SkData> storage;
+  SkYUVASizeInfo size_info;
+  SkYUVAIndex indices[SkYUVAIndex::kIndexCount];
+  SkYUVColorSpace color_space = kJPEG_SkYUVColorSpace;
+  SkPixmap pixmaps[SkYUVASizeInfo::kMaxCount];
+  SkISize dimensions = SkISize::MakeEmpty();
+};
+
 }  // namespace
 
 ImageDecoder::ImageDecoder(
@@ -299,6 +315,206 @@ static SkiaGPUObject<SkImage> UploadRasterImage(
   return result;
 }
 
+static std::unique_ptr<YUVAPlanes> DecodeYUVAPlanes(
+    const sk_sp<SkData>& data,
+    const fml::tracing::TraceFlow& flow) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+
+  auto codec = SkCodec::MakeFromData(data);
+  if (!codec || codec->getEncodedFormat() != SkEncodedImageFormat::kJPEG) {
+    return nullptr;
+  }
+
+  // The planes are returned in encoded orientation. Images that carry an EXIF
+  // orientation take the RGBA path which applies it.
+  if (codec->getOrigin() != kTopLeft_SkEncodedOrigin) {
+    return nullptr;
+  }
+
+  auto image_generator = SkCodecImageGenerator::MakeFromCodec(std::move(codec));
+  if (!image_generator) {
+    return nullptr;
+  }
+
+  auto planes = std::make_unique<YUVAPlanes>();
+  if (!image_generator->queryYUVA8(&planes->size_info, planes->indices,
+                                   &planes->color_space)) {
+    return nullptr;
+  }
+
+  const size_t total_bytes = planes->size_info.computeTotalBytes();
+  planes->storage = SkData::MakeUninitialized(total_bytes);
+  if (!planes->storage) {
+    FML_LOG(ERROR) << "Failed to allocate memory for YUV planes of size "
+                   << total_bytes << "B";
+    return nullptr;
+  }
+
+  void* plane_addresses[SkYUVASizeInfo::kMaxCount] = {};
+  planes->size_info.computePlanes(planes->storage->writable_data(),
+                                  plane_addresses);
+
+  if (!image_generator->getYUVA8Planes(planes->size_info, planes->indices,
+                                       plane_addresses)) {
+    FML_LOG(ERROR) << "Could not decode YUV planes.";
+    return nullptr;
+  }
+
+  for (int i = 0; i < SkYUVASizeInfo::kMaxCount; i++) {
+    if (plane_addresses[i] == nullptr) {
+      continue;
+    }
+    planes->pixmaps[i].reset(SkImageInfo::MakeA8(planes->size_info.fSizes[i]),
+                             plane_addresses[i],
+                             planes->size_info.fWidthBytes[i]);
+  }
+
+  planes->dimensions = image_generator->getInfo().dimensions();
+  return planes;
+}
+
+static SkiaGPUObject<SkImage> UploadYUVAPlanes(
+    const YUVAPlanes& planes,
+    fml::WeakPtr<IOManager> io_manager,
+    const fml::tracing::TraceFlow& flow) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+
+  if (!io_manager->GetResourceContext() || !io_manager->GetSkiaUnrefQueue()) {
+    return {};
+  }
+
+  SkiaGPUObject<SkImage> result;
+  io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+      fml::SyncSwitch::Handlers().SetIfFalse(
+          [&result, &planes, context = io_manager->GetResourceContext(),
+           queue = io_manager->GetSkiaUnrefQueue()] {
+            // Each plane is uploaded as a separate texture. The conversion to
+            // RGB happens in the fragment shader when the image is drawn.
+            sk_sp<SkImage> texture_image = SkImage::MakeFromYUVAPixmaps(
+                context.get(),             // context
+                planes.color_space,        // yuv color space
+                planes.pixmaps,            // yuva pixmaps
+                planes.indices,            // yuva indices
+                planes.dimensions,         // image size
+                kTopLeft_GrSurfaceOrigin,  // image origin
+                false,                     // build mips
+                true                       // limit to max texture size
+            );
+            if (!texture_image) {
+              FML_LOG(ERROR) << "Could not make image from YUV planes.";
+              result = {};
+            } else {
+              result = {texture_image, queue};
+            }
+          }));
+
+  return result;
+}
+
+static void DecompressAndUpload(ImageDecoder::ImageDescriptor descriptor,
+                                fml::WeakPtr<IOManager> io_manager,
+                                fml::RefPtr<fml::TaskRunner> io_runner,
+                                DecodeResult result,
+                                fml::tracing::TraceFlow flow) {
+  // Step 1: Decompress the image.
+  // On Worker.
+
+  auto decompressed =
+      descriptor.decompressed_image_info
+          ? ImageFromDecompressedData(
+                std::move(descriptor.data),                  //
+                descriptor.decompressed_image_info.value(),  //
+                descriptor.target_width,                     //
+                descriptor.target_height,                    //
+                flow                                         //
+                )
+          : ImageFromCompressedData(std::move(descriptor.data),  //
+                                    descriptor.target_width,     //
+                                    descriptor.target_height,    //
+                                    flow);
+
+  if (!decompressed) {
+    FML_LOG(ERROR) << "Could not decompress image.";
+    result({}, std::move(flow));
+    return;
+  }
+
+  // Step 2: Update the image to the GPU.
+  // On IO Thread.
+
+  io_runner->PostTask(fml::MakeCopyable([io_manager, decompressed, result,
+                                         flow = std::move(flow)]() mutable {
+    if (!io_manager) {
+      FML_LOG(ERROR) << "Could not acquire IO manager.";
+      return result({}, std::move(flow));
+    }
+
+    // If the IO manager does not have a resource context, the caller
+    // might not have set one or a software backend could be in use.
+    // Either way, just return the image as-is.
+    if (!io_manager->GetResourceContext()) {
+      result({std::move(decompressed), io_manager->GetSkiaUnrefQueue()},
+             std::move(flow));
+      return;
+    }
+
+    auto uploaded =
+        UploadRasterImage(std::move(decompressed), io_manager, flow);
+
+    if (!uploaded.get()) {
+      FML_LOG(ERROR) << "Could not upload image to the GPU.";
+      result({}, std::move(flow));
+      return;
+    }
+
+    // Finally, all done.
+    result(std::move(uploaded), std::move(flow));
+  }));
+}
+
+static void DecodeAndUploadYUVAPlanes(
+    ImageDecoder::ImageDescriptor descriptor,
+    fml::WeakPtr<IOManager> io_manager,
+    fml::RefPtr<fml::TaskRunner> io_runner,
+    std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
+    DecodeResult result,
+    fml::tracing::TraceFlow flow) {
+  // On Worker.
+  auto planes = DecodeYUVAPlanes(descriptor.data, flow);
+  if (!planes) {
+    DecompressAndUpload(std::move(descriptor), std::move(io_manager),
+                        std::move(io_runner), std::move(result),
+                        std::move(flow));
+    return;
+  }
+
+  io_runner->PostTask(fml::MakeCopyable(
+      [descriptor, planes = std::move(planes), io_manager, io_runner,
+       concurrent_task_runner, result, flow = std::move(flow)]() mutable {
+        auto uploaded = io_manager
+                            ? UploadYUVAPlanes(*planes, io_manager, flow)
+                            : SkiaGPUObject<SkImage>{};
+        if (uploaded.get()) {
+          result(std::move(uploaded), std::move(flow));
+          return;
+        }
+
+        // The planes could not be uploaded. This happens when the GPU is
+        // disabled or the resource context went away since the decode
+        // started. Decode into RGBA on a worker instead.
+        planes.reset();
+        concurrent_task_runner->PostTask(fml::MakeCopyable(
+            [descriptor, io_manager, io_runner, result,
+             flow = std::move(flow)]() mutable {
+              DecompressAndUpload(std::move(descriptor), std::move(io_manager),
+                                  std::move(io_runner), std::move(result),
+                                  std::move(flow));
+            }));
+      }));
+}
+
 void ImageDecoder::Decode(ImageDescriptor descriptor,
                           const ImageResult& callback) {
   TRACE_EVENT0("flutter", __FUNCTION__);
@@ -308,9 +524,9 @@ void ImageDecoder::Decode(ImageDescriptor descriptor,
   FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
 
   // Always service the callback on the UI thread.
-  auto result = [callback, ui_runner = runners_.GetUITaskRunner()](
-                    SkiaGPUObject<SkImage> image,
-                    fml::tracing::TraceFlow flow) {
+  DecodeResult result = [callback, ui_runner = runners_.GetUITaskRunner()](
+                            SkiaGPUObject<SkImage> image,
+                            fml::tracing::TraceFlow flow) {
     ui_runner->PostTask(fml::MakeCopyable(
         [callback, image = std::move(image), flow = std::move(flow)]() mutable {
           // We are going to terminate the trace flow here. Flows cannot
@@ -326,71 +542,62 @@ void ImageDecoder::Decode(ImageDescriptor descriptor,
     return;
   }
 
-  concurrent_task_runner_->PostTask(
-      fml::MakeCopyable([descriptor,                              //
-                         io_manager = io_manager_,                //
-                         io_runner = runners_.GetIOTaskRunner(),  //
-                         result,                                  //
-                         flow = std::move(flow)                   //
-  ]() mutable {
-        // Step 1: Decompress the image.
-        // On Worker.
-
-        auto decompressed =
-            descriptor.decompressed_image_info
-                ? ImageFromDecompressedData(
-                      std::move(descriptor.data),                  //
-                      descriptor.decompressed_image_info.value(),  //
-                      descriptor.target_width,                     //
-                      descriptor.target_height,                    //
-                      flow                                         //
-                      )
-                : ImageFromCompressedData(std::move(descriptor.data),  //
-                                          descriptor.target_width,     //
-                                          descriptor.target_height,    //
-                                          flow);
-
-        if (!decompressed) {
-          FML_LOG(ERROR) << "Could not decompress image.";
-          result({}, std::move(flow));
-          return;
-        }
-
-        // Step 2: Update the image to the GPU.
-        // On IO Thread.
-
-        io_runner->PostTask(fml::MakeCopyable([io_manager, decompressed, result,
-                                               flow =
-                                                   std::move(flow)]() mutable {
-          if (!io_manager) {
-            FML_LOG(ERROR) << "Could not acquire IO manager.";
-            return result({}, std::move(flow));
-          }
-
-          // If the IO manager does not have a resource context, the caller
-          // might not have set one or a software backend could be in use.
-          // Either way, just return the image as-is.
-          if (!io_manager->GetResourceContext()) {
-            result({std::move(decompressed), io_manager->GetSkiaUnrefQueue()},
-                   std::move(flow));
-            return;
-          }
-
-          auto uploaded =
-              UploadRasterImage(std::move(decompressed), io_manager, flow);
-
-          if (!uploaded.get()) {
-            FML_LOG(ERROR) << "Could not upload image to the GPU.";
-            result({}, std::move(flow));
-            return;
-          }
-
-          // Finally, all done.
-          result(std::move(uploaded), std::move(flow));
+  // Resizing is only supported on RGBA images.
+  const bool try_yuv_decode = yuv_decoding_enabled_ &&
+                              !descriptor.decompressed_image_info &&
+                              !descriptor.target_width &&
+                              !descriptor.target_height;
+
+  if (!try_yuv_decode) {
+    concurrent_task_runner_->PostTask(fml::MakeCopyable(
+        [descriptor,                              //
+         io_manager = io_manager_,                //
+         io_runner = runners_.GetIOTaskRunner(),  //
+         result,                                  //
+         flow = std::move(flow)                   //
+    ]() mutable {
+          DecompressAndUpload(std::move(descriptor), std::move(io_manager),
+                              std::move(io_runner), std::move(result),
+                              std::move(flow));
         }));
+    return;
+  }
+
+  // The planes can only be uploaded with a resource context, so they are
+  // not decoded without one. The resource context is only accessed on the IO
+  // thread.
+  runners_.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
+      [descriptor,                                        //
+       io_manager = io_manager_,                          //
+       io_runner = runners_.GetIOTaskRunner(),            //
+       concurrent_task_runner = concurrent_task_runner_,  //
+       result,                                            //
+       flow = std::move(flow)                             //
+  ]() mutable {
+        const bool has_resource_context =
+            io_manager && io_manager->GetResourceContext();
+        concurrent_task_runner->PostTask(fml::MakeCopyable(
+            [descriptor, has_resource_context, io_manager, io_runner,
+             concurrent_task_runner, result, flow = std::move(flow)]() mutable {
+              if (!has_resource_context) {
+                DecompressAndUpload(std::move(descriptor),
+                                    std::move(io_manager), std::move(io_runner),
+                                    std::move(result), std::move(flow));
+                return;
+              }
+              DecodeAndUploadYUVAPlanes(
+                  std::move(descriptor), std::move(io_manager),
+                  std::move(io_runner), std::move(concurrent_task_runner),
+                  std::move(result), std::move(flow));
+            }));
       }));
 }
 
+void ImageDecoder::SetYUVDecodingEnabled(bool enabled) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  yuv_decoding_enabled_ = enabled;
+}
+
 fml::WeakPtr<ImageDecoder> ImageDecoder::GetWeakPtr() const {
   return weak_factory_.GetWeakPtr();
 }
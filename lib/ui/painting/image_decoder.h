@@ -58,12 +58,20 @@ class ImageDecoder {
   // callback is guaranteed to return on the UI thread.
   void Decode(ImageDescriptor descriptor, const ImageResult& result);
 
+  // When enabled, JPEG images that don't need to be resized are decoded into
+  // separate Y, U and V planes instead of RGBA. The planes are uploaded
+  // individually and converted to RGB on the GPU when the image is drawn. If
+  // there is no GPU context on the IO thread, the decoder falls back to a
+  // regular RGBA decode. Disabled by default.
+  void SetYUVDecodingEnabled(bool enabled);
+
   fml::WeakPtr<ImageDecoder> GetWeakPtr() const;
 
  private:
   TaskRunners runners_;
   std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
   fml::WeakPtr<IOManager> io_manager_;
+  bool yuv_decoding_enabled_ = false;
   fml::WeakPtrFactory<ImageDecoder> weak_factory_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoder);
@@ -5,6 +5,7 @@
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_recorder.h"
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/testing/test_gl_surface.h"
 #include "flutter/testing/testing.h"
@@ -314,6 +315,131 @@ TEST_F(ImageDecoderFixtureTest, CanDecodeWithoutAGPUContext) {
   latch.Wait();
 }
 
+namespace {
+
+// What decoding a fixture with YUV decoding enabled resulted in, and which
+// steps of the decode its trace events show were taken.
+struct YUVDecodeResult {
+  SkISize dimensions = SkISize::MakeEmpty();
+  bool is_texture_backed = false;
+  bool decoded_yuv_planes = false;
+  bool uploaded_yuv_planes = false;
+  bool uploaded_raster_image = false;
+};
+
+bool TraceContainsEvent(const std::string& trace, const std::string& name) {
+  return trace.find("\"name\":\"" + name + "\"") != std::string::npos;
+}
+
+}  // namespace
+
+static YUVDecodeResult DecodeWithYUVDecodingEnabled(ThreadTest& test,
+                                                    const char* fixture_name,
+                                                    bool has_gpu_context) {
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  TaskRunners runners(GetCurrentTestName(),              // label
+                      test.CreateNewThread("platform"),  // platform
+                      test.CreateNewThread("gpu"),       // gpu
+                      test.CreateNewThread("ui"),        // ui
+                      test.CreateNewThread("io")         // io
+  );
+
+  fml::AutoResetWaitableEvent latch;
+
+  std::unique_ptr<IOManager> io_manager;
+  std::unique_ptr<ImageDecoder> image_decoder;
+  YUVDecodeResult decode_result;
+
+  auto release_io_manager = [&]() {
+    io_manager.reset();
+    latch.Signal();
+  };
+
+  auto decode_image = [&]() {
+    image_decoder = std::make_unique<ImageDecoder>(
+        runners, loop->GetTaskRunner(), io_manager->GetWeakIOManager());
+    image_decoder->SetYUVDecodingEnabled(true);
+
+    ImageDecoder::ImageDescriptor image_descriptor;
+    image_descriptor.data = OpenFixtureAsSkData(fixture_name);
+
+    ASSERT_TRUE(image_descriptor.data);
+    ASSERT_GE(image_descriptor.data->size(), 0u);
+
+    ImageDecoder::ImageResult callback = [&](SkiaGPUObject<SkImage> image) {
+      ASSERT_TRUE(runners.GetUITaskRunner()->RunsTasksOnCurrentThread());
+      ASSERT_TRUE(image.get());
+      decode_result.dimensions = image.get()->dimensions();
+      decode_result.is_texture_backed = image.get()->isTextureBacked();
+      image_decoder.reset();
+      runners.GetIOTaskRunner()->PostTask(release_io_manager);
+    };
+    image_decoder->Decode(std::move(image_descriptor), callback);
+  };
+
+  auto setup_io_manager_and_decode = [&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner(),
+                                                 has_gpu_context);
+    runners.GetUITaskRunner()->PostTask(decode_image);
+  };
+
+  auto& recorder = fml::tracing::TraceRecorder::GetInstance();
+  recorder.Enable();
+  recorder.Clear();
+  runners.GetIOTaskRunner()->PostTask(setup_io_manager_and_decode);
+
+  latch.Wait();
+  const auto trace = recorder.ExportChromeTraceJSON();
+  recorder.Disable();
+  recorder.Clear();
+  decode_result.decoded_yuv_planes =
+      TraceContainsEvent(trace, "DecodeYUVAPlanes");
+  decode_result.uploaded_yuv_planes =
+      TraceContainsEvent(trace, "UploadYUVAPlanes");
+  decode_result.uploaded_raster_image =
+      TraceContainsEvent(trace, "UploadRasterImage");
+  return decode_result;
+}
+
+TEST_F(ImageDecoderFixtureTest, CanDecodeJPEGToYUVPlanes) {
+  const auto image_dimensions =
+      SkImage::MakeFromEncoded(OpenFixtureAsSkData("DashInNooglerHat.jpg"))
+          ->dimensions();
+
+  const auto result =
+      DecodeWithYUVDecodingEnabled(*this, "DashInNooglerHat.jpg", true);
+
+  ASSERT_EQ(result.dimensions, image_dimensions);
+  ASSERT_TRUE(result.is_texture_backed);
+  ASSERT_TRUE(result.uploaded_yuv_planes);
+  ASSERT_FALSE(result.uploaded_raster_image);
+}
+
+TEST_F(ImageDecoderFixtureTest, YUVDecodingFallsBackToRGBAWithoutAGPUContext) {
+  const auto image_dimensions =
+      SkImage::MakeFromEncoded(OpenFixtureAsSkData("DashInNooglerHat.jpg"))
+          ->dimensions();
+
+  const auto result =
+      DecodeWithYUVDecodingEnabled(*this, "DashInNooglerHat.jpg", false);
+
+  ASSERT_EQ(result.dimensions, image_dimensions);
+  ASSERT_FALSE(result.is_texture_backed);
+  // The planes are not decoded when they can't be uploaded.
+  ASSERT_FALSE(result.decoded_yuv_planes);
+  ASSERT_FALSE(result.uploaded_yuv_planes);
+}
+
+TEST_F(ImageDecoderFixtureTest, YUVDecodingSkipsImagesWithAnOrientation) {
+  const auto result =
+      DecodeWithYUVDecodingEnabled(*this, "Horizontal.jpg", true);
+
+  ASSERT_EQ(result.dimensions, SkISize::Make(600, 200));
+  ASSERT_TRUE(result.decoded_yuv_planes);
+  ASSERT_FALSE(result.uploaded_yuv_planes);
+  ASSERT_TRUE(result.uploaded_raster_image);
+}
+
 TEST_F(ImageDecoderFixtureTest, CanDecodeWithResizes) {
   const auto image_dimensions =
       SkImage::MakeFromEncoded(OpenFixtureAsSkData("DashInNooglerHat.jpg"))
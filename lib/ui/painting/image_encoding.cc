@@ -28,13 +28,6 @@ using tonic::ToDart;
 namespace flutter {
 namespace {
 
-// This must be kept in sync with the enum in painting.dart
-enum ImageByteFormat {
-  kRawRGBA,
-  kRawUnmodified,
-  kPNG,
-};
-
 void InvokeDataCallback(std::unique_ptr<DartPersistentValue> callback,
                         sk_sp<SkData> buffer) {
   std::shared_ptr<tonic::DartState> dart_state = callback->dart_state().lock();
@@ -175,6 +168,34 @@ sk_sp<SkData> CopyImageByteData(sk_sp<SkImage> raster_image,
   return SkData::MakeWithCopy(pixmap.addr(), pixmap.computeByteSize());
 }
 
+void EncodeImageAndInvokeDataCallback(
+    sk_sp<SkImage> image,
+    std::unique_ptr<DartPersistentValue> callback,
+    ImageByteFormat format,
+    fml::RefPtr<fml::TaskRunner> ui_task_runner,
+    fml::RefPtr<fml::TaskRunner> gpu_task_runner,
+    fml::RefPtr<fml::TaskRunner> io_task_runner,
+    GrContext* resource_context,
+    fml::WeakPtr<SnapshotDelegate> snapshot_delegate) {
+  auto callback_task = fml::MakeCopyable(
+      [callback = std::move(callback)](sk_sp<SkData> encoded) mutable {
+        InvokeDataCallback(std::move(callback), std::move(encoded));
+      });
+
+  auto encode_task = [callback_task = std::move(callback_task), format,
+                      ui_task_runner](sk_sp<SkImage> raster_image) {
+    sk_sp<SkData> encoded = EncodeImage(std::move(raster_image), format);
+    ui_task_runner->PostTask(
+        [callback_task = std::move(callback_task),
+         encoded = std::move(encoded)] { callback_task(encoded); });
+  };
+
+  ConvertImageToRaster(std::move(image), encode_task, gpu_task_runner,
+                       io_task_runner, resource_context, snapshot_delegate);
+}
+
+}  // namespace
+
 sk_sp<SkData> EncodeImage(sk_sp<SkImage> raster_image, ImageByteFormat format) {
   TRACE_EVENT0("flutter", __FUNCTION__);
 
@@ -205,34 +226,6 @@ sk_sp<SkData> EncodeImage(sk_sp<SkImage> raster_image, ImageByteFormat format) {
   return nullptr;
 }
 
-void EncodeImageAndInvokeDataCallback(
-    sk_sp<SkImage> image,
-    std::unique_ptr<DartPersistentValue> callback,
-    ImageByteFormat format,
-    fml::RefPtr<fml::TaskRunner> ui_task_runner,
-    fml::RefPtr<fml::TaskRunner> gpu_task_runner,
-    fml::RefPtr<fml::TaskRunner> io_task_runner,
-    GrContext* resource_context,
-    fml::WeakPtr<SnapshotDelegate> snapshot_delegate) {
-  auto callback_task = fml::MakeCopyable(
-      [callback = std::move(callback)](sk_sp<SkData> encoded) mutable {
-        InvokeDataCallback(std::move(callback), std::move(encoded));
-      });
-
-  auto encode_task = [callback_task = std::move(callback_task), format,
-                      ui_task_runner](sk_sp<SkImage> raster_image) {
-    sk_sp<SkData> encoded = EncodeImage(std::move(raster_image), format);
-    ui_task_runner->PostTask(
-        [callback_task = std::move(callback_task),
-         encoded = std::move(encoded)] { callback_task(encoded); });
-  };
-
-  ConvertImageToRaster(std::move(image), encode_task, gpu_task_runner,
-                       io_task_runner, resource_context, snapshot_delegate);
-}
-
-}  // namespace
-
 Dart_Handle EncodeImage(CanvasImage* canvas_image,
                         int format,
                         Dart_Handle callback_handle) {
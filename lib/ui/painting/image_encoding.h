@@ -5,12 +5,25 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_ENCODING_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_ENCODING_H_
 
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
 #include "third_party/tonic/dart_library_natives.h"
 
 namespace flutter {
 
 class CanvasImage;
 
+// This must be kept in sync with the enum in painting.dart
+enum ImageByteFormat {
+  kRawRGBA,
+  kRawUnmodified,
+  kPNG,
+};
+
+// Encodes an image whose pixels are in CPU memory. May be called on any
+// thread.
+sk_sp<SkData> EncodeImage(sk_sp<SkImage> raster_image, ImageByteFormat format);
+
 Dart_Handle EncodeImage(CanvasImage* canvas_image,
                         int format,
                         Dart_Handle callback_handle);
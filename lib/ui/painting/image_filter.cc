@@ -48,10 +48,11 @@ void ImageFilter::initImage(CanvasImage* image) {
 }
 
 void ImageFilter::initPicture(Picture* picture) {
-  filter_ = SkPictureImageFilter::Make(picture->picture());
+  filter_ = SkPictureImageFilter::Make(picture->display_list()->ToSkPicture());
 }
 
 void ImageFilter::initBlur(double sigma_x, double sigma_y) {
+  blur_sigma_ = SkVector::Make(sigma_x, sigma_y);
   filter_ = SkBlurImageFilter::Make(sigma_x, sigma_y, nullptr, nullptr,
                                     SkBlurImageFilter::kClamp_TileMode);
 }
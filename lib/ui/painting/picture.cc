@@ -27,23 +27,25 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Picture);
 DART_BIND_ALL(Picture, FOR_EACH_BINDING)
 
 fml::RefPtr<Picture> Picture::Create(
-    flutter::SkiaGPUObject<SkPicture> picture) {
-  return fml::MakeRefCounted<Picture>(std::move(picture));
+    flutter::SkiaGPUObject<DisplayList> display_list) {
+  return fml::MakeRefCounted<Picture>(std::move(display_list));
 }
 
-Picture::Picture(flutter::SkiaGPUObject<SkPicture> picture)
-    : picture_(std::move(picture)) {}
+Picture::Picture(flutter::SkiaGPUObject<DisplayList> display_list)
+    : display_list_(std::move(display_list)) {}
 
 Picture::~Picture() = default;
 
 Dart_Handle Picture::toImage(uint32_t width,
                              uint32_t height,
                              Dart_Handle raw_image_callback) {
-  if (!picture_.get()) {
+  if (!display_list_.get()) {
     return tonic::ToDart("Picture is null");
   }
 
-  return RasterizeToImage(picture_.get(), width, height, raw_image_callback);
+  // Snapshots are taken by Skia, which only knows how to draw pictures.
+  return RasterizeToImage(display_list_.get()->ToSkPicture(), width, height,
+                          raw_image_callback);
 }
 
 void Picture::dispose() {
@@ -51,8 +53,8 @@ void Picture::dispose() {
 }
 
 size_t Picture::GetAllocationSize() {
-  if (auto picture = picture_.get()) {
-    return picture->approximateBytesUsed();
+  if (auto display_list = display_list_.get()) {
+    return display_list->bytes_used();
   } else {
     return sizeof(Picture);
   }
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PICTURE_H_
 #define FLUTTER_LIB_UI_PAINTING_PICTURE_H_
 
+#include "flutter/flow/display_list.h"
 #include "flutter/flow/skia_gpu_object.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/image.h"
@@ -23,9 +24,10 @@ class Picture : public RefCountedDartWrappable<Picture> {
 
  public:
   ~Picture() override;
-  static fml::RefPtr<Picture> Create(flutter::SkiaGPUObject<SkPicture> picture);
+  static fml::RefPtr<Picture> Create(
+      flutter::SkiaGPUObject<DisplayList> display_list);
 
-  sk_sp<SkPicture> picture() const { return picture_.get(); }
+  sk_sp<DisplayList> display_list() const { return display_list_.get(); }
 
   Dart_Handle toImage(uint32_t width,
                       uint32_t height,
@@ -43,9 +45,9 @@ class Picture : public RefCountedDartWrappable<Picture> {
                                       Dart_Handle raw_image_callback);
 
  private:
-  explicit Picture(flutter::SkiaGPUObject<SkPicture> picture);
+  explicit Picture(flutter::SkiaGPUObject<DisplayList> display_list);
 
-  flutter::SkiaGPUObject<SkPicture> picture_;
+  flutter::SkiaGPUObject<DisplayList> display_list_;
 };
 
 }  // namespace flutter
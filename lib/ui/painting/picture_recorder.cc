@@ -44,15 +44,17 @@ bool PictureRecorder::isRecording() {
 }
 
 SkCanvas* PictureRecorder::BeginRecording(SkRect bounds) {
-  return picture_recorder_.beginRecording(bounds, &rtree_factory_);
+  recorder_ = std::make_unique<DisplayListRecorder>(bounds);
+  return recorder_.get();
 }
 
 fml::RefPtr<Picture> PictureRecorder::endRecording() {
   if (!isRecording())
     return nullptr;
 
-  fml::RefPtr<Picture> picture = Picture::Create(UIDartState::CreateGPUObject(
-      picture_recorder_.finishRecordingAsPicture()));
+  fml::RefPtr<Picture> picture =
+      Picture::Create(UIDartState::CreateGPUObject(recorder_->Build()));
+  recorder_ = nullptr;
   canvas_->Clear();
   canvas_->ClearDartWrapper();
   canvas_ = nullptr;
@@ -5,8 +5,10 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PICTURE_RECORDER_H_
 #define FLUTTER_LIB_UI_PAINTING_PICTURE_RECORDER_H_
 
+#include <memory>
+
+#include "flutter/flow/display_list.h"
 #include "flutter/lib/ui/dart_wrapper.h"
-#include "third_party/skia/include/core/SkPictureRecorder.h"
 
 namespace tonic {
 class DartLibraryNatives;
@@ -36,8 +38,7 @@ class PictureRecorder : public RefCountedDartWrappable<PictureRecorder> {
  private:
   PictureRecorder();
 
-  SkRTreeFactory rtree_factory_;
-  SkPictureRecorder picture_recorder_;
+  std::unique_ptr<DisplayListRecorder> recorder_;
   fml::RefPtr<Canvas> canvas_;
 };
 
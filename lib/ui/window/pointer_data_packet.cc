@@ -11,7 +11,7 @@ namespace flutter {
 PointerDataPacket::PointerDataPacket(size_t count)
     : data_(count * sizeof(PointerData)) {}
 
-PointerDataPacket::PointerDataPacket(uint8_t* data, size_t num_bytes)
+PointerDataPacket::PointerDataPacket(const uint8_t* data, size_t num_bytes)
     : data_(data, data + num_bytes) {}
 
 PointerDataPacket::~PointerDataPacket() = default;
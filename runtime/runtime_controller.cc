@@ -358,6 +358,15 @@ std::pair<bool, uint32_t> RuntimeController::GetRootIsolateReturnCode() {
   return root_isolate_return_code_;
 }
 
+DartVM* RuntimeController::GetDartVM() const {
+  return vm_;
+}
+
+const fml::RefPtr<const DartSnapshot>& RuntimeController::GetIsolateSnapshot()
+    const {
+  return isolate_snapshot_;
+}
+
 RuntimeController::Locale::Locale(std::string language_code_,
                                   std::string country_code_,
                                   std::string script_code_,
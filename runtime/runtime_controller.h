@@ -90,6 +90,10 @@ class RuntimeController final : public WindowClient {
 
   std::pair<bool, uint32_t> GetRootIsolateReturnCode();
 
+  DartVM* GetDartVM() const;
+
+  const fml::RefPtr<const DartSnapshot>& GetIsolateSnapshot() const;
+
  private:
   struct Locale {
     Locale(std::string language_code_,
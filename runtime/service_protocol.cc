@@ -32,6 +32,12 @@ const std::string_view ServiceProtocol::kSetAssetBundlePathExtensionName =
     "_flutter.setAssetBundlePath";
 const std::string_view ServiceProtocol::kGetDisplayRefreshRateExtensionName =
     "_flutter.getDisplayRefreshRate";
+const std::string_view ServiceProtocol::kGetFrameStatisticsExtensionName =
+    "_flutter.getFrameStatistics";
+const std::string_view ServiceProtocol::kGetTraceRecordingExtensionName =
+    "_flutter.getTraceRecording";
+const std::string_view ServiceProtocol::kGetLayerProfileExtensionName =
+    "_flutter.getLayerProfile";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -49,6 +55,9 @@ ServiceProtocol::ServiceProtocol()
           kFlushUIThreadTasksExtensionName,
           kSetAssetBundlePathExtensionName,
           kGetDisplayRefreshRateExtensionName,
+          kGetFrameStatisticsExtensionName,
+          kGetTraceRecordingExtensionName,
+          kGetLayerProfileExtensionName,
       }),
       handlers_mutex_(fml::SharedMutex::Create()) {}
 
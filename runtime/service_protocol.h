@@ -27,6 +27,9 @@ class ServiceProtocol {
   static const std::string_view kFlushUIThreadTasksExtensionName;
   static const std::string_view kSetAssetBundlePathExtensionName;
   static const std::string_view kGetDisplayRefreshRateExtensionName;
+  static const std::string_view kGetFrameStatisticsExtensionName;
+  static const std::string_view kGetTraceRecordingExtensionName;
+  static const std::string_view kGetLayerProfileExtensionName;
 
   class Handler {
    public:
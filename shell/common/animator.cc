@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/animator.h"
 
+#include <algorithm>
+
 #include "flutter/fml/trace_event.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
@@ -17,28 +19,69 @@ namespace {
 constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
     fml::TimeDelta::FromMilliseconds(51);
 
+// The number of recent frames whose build and raster durations are used to
+// estimate how long the next frame will take under the low latency policy.
+constexpr size_t kFrameDurationSampleCount = 30;
+
+// Headroom added to the estimated frame duration under the low latency policy
+// to absorb scheduling jitter on the UI and raster task runners.
+constexpr fml::TimeDelta kBeginFrameDelayMargin =
+    fml::TimeDelta::FromMilliseconds(2);
+
+size_t GetPipelineDepth(FrameSchedulingPolicy policy,
+                        const TaskRunners& task_runners) {
+  // When the platform and raster work happen on the same thread, frames
+  // cannot be rasterized while the next one is built so a deeper pipeline
+  // only adds latency.
+  const bool shared_raster_thread = task_runners.GetPlatformTaskRunner() ==
+                                    task_runners.GetGPUTaskRunner();
+  switch (policy) {
+    case FrameSchedulingPolicy::kLowLatency:
+      return 1;
+    case FrameSchedulingPolicy::kHighThroughput:
+      return shared_raster_thread ? 1 : 3;
+    case FrameSchedulingPolicy::kDefault:
+      break;
+  }
+#if FLUTTER_SHELL_ENABLE_METAL
+  return 2;
+#else   // FLUTTER_SHELL_ENABLE_METAL
+  // TODO(dnfield): We should remove this logic and set the pipeline depth
+  // back to 2 in this case. See
+  // https://github.com/flutter/engine/pull/9132 for discussion.
+  return shared_raster_thread ? 1 : 2;
+#endif  // FLUTTER_SHELL_ENABLE_METAL
+}
+
+void AddDurationSample(std::deque<fml::TimeDelta>& samples,
+                       fml::TimeDelta duration) {
+  samples.push_back(duration);
+  if (samples.size() > kFrameDurationSampleCount) {
+    samples.pop_front();
+  }
+}
+
+fml::TimeDelta MaxDuration(const std::deque<fml::TimeDelta>& samples) {
+  if (samples.empty()) {
+    return fml::TimeDelta::Zero();
+  }
+  return *std::max_element(samples.begin(), samples.end());
+}
+
 }  // namespace
 
 Animator::Animator(Delegate& delegate,
                    TaskRunners task_runners,
-                   std::unique_ptr<VsyncWaiter> waiter)
+                   std::unique_ptr<VsyncWaiter> waiter,
+                   FrameSchedulingPolicy policy)
     : delegate_(delegate),
       task_runners_(std::move(task_runners)),
       waiter_(std::move(waiter)),
+      policy_(policy),
       last_begin_frame_time_(),
       dart_frame_deadline_(0),
-#if FLUTTER_SHELL_ENABLE_METAL
-      layer_tree_pipeline_(fml::MakeRefCounted<LayerTreePipeline>(2)),
-#else   // FLUTTER_SHELL_ENABLE_METAL
-      // TODO(dnfield): We should remove this logic and set the pipeline depth
-      // back to 2 in this case. See
-      // https://github.com/flutter/engine/pull/9132 for discussion.
       layer_tree_pipeline_(fml::MakeRefCounted<LayerTreePipeline>(
-          task_runners.GetPlatformTaskRunner() ==
-                  task_runners.GetGPUTaskRunner()
-              ? 1
-              : 2)),
-#endif  // FLUTTER_SHELL_ENABLE_METAL
+          GetPipelineDepth(policy, task_runners_))),
       pending_frame_semaphore_(1),
       frame_number_(1),
       paused_(false),
@@ -74,6 +117,15 @@ void Animator::SetDimensionChangePending() {
   dimension_change_pending_ = true;
 }
 
+void Animator::ReportRasterDuration(fml::TimeDelta duration) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  AddDurationSample(raster_durations_, duration);
+}
+
+FrameSchedulingPolicy Animator::GetFrameSchedulingPolicy() const {
+  return policy_;
+}
+
 void Animator::EnqueueTraceFlowId(uint64_t trace_flow_id) {
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetUITaskRunner(),
@@ -133,6 +185,9 @@ void Animator::BeginFrame(fml::TimePoint frame_start_time,
   FML_DCHECK(producer_continuation_);
 
   last_begin_frame_time_ = frame_start_time;
+  build_start_time_ = fml::TimePoint::Now();
+  build_in_progress_ = true;
+  frame_target_time_ = frame_target_time;
   dart_frame_deadline_ = FxlToDartOrEarlier(frame_target_time);
   {
     TRACE_EVENT2("flutter", "Framework Workload", "mode", "basic", "frame",
@@ -178,9 +233,22 @@ void Animator::Render(std::unique_ptr<flutter::LayerTree> layer_tree) {
 
   if (layer_tree) {
     // Note the frame time for instrumentation.
-    layer_tree->RecordBuildTime(last_begin_frame_time_);
+    layer_tree->RecordBuildTime(last_begin_frame_time_, build_start_time_);
   }
 
+  const auto now = fml::TimePoint::Now();
+  // Only the first render of a frame started by |BeginFrame| measures how
+  // long the frame took to build.
+  if (build_in_progress_) {
+    build_in_progress_ = false;
+    AddDurationSample(build_durations_, now - build_start_time_);
+  }
+  FML_TRACE_COUNTER("flutter", "FrameScheduling",
+                    reinterpret_cast<int64_t>(this),                         //
+                    "Policy", static_cast<int>(policy_),                     //
+                    "SlackMs", (frame_target_time_ - now).ToMillisecondsF()  //
+  );
+
   // Commit the pending continuation.
   producer_continuation_.Complete(std::move(layer_tree));
 
@@ -232,18 +300,44 @@ void Animator::AwaitVSync() {
   waiter_->AsyncWaitForVsync(
       [self = weak_factory_.GetWeakPtr()](fml::TimePoint frame_start_time,
                                           fml::TimePoint frame_target_time) {
-        if (self) {
-          if (self->CanReuseLastLayerTree()) {
-            self->DrawLastLayerTree();
-          } else {
-            self->BeginFrame(frame_start_time, frame_target_time);
-          }
+        if (!self) {
+          return;
+        }
+        if (self->CanReuseLastLayerTree()) {
+          self->DrawLastLayerTree();
+          return;
+        }
+        const auto delay = self->GetBeginFrameDelay(frame_target_time);
+        if (delay <= fml::TimeDelta::Zero()) {
+          self->BeginFrame(frame_start_time, frame_target_time);
+          return;
         }
+        const auto delay_ms = std::to_string(delay.ToMilliseconds());
+        TRACE_EVENT1("flutter", "Animator::DelayBeginFrame", "delay_ms",
+                     delay_ms.c_str());
+        self->task_runners_.GetUITaskRunner()->PostDelayedTask(
+            [self, frame_start_time, frame_target_time]() {
+              if (self) {
+                self->BeginFrame(frame_start_time, frame_target_time);
+              }
+            },
+            delay);
       });
 
   delegate_.OnAnimatorNotifyIdle(dart_frame_deadline_);
 }
 
+fml::TimeDelta Animator::GetBeginFrameDelay(
+    fml::TimePoint frame_target_time) const {
+  if (policy_ != FrameSchedulingPolicy::kLowLatency ||
+      build_durations_.empty() || raster_durations_.empty()) {
+    return fml::TimeDelta::Zero();
+  }
+  const auto estimate = MaxDuration(build_durations_) +
+                        MaxDuration(raster_durations_) + kBeginFrameDelayMargin;
+  return (frame_target_time - fml::TimePoint::Now()) - estimate;
+}
+
 void Animator::ScheduleSecondaryVsyncCallback(const fml::closure& callback) {
   waiter_->ScheduleSecondaryCallback(callback);
 }
@@ -7,6 +7,7 @@
 
 #include <deque>
 
+#include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/memory/weak_ptr.h"
@@ -19,6 +20,7 @@
 namespace flutter {
 
 namespace testing {
+class AnimatorTest;
 class ShellTest;
 }
 
@@ -42,7 +44,8 @@ class Animator final {
 
   Animator(Delegate& delegate,
            TaskRunners task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           FrameSchedulingPolicy policy = FrameSchedulingPolicy::kDefault);
 
   ~Animator();
 
@@ -79,6 +82,19 @@ class Animator final {
   // will be ended during the next |BeginFrame|.
   void EnqueueTraceFlowId(uint64_t trace_flow_id);
 
+  //--------------------------------------------------------------------------
+  /// @brief    Records how long the raster thread took to draw a frame. With
+  ///           the low latency scheduling policy, the slowest of the recently
+  ///           reported durations determines how late in the vsync interval
+  ///           the animator can start building the next frame.
+  ///
+  /// @param[in]  duration  The time between the start and the end of
+  ///                       rasterizing a frame.
+  ///
+  void ReportRasterDuration(fml::TimeDelta duration);
+
+  FrameSchedulingPolicy GetFrameSchedulingPolicy() const;
+
  private:
   using LayerTreePipeline = Pipeline<flutter::LayerTree>;
 
@@ -90,11 +106,17 @@ class Animator final {
 
   void AwaitVSync();
 
+  // The time by which the start of a frame may be delayed past vsync without
+  // missing |frame_target_time|. Always zero unless the low latency policy is
+  // in use.
+  fml::TimeDelta GetBeginFrameDelay(fml::TimePoint frame_target_time) const;
+
   const char* FrameParity();
 
   Delegate& delegate_;
   TaskRunners task_runners_;
   std::shared_ptr<VsyncWaiter> waiter_;
+  const FrameSchedulingPolicy policy_;
 
   fml::TimePoint last_begin_frame_time_;
   int64_t dart_frame_deadline_;
@@ -109,9 +131,16 @@ class Animator final {
   bool dimension_change_pending_;
   SkISize last_layer_tree_size_;
   std::deque<uint64_t> trace_flow_ids_;
+  fml::TimePoint build_start_time_;
+  // Whether a frame was begun and not rendered yet.
+  bool build_in_progress_ = false;
+  fml::TimePoint frame_target_time_;
+  std::deque<fml::TimeDelta> build_durations_;
+  std::deque<fml::TimeDelta> raster_durations_;
 
   fml::WeakPtrFactory<Animator> weak_factory_;
 
+  friend class testing::AnimatorTest;
   friend class testing::ShellTest;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Animator);
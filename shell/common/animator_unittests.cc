@@ -8,14 +8,132 @@
 #include <future>
 #include <memory>
 
+#include "flutter/flow/layers/layer_tree.h"
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/shell_test.h"
+#include "flutter/shell/common/vsync_waiters_test.h"
 #include "flutter/testing/testing.h"
+#include "flutter/testing/thread_test.h"
 #include "gtest/gtest.h"
 
 namespace flutter {
 namespace testing {
 
+class AnimatorTest : public ThreadTest {
+ protected:
+  // Runs |test| with an animator using |policy| on a thread of its own, which
+  // is used for all task runners. The delegate consumes the layer trees that
+  // are rendered. Failures in |test| must not return early, or this never
+  // returns.
+  void RunWithAnimator(FrameSchedulingPolicy policy,
+                       const std::function<void(Animator&)>& test) {
+    auto task_runner = CreateNewThread();
+    TaskRunners task_runners(GetCurrentTestName(), task_runner, task_runner,
+                             task_runner, task_runner);
+    fml::AutoResetWaitableEvent latch;
+    task_runner->PostTask([&]() {
+      TestDelegate delegate;
+      Animator animator(
+          delegate, task_runners,
+          std::make_unique<ConstantFiringVsyncWaiter>(task_runners), policy);
+      test(animator);
+      latch.Signal();
+    });
+    latch.Wait();
+  }
+
+  static void BeginFrame(Animator& animator, fml::TimePoint target_time) {
+    animator.BeginFrame(fml::TimePoint::Now(), target_time);
+  }
+
+  static void Render(Animator& animator) {
+    animator.Render(std::make_unique<LayerTree>(SkISize::Make(1, 1), 0, 1));
+  }
+
+  static size_t GetBuildDurationSampleCount(const Animator& animator) {
+    return animator.build_durations_.size();
+  }
+
+  static fml::TimeDelta GetBeginFrameDelay(const Animator& animator,
+                                           fml::TimePoint target_time) {
+    return animator.GetBeginFrameDelay(target_time);
+  }
+
+ private:
+  class TestDelegate : public Animator::Delegate {
+   public:
+    void OnAnimatorBeginFrame(fml::TimePoint frame_time) override {}
+
+    void OnAnimatorNotifyIdle(int64_t deadline) override {}
+
+    void OnAnimatorDraw(
+        fml::RefPtr<Pipeline<flutter::LayerTree>> pipeline) override {
+      auto result = pipeline->Consume([](std::unique_ptr<LayerTree>) {});
+      (void)result;
+    }
+
+    void OnAnimatorDrawLastLayerTree() override {}
+  };
+};
+
+TEST_F(AnimatorTest, OnlyFramesBegunByTheAnimatorSampleBuildDurations) {
+  for (auto policy : {FrameSchedulingPolicy::kDefault,
+                      FrameSchedulingPolicy::kLowLatency,
+                      FrameSchedulingPolicy::kHighThroughput}) {
+    RunWithAnimator(policy, [](Animator& animator) {
+      // Rendering outside of a frame measures nothing.
+      Render(animator);
+      EXPECT_EQ(GetBuildDurationSampleCount(animator), 0u);
+
+      // Neither does rendering a frame again.
+      BeginFrame(animator, fml::TimePoint::Now());
+      Render(animator);
+      Render(animator);
+      EXPECT_EQ(GetBuildDurationSampleCount(animator), 1u);
+
+      BeginFrame(animator, fml::TimePoint::Now());
+      Render(animator);
+      EXPECT_EQ(GetBuildDurationSampleCount(animator), 2u);
+    });
+  }
+}
+
+TEST_F(AnimatorTest, LowLatencyPolicyDelaysFramesByTheirSlack) {
+  RunWithAnimator(FrameSchedulingPolicy::kLowLatency, [](Animator& animator) {
+    const auto target_time =
+        fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10);
+    // Nothing is known about the duration of frames yet.
+    EXPECT_EQ(GetBeginFrameDelay(animator, target_time),
+              fml::TimeDelta::Zero());
+
+    // A render outside of a frame must not be taken for a long build.
+    Render(animator);
+    BeginFrame(animator, fml::TimePoint::Now());
+    Render(animator);
+    Render(animator);
+    animator.ReportRasterDuration(fml::TimeDelta::FromMilliseconds(1));
+
+    const auto delay = GetBeginFrameDelay(animator, target_time);
+    EXPECT_GT(delay, fml::TimeDelta::FromSeconds(9));
+    EXPECT_LT(delay, fml::TimeDelta::FromSeconds(10));
+  });
+}
+
+TEST_F(AnimatorTest, OtherPoliciesNeverDelayFrames) {
+  for (auto policy : {FrameSchedulingPolicy::kDefault,
+                      FrameSchedulingPolicy::kHighThroughput}) {
+    RunWithAnimator(policy, [](Animator& animator) {
+      BeginFrame(animator, fml::TimePoint::Now());
+      Render(animator);
+      animator.ReportRasterDuration(fml::TimeDelta::FromMilliseconds(1));
+      const auto target_time =
+          fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10);
+      EXPECT_EQ(GetBeginFrameDelay(animator, target_time),
+                fml::TimeDelta::Zero());
+    });
+  }
+}
+
 TEST_F(ShellTest, VSyncTargetTime) {
   // Add native callbacks to listen for window.onBeginFrame
   int64_t target_time;
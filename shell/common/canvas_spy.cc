@@ -4,6 +4,15 @@
 
 #include "flutter/shell/common/canvas_spy.h"
 
+#include <algorithm>
+
+#include "third_party/skia/include/core/SkDrawable.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkRegion.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkVertices.h"
+
 namespace flutter {
 
 CanvasSpy::CanvasSpy(SkCanvas* target_canvas) {
@@ -26,22 +35,75 @@ DidDrawCanvas::DidDrawCanvas(int width, int height)
 DidDrawCanvas::~DidDrawCanvas() {}
 
 void DidDrawCanvas::MarkDrawIfNonTransparentPaint(const SkPaint& paint) {
-  bool isTransparent = paint.getAlpha() == 0;
-  did_draw_ |= !isTransparent;
+  if (paint.getAlpha() != 0) {
+    MarkDraw(nullptr, &paint);
+  }
+}
+
+void DidDrawCanvas::MarkDrawIfNonTransparentPaint(const SkPaint& paint,
+                                                  const SkRect& bounds) {
+  if (paint.getAlpha() != 0) {
+    MarkDraw(&bounds, &paint);
+  }
+}
+
+void DidDrawCanvas::MarkDraw(const SkRect* bounds, const SkPaint* paint) {
+  did_draw_ = true;
+
+  SkIRect clip_bounds;
+  if (!getDeviceClipBounds(&clip_bounds)) {
+    return;
+  }
+  SkRect device_bounds = SkRect::Make(clip_bounds);
+
+  const bool unbounded =
+      std::find(unbounded_layers_.begin(), unbounded_layers_.end(), true) !=
+      unbounded_layers_.end();
+  const auto& matrix = getTotalMatrix();
+  if (bounds != nullptr && !unbounded && !matrix.hasPerspective() &&
+      (paint == nullptr || paint->canComputeFastBounds())) {
+    SkRect storage;
+    const SkRect& local_bounds = paint == nullptr
+                                     ? *bounds
+                                     : paint->computeFastBounds(*bounds,
+                                                                &storage);
+    // Outset by a pixel for anti-aliasing.
+    SkRect mapped_bounds = matrix.mapRect(local_bounds).makeOutset(1, 1);
+    if (!device_bounds.intersect(mapped_bounds)) {
+      return;
+    }
+  }
+
+  draw_bounds_.join(device_bounds);
 }
 
 bool CanvasSpy::DidDrawIntoCanvas() {
   return did_draw_canvas_->DidDrawIntoCanvas();
 }
 
+SkRect CanvasSpy::GetDrawBounds() {
+  return did_draw_canvas_->GetDrawBounds();
+}
+
 bool DidDrawCanvas::DidDrawIntoCanvas() {
   return did_draw_;
 }
 
-void DidDrawCanvas::willSave() {}
+SkRect DidDrawCanvas::GetDrawBounds() {
+  return draw_bounds_;
+}
+
+void DidDrawCanvas::willSave() {
+  unbounded_layers_.push_back(false);
+}
 
 SkCanvas::SaveLayerStrategy DidDrawCanvas::getSaveLayerStrategy(
     const SaveLayerRec& rec) {
+  // Filters may move content outside of the bounds it was drawn in and
+  // backdrop filters affect everything under the layer.
+  unbounded_layers_.push_back(
+      rec.fBackdrop != nullptr ||
+      (rec.fPaint != nullptr && rec.fPaint->getImageFilter() != nullptr));
   return kNoLayer_SaveLayerStrategy;
 }
 
@@ -49,25 +111,40 @@ bool DidDrawCanvas::onDoSaveBehind(const SkRect* bounds) {
   return false;
 }
 
-void DidDrawCanvas::willRestore() {}
+void DidDrawCanvas::willRestore() {
+  if (!unbounded_layers_.empty()) {
+    unbounded_layers_.pop_back();
+  }
+}
 
 void DidDrawCanvas::didConcat(const SkMatrix& matrix) {}
 
 void DidDrawCanvas::didSetMatrix(const SkMatrix& matrix) {}
 
+// The clips are forwarded to the base canvas so that it tracks the clip
+// bounds the draw bounds are limited to.
+
 void DidDrawCanvas::onClipRect(const SkRect& rect,
                                SkClipOp op,
-                               ClipEdgeStyle edgeStyle) {}
+                               ClipEdgeStyle edgeStyle) {
+  SkCanvasVirtualEnforcer<SkNoDrawCanvas>::onClipRect(rect, op, edgeStyle);
+}
 
 void DidDrawCanvas::onClipRRect(const SkRRect& rrect,
                                 SkClipOp op,
-                                ClipEdgeStyle edgeStyle) {}
+                                ClipEdgeStyle edgeStyle) {
+  SkCanvasVirtualEnforcer<SkNoDrawCanvas>::onClipRRect(rrect, op, edgeStyle);
+}
 
 void DidDrawCanvas::onClipPath(const SkPath& path,
                                SkClipOp op,
-                               ClipEdgeStyle edgeStyle) {}
+                               ClipEdgeStyle edgeStyle) {
+  SkCanvasVirtualEnforcer<SkNoDrawCanvas>::onClipPath(path, op, edgeStyle);
+}
 
-void DidDrawCanvas::onClipRegion(const SkRegion& deviceRgn, SkClipOp op) {}
+void DidDrawCanvas::onClipRegion(const SkRegion& deviceRgn, SkClipOp op) {
+  SkCanvasVirtualEnforcer<SkNoDrawCanvas>::onClipRegion(deviceRgn, op);
+}
 
 void DidDrawCanvas::onDrawPaint(const SkPaint& paint) {
   MarkDrawIfNonTransparentPaint(paint);
@@ -81,19 +158,23 @@ void DidDrawCanvas::onDrawPoints(PointMode mode,
                                  size_t count,
                                  const SkPoint pts[],
                                  const SkPaint& paint) {
-  MarkDrawIfNonTransparentPaint(paint);
+  SkRect bounds;
+  bounds.setBounds(pts, count);
+  const SkScalar radius = std::max(paint.getStrokeWidth(), 1.0f);
+  bounds.outset(radius, radius);
+  MarkDrawIfNonTransparentPaint(paint, bounds);
 }
 
 void DidDrawCanvas::onDrawRect(const SkRect& rect, const SkPaint& paint) {
-  MarkDrawIfNonTransparentPaint(paint);
+  MarkDrawIfNonTransparentPaint(paint, rect);
 }
 
 void DidDrawCanvas::onDrawRegion(const SkRegion& region, const SkPaint& paint) {
-  MarkDrawIfNonTransparentPaint(paint);
+  MarkDrawIfNonTransparentPaint(paint, SkRect::Make(region.getBounds()));
 }
 
 void DidDrawCanvas::onDrawOval(const SkRect& rect, const SkPaint& paint) {
-  MarkDrawIfNonTransparentPaint(paint);
+  MarkDrawIfNonTransparentPaint(paint, rect);
 }
 
 void DidDrawCanvas::onDrawArc(const SkRect& rect,
@@ -101,28 +182,34 @@ void DidDrawCanvas::onDrawArc(const SkRect& rect,
                               SkScalar sweepAngle,
                               bool useCenter,
                               const SkPaint& paint) {
-  MarkDrawIfNonTransparentPaint(paint);
+  MarkDrawIfNonTransparentPaint(paint, rect);
 }
 
 void DidDrawCanvas::onDrawRRect(const SkRRect& rrect, const SkPaint& paint) {
-  MarkDrawIfNonTransparentPaint(paint);
+  MarkDrawIfNonTransparentPaint(paint, rrect.getBounds());
 }
 
 void DidDrawCanvas::onDrawDRRect(const SkRRect& outer,
                                  const SkRRect& inner,
                                  const SkPaint& paint) {
-  MarkDrawIfNonTransparentPaint(paint);
+  MarkDrawIfNonTransparentPaint(paint, outer.getBounds());
 }
 
 void DidDrawCanvas::onDrawPath(const SkPath& path, const SkPaint& paint) {
-  MarkDrawIfNonTransparentPaint(paint);
+  if (path.isInverseFillType()) {
+    MarkDrawIfNonTransparentPaint(paint);
+  } else {
+    MarkDrawIfNonTransparentPaint(paint, path.getBounds());
+  }
 }
 
 void DidDrawCanvas::onDrawBitmap(const SkBitmap& bitmap,
                                  SkScalar x,
                                  SkScalar y,
                                  const SkPaint* paint) {
-  did_draw_ = true;
+  const auto bounds =
+      SkRect::MakeXYWH(x, y, bitmap.width(), bitmap.height());
+  MarkDraw(&bounds, paint);
 }
 
 void DidDrawCanvas::onDrawBitmapRect(const SkBitmap& bitmap,
@@ -130,28 +217,30 @@ void DidDrawCanvas::onDrawBitmapRect(const SkBitmap& bitmap,
                                      const SkRect& dst,
                                      const SkPaint* paint,
                                      SrcRectConstraint constraint) {
-  did_draw_ = true;
+  MarkDraw(&dst, paint);
 }
 
 void DidDrawCanvas::onDrawBitmapNine(const SkBitmap& bitmap,
                                      const SkIRect& center,
                                      const SkRect& dst,
                                      const SkPaint* paint) {
-  did_draw_ = true;
+  MarkDraw(&dst, paint);
 }
 
 void DidDrawCanvas::onDrawBitmapLattice(const SkBitmap& bitmap,
                                         const Lattice& lattice,
                                         const SkRect& dst,
                                         const SkPaint* paint) {
-  did_draw_ = true;
+  MarkDraw(&dst, paint);
 }
 
 void DidDrawCanvas::onDrawImage(const SkImage* image,
                                 SkScalar left,
                                 SkScalar top,
                                 const SkPaint* paint) {
-  did_draw_ = true;
+  const auto bounds =
+      SkRect::MakeXYWH(left, top, image->width(), image->height());
+  MarkDraw(&bounds, paint);
 }
 
 void DidDrawCanvas::onDrawImageRect(const SkImage* image,
@@ -159,39 +248,45 @@ void DidDrawCanvas::onDrawImageRect(const SkImage* image,
                                     const SkRect& dst,
                                     const SkPaint* paint,
                                     SrcRectConstraint constraint) {
-  did_draw_ = true;
+  MarkDraw(&dst, paint);
 }
 
 void DidDrawCanvas::onDrawImageNine(const SkImage* image,
                                     const SkIRect& center,
                                     const SkRect& dst,
                                     const SkPaint* paint) {
-  did_draw_ = true;
+  MarkDraw(&dst, paint);
 }
 
 void DidDrawCanvas::onDrawImageLattice(const SkImage* image,
                                        const Lattice& lattice,
                                        const SkRect& dst,
                                        const SkPaint* paint) {
-  did_draw_ = true;
+  MarkDraw(&dst, paint);
 }
 
 void DidDrawCanvas::onDrawTextBlob(const SkTextBlob* blob,
                                    SkScalar x,
                                    SkScalar y,
                                    const SkPaint& paint) {
-  MarkDrawIfNonTransparentPaint(paint);
+  MarkDrawIfNonTransparentPaint(paint, blob->bounds().makeOffset(x, y));
 }
 
 void DidDrawCanvas::onDrawPicture(const SkPicture* picture,
                                   const SkMatrix* matrix,
                                   const SkPaint* paint) {
-  did_draw_ = true;
+  const auto bounds = matrix == nullptr
+                          ? picture->cullRect()
+                          : matrix->mapRect(picture->cullRect());
+  MarkDraw(&bounds, paint);
 }
 
 void DidDrawCanvas::onDrawDrawable(SkDrawable* drawable,
                                    const SkMatrix* matrix) {
-  did_draw_ = true;
+  const auto bounds = matrix == nullptr
+                          ? drawable->getBounds()
+                          : matrix->mapRect(drawable->getBounds());
+  MarkDraw(&bounds, nullptr);
 }
 
 void DidDrawCanvas::onDrawVerticesObject(const SkVertices* vertices,
@@ -199,7 +294,7 @@ void DidDrawCanvas::onDrawVerticesObject(const SkVertices* vertices,
                                          int boneCount,
                                          SkBlendMode bmode,
                                          const SkPaint& paint) {
-  MarkDrawIfNonTransparentPaint(paint);
+  MarkDrawIfNonTransparentPaint(paint, vertices->bounds());
 }
 
 void DidDrawCanvas::onDrawPatch(const SkPoint cubics[12],
@@ -207,7 +302,9 @@ void DidDrawCanvas::onDrawPatch(const SkPoint cubics[12],
                                 const SkPoint texCoords[4],
                                 SkBlendMode bmode,
                                 const SkPaint& paint) {
-  MarkDrawIfNonTransparentPaint(paint);
+  SkRect bounds;
+  bounds.setBounds(cubics, 12);
+  MarkDrawIfNonTransparentPaint(paint, bounds);
 }
 
 void DidDrawCanvas::onDrawAtlas(const SkImage* image,
@@ -218,18 +315,18 @@ void DidDrawCanvas::onDrawAtlas(const SkImage* image,
                                 SkBlendMode bmode,
                                 const SkRect* cull,
                                 const SkPaint* paint) {
-  did_draw_ = true;
+  MarkDraw(cull, paint);
 }
 
 void DidDrawCanvas::onDrawShadowRec(const SkPath& path,
                                     const SkDrawShadowRec& rec) {
-  did_draw_ = true;
+  MarkDraw(nullptr, nullptr);
 }
 
 void DidDrawCanvas::onDrawAnnotation(const SkRect& rect,
                                      const char key[],
                                      SkData* data) {
-  did_draw_ = true;
+  MarkDraw(&rect, nullptr);
 }
 
 void DidDrawCanvas::onDrawEdgeAAQuad(const SkRect& rect,
@@ -237,7 +334,7 @@ void DidDrawCanvas::onDrawEdgeAAQuad(const SkRect& rect,
                                      SkCanvas::QuadAAFlags aa,
                                      const SkColor4f& color,
                                      SkBlendMode mode) {
-  did_draw_ = true;
+  MarkDraw(&rect, nullptr);
 }
 
 void DidDrawCanvas::onDrawEdgeAAImageSet(const ImageSetEntry set[],
@@ -246,7 +343,7 @@ void DidDrawCanvas::onDrawEdgeAAImageSet(const ImageSetEntry set[],
                                          const SkMatrix preViewMatrices[],
                                          const SkPaint* paint,
                                          SrcRectConstraint constraint) {
-  did_draw_ = true;
+  MarkDraw(nullptr, paint);
 }
 
 void DidDrawCanvas::onFlush() {}
@@ -3,6 +3,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 //
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkCanvasVirtualEnforcer.h"
@@ -35,6 +37,15 @@ class CanvasSpy {
   ///             canvas).
   bool DidDrawIntoCanvas();
 
+  //------------------------------------------------------------------------------
+  /// @brief      Returns conservative bounds of the content drawn into the
+  ///             spying canvas, in the device space of the canvas and limited
+  ///             to its clip. Draws whose bounds cannot be computed, such as
+  ///             drawPaint or draws under a layer with an image filter, are
+  ///             assumed to cover the whole clip. Empty if
+  ///             |DidDrawIntoCanvas| is false.
+  SkRect GetDrawBounds();
+
   //------------------------------------------------------------------------------
   /// @brief      The returned canvas delegate all operations to the target
   /// canvas
@@ -53,9 +64,14 @@ class DidDrawCanvas final : public SkCanvasVirtualEnforcer<SkNoDrawCanvas> {
   DidDrawCanvas(int width, int height);
   ~DidDrawCanvas() override;
   bool DidDrawIntoCanvas();
+  SkRect GetDrawBounds();
 
  private:
   bool did_draw_ = false;
+  SkRect draw_bounds_ = SkRect::MakeEmpty();
+  // One entry per save, true if the bounds of the draws within it cannot be
+  // computed because the layer it saved has an image filter or a backdrop.
+  std::vector<bool> unbounded_layers_;
 
   // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
   void willSave() override;
@@ -237,6 +253,13 @@ class DidDrawCanvas final : public SkCanvasVirtualEnforcer<SkNoDrawCanvas> {
 
   void MarkDrawIfNonTransparentPaint(const SkPaint& paint);
 
+  void MarkDrawIfNonTransparentPaint(const SkPaint& paint,
+                                     const SkRect& bounds);
+
+  // Marks a draw covering |bounds| in local coordinates, which is null if the
+  // bounds are unknown. |paint| may be null.
+  void MarkDraw(const SkRect* bounds, const SkPaint* paint);
+
   FML_DISALLOW_COPY_AND_ASSIGN(DidDrawCanvas);
 };
 
@@ -6,6 +6,7 @@
 #include "gtest/gtest.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/effects/SkBlurImageFilter.h"
 
 namespace flutter {
 namespace testing {
@@ -62,5 +63,59 @@ TEST(CanvasSpyTest, SpiedCanvasIsDrawing) {
 
   ASSERT_EQ(::memcmp(actual.addr(), expected.addr(), size), 0);
 }
+
+TEST(CanvasSpyTest, DrawBoundsAreTracked) {
+  SkPictureRecorder picture_recorder;
+  SkCanvas* canvas = picture_recorder.beginRecording(100, 100);
+  CanvasSpy canvas_spy = CanvasSpy(canvas);
+  SkCanvas* spy = canvas_spy.GetSpyingCanvas();
+
+  ASSERT_TRUE(canvas_spy.GetDrawBounds().isEmpty());
+
+  SkPaint paint;
+  spy->translate(10, 10);
+  spy->drawRect(SkRect::MakeXYWH(0, 0, 20, 20), paint);
+  ASSERT_EQ(canvas_spy.GetDrawBounds(), SkRect::MakeLTRB(9, 9, 31, 31));
+
+  // Transparent paints are not drawn.
+  paint.setAlpha(0);
+  spy->drawRect(SkRect::MakeXYWH(50, 50, 20, 20), paint);
+  ASSERT_EQ(canvas_spy.GetDrawBounds(), SkRect::MakeLTRB(9, 9, 31, 31));
+}
+
+TEST(CanvasSpyTest, DrawBoundsAreClipped) {
+  SkPictureRecorder picture_recorder;
+  SkCanvas* canvas = picture_recorder.beginRecording(100, 100);
+  CanvasSpy canvas_spy = CanvasSpy(canvas);
+  SkCanvas* spy = canvas_spy.GetSpyingCanvas();
+
+  spy->save();
+  spy->clipRect(SkRect::MakeXYWH(40, 40, 10, 10));
+  spy->drawPaint(SkPaint());
+  spy->restore();
+  const auto bounds = canvas_spy.GetDrawBounds();
+  ASSERT_TRUE(bounds.contains(SkRect::MakeXYWH(40, 40, 10, 10)));
+  ASSERT_TRUE(SkRect::MakeXYWH(39, 39, 12, 12).contains(bounds));
+
+  // Draws outside of the canvas are not tracked.
+  spy->drawRect(SkRect::MakeXYWH(200, 200, 10, 10), SkPaint());
+  ASSERT_EQ(canvas_spy.GetDrawBounds(), bounds);
+}
+
+TEST(CanvasSpyTest, DrawsUnderImageFiltersCoverTheClip) {
+  SkPictureRecorder picture_recorder;
+  SkCanvas* canvas = picture_recorder.beginRecording(100, 100);
+  CanvasSpy canvas_spy = CanvasSpy(canvas);
+  SkCanvas* spy = canvas_spy.GetSpyingCanvas();
+
+  SkPaint layer_paint;
+  layer_paint.setImageFilter(SkBlurImageFilter::Make(
+      10, 10, nullptr, nullptr, SkBlurImageFilter::kClamp_TileMode));
+  spy->saveLayer(nullptr, &layer_paint);
+  spy->drawRect(SkRect::MakeXYWH(0, 0, 10, 10), SkPaint());
+  spy->restore();
+  ASSERT_TRUE(canvas_spy.GetDrawBounds().contains(SkRect::MakeWH(100, 100)));
+}
+
 }  // namespace testing
 }  // namespace flutter
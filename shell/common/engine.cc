@@ -4,6 +4,7 @@
 
 #include "flutter/shell/common/engine.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -46,15 +47,42 @@ Engine::Engine(Delegate& delegate,
                fml::WeakPtr<IOManager> io_manager,
                fml::RefPtr<SkiaUnrefQueue> unref_queue,
                fml::WeakPtr<SnapshotDelegate> snapshot_delegate)
+    : Engine(delegate,
+             dispatcher_maker,
+             vm,
+             std::move(isolate_snapshot),
+             std::move(task_runners),
+             window_data,
+             std::move(settings),
+             std::move(animator),
+             std::move(io_manager),
+             std::move(unref_queue),
+             std::move(snapshot_delegate),
+             std::make_shared<FontCollection>()) {}
+
+Engine::Engine(Delegate& delegate,
+               const PointerDataDispatcherMaker& dispatcher_maker,
+               DartVM& vm,
+               fml::RefPtr<const DartSnapshot> isolate_snapshot,
+               TaskRunners task_runners,
+               const WindowData window_data,
+               Settings settings,
+               std::unique_ptr<Animator> animator,
+               fml::WeakPtr<IOManager> io_manager,
+               fml::RefPtr<SkiaUnrefQueue> unref_queue,
+               fml::WeakPtr<SnapshotDelegate> snapshot_delegate,
+               std::shared_ptr<FontCollection> font_collection)
     : delegate_(delegate),
       settings_(std::move(settings)),
       animator_(std::move(animator)),
       activity_running_(true),
       have_surface_(false),
+      font_collection_(std::move(font_collection)),
       image_decoder_(task_runners,
                      vm.GetConcurrentWorkerTaskRunner(),
                      io_manager),
       task_runners_(std::move(task_runners)),
+      concurrent_task_runner_(vm.GetConcurrentWorkerTaskRunner()),
       weak_factory_(this) {
   // Runtime controller is initialized here because it takes a reference to this
   // object as its delegate. The delegate may be called in the constructor and
@@ -77,11 +105,47 @@ Engine::Engine(Delegate& delegate,
       settings_.persistent_isolate_data      // persistent isolate data
   );
 
+  image_decoder_.SetYUVDecodingEnabled(settings_.enable_yuv_image_decoding);
+
   pointer_data_dispatcher_ = dispatcher_maker(*this);
 }
 
 Engine::~Engine() = default;
 
+std::unique_ptr<Engine> Engine::Spawn(
+    Delegate& delegate,
+    const PointerDataDispatcherMaker& dispatcher_maker,
+    Settings settings,
+    std::unique_ptr<Animator> animator,
+    fml::WeakPtr<IOManager> io_manager,
+    fml::RefPtr<SkiaUnrefQueue> unref_queue,
+    fml::WeakPtr<SnapshotDelegate> snapshot_delegate) const {
+  TRACE_EVENT0("flutter", "Engine::Spawn");
+  // Startup assets are recorded and prefetched by the engine that first loads
+  // the asset manager. A spawned engine shares that asset manager and must not
+  // interfere with the recording.
+  settings.asset_prefetch_manifest_path.clear();
+  auto engine = std::make_unique<Engine>(
+      delegate,                                   //
+      dispatcher_maker,                           //
+      *runtime_controller_->GetDartVM(),          //
+      runtime_controller_->GetIsolateSnapshot(),  //
+      task_runners_,                              //
+      WindowData{/* default window data */},      //
+      std::move(settings),                        //
+      std::move(animator),                        //
+      std::move(io_manager),                      //
+      std::move(unref_queue),                     //
+      std::move(snapshot_delegate),               //
+      font_collection_                            //
+  );
+  // The fonts in the asset manager have already been registered with the
+  // shared font collection. Running the new engine with the same asset manager
+  // does not register them again.
+  engine->asset_manager_ = asset_manager_;
+  return engine;
+}
+
 float Engine::GetDisplayRefreshRate() const {
   return animator_->GetDisplayRefreshRate();
 }
@@ -96,6 +160,12 @@ bool Engine::UpdateAssetManager(
     return false;
   }
 
+  if (asset_manager_ && new_asset_manager) {
+    // Assets looked up before the swap still count towards the startup
+    // assets.
+    new_asset_manager->TakeAssetNameRecording(*asset_manager_);
+  }
+
   asset_manager_ = new_asset_manager;
 
   if (!asset_manager_) {
@@ -103,10 +173,10 @@ bool Engine::UpdateAssetManager(
   }
 
   // Using libTXT as the text engine.
-  font_collection_.RegisterFonts(asset_manager_);
+  font_collection_->RegisterFonts(asset_manager_);
 
   if (settings_.use_test_fonts) {
-    font_collection_.RegisterTestFonts();
+    font_collection_->RegisterTestFonts();
   }
 
   return true;
@@ -180,6 +250,8 @@ Engine::RunStatus Engine::PrepareAndLaunchIsolate(
 
   UpdateAssetManager(configuration.GetAssetManager());
 
+  PrefetchStartupAssets();
+
   auto isolate_configuration = configuration.TakeIsolateConfiguration();
 
   std::shared_ptr<DartIsolate> isolate =
@@ -229,6 +301,10 @@ void Engine::ReportTimings(std::vector<int64_t> timings) {
   runtime_controller_->ReportTimings(std::move(timings));
 }
 
+void Engine::ReportRasterDuration(fml::TimeDelta duration) {
+  animator_->ReportRasterDuration(duration);
+}
+
 void Engine::NotifyIdle(int64_t deadline) {
   auto trace_event = std::to_string(deadline - Dart_TimelineGetMicros());
   TRACE_EVENT1("flutter", "Engine::NotifyIdle", "deadline_now_delta",
@@ -445,6 +521,10 @@ void Engine::Render(std::unique_ptr<flutter::LayerTree> layer_tree) {
       layer_tree->frame_device_pixel_ratio() <= 0.0f)
     return;
 
+  if (recording_startup_assets_) {
+    FinishRecordingStartupAssets();
+  }
+
   animator_->Render(std::move(layer_tree));
 }
 
@@ -471,7 +551,7 @@ void Engine::SetNeedsReportTimings(bool needs_reporting) {
 }
 
 FontCollection& Engine::GetFontCollection() {
-  return font_collection_;
+  return *font_collection_;
 }
 
 void Engine::DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
@@ -495,16 +575,94 @@ void Engine::HandleAssetPlatformMessage(fml::RefPtr<PlatformMessage> message) {
   std::string asset_name(reinterpret_cast<const char*>(data.data()),
                          data.size());
 
-  if (asset_manager_) {
-    std::unique_ptr<fml::Mapping> asset_mapping =
-        asset_manager_->GetAsMapping(asset_name);
-    if (asset_mapping) {
-      response->Complete(std::move(asset_mapping));
-      return;
+  if (!asset_manager_) {
+    response->CompleteEmpty();
+    return;
+  }
+
+  // Resolve the asset on a worker so that disk access does not stall the UI
+  // thread. Responses may be completed on any thread.
+  asset_manager_->GetAsMappingAsync(
+      asset_name, concurrent_task_runner_,
+      [response](std::unique_ptr<fml::Mapping> asset_mapping) {
+        if (asset_mapping) {
+          response->Complete(std::move(asset_mapping));
+        } else {
+          response->CompleteEmpty();
+        }
+      });
+}
+
+static std::vector<std::string> ParseAssetPrefetchManifest(
+    const fml::Mapping& manifest) {
+  std::vector<std::string> asset_names;
+  const auto* begin = reinterpret_cast<const char*>(manifest.GetMapping());
+  const auto* end = begin + manifest.GetSize();
+  while (begin < end) {
+    const auto* line_end = std::find(begin, end, '\n');
+    if (line_end != begin) {
+      asset_names.emplace_back(begin, line_end);
     }
+    begin = line_end + 1;
+  }
+  return asset_names;
+}
+
+void Engine::PrefetchStartupAssets() {
+  const auto& manifest_path = settings_.asset_prefetch_manifest_path;
+  if (!asset_manager_ || manifest_path.empty()) {
+    return;
+  }
+
+  TRACE_EVENT0("flutter", "Engine::PrefetchStartupAssets");
+  if (auto manifest = fml::FileMapping::CreateReadOnly(manifest_path)) {
+    asset_prefetch_manifest_.assign(
+        reinterpret_cast<const char*>(manifest->GetMapping()),
+        manifest->GetSize());
+    asset_manager_->Prefetch(ParseAssetPrefetchManifest(*manifest),
+                             concurrent_task_runner_);
   }
 
-  response->CompleteEmpty();
+  asset_manager_->SetRecordsAssetNames(true);
+  recording_startup_assets_ = true;
+}
+
+void Engine::FinishRecordingStartupAssets() {
+  recording_startup_assets_ = false;
+  if (!asset_manager_) {
+    return;
+  }
+
+  asset_manager_->SetRecordsAssetNames(false);
+  // Anything still held at this point was not needed for startup.
+  asset_manager_->ClearPrefetchedAssets();
+
+  std::string manifest;
+  for (const auto& asset_name : asset_manager_->TakeRecordedAssetNames()) {
+    manifest += asset_name;
+    manifest += '\n';
+  }
+  if (manifest == asset_prefetch_manifest_) {
+    return;
+  }
+  asset_prefetch_manifest_ = manifest;
+
+  concurrent_task_runner_->PostTask(
+      [manifest_path = settings_.asset_prefetch_manifest_path,
+       manifest = std::move(manifest)]() {
+        TRACE_EVENT0("flutter", "WriteAssetPrefetchManifest");
+        const auto directory_path = fml::paths::GetDirectoryName(manifest_path);
+        const auto file_name = manifest_path.substr(
+            directory_path.empty() ? 0 : directory_path.size() + 1);
+        auto directory = fml::OpenDirectory(
+            directory_path.empty() ? "." : directory_path.c_str(), false,
+            fml::FilePermission::kReadWrite);
+        if (!fml::WriteAtomically(directory, file_name.c_str(),
+                                  fml::DataMapping(manifest))) {
+          FML_LOG(ERROR) << "Could not write the asset prefetch manifest to "
+                         << manifest_path;
+        }
+      });
 }
 
 const std::string& Engine::GetLastEntrypoint() const {
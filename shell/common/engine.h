@@ -283,6 +283,57 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
          fml::RefPtr<SkiaUnrefQueue> unref_queue,
          fml::WeakPtr<SnapshotDelegate> snapshot_delegate);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates an instance of the engine that uses the given font
+  ///             collection instead of creating its own. Fonts registered by
+  ///             any engine are visible to all engines sharing the collection.
+  ///
+  /// @see        The constructor above for a description of the remaining
+  ///             arguments.
+  ///
+  /// @param[in]  font_collection    The font collection used to lay out text.
+  ///
+  Engine(Delegate& delegate,
+         const PointerDataDispatcherMaker& dispatcher_maker,
+         DartVM& vm,
+         fml::RefPtr<const DartSnapshot> isolate_snapshot,
+         TaskRunners task_runners,
+         const WindowData window_data,
+         Settings settings,
+         std::unique_ptr<Animator> animator,
+         fml::WeakPtr<IOManager> io_manager,
+         fml::RefPtr<SkiaUnrefQueue> unref_queue,
+         fml::WeakPtr<SnapshotDelegate> snapshot_delegate,
+         std::shared_ptr<FontCollection> font_collection);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a new engine for a spawned shell. The new engine runs
+  ///             on the same task runners and shares the VM, the isolate
+  ///             snapshot, the font collection and the asset manager of this
+  ///             engine, so none of these have to be loaded again. It gets its
+  ///             own root isolate. Must be called on the UI task runner.
+  ///
+  /// @param      delegate           The shell hosting the new engine.
+  /// @param      dispatcher_maker   The callback provided by the `PlatformView`
+  ///                                of the new shell to create the pointer
+  ///                                data dispatcher.
+  /// @param[in]  settings           The settings of the new shell.
+  /// @param[in]  animator           The animator used to schedule frames.
+  /// @param[in]  io_manager         The IO manager of the new shell.
+  /// @param[in]  unref_queue        The Skia unref queue of the IO manager.
+  /// @param[in]  snapshot_delegate  The snapshot delegate of the new shell.
+  ///
+  /// @return     The new engine. Its root isolate is not yet running.
+  ///
+  std::unique_ptr<Engine> Spawn(
+      Delegate& delegate,
+      const PointerDataDispatcherMaker& dispatcher_maker,
+      Settings settings,
+      std::unique_ptr<Animator> animator,
+      fml::WeakPtr<IOManager> io_manager,
+      fml::RefPtr<SkiaUnrefQueue> unref_queue,
+      fml::WeakPtr<SnapshotDelegate> snapshot_delegate) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Destroys the engine engine. Called by the shell on the UI task
   ///             runner. The running root isolate is terminated and will no
@@ -505,6 +556,16 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void ReportTimings(std::vector<int64_t> timings);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Reports how long the raster thread took to draw a frame to the
+  ///             animator so that it can schedule subsequent frames. Only used
+  ///             by the low latency frame scheduling policy.
+  ///
+  /// @param[in]  duration  The time between the start and the end of
+  ///                       rasterizing a frame.
+  ///
+  void ReportRasterDuration(fml::TimeDelta duration);
+
   //----------------------------------------------------------------------------
   /// @brief      Gets the main port of the root isolate. Since the isolate is
   ///             created immediately in the constructor of the engine, it is
@@ -747,9 +808,14 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   std::shared_ptr<AssetManager> asset_manager_;
   bool activity_running_;
   bool have_surface_;
-  FontCollection font_collection_;
+  std::shared_ptr<FontCollection> font_collection_;
   ImageDecoder image_decoder_;
   TaskRunners task_runners_;
+  std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
+  bool recording_startup_assets_ = false;
+  // The asset prefetch manifest read at startup, which is only written again
+  // if the assets used during startup changed.
+  std::string asset_prefetch_manifest_;
   fml::WeakPtrFactory<Engine> weak_factory_;
 
   // |RuntimeDelegate|
@@ -785,6 +851,10 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
 
   void HandleAssetPlatformMessage(fml::RefPtr<PlatformMessage> message);
 
+  void PrefetchStartupAssets();
+
+  void FinishRecordingStartupAssets();
+
   bool GetAssetAsBuffer(const std::string& name, std::vector<uint8_t>* data);
 
   RunStatus PrepareAndLaunchIsolate(RunConfiguration configuration);
@@ -0,0 +1,180 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+// Durations below this all fall in the first bucket.
+static constexpr int64_t kMinBucketMicros = 16;
+
+DurationHistogram::DurationHistogram() {
+  Reset();
+}
+
+DurationHistogram::~DurationHistogram() = default;
+
+size_t DurationHistogram::GetBucketIndex(fml::TimeDelta duration) {
+  const auto micros = duration.ToMicroseconds();
+  if (micros < kMinBucketMicros) {
+    return 0;
+  }
+  const auto doublings =
+      std::log2(static_cast<double>(micros) / kMinBucketMicros);
+  const auto index = 1 + static_cast<size_t>(doublings * kBucketsPerDoubling);
+  return std::min(index, kBucketCount - 1);
+}
+
+fml::TimeDelta DurationHistogram::GetBucketUpperBound(size_t index) {
+  return fml::TimeDelta::FromMicroseconds(static_cast<int64_t>(
+      kMinBucketMicros *
+      std::exp2(static_cast<double>(index) / kBucketsPerDoubling)));
+}
+
+void DurationHistogram::Add(fml::TimeDelta duration) {
+  duration = std::max(duration, fml::TimeDelta::Zero());
+  buckets_[GetBucketIndex(duration)]++;
+  count_++;
+  max_ = std::max(max_, duration);
+}
+
+void DurationHistogram::Reset() {
+  buckets_.fill(0);
+  count_ = 0;
+  max_ = fml::TimeDelta::Zero();
+}
+
+fml::TimeDelta DurationHistogram::GetPercentile(double percentile) const {
+  if (count_ == 0) {
+    return fml::TimeDelta::Zero();
+  }
+  // The rank of the sample at the percentile, starting from 1.
+  const auto rank = std::max<size_t>(
+      1, static_cast<size_t>(
+             std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * count_)));
+  size_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      return std::min(GetBucketUpperBound(i), max_);
+    }
+  }
+  return max_;
+}
+
+const char* FrameStatistics::GetJankCauseName(JankCause cause) {
+  switch (cause) {
+    case JankCause::kBuild:
+      return "build";
+    case JankCause::kPreroll:
+      return "preroll";
+    case JankCause::kPaint:
+      return "paint";
+    case JankCause::kRasterCache:
+      return "rasterCache";
+    case JankCause::kGPUFlush:
+      return "gpuFlush";
+    case JankCause::kShaderCompilation:
+      return "shaderCompilation";
+    case JankCause::kCount:
+      break;
+  }
+  FML_DCHECK(false);
+  return "unknown";
+}
+
+std::optional<FrameStatistics::JankCause> FrameStatistics::AttributeJank(
+    const FramePhaseDurations& durations,
+    fml::TimeDelta frame_budget) {
+  const auto ui_time = durations.vsync_latency + durations.build;
+  const auto ui_overrun = ui_time - frame_budget;
+  const auto raster_overrun = durations.raster - frame_budget;
+  if (ui_overrun <= fml::TimeDelta::Zero() &&
+      raster_overrun <= fml::TimeDelta::Zero()) {
+    return std::nullopt;
+  }
+
+  if (ui_overrun >= raster_overrun) {
+    return JankCause::kBuild;
+  }
+
+  // Shader compilation happens lazily while painting and flushing, so its cost
+  // is hidden in those phases. It is almost always the reason a frame that
+  // compiled shaders was slow.
+  if (durations.compiled_shaders) {
+    return JankCause::kShaderCompilation;
+  }
+
+  const std::pair<JankCause, fml::TimeDelta> phases[] = {
+      {JankCause::kPreroll, durations.preroll - durations.raster_cache},
+      {JankCause::kPaint, durations.paint},
+      {JankCause::kRasterCache, durations.raster_cache},
+      {JankCause::kGPUFlush, durations.gpu_flush},
+  };
+  return std::max_element(std::begin(phases), std::end(phases),
+                          [](const auto& a, const auto& b) {
+                            return a.second < b.second;
+                          })
+      ->first;
+}
+
+FrameStatistics::FrameStatistics() = default;
+
+FrameStatistics::~FrameStatistics() = default;
+
+void FrameStatistics::AddFrame(const FramePhaseDurations& durations,
+                               fml::TimeDelta frame_budget) {
+  const auto jank_cause = AttributeJank(durations, frame_budget);
+
+  std::scoped_lock lock(mutex_);
+  build_.Add(durations.build);
+  raster_.Add(durations.raster);
+  vsync_latency_.Add(durations.vsync_latency);
+  total_.Add(durations.total);
+  if (jank_cause.has_value()) {
+    missed_frame_count_++;
+    missed_frames_by_cause_[static_cast<size_t>(jank_cause.value())]++;
+  }
+}
+
+static FrameStatistics::Percentiles GetPercentiles(
+    const DurationHistogram& histogram) {
+  return {
+      histogram.GetPercentile(50),  // p50
+      histogram.GetPercentile(90),  // p90
+      histogram.GetPercentile(99),  // p99
+      histogram.GetMax(),           // max
+  };
+}
+
+FrameStatistics::Summary FrameStatistics::GetSummary() const {
+  std::scoped_lock lock(mutex_);
+  Summary summary;
+  summary.frame_count = total_.GetCount();
+  summary.missed_frame_count = missed_frame_count_;
+  summary.build = GetPercentiles(build_);
+  summary.raster = GetPercentiles(raster_);
+  summary.vsync_latency = GetPercentiles(vsync_latency_);
+  summary.total = GetPercentiles(total_);
+  summary.missed_frames_by_cause = missed_frames_by_cause_;
+  return summary;
+}
+
+void FrameStatistics::Reset() {
+  std::scoped_lock lock(mutex_);
+  missed_frame_count_ = 0;
+  build_.Reset();
+  raster_.Reset();
+  vsync_latency_.Reset();
+  total_.Reset();
+  missed_frames_by_cause_.fill(0);
+}
+
+}  // namespace flutter
@@ -0,0 +1,156 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_STATISTICS_H_
+#define FLUTTER_SHELL_COMMON_FRAME_STATISTICS_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+/// The time spent in each phase of producing a single frame.
+struct FramePhaseDurations {
+  // From the vsync signal to the UI thread starting to build the frame.
+  fml::TimeDelta vsync_latency;
+  // Building the layer tree on the UI thread.
+  fml::TimeDelta build;
+  // Prerolling the layer tree, including |raster_cache|.
+  fml::TimeDelta preroll;
+  // Painting the layer tree into the surface canvas.
+  fml::TimeDelta paint;
+  // Populating the raster cache during preroll.
+  fml::TimeDelta raster_cache;
+  // Submitting the frame, which flushes the recorded work to the GPU.
+  fml::TimeDelta gpu_flush;
+  // All the work done on the GPU thread for the frame.
+  fml::TimeDelta raster;
+  // From the vsync signal to the end of rasterization.
+  fml::TimeDelta total;
+  // Whether Skia compiled new shaders while rasterizing the frame.
+  bool compiled_shaders = false;
+};
+
+//------------------------------------------------------------------------------
+/// A histogram of durations that uses constant memory regardless of the number
+/// of samples. Buckets grow exponentially so that percentiles are accurate to
+/// within about 10% of their value from tens of microseconds to seconds.
+///
+class DurationHistogram {
+ public:
+  DurationHistogram();
+
+  ~DurationHistogram();
+
+  void Add(fml::TimeDelta duration);
+
+  void Reset();
+
+  size_t GetCount() const { return count_; }
+
+  fml::TimeDelta GetMax() const { return max_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Estimates a percentile of the samples. The estimate is the
+  ///             upper bound of the bucket the percentile falls into, clamped
+  ///             to the largest sample.
+  ///
+  /// @param[in]  percentile  The percentile, between 0 and 100.
+  ///
+  fml::TimeDelta GetPercentile(double percentile) const;
+
+ private:
+  static constexpr size_t kBucketsPerDoubling = 8;
+  static constexpr size_t kBucketCount = 20 * kBucketsPerDoubling;
+
+  static size_t GetBucketIndex(fml::TimeDelta duration);
+
+  static fml::TimeDelta GetBucketUpperBound(size_t index);
+
+  std::array<uint32_t, kBucketCount> buckets_;
+  size_t count_ = 0;
+  fml::TimeDelta max_;
+};
+
+//------------------------------------------------------------------------------
+/// Aggregates the phase durations of every rasterized frame into histograms
+/// and attributes the frames that missed their deadline to the phase most
+/// likely responsible. This may be used from any thread.
+///
+class FrameStatistics {
+ public:
+  enum class JankCause {
+    kBuild,
+    kPreroll,
+    kPaint,
+    kRasterCache,
+    kGPUFlush,
+    kShaderCompilation,
+    kCount,
+  };
+
+  struct Percentiles {
+    fml::TimeDelta p50;
+    fml::TimeDelta p90;
+    fml::TimeDelta p99;
+    fml::TimeDelta max;
+  };
+
+  struct Summary {
+    size_t frame_count = 0;
+    size_t missed_frame_count = 0;
+    Percentiles build;
+    Percentiles raster;
+    Percentiles vsync_latency;
+    Percentiles total;
+    std::array<size_t, static_cast<size_t>(JankCause::kCount)>
+        missed_frames_by_cause = {};
+  };
+
+  static const char* GetJankCauseName(JankCause cause);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Determines why a frame missed its deadline.
+  ///
+  /// @return     The cause, or no value if the frame met its deadline. The
+  ///             work on the UI and GPU threads is pipelined, so a frame is
+  ///             late if either thread took longer than the frame budget.
+  ///
+  static std::optional<JankCause> AttributeJank(
+      const FramePhaseDurations& durations,
+      fml::TimeDelta frame_budget);
+
+  FrameStatistics();
+
+  ~FrameStatistics();
+
+  void AddFrame(const FramePhaseDurations& durations,
+                fml::TimeDelta frame_budget);
+
+  Summary GetSummary() const;
+
+  void Reset();
+
+ private:
+  mutable std::mutex mutex_;
+  size_t missed_frame_count_ = 0;
+  DurationHistogram build_;
+  DurationHistogram raster_;
+  DurationHistogram vsync_latency_;
+  DurationHistogram total_;
+  std::array<size_t, static_cast<size_t>(JankCause::kCount)>
+      missed_frames_by_cause_ = {};
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameStatistics);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_STATISTICS_H_
@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_statistics.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static constexpr fml::TimeDelta kFrameBudget =
+    fml::TimeDelta::FromMicroseconds(16667);
+
+static fml::TimeDelta Milliseconds(int64_t millis) {
+  return fml::TimeDelta::FromMilliseconds(millis);
+}
+
+static FramePhaseDurations CreateDurations(int64_t build_ms,
+                                           int64_t raster_ms) {
+  FramePhaseDurations durations;
+  durations.build = Milliseconds(build_ms);
+  durations.raster = Milliseconds(raster_ms);
+  durations.paint = Milliseconds(raster_ms);
+  durations.total = Milliseconds(build_ms + raster_ms);
+  return durations;
+}
+
+TEST(DurationHistogramTest, EmptyHistogramReportsZero) {
+  DurationHistogram histogram;
+  ASSERT_EQ(histogram.GetCount(), 0u);
+  ASSERT_EQ(histogram.GetPercentile(50), fml::TimeDelta::Zero());
+  ASSERT_EQ(histogram.GetMax(), fml::TimeDelta::Zero());
+}
+
+TEST(DurationHistogramTest, PercentilesAreWithinBucketPrecision) {
+  DurationHistogram histogram;
+  for (int64_t i = 1; i <= 100; i++) {
+    histogram.Add(Milliseconds(i));
+  }
+  ASSERT_EQ(histogram.GetCount(), 100u);
+  ASSERT_EQ(histogram.GetMax(), Milliseconds(100));
+
+  const std::pair<double, double> expectations[] = {
+      {50, 50},
+      {90, 90},
+      {99, 99},
+  };
+  for (const auto& expectation : expectations) {
+    const auto value =
+        histogram.GetPercentile(expectation.first).ToMillisecondsF();
+    ASSERT_GE(value, expectation.second);
+    ASSERT_LE(value, expectation.second * 1.1);
+  }
+  ASSERT_EQ(histogram.GetPercentile(100), Milliseconds(100));
+}
+
+TEST(DurationHistogramTest, ResetDiscardsSamples) {
+  DurationHistogram histogram;
+  histogram.Add(Milliseconds(10));
+  histogram.Reset();
+  ASSERT_EQ(histogram.GetCount(), 0u);
+  ASSERT_EQ(histogram.GetMax(), fml::TimeDelta::Zero());
+}
+
+TEST(FrameStatisticsTest, FramesWithinBudgetAreNotMissed) {
+  ASSERT_FALSE(FrameStatistics::AttributeJank(CreateDurations(8, 8),
+                                              kFrameBudget)
+                   .has_value());
+}
+
+TEST(FrameStatisticsTest, SlowBuildIsAttributedToBuild) {
+  auto durations = CreateDurations(30, 20);
+  ASSERT_EQ(FrameStatistics::AttributeJank(durations, kFrameBudget),
+            FrameStatistics::JankCause::kBuild);
+
+  // Starting the build late counts towards the build.
+  durations = CreateDurations(10, 8);
+  durations.vsync_latency = Milliseconds(10);
+  ASSERT_EQ(FrameStatistics::AttributeJank(durations, kFrameBudget),
+            FrameStatistics::JankCause::kBuild);
+}
+
+TEST(FrameStatisticsTest, SlowRasterIsAttributedToLongestPhase) {
+  auto durations = CreateDurations(8, 30);
+  durations.paint = Milliseconds(5);
+  durations.preroll = Milliseconds(22);
+  durations.raster_cache = Milliseconds(20);
+  durations.gpu_flush = Milliseconds(3);
+  ASSERT_EQ(FrameStatistics::AttributeJank(durations, kFrameBudget),
+            FrameStatistics::JankCause::kRasterCache);
+
+  durations.raster_cache = Milliseconds(2);
+  ASSERT_EQ(FrameStatistics::AttributeJank(durations, kFrameBudget),
+            FrameStatistics::JankCause::kPreroll);
+
+  durations.preroll = Milliseconds(2);
+  durations.gpu_flush = Milliseconds(25);
+  ASSERT_EQ(FrameStatistics::AttributeJank(durations, kFrameBudget),
+            FrameStatistics::JankCause::kGPUFlush);
+
+  durations.compiled_shaders = true;
+  ASSERT_EQ(FrameStatistics::AttributeJank(durations, kFrameBudget),
+            FrameStatistics::JankCause::kShaderCompilation);
+}
+
+TEST(FrameStatisticsTest, SummaryCountsMissedFramesByCause) {
+  FrameStatistics statistics;
+  statistics.AddFrame(CreateDurations(8, 8), kFrameBudget);
+  statistics.AddFrame(CreateDurations(30, 8), kFrameBudget);
+  statistics.AddFrame(CreateDurations(8, 30), kFrameBudget);
+  statistics.AddFrame(CreateDurations(8, 40), kFrameBudget);
+
+  auto summary = statistics.GetSummary();
+  ASSERT_EQ(summary.frame_count, 4u);
+  ASSERT_EQ(summary.missed_frame_count, 3u);
+  ASSERT_EQ(summary.missed_frames_by_cause[static_cast<size_t>(
+                FrameStatistics::JankCause::kBuild)],
+            1u);
+  ASSERT_EQ(summary.missed_frames_by_cause[static_cast<size_t>(
+                FrameStatistics::JankCause::kPaint)],
+            2u);
+  ASSERT_EQ(summary.raster.max, Milliseconds(40));
+  ASSERT_EQ(summary.build.max, Milliseconds(30));
+
+  statistics.Reset();
+  summary = statistics.GetSummary();
+  ASSERT_EQ(summary.frame_count, 0u);
+  ASSERT_EQ(summary.missed_frame_count, 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
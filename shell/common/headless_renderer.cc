@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/headless_renderer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+
+HeadlessRenderer::HeadlessRenderer(const Options& options)
+    : options_(options),
+      loop_(fml::ConcurrentMessageLoop::Create(
+          std::max<size_t>(options.thread_count, 1))),
+      task_runner_(loop_->GetTaskRunner()) {}
+
+HeadlessRenderer::~HeadlessRenderer() {
+  WaitForIdle();
+}
+
+bool HeadlessRenderer::Render(std::unique_ptr<LayerTree> layer_tree,
+                              ImageByteFormat format,
+                              RenderCallback callback) {
+  if (!layer_tree || layer_tree->frame_size().isEmpty()) {
+    FML_LOG(ERROR) << "Headless render requested with an empty layer tree.";
+    return false;
+  }
+
+  const auto& size = layer_tree->frame_size();
+  Request request;
+  request.pixel_bytes = SkImageInfo::MakeN32Premul(size).computeMinByteSize();
+  request.layer_tree = std::move(layer_tree);
+  request.format = format;
+  request.callback = std::move(callback);
+
+  std::scoped_lock lock(mutex_);
+  if (queued_requests_.size() >= options_.max_queued_requests) {
+    return false;
+  }
+  queued_requests_.emplace_back(std::move(request));
+  DispatchQueuedRequestsLocked();
+  return true;
+}
+
+void HeadlessRenderer::WaitForIdle() {
+  std::unique_lock lock(mutex_);
+  idle_condition_.wait(lock, [this]() {
+    return in_flight_count_ == 0 && queued_requests_.empty();
+  });
+}
+
+void HeadlessRenderer::DispatchQueuedRequestsLocked() {
+  while (!queued_requests_.empty()) {
+    auto& request = queued_requests_.front();
+    const bool fits_in_budget = in_flight_pixel_bytes_ + request.pixel_bytes <=
+                                options_.max_pixel_bytes;
+    // A request that doesn't fit in the budget on its own may still proceed
+    // once nothing else is in flight. Otherwise it would never be processed.
+    if (!fits_in_budget && in_flight_count_ > 0) {
+      return;
+    }
+    in_flight_count_++;
+    in_flight_pixel_bytes_ += request.pixel_bytes;
+    task_runner_->PostTask(fml::MakeCopyable(
+        [this, request = std::move(request)]() mutable {
+          RasterizeRequest(std::move(request));
+        }));
+    queued_requests_.pop_front();
+  }
+}
+
+sk_sp<SkImage> HeadlessRenderer::RasterizeLayerTree(LayerTree& layer_tree) {
+  TRACE_EVENT0("flutter", "HeadlessRenderer::RasterizeLayerTree");
+  const auto& size = layer_tree.frame_size();
+
+  // Flattening doesn't use the raster cache or any other state shared between
+  // frames, so trees may be flattened on several threads at once.
+  auto picture =
+      layer_tree.Flatten(SkRect::MakeWH(size.width(), size.height()));
+  if (!picture) {
+    FML_LOG(ERROR) << "Could not flatten the layer tree.";
+    return nullptr;
+  }
+
+  auto surface = SkSurface::MakeRaster(SkImageInfo::MakeN32Premul(
+      size.width(), size.height(), SkColorSpace::MakeSRGB()));
+  if (!surface) {
+    FML_LOG(ERROR) << "Could not create an offscreen surface of size "
+                   << size.width() << "x" << size.height() << ".";
+    return nullptr;
+  }
+
+  auto* canvas = surface->getCanvas();
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->drawPicture(picture.get());
+  canvas->flush();
+
+  // The image takes over the pixels of the surface since the surface is not
+  // drawn into again.
+  return surface->makeImageSnapshot();
+}
+
+void HeadlessRenderer::RasterizeRequest(Request request) {
+  auto image = RasterizeLayerTree(*request.layer_tree);
+  // Release the layers on this thread instead of while encoding.
+  request.layer_tree.reset();
+  if (!image) {
+    CompleteRequest(request, nullptr);
+    return;
+  }
+
+  // Yield to the other queued tasks, which may be rasterizing other requests,
+  // before encoding.
+  task_runner_->PostTask(fml::MakeCopyable(
+      [this, request = std::move(request), image = std::move(image)]() mutable {
+        EncodeRequest(std::move(request), std::move(image));
+      }));
+}
+
+void HeadlessRenderer::EncodeRequest(Request request, sk_sp<SkImage> image) {
+  TRACE_EVENT0("flutter", "HeadlessRenderer::EncodeRequest");
+  auto data = EncodeImage(std::move(image), request.format);
+  CompleteRequest(request, std::move(data));
+}
+
+void HeadlessRenderer::CompleteRequest(const Request& request,
+                                       sk_sp<SkData> data) {
+  if (request.callback) {
+    request.callback(std::move(data));
+  }
+
+  std::scoped_lock lock(mutex_);
+  FML_DCHECK(in_flight_count_ > 0);
+  in_flight_count_--;
+  in_flight_pixel_bytes_ -= request.pixel_bytes;
+  DispatchQueuedRequestsLocked();
+  if (in_flight_count_ == 0 && queued_requests_.empty()) {
+    idle_condition_.notify_all();
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,125 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_HEADLESS_RENDERER_H_
+#define FLUTTER_SHELL_COMMON_HEADLESS_RENDERER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/painting/image_encoding.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Renders layer trees into encoded images without a platform view, surface
+/// or vsync. Meant for servers that render charts, reports and thumbnails on
+/// demand.
+///
+/// Requests are independent of each other and are processed concurrently on
+/// a pool of worker threads. Each request is rasterized into its own offscreen
+/// software surface, and encoding the image is posted as a separate task so
+/// that the workers interleave rasterizing and encoding different requests.
+///
+/// To bound memory usage, only requests whose pixels fit in the pixel budget
+/// are in flight at once. Other requests wait in a queue that holds their
+/// layer trees only. A request larger than the whole budget is processed on
+/// its own.
+///
+class HeadlessRenderer {
+ public:
+  struct Options {
+    // The number of worker threads.
+    size_t thread_count = 4;
+    // The maximum number of bytes of pixels held by requests in flight.
+    size_t max_pixel_bytes = 256 * 1024 * 1024;
+    // The maximum number of requests waiting for the pixel budget. Further
+    // requests are rejected.
+    size_t max_queued_requests = 256;
+  };
+
+  // Called on a worker thread with the encoded image, or null if the request
+  // failed.
+  using RenderCallback = std::function<void(sk_sp<SkData> data)>;
+
+  explicit HeadlessRenderer(const Options& options);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Destroys the renderer after all the requests submitted so far
+  ///             have completed.
+  ///
+  ~HeadlessRenderer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asynchronously renders a layer tree and encodes the result.
+  ///
+  /// @param[in]  layer_tree  The layer tree to render. The renderer takes
+  ///                         ownership of it since rendering modifies the
+  ///                         layers. Platform views and external textures are
+  ///                         not rendered.
+  /// @param[in]  format      The format to encode the image in.
+  /// @param[in]  callback    The callback invoked once the request completes.
+  ///                         It is not invoked if the request is rejected.
+  ///
+  /// @return     If the request was accepted. Requests are rejected when the
+  ///             queue of waiting requests is full or the layer tree is empty.
+  ///
+  bool Render(std::unique_ptr<LayerTree> layer_tree,
+              ImageByteFormat format,
+              RenderCallback callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Blocks until all the requests submitted so far have
+  ///             completed.
+  ///
+  void WaitForIdle();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Renders a layer tree into a raster image on the calling
+  ///             thread.
+  ///
+  static sk_sp<SkImage> RasterizeLayerTree(LayerTree& layer_tree);
+
+ private:
+  struct Request {
+    std::unique_ptr<LayerTree> layer_tree;
+    ImageByteFormat format;
+    RenderCallback callback;
+    size_t pixel_bytes = 0;
+  };
+
+  const Options options_;
+  std::shared_ptr<fml::ConcurrentMessageLoop> loop_;
+  std::shared_ptr<fml::ConcurrentTaskRunner> task_runner_;
+
+  std::mutex mutex_;
+  std::condition_variable idle_condition_;
+  std::deque<Request> queued_requests_;
+  size_t in_flight_count_ = 0;
+  size_t in_flight_pixel_bytes_ = 0;
+
+  // Starts queued requests while they fit in the pixel budget. Must be called
+  // with |mutex_| held.
+  void DispatchQueuedRequestsLocked();
+
+  void RasterizeRequest(Request request);
+
+  void EncodeRequest(Request request, sk_sp<SkImage> image);
+
+  void CompleteRequest(const Request& request, sk_sp<SkData> data);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(HeadlessRenderer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_HEADLESS_RENDERER_H_
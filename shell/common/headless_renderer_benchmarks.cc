@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/flow/display_list.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/thread.h"
+#include "flutter/shell/common/headless_renderer.h"
+#include "third_party/skia/include/core/SkPaint.h"
+
+namespace flutter {
+
+// Roughly what a chart in a report looks like: a few hundred anti-aliased
+// bars and points over a light background.
+static sk_sp<DisplayList> RecordChart(const SkISize& size) {
+  DisplayListRecorder recorder(SkRect::MakeWH(size.width(), size.height()));
+  auto* canvas = &recorder;
+  canvas->drawColor(SK_ColorWHITE);
+  SkPaint paint;
+  paint.setAntiAlias(true);
+  for (int i = 0; i < 400; i++) {
+    const SkScalar x = (i * size.width()) / 400.0f;
+    const SkScalar height = (i * 97) % size.height();
+    paint.setColor(SkColorSetRGB(i % 255, 80, 200));
+    canvas->drawRect(
+        SkRect::MakeXYWH(x, size.height() - height, 2, height), paint);
+    canvas->drawCircle(x, size.height() - height, 3, paint);
+  }
+  return recorder.Build();
+}
+
+static void BM_HeadlessRendererThroughput(benchmark::State& state) {
+  constexpr size_t kRequestsPerIteration = 64;
+  const auto size = SkISize::Make(800, 600);
+  const auto picture = RecordChart(size);
+  fml::Thread unref_thread("unref");
+  auto unref_queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      unref_thread.GetTaskRunner(), fml::TimeDelta::Zero());
+
+  HeadlessRenderer::Options options;
+  options.thread_count = state.range(0);
+  HeadlessRenderer renderer(options);
+
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < kRequestsPerIteration; i++) {
+      auto layer_tree = std::make_unique<LayerTree>(size, 100.0f, 1.0f);
+      layer_tree->set_root_layer(std::make_shared<PictureLayer>(
+          SkPoint::Make(0, 0),
+          SkiaGPUObject<DisplayList>(picture, unref_queue), false, false));
+      FML_CHECK(renderer.Render(
+          std::move(layer_tree), kPNG,
+          [](sk_sp<SkData> data) { FML_CHECK(data); }));
+    }
+    renderer.WaitForIdle();
+  }
+  // Reported as encoded images per second.
+  state.counters["images"] = benchmark::Counter(
+      state.iterations() * kRequestsPerIteration, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_HeadlessRendererThroughput)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace flutter
@@ -0,0 +1,135 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+
+#include "flutter/flow/display_list.h"
+#include "flutter/flow/layers/picture_layer.h"
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/shell/common/headless_renderer.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+class HeadlessRendererTest : public ::testing::Test {
+ public:
+  HeadlessRendererTest()
+      : unref_thread_("unref"),
+        unref_queue_(fml::MakeRefCounted<SkiaUnrefQueue>(
+            unref_thread_.GetTaskRunner(),
+            fml::TimeDelta::Zero())) {}
+
+  // A tree that fills the frame with a color.
+  std::unique_ptr<LayerTree> MakeLayerTree(const SkISize& size, SkColor color) {
+    DisplayListRecorder recorder(SkRect::MakeWH(size.width(), size.height()));
+    recorder.drawColor(color);
+    auto picture_layer = std::make_shared<PictureLayer>(
+        SkPoint::Make(0, 0),
+        SkiaGPUObject<DisplayList>(recorder.Build(), unref_queue_), false,
+        false);
+    auto layer_tree = std::make_unique<LayerTree>(size, 100.0f, 1.0f);
+    layer_tree->set_root_layer(std::move(picture_layer));
+    return layer_tree;
+  }
+
+ private:
+  fml::Thread unref_thread_;
+  fml::RefPtr<SkiaUnrefQueue> unref_queue_;
+};
+
+TEST_F(HeadlessRendererTest, RendersLayerTreeToPNG) {
+  HeadlessRenderer renderer(HeadlessRenderer::Options{});
+  sk_sp<SkData> png;
+  fml::AutoResetWaitableEvent latch;
+  ASSERT_TRUE(renderer.Render(MakeLayerTree(SkISize::Make(64, 32), SK_ColorRED),
+                              kPNG, [&](sk_sp<SkData> data) {
+                                png = std::move(data);
+                                latch.Signal();
+                              }));
+  latch.Wait();
+  ASSERT_TRUE(png);
+
+  auto image = SkImage::MakeFromEncoded(png);
+  ASSERT_TRUE(image);
+  ASSERT_EQ(image->dimensions(), SkISize::Make(64, 32));
+  auto raster_image = image->makeRasterImage();
+  SkPixmap pixmap;
+  ASSERT_TRUE(raster_image->peekPixels(&pixmap));
+  ASSERT_EQ(pixmap.getColor(10, 10), SK_ColorRED);
+}
+
+TEST_F(HeadlessRendererTest, RendersRawPixels) {
+  HeadlessRenderer renderer(HeadlessRenderer::Options{});
+  sk_sp<SkData> pixels;
+  ASSERT_TRUE(renderer.Render(
+      MakeLayerTree(SkISize::Make(8, 4), SK_ColorBLUE), kRawRGBA,
+      [&](sk_sp<SkData> data) { pixels = std::move(data); }));
+  renderer.WaitForIdle();
+  ASSERT_TRUE(pixels);
+  ASSERT_EQ(pixels->size(), 8u * 4u * 4u);
+  const auto* bytes = pixels->bytes();
+  ASSERT_EQ(bytes[0], 0x00);  // r
+  ASSERT_EQ(bytes[1], 0x00);  // g
+  ASSERT_EQ(bytes[2], 0xFF);  // b
+  ASSERT_EQ(bytes[3], 0xFF);  // a
+}
+
+TEST_F(HeadlessRendererTest, CompletesManyRequestsWithASmallBudget) {
+  HeadlessRenderer::Options options;
+  options.thread_count = 4;
+  // Smaller than a single request, so requests are processed one at a time.
+  options.max_pixel_bytes = 1024;
+  HeadlessRenderer renderer(options);
+  std::atomic_size_t completed = {0};
+  for (int i = 0; i < 32; i++) {
+    ASSERT_TRUE(renderer.Render(
+        MakeLayerTree(SkISize::Make(100, 100), SK_ColorGREEN), kPNG,
+        [&](sk_sp<SkData> data) {
+          ASSERT_TRUE(data);
+          completed++;
+        }));
+  }
+  renderer.WaitForIdle();
+  ASSERT_EQ(completed.load(), 32u);
+}
+
+TEST_F(HeadlessRendererTest, RejectsRequestsWhenQueueIsFull) {
+  const auto size = SkISize::Make(16, 16);
+  HeadlessRenderer::Options options;
+  options.max_pixel_bytes =
+      SkImageInfo::MakeN32Premul(size).computeMinByteSize();
+  options.max_queued_requests = 1;
+  HeadlessRenderer renderer(options);
+
+  // The first request stays in flight until its callback returns.
+  fml::CountDownLatch first_started(1);
+  fml::AutoResetWaitableEvent release_first;
+  ASSERT_TRUE(renderer.Render(MakeLayerTree(size, SK_ColorRED), kPNG,
+                              [&](sk_sp<SkData> data) {
+                                first_started.CountDown();
+                                release_first.Wait();
+                              }));
+  first_started.Wait();
+
+  // The second one waits for the budget and the third one has no room.
+  ASSERT_TRUE(renderer.Render(MakeLayerTree(size, SK_ColorRED), kPNG, {}));
+  ASSERT_FALSE(renderer.Render(MakeLayerTree(size, SK_ColorRED), kPNG, {}));
+
+  release_first.Signal();
+  renderer.WaitForIdle();
+}
+
+TEST_F(HeadlessRendererTest, RejectsEmptyLayerTrees) {
+  HeadlessRenderer renderer(HeadlessRenderer::Options{});
+  ASSERT_FALSE(renderer.Render(nullptr, kPNG, {}));
+  ASSERT_FALSE(renderer.Render(
+      MakeLayerTree(SkISize::Make(0, 10), SK_ColorRED), kPNG, {}));
+}
+
+}  // namespace testing
+}  // namespace flutter
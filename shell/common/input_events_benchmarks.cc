@@ -0,0 +1,130 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/lib/ui/window/pointer_data_packet_converter.h"
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+namespace flutter {
+
+namespace {
+
+// Stands in for the engine. Counts the dispatched packets and fires the
+// secondary vsync callback when the benchmark says a frame begins.
+class BenchmarkDispatcherDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  // |PointerDataDispatcher::Delegate|
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    dispatch_count_++;
+    benchmark::DoNotOptimize(packet->data().data());
+  }
+
+  // |PointerDataDispatcher::Delegate|
+  void ScheduleSecondaryVsyncCallback(const fml::closure& callback) override {
+    if (!vsync_callback_) {
+      vsync_callback_ = callback;
+    }
+  }
+
+  void FireVsync() {
+    auto callback = std::move(vsync_callback_);
+    vsync_callback_ = nullptr;
+    if (callback) {
+      callback();
+    }
+  }
+
+  size_t dispatch_count() const { return dispatch_count_; }
+
+ private:
+  size_t dispatch_count_ = 0;
+  fml::closure vsync_callback_;
+};
+
+}  // namespace
+
+static PointerData CreateMovePointerData(int64_t time_stamp, double x) {
+  PointerData data;
+  data.Clear();
+  data.time_stamp = time_stamp;
+  data.change = PointerData::Change::kMove;
+  data.kind = PointerData::DeviceKind::kStylus;
+  data.physical_x = x;
+  data.physical_y = x;
+  data.buttons = kPointerButtonStylusContact;
+  return data;
+}
+
+// Simulates an input device that delivers |state.range(0)| events per frame,
+// one packet per event, like a 240 Hz stylus on a 60 Hz display does with
+// four events per frame.
+static void DispatchInputEvents(benchmark::State& state,
+                                bool resample_to_vsync) {
+  const size_t events_per_frame = state.range(0);
+  BenchmarkDispatcherDelegate delegate;
+  SmoothPointerDataDispatcher dispatcher(delegate, resample_to_vsync);
+  size_t frame_count = 0;
+  double x = 0;
+  while (state.KeepRunning()) {
+    const auto now = fml::TimePoint::Now().ToEpochDelta().ToMicroseconds();
+    for (size_t i = 0; i < events_per_frame; i++) {
+      auto packet = std::make_unique<PointerDataPacket>(1);
+      packet->SetPointerData(
+          0, CreateMovePointerData(
+                 now - PointerDataResampler::kDefaultLatencyMicros * 2 + i,
+                 x++));
+      dispatcher.DispatchPacket(std::move(packet), 0);
+    }
+    delegate.FireVsync();
+    frame_count++;
+  }
+  state.SetItemsProcessed(state.iterations() * events_per_frame);
+  state.counters["DispatchesPerFrame"] =
+      static_cast<double>(delegate.dispatch_count()) / frame_count;
+}
+
+static void BM_SmoothPointerDataDispatcher(benchmark::State& state) {
+  DispatchInputEvents(state, false);
+}
+
+BENCHMARK(BM_SmoothPointerDataDispatcher)->RangeMultiplier(2)->Range(1, 32);
+
+static void BM_ResamplingPointerDataDispatcher(benchmark::State& state) {
+  DispatchInputEvents(state, true);
+}
+
+BENCHMARK(BM_ResamplingPointerDataDispatcher)->RangeMultiplier(2)->Range(1, 32);
+
+// Measures the conversion every packet goes through on the platform thread,
+// for packets of |state.range(0)| events.
+static void BM_PointerDataPacketConversion(benchmark::State& state) {
+  const size_t events_per_packet = state.range(0);
+  PointerDataPacketConverter converter;
+
+  // Put the pointer down once so that the moves are valid transitions.
+  auto down = std::make_unique<PointerDataPacket>(2);
+  auto data = CreateMovePointerData(0, 0);
+  data.change = PointerData::Change::kAdd;
+  down->SetPointerData(0, data);
+  data.change = PointerData::Change::kDown;
+  down->SetPointerData(1, data);
+  FML_CHECK(converter.Convert(std::move(down)));
+
+  double x = 0;
+  while (state.KeepRunning()) {
+    auto packet = std::make_unique<PointerDataPacket>(events_per_packet);
+    for (size_t i = 0; i < events_per_packet; i++) {
+      packet->SetPointerData(i, CreateMovePointerData(0, x++));
+    }
+    benchmark::DoNotOptimize(converter.Convert(std::move(packet)));
+  }
+  state.SetItemsProcessed(state.iterations() * events_per_packet);
+}
+
+BENCHMARK(BM_PointerDataPacketConversion)->RangeMultiplier(4)->Range(1, 256);
+
+}  // namespace flutter
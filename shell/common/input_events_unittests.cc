@@ -175,6 +175,84 @@ void CreateSimulatedPointerData(PointerData& data,
   data.scroll_delta_y = 0.0;
 }
 
+static PointerData CreateMovePointerData(int64_t time_stamp,
+                                         double x,
+                                         double delta_x) {
+  PointerData data;
+  CreateSimulatedPointerData(data, PointerData::Change::kMove, x, 0.0);
+  data.time_stamp = time_stamp;
+  data.physical_delta_x = delta_x;
+  return data;
+}
+
+static std::vector<PointerData> UnpackPointerData(
+    const PointerDataPacket& packet) {
+  std::vector<PointerData> result(packet.data().size() / sizeof(PointerData));
+  memcpy(result.data(), packet.data().data(), packet.data().size());
+  return result;
+}
+
+TEST(PointerDataResamplerTest, ResamplesMovesToSampleTime) {
+  PointerDataResampler resampler;
+  auto packet = std::make_unique<PointerDataPacket>(3);
+  packet->SetPointerData(0, CreateMovePointerData(0, 0.0, 0.0));
+  packet->SetPointerData(1, CreateMovePointerData(10, 10.0, 10.0));
+  packet->SetPointerData(2, CreateMovePointerData(20, 20.0, 10.0));
+  resampler.AddPacket(*packet);
+
+  auto resampled = resampler.Resample(15);
+  ASSERT_TRUE(resampled);
+  auto events = UnpackPointerData(*resampled);
+  ASSERT_EQ(events.size(), 2u);
+  ASSERT_EQ(events[0].time_stamp, 0);
+  ASSERT_EQ(events[0].physical_x, 0.0);
+  // The last due event is moved halfway to the next one.
+  ASSERT_EQ(events[1].time_stamp, 15);
+  ASSERT_EQ(events[1].physical_x, 15.0);
+  ASSERT_EQ(events[1].physical_delta_x, 15.0);
+  ASSERT_TRUE(resampler.HasPendingEvents());
+
+  resampled = resampler.Resample(25);
+  ASSERT_TRUE(resampled);
+  events = UnpackPointerData(*resampled);
+  ASSERT_EQ(events.size(), 1u);
+  ASSERT_EQ(events[0].physical_x, 20.0);
+  // The deltas still add up to the distance travelled.
+  ASSERT_EQ(events[0].physical_delta_x, 5.0);
+  ASSERT_FALSE(resampler.HasPendingEvents());
+}
+
+TEST(PointerDataResamplerTest, DoesNotResampleAcrossPhaseChanges) {
+  PointerDataResampler resampler;
+  auto packet = std::make_unique<PointerDataPacket>(2);
+  packet->SetPointerData(0, CreateMovePointerData(10, 10.0, 10.0));
+  auto up = CreateMovePointerData(20, 20.0, 10.0);
+  up.change = PointerData::Change::kUp;
+  packet->SetPointerData(1, up);
+  resampler.AddPacket(*packet);
+
+  auto resampled = resampler.Resample(15);
+  ASSERT_TRUE(resampled);
+  auto events = UnpackPointerData(*resampled);
+  ASSERT_EQ(events.size(), 1u);
+  ASSERT_EQ(events[0].time_stamp, 10);
+  ASSERT_EQ(events[0].physical_x, 10.0);
+}
+
+TEST(PointerDataResamplerTest, DelaysEventsByOneFrameAtMost) {
+  PointerDataResampler resampler;
+  // A timestamp far ahead of the sample time, as if from another clock.
+  auto packet = std::make_unique<PointerDataPacket>(1);
+  packet->SetPointerData(0, CreateMovePointerData(1000000, 10.0, 10.0));
+  resampler.AddPacket(*packet);
+
+  ASSERT_FALSE(resampler.Resample(0));
+  auto resampled = resampler.Resample(0);
+  ASSERT_TRUE(resampled);
+  ASSERT_EQ(UnpackPointerData(*resampled).size(), 1u);
+  ASSERT_FALSE(resampler.HasPendingEvents());
+}
+
 TEST_F(ShellTest, MissAtMostOneFrameForIrregularInputEvents) {
   // We don't use `constexpr int frame_time` here because MSVC doesn't handle
   // it well with lambda capture.
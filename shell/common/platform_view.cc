@@ -89,6 +89,10 @@ sk_sp<GrContext> PlatformView::CreateResourceContext() const {
 
 void PlatformView::ReleaseResourceContext() const {}
 
+fml::closure PlatformView::GetResourceContextReleaser() const {
+  return nullptr;
+}
+
 PointerDataDispatcherMaker PlatformView::GetDispatcherMaker() {
   return [](DefaultPointerDataDispatcher::Delegate& delegate) {
     return std::make_unique<DefaultPointerDataDispatcher>(delegate);
@@ -9,6 +9,7 @@
 
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/texture.h"
+#include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
@@ -421,6 +422,23 @@ class PlatformView {
   ///
   virtual void ReleaseResourceContext() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by the shell when the resource context previously
+  ///             obtained via a call to `CreateResourceContext()` may outlive
+  ///             this platform view, which happens when it is shared with
+  ///             shells spawned from this one. The returned closure does what
+  ///             `ReleaseResourceContext()` does without referencing this
+  ///             platform view, and keeps alive only the platform specific
+  ///             resources it needs to do so.
+  ///
+  /// @attention  Unlike all other methods on the platform view, this will be
+  ///             called on IO task runner. So will the returned closure.
+  ///
+  /// @return     The closure releasing the resource context, or `nullptr` if
+  ///             there is nothing to release.
+  ///
+  virtual fml::closure GetResourceContextReleaser() const;
+
   //--------------------------------------------------------------------------
   /// @brief      Returns a platform-specific PointerDataDispatcherMaker so the
   ///             `Engine` can construct the PointerDataPacketDispatcher based
@@ -4,13 +4,22 @@
 
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/fml/time/time_point.h"
+
 namespace flutter {
 
 PointerDataDispatcher::~PointerDataDispatcher() = default;
 DefaultPointerDataDispatcher::~DefaultPointerDataDispatcher() = default;
 
-SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
-    : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
+SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate,
+                                                         bool resample_to_vsync)
+    : DefaultPointerDataDispatcher(delegate),
+      resampler_(resample_to_vsync ? std::make_unique<PointerDataResampler>()
+                                   : nullptr),
+      weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
 void DefaultPointerDataDispatcher::DispatchPacket(
@@ -22,6 +31,13 @@ void DefaultPointerDataDispatcher::DispatchPacket(
 void SmoothPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
+  if (resampler_) {
+    resampler_->AddPacket(*packet);
+    pending_trace_flow_id_ = trace_flow_id;
+    ScheduleSecondaryVsyncCallback();
+    return;
+  }
+
   if (is_pointer_data_in_progress_) {
     if (pending_packet_ != nullptr) {
       DispatchPendingPacket();
@@ -40,7 +56,9 @@ void SmoothPointerDataDispatcher::DispatchPacket(
 void SmoothPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
   delegate_.ScheduleSecondaryVsyncCallback(
       [dispatcher = weak_factory_.GetWeakPtr()]() {
-        if (dispatcher && dispatcher->is_pointer_data_in_progress_) {
+        if (dispatcher && dispatcher->resampler_) {
+          dispatcher->DispatchResampledPacket();
+        } else if (dispatcher && dispatcher->is_pointer_data_in_progress_) {
           if (dispatcher->pending_packet_ != nullptr) {
             dispatcher->DispatchPendingPacket();
           } else {
@@ -60,4 +78,97 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+void SmoothPointerDataDispatcher::DispatchResampledPacket() {
+  const auto sample_time =
+      fml::TimePoint::Now().ToEpochDelta().ToMicroseconds() -
+      PointerDataResampler::kDefaultLatencyMicros;
+  auto packet = resampler_->Resample(sample_time);
+  if (packet) {
+    DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                                 pending_trace_flow_id_);
+  }
+  if (resampler_->HasPendingEvents()) {
+    ScheduleSecondaryVsyncCallback();
+  }
+}
+
+PointerDataResampler::PointerDataResampler() = default;
+
+PointerDataResampler::~PointerDataResampler() = default;
+
+void PointerDataResampler::AddPacket(const PointerDataPacket& packet) {
+  const auto& data = packet.data();
+  const size_t count = data.size() / sizeof(PointerData);
+  for (size_t i = 0; i < count; i++) {
+    PointerData pointer_data;
+    memcpy(&pointer_data, &data[i * sizeof(PointerData)], sizeof(PointerData));
+    events_.push_back(pointer_data);
+  }
+}
+
+static bool IsMotion(const PointerData& data) {
+  return (data.change == PointerData::Change::kMove ||
+          data.change == PointerData::Change::kHover) &&
+         data.signal_kind == PointerData::SignalKind::kNone;
+}
+
+std::unique_ptr<PointerDataPacket> PointerDataResampler::Resample(
+    int64_t sample_time) {
+  size_t due_count = std::min(held_count_, events_.size());
+  while (due_count < events_.size() &&
+         events_[due_count].time_stamp <= sample_time) {
+    due_count++;
+  }
+  if (due_count == 0) {
+    held_count_ = events_.size();
+    return nullptr;
+  }
+
+  // Move the last due event of each moving pointer to the sample time. Only
+  // the last one is moved so that the events the framework uses to estimate
+  // velocities keep their original timing.
+  std::vector<int64_t> seen_devices;
+  for (size_t i = due_count; i-- > 0;) {
+    auto& current = events_[i];
+    if (std::find(seen_devices.begin(), seen_devices.end(), current.device) !=
+        seen_devices.end()) {
+      continue;
+    }
+    seen_devices.push_back(current.device);
+    if (!IsMotion(current) || current.time_stamp >= sample_time) {
+      continue;
+    }
+    auto next = std::find_if(
+        events_.begin() + due_count, events_.end(),
+        [&current](const PointerData& data) {
+          return data.device == current.device;
+        });
+    if (next == events_.end() || !IsMotion(*next) ||
+        next->change != current.change || next->buttons != current.buttons ||
+        next->time_stamp <= current.time_stamp) {
+      continue;
+    }
+    const double t = std::min(
+        1.0, static_cast<double>(sample_time - current.time_stamp) /
+                 (next->time_stamp - current.time_stamp));
+    const double dx = (next->physical_x - current.physical_x) * t;
+    const double dy = (next->physical_y - current.physical_y) * t;
+    current.time_stamp = sample_time;
+    current.physical_x += dx;
+    current.physical_y += dy;
+    current.physical_delta_x += dx;
+    current.physical_delta_y += dy;
+    next->physical_delta_x -= dx;
+    next->physical_delta_y -= dy;
+  }
+
+  auto packet = std::make_unique<PointerDataPacket>(due_count);
+  for (size_t i = 0; i < due_count; i++) {
+    packet->SetPointerData(i, events_[i]);
+  }
+  events_.erase(events_.begin(), events_.begin() + due_count);
+  held_count_ = events_.size();
+  return packet;
+}
+
 }  // namespace flutter
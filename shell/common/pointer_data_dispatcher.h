@@ -5,6 +5,8 @@
 #ifndef POINTER_DATA_DISPATCHER_H_
 #define POINTER_DATA_DISPATCHER_H_
 
+#include <deque>
+
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
 
@@ -96,6 +98,51 @@ class DefaultPointerDataDispatcher : public PointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(DefaultPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// Holds pointer events until they are due and moves the position of each
+/// moving pointer to the sample time, interpolating between the events sampled
+/// right before and right after it. Events are never dropped or synthesized.
+/// The deltas of the resampled event and of the event following it are
+/// adjusted so that they still add up to the distance travelled.
+///
+/// Event timestamps must use the clock of `fml::TimePoint`, in microseconds.
+/// Events whose timestamps are not due yet are still released on the second
+/// call to `Resample` after they were added, so that events with timestamps
+/// from another clock are delayed by one frame at most.
+///
+class PointerDataResampler {
+ public:
+  // How far before the vsync pointers are sampled. Resampling needs the event
+  // following the sample time, so this should be a bit more than the interval
+  // of the input device.
+  static constexpr int64_t kDefaultLatencyMicros = 5000;
+
+  PointerDataResampler();
+
+  ~PointerDataResampler();
+
+  void AddPacket(const PointerDataPacket& packet);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes the events that are due at a sample time.
+  ///
+  /// @param[in]  sample_time  The sample time in microseconds.
+  ///
+  /// @return     The due events, or null if no event is due.
+  ///
+  std::unique_ptr<PointerDataPacket> Resample(int64_t sample_time);
+
+  bool HasPendingEvents() const { return !events_.empty(); }
+
+ private:
+  std::deque<PointerData> events_;
+  // The number of events that were already pending during the last call to
+  // |Resample| and must be released by the next one.
+  size_t held_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PointerDataResampler);
+};
+
 //------------------------------------------------------------------------------
 /// A dispatcher that may temporarily store and defer the last received
 /// PointerDataPacket if multiple packets are received in one VSYNC. The
@@ -133,10 +180,18 @@ class DefaultPointerDataDispatcher : public PointerDataDispatcher {
 /// assumption seems to hold on all devices. If it's changed in the future,
 /// we'll need a different solution.
 ///
+/// When constructed with `resample_to_vsync`, the dispatcher instead holds
+/// every event until the vsync after it was sampled, and resamples the position
+/// of each moving pointer to a fixed latency before the vsync. See
+/// `PointerDataResampler`. This trades a constant latency for a constant number
+/// of pointer data dispatches per frame and for positions that advance by the
+/// same amount every frame, regardless of the input sampling rate.
+///
 /// See also input_events_unittests.cc where we test all our claims above.
 class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
  public:
-  SmoothPointerDataDispatcher(Delegate& delegate);
+  SmoothPointerDataDispatcher(Delegate& delegate,
+                              bool resample_to_vsync = false);
 
   // |PointerDataDispatcer|
   void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
@@ -153,10 +208,15 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
 
   bool is_pointer_data_in_progress_ = false;
 
+  // Only used when resampling to vsync.
+  std::unique_ptr<PointerDataResampler> resampler_;
+
   fml::WeakPtrFactory<SmoothPointerDataDispatcher> weak_factory_;
 
   void DispatchPendingPacket();
 
+  void DispatchResampledPacket();
+
   void ScheduleSecondaryVsyncCallback();
 
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
@@ -239,6 +239,10 @@ RasterStatus Rasterizer::DoDraw(
     return RasterStatus::kFailed;
   }
 
+  last_submit_duration_ = fml::TimeDelta::Zero();
+  compositor_context_->ResetRasterPhaseDurations();
+
+  const auto vsync_latency = layer_tree->vsync_latency();
   FrameTiming timing;
   timing.Set(FrameTiming::kBuildStart, layer_tree->build_start());
   timing.Set(FrameTiming::kBuildFinish, layer_tree->build_finish());
@@ -266,6 +270,24 @@ RasterStatus Rasterizer::DoDraw(
   // Rasterizer::DoDraw finishes. Future work is needed to adapt the timestamp
   // for Fuchsia to capture SceneUpdateContext::ExecutePaintTasks.
   timing.Set(FrameTiming::kRasterFinish, fml::TimePoint::Now());
+
+  const auto& raster_durations =
+      compositor_context_->last_raster_phase_durations();
+  FramePhaseDurations durations;
+  durations.vsync_latency = vsync_latency;
+  durations.build = timing.Get(FrameTiming::kBuildFinish) -
+                    timing.Get(FrameTiming::kBuildStart) - vsync_latency;
+  durations.preroll = raster_durations.preroll;
+  durations.paint = raster_durations.paint;
+  durations.raster_cache = raster_durations.raster_cache;
+  durations.gpu_flush = last_submit_duration_;
+  durations.raster = timing.Get(FrameTiming::kRasterFinish) -
+                     timing.Get(FrameTiming::kRasterStart);
+  durations.total = timing.Get(FrameTiming::kRasterFinish) -
+                    timing.Get(FrameTiming::kBuildStart);
+  durations.compiled_shaders = persistent_cache->StoredNewShaders();
+  delegate_.OnFramePhaseDurations(durations);
+
   delegate_.OnFrameRasterized(timing);
 
   // Pipeline pressure is applied from a couple of places:
@@ -342,10 +364,12 @@ RasterStatus Rasterizer::DrawToSurface(flutter::LayerTree& layer_tree) {
     if (raster_status == RasterStatus::kFailed) {
       return raster_status;
     }
+    const auto submit_start = fml::TimePoint::Now();
     frame->Submit();
     if (external_view_embedder != nullptr) {
       external_view_embedder->SubmitFrame(surface_->GetContext());
     }
+    last_submit_duration_ = fml::TimePoint::Now() - submit_start;
 
     FireNextFrameCallbackIfPresent();
 
@@ -17,6 +17,7 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
+#include "flutter/shell/common/frame_statistics.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/surface.h"
 
@@ -65,6 +66,15 @@ class Rasterizer final : public SnapshotDelegate {
     ///
     virtual void OnFrameRasterized(const FrameTiming& frame_timing) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Notifies the delegate of the time spent in each phase of a
+    ///             frame that has been rendered. This is called just before
+    ///             |OnFrameRasterized| for the same frame.
+    ///
+    /// @param[in]  durations  The durations of the phases of the frame.
+    ///
+    virtual void OnFramePhaseDurations(const FramePhaseDurations& durations) {}
+
     /// Time limit for a smooth frame. See `Engine::GetDisplayRefreshRate`.
     virtual fml::Milliseconds GetFrameBudget() = 0;
   };
@@ -204,6 +214,9 @@ class Rasterizer final : public SnapshotDelegate {
   ///             Flutter can re-render the layer tree with just the updated
   ///             textures instead of waiting for the framework to do the work
   ///             to generate the layer tree describing the same contents.
+  ///             When nothing it depends on changed, the preroll of the last
+  ///             frame is reused along with the raster cache entries it
+  ///             prepared.
   ///
   void DrawLastLayerTree();
 
@@ -421,6 +434,9 @@ class Rasterizer final : public SnapshotDelegate {
   std::optional<size_t> max_cache_bytes_;
   fml::WeakPtrFactory<Rasterizer> weak_factory_;
   fml::RefPtr<fml::GpuThreadMerger> gpu_thread_merger_;
+  // The time taken to submit the last frame drawn by |DrawToSurface|. Zero if
+  // the frame failed before it was submitted.
+  fml::TimeDelta last_submit_duration_;
 
   // |SnapshotDelegate|
   sk_sp<SkImage> MakeRasterSnapshot(sk_sp<SkPicture> picture,
@@ -7,6 +7,7 @@
 #include <sstream>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/packed_asset_bundle.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/runtime/dart_vm.h"
@@ -23,9 +24,19 @@ RunConfiguration RunConfiguration::InferFromSettings(
         fml::Duplicate(settings.assets_dir)));
   }
 
+  auto assets_directory = fml::OpenDirectory(
+      settings.assets_path.c_str(), false, fml::FilePermission::kRead);
+
+  // A packed bundle serves all lookups from a single mapping. Individual files
+  // in the directory are still consulted for assets not in the bundle.
+  if (fml::FileExists(assets_directory, kPackedAssetBundleFileName)) {
+    asset_manager->PushBack(std::make_unique<PackedAssetBundle>(
+        fml::OpenFile(assets_directory, kPackedAssetBundleFileName, false,
+                      fml::FilePermission::kRead)));
+  }
+
   asset_manager->PushBack(
-      std::make_unique<DirectoryAssetBundle>(fml::OpenDirectory(
-          settings.assets_path.c_str(), false, fml::FilePermission::kRead)));
+      std::make_unique<DirectoryAssetBundle>(std::move(assets_directory)));
 
   return {IsolateConfiguration::InferFromSettings(settings, asset_manager,
                                                   io_worker),
@@ -18,6 +18,7 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_recorder.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/start_up.h"
@@ -46,15 +47,37 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     Settings settings,
     fml::RefPtr<const DartSnapshot> isolate_snapshot,
     const Shell::CreateCallback<PlatformView>& on_create_platform_view,
-    const Shell::CreateCallback<Rasterizer>& on_create_rasterizer) {
+    const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
+    const Shell* parent_shell) {
   if (!task_runners.IsValid()) {
     FML_LOG(ERROR) << "Task runners to run the shell were invalid.";
     return nullptr;
   }
 
+  TRACE_EVENT0("flutter", "Shell::CreateShellOnPlatformThread");
+  const auto startup_begin = fml::TimePoint::Now();
+
   auto shell =
       std::unique_ptr<Shell>(new Shell(std::move(vm), task_runners, settings));
 
+  // A spawned shell uses the IO manager of its parent and hence must observe
+  // the same GPU availability.
+  std::shared_ptr<ShellIOManager> parent_io_manager;
+  const Engine* parent_engine = nullptr;
+  if (parent_shell) {
+    shell->is_gpu_disabled_sync_switch_ =
+        parent_shell->is_gpu_disabled_sync_switch_;
+    parent_io_manager = parent_shell->io_manager_;
+    parent_engine = parent_shell->engine_.get();
+  }
+
+  // The stages of shell creation run concurrently on the GPU, IO, UI and
+  // concurrent worker task runners. Each stage only waits on the results of
+  // other stages it actually depends on. The time spent in each stage is
+  // recorded in the |StartupTimings| of the shell before the stage fulfills
+  // its promise so that it is visible once all the futures below are ready.
+  StartupTimings& timings = shell->startup_timings_;
+
   // Create the rasterizer on the GPU thread.
   std::promise<std::unique_ptr<Rasterizer>> rasterizer_promise;
   auto rasterizer_future = rasterizer_promise.get_future();
@@ -64,16 +87,25 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
       task_runners.GetGPUTaskRunner(), [&rasterizer_promise,  //
                                         &snapshot_delegate_promise,
                                         on_create_rasterizer,  //
-                                        shell = shell.get()    //
+                                        shell = shell.get(),   //
+                                        &timings               //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
+        const auto start = fml::TimePoint::Now();
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
+        timings.rasterizer = fml::TimePoint::Now() - start;
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
 
   // Create the platform view on the platform thread (this thread).
-  auto platform_view = on_create_platform_view(*shell.get());
+  std::unique_ptr<PlatformView> platform_view;
+  {
+    TRACE_EVENT0("flutter", "ShellSetupPlatformView");
+    const auto start = fml::TimePoint::Now();
+    platform_view = on_create_platform_view(*shell.get());
+    timings.platform_view = fml::TimePoint::Now() - start;
+  }
   if (!platform_view || !platform_view->GetWeakPtr()) {
     return nullptr;
   }
@@ -85,11 +117,36 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     return nullptr;
   }
 
+  // Create the font collection on a concurrent worker. Setting up the default
+  // font manager may scan the fonts installed on the system and does not
+  // depend on any of the other subsystems. Spawned shells share the font
+  // collection of their parent.
+  std::promise<std::shared_ptr<FontCollection>> font_collection_promise;
+  auto font_collection_future = font_collection_promise.get_future();
+  if (parent_engine) {
+    font_collection_promise.set_value(nullptr);
+  } else {
+    shell->GetDartVM()->GetConcurrentWorkerTaskRunner()->PostTask(
+        [&font_collection_promise, &timings]() {
+          TRACE_EVENT0("flutter", "ShellSetupFontCollection");
+          const auto start = fml::TimePoint::Now();
+          auto font_collection = std::make_shared<FontCollection>();
+          timings.font_collection = fml::TimePoint::Now() - start;
+          font_collection_promise.set_value(std::move(font_collection));
+        });
+  }
+
   // Create the IO manager on the IO thread. The IO manager must be initialized
   // first because it has state that the other subsystems depend on. It must
   // first be booted and the necessary references obtained to initialize the
-  // other subsystems.
-  std::promise<std::unique_ptr<ShellIOManager>> io_manager_promise;
+  // other subsystems. Spawned shells reuse the IO manager, and with it the
+  // resource context, of their parent.
+  //
+  // Only the weak pointer and the unref queue of the IO manager are needed to
+  // create the engine. These are handed out before the resource context is
+  // created so that the engine can be created while the resource context is
+  // still being set up.
+  std::promise<std::shared_ptr<ShellIOManager>> io_manager_promise;
   auto io_manager_future = io_manager_promise.get_future();
   std::promise<fml::WeakPtr<ShellIOManager>> weak_io_manager_promise;
   auto weak_io_manager_future = weak_io_manager_promise.get_future();
@@ -105,25 +162,52 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   // https://github.com/flutter/flutter/issues/42948
   fml::TaskRunner::RunNowOrPostTask(
       io_task_runner,
-      [&io_manager_promise,                                               //
-       &weak_io_manager_promise,                                          //
-       &unref_queue_promise,                                              //
-       platform_view = platform_view->GetWeakPtr(),                       //
-       io_task_runner,                                                    //
-       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
+      [&io_manager_promise,                                                //
+       &weak_io_manager_promise,                                           //
+       &unref_queue_promise,                                               //
+       platform_view = platform_view->GetWeakPtr(),                        //
+       io_task_runner,                                                     //
+       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch(),  //
+       parent_io_manager,                                                  //
+       &timings                                                            //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
-        auto io_manager = std::make_unique<ShellIOManager>(
-            platform_view.getUnsafe()->CreateResourceContext(),
-            is_backgrounded_sync_switch, io_task_runner);
+        auto io_manager = parent_io_manager;
+        if (!io_manager) {
+          const auto start = fml::TimePoint::Now();
+          io_manager = std::make_shared<ShellIOManager>(
+              nullptr, is_backgrounded_sync_switch, io_task_runner);
+          timings.io_manager = fml::TimePoint::Now() - start;
+        }
         weak_io_manager_promise.set_value(io_manager->GetWeakPtr());
         unref_queue_promise.set_value(io_manager->GetSkiaUnrefQueue());
+
+        if (!parent_io_manager) {
+          TRACE_EVENT0("flutter", "ShellSetupResourceContext");
+          const auto start = fml::TimePoint::Now();
+          io_manager->CreateResourceContext(*platform_view.getUnsafe());
+          timings.resource_context = fml::TimePoint::Now() - start;
+#ifndef OS_FUCHSIA
+          if (!io_manager->GetResourceContext()) {
+            FML_DLOG(WARNING)
+                << "The IO manager was initialized without a resource "
+                   "context. Async texture uploads will be disabled. Expect "
+                   "performance degradation.";
+          }
+#endif  // OS_FUCHSIA
+        }
         io_manager_promise.set_value(std::move(io_manager));
       });
 
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
   auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  if (shell->GetSettings().resample_pointer_events_to_vsync) {
+    dispatcher_maker = [](PointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<SmoothPointerDataDispatcher>(
+          delegate, true /* resample to vsync */);
+    };
+  }
 
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
@@ -138,29 +222,56 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                          vsync_waiter = std::move(vsync_waiter),          //
                          &weak_io_manager_future,                         //
                          &snapshot_delegate_future,                       //
-                         &unref_queue_future                              //
+                         &unref_queue_future,                             //
+                         &font_collection_future,                         //
+                         parent_engine,                                   //
+                         &timings                                         //
   ]() mutable {
         TRACE_EVENT0("flutter", "ShellSetupUISubsystem");
         const auto& task_runners = shell->GetTaskRunners();
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
-
-        engine_promise.set_value(std::make_unique<Engine>(
-            *shell,                         //
-            dispatcher_maker,               //
-            *shell->GetDartVM(),            //
-            std::move(isolate_snapshot),    //
-            task_runners,                   //
-            window_data,                    //
-            shell->GetSettings(),           //
-            std::move(animator),            //
-            weak_io_manager_future.get(),   //
-            unref_queue_future.get(),       //
-            snapshot_delegate_future.get()  //
-            ));
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell->GetSettings().frame_scheduling_policy);
+
+        // Wait for the stages on the other threads the engine depends on.
+        auto weak_io_manager = weak_io_manager_future.get();
+        auto unref_queue = unref_queue_future.get();
+        auto snapshot_delegate = snapshot_delegate_future.get();
+        auto font_collection = font_collection_future.get();
+
+        const auto start = fml::TimePoint::Now();
+        std::unique_ptr<Engine> engine;
+        if (parent_engine) {
+          engine = parent_engine->Spawn(
+              *shell,                       //
+              dispatcher_maker,             //
+              shell->GetSettings(),         //
+              std::move(animator),          //
+              std::move(weak_io_manager),   //
+              std::move(unref_queue),       //
+              std::move(snapshot_delegate)  //
+          );
+        } else {
+          engine = std::make_unique<Engine>(
+              *shell,                        //
+              dispatcher_maker,              //
+              *shell->GetDartVM(),           //
+              std::move(isolate_snapshot),   //
+              task_runners,                  //
+              window_data,                   //
+              shell->GetSettings(),          //
+              std::move(animator),           //
+              std::move(weak_io_manager),    //
+              std::move(unref_queue),        //
+              std::move(snapshot_delegate),  //
+              std::move(font_collection)     //
+          );
+        }
+        timings.engine = fml::TimePoint::Now() - start;
+        engine_promise.set_value(std::move(engine));
       }));
 
   if (!shell->Setup(std::move(platform_view),  //
@@ -171,6 +282,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     return nullptr;
   }
 
+  timings.total = fml::TimePoint::Now() - startup_begin;
   return shell;
 }
 
@@ -205,6 +317,10 @@ static void PerformInitializationTasks(const Settings& settings) {
       InitSkiaEventTracer(settings.trace_skia);
     }
 
+    if (settings.enable_trace_recorder) {
+      fml::tracing::TraceRecorder::GetInstance().Enable();
+    }
+
     if (!settings.skia_deterministic_rendering_on_cpu) {
       SkGraphics::Init();
     } else {
@@ -247,19 +363,25 @@ std::unique_ptr<Shell> Shell::Create(
 
   TRACE_EVENT0("flutter", "Shell::Create");
 
+  const auto vm_start = fml::TimePoint::Now();
   auto vm = DartVMRef::Create(settings);
   FML_CHECK(vm) << "Must be able to initialize the VM.";
+  const auto vm_duration = fml::TimePoint::Now() - vm_start;
 
   auto vm_data = vm->GetVMData();
 
-  return Shell::Create(std::move(task_runners),        //
-                       std::move(window_data),         //
-                       std::move(settings),            //
-                       vm_data->GetIsolateSnapshot(),  // isolate snapshot
-                       on_create_platform_view,        //
-                       on_create_rasterizer,           //
-                       std::move(vm)                   //
+  auto shell = Shell::Create(std::move(task_runners),        //
+                             std::move(window_data),         //
+                             std::move(settings),            //
+                             vm_data->GetIsolateSnapshot(),  // isolate snapshot
+                             on_create_platform_view,        //
+                             on_create_rasterizer,           //
+                             std::move(vm)                   //
   );
+  if (shell) {
+    shell->startup_timings_.vm = vm_duration;
+  }
+  return shell;
 }
 
 std::unique_ptr<Shell> Shell::Create(
@@ -300,7 +422,8 @@ std::unique_ptr<Shell> Shell::Create(
                                             settings,                     //
                                             std::move(isolate_snapshot),  //
                                             on_create_platform_view,      //
-                                            on_create_rasterizer          //
+                                            on_create_rasterizer,         //
+                                            nullptr                       //
         );
         latch.Signal();
       }));
@@ -308,6 +431,38 @@ std::unique_ptr<Shell> Shell::Create(
   return shell;
 }
 
+std::unique_ptr<Shell> Shell::Spawn(
+    RunConfiguration run_configuration,
+    const CreateCallback<PlatformView>& on_create_platform_view,
+    const CreateCallback<Rasterizer>& on_create_rasterizer) const {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  TRACE_EVENT0("flutter", "Shell::Spawn");
+
+  if (!on_create_platform_view || !on_create_rasterizer) {
+    return nullptr;
+  }
+
+  // The VM is already running so this only takes a reference to it.
+  auto shell = CreateShellOnPlatformThread(
+      DartVMRef::Create(settings_),  //
+      task_runners_,                 //
+      WindowData{},                  //
+      settings_,                     //
+      nullptr,                       // uses the parent engine's snapshot
+      on_create_platform_view,       //
+      on_create_rasterizer,          //
+      this                           // parent shell
+  );
+  if (!shell) {
+    return nullptr;
+  }
+
+  shell->RunEngine(std::move(run_configuration));
+  return shell;
+}
+
 Shell::Shell(DartVMRef vm, TaskRunners task_runners, Settings settings)
     : task_runners_(std::move(task_runners)),
       settings_(std::move(settings)),
@@ -357,6 +512,20 @@ Shell::Shell(DartVMRef vm, TaskRunners task_runners, Settings settings)
           task_runners_.GetUITaskRunner(),
           std::bind(&Shell::OnServiceProtocolGetDisplayRefreshRate, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameStatisticsExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameStatistics, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetTraceRecordingExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetTraceRecording, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetLayerProfileExtensionName] =
+      {task_runners_.GetGPUTaskRunner(),
+       std::bind(&Shell::OnServiceProtocolGetLayerProfile, this,
+                 std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -391,10 +560,15 @@ Shell::~Shell() {
       fml::MakeCopyable([io_manager = std::move(io_manager_),
                          platform_view = platform_view_.get(),
                          &io_latch]() mutable {
-        io_manager.reset();
-        if (platform_view) {
-          platform_view->ReleaseResourceContext();
+        // The IO manager and its resource context are shared with spawned
+        // shells and the context is released along with the IO manager. If
+        // the platform view of this shell created the context, the context
+        // must be released without it. The platform view is collected once
+        // the latch is signaled.
+        if (io_manager.use_count() > 1 && platform_view) {
+          io_manager->DetachResourceContextCreator(*platform_view);
         }
+        io_manager.reset();
         io_latch.Signal();
       }));
 
@@ -505,7 +679,7 @@ bool Shell::IsSetup() const {
 bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
                   std::unique_ptr<Engine> engine,
                   std::unique_ptr<Rasterizer> rasterizer,
-                  std::unique_ptr<ShellIOManager> io_manager) {
+                  std::shared_ptr<ShellIOManager> io_manager) {
   if (is_setup_) {
     return false;
   }
@@ -641,9 +815,8 @@ void Shell::OnPlatformViewCreated(std::unique_ptr<Surface> surface) {
 
   auto io_task = [io_manager = io_manager_->GetWeakPtr(), platform_view,
                   ui_task_runner = task_runners_.GetUITaskRunner(), ui_task] {
-    if (io_manager && !io_manager->GetResourceContext()) {
-      io_manager->NotifyResourceContextAvailable(
-          platform_view->CreateResourceContext());
+    if (io_manager) {
+      io_manager->CreateResourceContext(*platform_view);
     }
     // Step 1: Next, post a task on the UI thread to tell the engine that it has
     // an output surface.
@@ -870,28 +1043,35 @@ void Shell::OnPlatformViewMarkTextureFrameAvailable(int64_t texture_id) {
 
   // Tell the rasterizer that one of its textures has a new frame available.
   task_runners_.GetGPUTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), texture_id]() {
+      [rasterizer = rasterizer_->GetWeakPtr(), engine = engine_->GetWeakPtr(),
+       ui_task_runner = task_runners_.GetUITaskRunner(), texture_id]() {
+        if (!rasterizer) {
+          return;
+        }
+
         auto* registry = rasterizer->GetTextureRegistry();
 
         if (!registry) {
           return;
         }
 
-        auto texture = registry->GetTexture(texture_id);
-
-        if (!texture) {
+        // Only textures that are on screen need a frame to show their new
+        // frames. The others are drawn with their latest frame once they are
+        // painted again.
+        if (!registry->MarkNewFrameAvailable(texture_id)) {
+          TRACE_EVENT_INSTANT0("flutter", "Texture frame not shown");
           return;
         }
 
-        texture->MarkNewFrameAvailable();
+        // Schedule a new frame without having to rebuild the layer tree. The
+        // animator draws a single frame per vsync however many textures have
+        // new frames by then.
+        ui_task_runner->PostTask([engine]() {
+          if (engine) {
+            engine->ScheduleFrame(false);
+          }
+        });
       });
-
-  // Schedule a new frame without having to rebuild the layer tree.
-  task_runners_.GetUITaskRunner()->PostTask([engine = engine_->GetWeakPtr()]() {
-    if (engine) {
-      engine->ScheduleFrame(false);
-    }
-  });
 }
 
 // |PlatformView::Delegate|
@@ -1075,6 +1255,53 @@ size_t Shell::UnreportedFramesCount() const {
   return unreported_timings_.size() / FrameTiming::kCount;
 }
 
+void Shell::MaybeDumpTraceRecording(const FrameTiming& timing) {
+  FML_DCHECK(task_runners_.GetGPUTaskRunner()->RunsTasksOnCurrentThread());
+  if (settings_.trace_recorder_dump_path.empty() ||
+      !fml::tracing::TraceRecorder::IsEnabled()) {
+    return;
+  }
+
+  const auto frame_duration = timing.Get(FrameTiming::kRasterFinish) -
+                              timing.Get(FrameTiming::kBuildStart);
+  if (frame_duration.ToMillisecondsF() <= GetFrameBudget().count() * 2) {
+    return;
+  }
+
+  // Dumps are expensive and janky frames tend to come in bursts. A single
+  // recording covers the preceding frames as well.
+  constexpr fml::TimeDelta kMinDumpInterval = fml::TimeDelta::FromSeconds(10);
+  const auto now = fml::TimePoint::Now();
+  if (last_trace_recording_dump_.has_value() &&
+      now - last_trace_recording_dump_.value() < kMinDumpInterval) {
+    return;
+  }
+  last_trace_recording_dump_ = now;
+
+  TRACE_EVENT0("flutter", "Shell::DumpTraceRecording");
+  std::stringstream file_name;
+  file_name << "trace_" << now.ToEpochDelta().ToMicroseconds() << ".json";
+  vm_->GetConcurrentWorkerTaskRunner()->PostTask(
+      [path = settings_.trace_recorder_dump_path, file_name = file_name.str()] {
+        auto directory = fml::OpenDirectory(path.c_str(), true,
+                                            fml::FilePermission::kReadWrite);
+        if (!directory.is_valid()) {
+          FML_LOG(ERROR) << "Could not open the trace recorder dump path: "
+                         << path;
+          return;
+        }
+        fml::tracing::TraceRecorder::GetInstance().WriteChromeTrace(
+            directory, file_name.c_str());
+      });
+}
+
+// |Rasterizer::Delegate|
+void Shell::OnFramePhaseDurations(const FramePhaseDurations& durations) {
+  FML_DCHECK(task_runners_.GetGPUTaskRunner()->RunsTasksOnCurrentThread());
+  frame_statistics_.AddFrame(
+      durations, fml::TimeDelta::FromSecondsF(GetFrameBudget().count() / 1e3));
+}
+
 void Shell::OnFrameRasterized(const FrameTiming& timing) {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetGPUTaskRunner()->RunsTasksOnCurrentThread());
@@ -1085,6 +1312,21 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  MaybeDumpTraceRecording(timing);
+
+  // The low latency scheduling policy starts frames as late as the recent
+  // raster durations allow.
+  if (settings_.frame_scheduling_policy == FrameSchedulingPolicy::kLowLatency) {
+    const auto raster_duration = timing.Get(FrameTiming::kRasterFinish) -
+                                 timing.Get(FrameTiming::kRasterStart);
+    task_runners_.GetUITaskRunner()->PostTask(
+        [engine = weak_engine_, raster_duration] {
+          if (engine) {
+            engine->ReportRasterDuration(raster_duration);
+          }
+        });
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1337,6 +1579,139 @@ bool Shell::OnServiceProtocolGetDisplayRefreshRate(
   return true;
 }
 
+static void AddPercentiles(rapidjson::Document& response,
+                           const char* name,
+                           const FrameStatistics::Percentiles& percentiles) {
+  auto& allocator = response.GetAllocator();
+  rapidjson::Value value(rapidjson::kObjectType);
+  value.AddMember("p50Ms", percentiles.p50.ToMillisecondsF(), allocator);
+  value.AddMember("p90Ms", percentiles.p90.ToMillisecondsF(), allocator);
+  value.AddMember("p99Ms", percentiles.p99.ToMillisecondsF(), allocator);
+  value.AddMember("maxMs", percentiles.max.ToMillisecondsF(), allocator);
+  response.AddMember(rapidjson::StringRef(name), value, allocator);
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetFrameStatistics(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document& response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  const auto summary = GetFrameStatistics();
+  if (params.count("reset") != 0 && params.at("reset") == "true") {
+    ResetFrameStatistics();
+  }
+
+  auto& allocator = response.GetAllocator();
+  response.SetObject();
+  response.AddMember("type", "FrameStatistics", allocator);
+  response.AddMember("frameCount", static_cast<uint64_t>(summary.frame_count),
+                     allocator);
+  response.AddMember("missedFrameCount",
+                     static_cast<uint64_t>(summary.missed_frame_count),
+                     allocator);
+  AddPercentiles(response, "build", summary.build);
+  AddPercentiles(response, "raster", summary.raster);
+  AddPercentiles(response, "vsyncLatency", summary.vsync_latency);
+  AddPercentiles(response, "total", summary.total);
+
+  rapidjson::Value causes(rapidjson::kObjectType);
+  for (size_t i = 0; i < summary.missed_frames_by_cause.size(); i++) {
+    const auto cause = static_cast<FrameStatistics::JankCause>(i);
+    causes.AddMember(
+        rapidjson::StringRef(FrameStatistics::GetJankCauseName(cause)),
+        static_cast<uint64_t>(summary.missed_frames_by_cause[i]), allocator);
+  }
+  response.AddMember("missedFramesByCause", causes, allocator);
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetTraceRecording(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document& response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  const auto& recorder = fml::tracing::TraceRecorder::GetInstance();
+  const auto trace = recorder.ExportChromeTraceJSON();
+  auto& allocator = response.GetAllocator();
+  response.SetObject();
+  response.AddMember("type", "TraceRecording", allocator);
+  response.AddMember("enabled", recorder.IsEnabled(), allocator);
+  rapidjson::Value trace_value;
+  trace_value.SetString(trace.data(), trace.size(), allocator);
+  response.AddMember("trace", trace_value, allocator);
+  return true;
+}
+
+// Service protocol handler
+//
+// Reports the layers that took the most time to paint in the frames painted
+// since profiling was enabled. The optional parameters are:
+//   enabled: "true" or "false" to start or stop profiling after the report.
+//   reset: "true" to forget the profiled frames after the report.
+//   limit: The number of layers to report, 20 by default.
+bool Shell::OnServiceProtocolGetLayerProfile(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document& response) {
+  FML_DCHECK(task_runners_.GetGPUTaskRunner()->RunsTasksOnCurrentThread());
+  if (!rasterizer_ || !rasterizer_->compositor_context()) {
+    ServiceProtocolFailureError(response, "Rasterizer is unavailable.");
+    return false;
+  }
+
+  size_t limit = 20;
+  if (params.count("limit") != 0) {
+    std::stringstream stream{std::string(params.at("limit"))};
+    if (!(stream >> limit)) {
+      ServiceProtocolParameterError(response,
+                                    "'limit' parameter is not a number.");
+      return false;
+    }
+  }
+
+  auto& profiler = rasterizer_->compositor_context()->layer_profiler();
+  const auto report = profiler.GetReport(limit);
+  if (params.count("reset") != 0 && params.at("reset") == "true") {
+    profiler.Reset();
+  }
+  if (params.count("enabled") != 0) {
+    profiler.set_enabled(params.at("enabled") == "true");
+  }
+
+  auto& allocator = response.GetAllocator();
+  response.SetObject();
+  response.AddMember("type", "LayerProfile", allocator);
+  response.AddMember("enabled", profiler.enabled(), allocator);
+  response.AddMember("frameCount", static_cast<uint64_t>(report.frame_count),
+                     allocator);
+  response.AddMember("paintMs", report.paint_time.ToMillisecondsF(),
+                     allocator);
+  response.AddMember("averageOverdraw", report.average_overdraw, allocator);
+  response.AddMember("maxOverdraw", report.max_overdraw, allocator);
+
+  rapidjson::Value layers(rapidjson::kArrayType);
+  for (const auto& stats : report.layers) {
+    rapidjson::Value layer(rapidjson::kObjectType);
+    layer.AddMember("id", stats.layer_id, allocator);
+    layer.AddMember("type", rapidjson::StringRef(stats.type_name), allocator);
+    if (stats.picture_id != 0) {
+      layer.AddMember("pictureId", stats.picture_id, allocator);
+      layer.AddMember("pictureOpCount",
+                      static_cast<uint64_t>(stats.picture_op_count),
+                      allocator);
+    }
+    layer.AddMember("paintCount", static_cast<uint64_t>(stats.paint_count),
+                    allocator);
+    layer.AddMember("selfMs", stats.self_time.ToMillisecondsF(), allocator);
+    layer.AddMember("maxSelfMs", stats.max_self_time.ToMillisecondsF(),
+                    allocator);
+    layer.AddMember("totalMs", stats.total_time.ToMillisecondsF(), allocator);
+    layer.AddMember("pixelCount", stats.pixel_count, allocator);
+    layers.PushBack(layer, allocator);
+  }
+  response.AddMember("layers", layers, allocator);
+  return true;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -1451,6 +1826,18 @@ bool Shell::ReloadSystemFonts() {
   return true;
 }
 
+const Shell::StartupTimings& Shell::GetStartupTimings() const {
+  return startup_timings_;
+}
+
+FrameStatistics::Summary Shell::GetFrameStatistics() const {
+  return frame_statistics_.GetSummary();
+}
+
+void Shell::ResetFrameStatistics() {
+  frame_statistics_.Reset();
+}
+
 std::shared_ptr<fml::SyncSwitch> Shell::GetIsGpuDisabledSyncSwitch() const {
   return is_gpu_disabled_sync_switch_;
 }
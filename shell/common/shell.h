@@ -6,6 +6,7 @@
 #define SHELL_COMMON_SHELL_H_
 
 #include <functional>
+#include <optional>
 #include <string_view>
 #include <unordered_map>
 
@@ -28,6 +29,7 @@
 #include "flutter/runtime/service_protocol.h"
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/frame_statistics.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/shell_io_manager.h"
@@ -208,6 +210,45 @@ class Shell final : public PlatformView::Delegate,
       const CreateCallback<Rasterizer>& on_create_rasterizer,
       DartVMRef vm);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a new shell that shares the expensive to create
+  ///             resources of this shell and launches the given run
+  ///             configuration in it. The new shell runs on the same task
+  ///             runners as this shell and reuses its VM, isolate snapshot, IO
+  ///             manager (along with its resource context), font collection and
+  ///             asset manager. Only the platform view, rasterizer, engine and
+  ///             root isolate are created anew. This is much cheaper than
+  ///             creating a shell from scratch and is intended for embedders
+  ///             that host many Flutter surfaces in the same process.
+  ///
+  ///             The parent and spawned shells may be collected in any order.
+  ///             The shared resource context is released along with the last
+  ///             shell using it, via the platform view that created it or, if
+  ///             that platform view is gone, the closure returned by its
+  ///             |PlatformView::GetResourceContextReleaser|.
+  ///
+  /// @param[in]  run_configuration        The configuration to launch in the
+  ///                                      new shell. To avoid loading and
+  ///                                      registering assets and fonts again,
+  ///                                      use the asset manager this shell was
+  ///                                      launched with.
+  /// @param[in]  on_create_platform_view  The callback that must return a
+  ///                                      platform view. This will be called on
+  ///                                      the platform task runner before this
+  ///                                      method returns.
+  /// @param[in]  on_create_rasterizer     That callback that must provide a
+  ///                                      valid rasterizer. This will be called
+  ///                                      on the render task runner before this
+  ///                                      method returns.
+  ///
+  /// @return     The spawned shell or null if its subcomponents could not be
+  ///             created. Must be called on the platform task runner.
+  ///
+  std::unique_ptr<Shell> Spawn(
+      RunConfiguration run_configuration,
+      const CreateCallback<PlatformView>& on_create_platform_view,
+      const CreateCallback<Rasterizer>& on_create_rasterizer) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Destroys the shell. This is a synchronous operation and
   ///             synchronous barrier blocks are introduced on the various
@@ -352,6 +393,56 @@ class Shell final : public PlatformView::Delegate,
   /// @brief     Accessor for the disable GPU SyncSwitch
   std::shared_ptr<fml::SyncSwitch> GetIsGpuDisabledSyncSwitch() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The time spent in each phase of creating the shell. Phases on
+  ///             different threads overlap so they don't add up to the total.
+  ///             The same phases are also emitted as trace events in the
+  ///             "flutter" category.
+  ///
+  struct StartupTimings {
+    /// Launching the Dart VM and mapping its snapshots, or referencing the VM
+    /// if it is already running. Zero if the VM was provided by the embedder.
+    fml::TimeDelta vm;
+    /// The embedder's platform view callback, on the platform thread.
+    fml::TimeDelta platform_view;
+    /// The embedder's rasterizer callback, on the GPU thread.
+    fml::TimeDelta rasterizer;
+    /// Creating the IO manager, on the IO thread.
+    fml::TimeDelta io_manager;
+    /// Creating the resource context for the IO manager, on the IO thread.
+    fml::TimeDelta resource_context;
+    /// Setting up the font collection and the default font manager, on a
+    /// concurrent worker.
+    fml::TimeDelta font_collection;
+    /// Creating the engine and its root isolate, on the UI thread.
+    fml::TimeDelta engine;
+    /// The time from the start of shell creation (after the VM is running)
+    /// till the shell is setup.
+    fml::TimeDelta total;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @return     The time spent in each phase of creating this shell.
+  ///
+  const StartupTimings& GetStartupTimings() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders and tools to find out how smoothly frames
+  ///             are being rendered and why frames were missed. This may be
+  ///             called on any thread.
+  ///
+  /// @return     The distribution of the durations of the phases of all the
+  ///             frames rasterized since the shell was created or the
+  ///             statistics were last reset.
+  ///
+  FrameStatistics::Summary GetFrameStatistics() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Discards the frame statistics collected so far. This may be
+  ///             called on any thread.
+  ///
+  void ResetFrameStatistics();
+
  private:
   using ServiceProtocolHandler =
       std::function<bool(const ServiceProtocol::Handler::ServiceProtocolMap&,
@@ -363,8 +454,10 @@ class Shell final : public PlatformView::Delegate,
   std::unique_ptr<PlatformView> platform_view_;  // on platform task runner
   std::unique_ptr<Engine> engine_;               // on UI task runner
   std::unique_ptr<Rasterizer> rasterizer_;       // on GPU task runner
-  std::unique_ptr<ShellIOManager> io_manager_;   // on IO task runner
+  std::shared_ptr<ShellIOManager> io_manager_;   // on IO task runner
   std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
+  StartupTimings startup_timings_;
+  FrameStatistics frame_statistics_;
 
   fml::WeakPtr<Engine> weak_engine_;          // to be shared across threads
   fml::WeakPtr<Rasterizer> weak_rasterizer_;  // to be shared across threads
@@ -405,9 +498,17 @@ class Shell final : public PlatformView::Delegate,
   // and read from the GPU thread.
   std::atomic<float> display_refresh_rate_ = 0.0f;
 
+  // When the last trace recording was written because of a janky frame. Only
+  // accessed on the GPU thread.
+  std::optional<fml::TimePoint> last_trace_recording_dump_;
+
   // How many frames have been timed since last report.
   size_t UnreportedFramesCount() const;
 
+  // Writes the trace recorder's recording to the dump path if the frame took
+  // more than twice the frame budget.
+  void MaybeDumpTraceRecording(const FrameTiming& timing);
+
   Shell(DartVMRef vm, TaskRunners task_runners, Settings settings);
 
   static std::unique_ptr<Shell> CreateShellOnPlatformThread(
@@ -417,12 +518,13 @@ class Shell final : public PlatformView::Delegate,
       Settings settings,
       fml::RefPtr<const DartSnapshot> isolate_snapshot,
       const Shell::CreateCallback<PlatformView>& on_create_platform_view,
-      const Shell::CreateCallback<Rasterizer>& on_create_rasterizer);
+      const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
+      const Shell* parent_shell);
 
   bool Setup(std::unique_ptr<PlatformView> platform_view,
              std::unique_ptr<Engine> engine,
              std::unique_ptr<Rasterizer> rasterizer,
-             std::unique_ptr<ShellIOManager> io_manager);
+             std::shared_ptr<ShellIOManager> io_manager);
 
   DartVM* GetDartVM();
 
@@ -508,6 +610,9 @@ class Shell final : public PlatformView::Delegate,
   // |Rasterizer::Delegate|
   void OnFrameRasterized(const FrameTiming&) override;
 
+  // |Rasterizer::Delegate|
+  void OnFramePhaseDurations(const FramePhaseDurations& durations) override;
+
   // |Rasterizer::Delegate|
   fml::Milliseconds GetFrameBudget() override;
 
@@ -555,6 +660,21 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document& response);
 
+  // Service protocol handler
+  bool OnServiceProtocolGetFrameStatistics(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document& response);
+
+  // Service protocol handler
+  bool OnServiceProtocolGetTraceRecording(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document& response);
+
+  // Service protocol handler
+  bool OnServiceProtocolGetLayerProfile(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document& response);
+
   fml::WeakPtrFactory<Shell> weak_factory_;
 
   // For accessing the Shell via the GPU thread, necessary for various
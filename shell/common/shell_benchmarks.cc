@@ -2,15 +2,76 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <optional>
+
+#include "flutter/assets/asset_manager.h"
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/fml/logging.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/isolate_configuration.h"
+#include "flutter/shell/common/run_configuration.h"
 #include "flutter/shell/common/shell.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/testing.h"
 
 namespace flutter {
 
+static Settings CreateSettingsForBenchmark(const fml::UniqueFD& assets_dir) {
+  Settings settings = {};
+  settings.task_observer_add = [](intptr_t, fml::closure) {};
+  settings.task_observer_remove = [](intptr_t) {};
+
+  if (DartVM::IsRunningPrecompiledCode()) {
+    settings.vm_snapshot_data = [&assets_dir]() {
+      return fml::FileMapping::CreateReadOnly(assets_dir, "vm_snapshot_data");
+    };
+
+    settings.isolate_snapshot_data = [&assets_dir]() {
+      return fml::FileMapping::CreateReadOnly(assets_dir,
+                                              "isolate_snapshot_data");
+    };
+
+    settings.vm_snapshot_instr = [&assets_dir]() {
+      return fml::FileMapping::CreateReadExecute(assets_dir,
+                                                 "vm_snapshot_instr");
+    };
+
+    settings.isolate_snapshot_instr = [&assets_dir]() {
+      return fml::FileMapping::CreateReadExecute(assets_dir,
+                                                 "isolate_snapshot_instr");
+    };
+
+  } else {
+    settings.application_kernels = [&assets_dir]() {
+      std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
+      kernel_mappings.emplace_back(
+          fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
+      return kernel_mappings;
+    };
+  }
+  return settings;
+}
+
+static std::unique_ptr<PlatformView> CreatePlatformView(Shell& shell) {
+  return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
+}
+
+static std::unique_ptr<Rasterizer> CreateRasterizer(Shell& shell) {
+  return std::make_unique<Rasterizer>(shell, shell.GetTaskRunners());
+}
+
+static void DestroyShell(std::unique_ptr<Shell> shell,
+                         fml::RefPtr<fml::TaskRunner> platform_task_runner) {
+  // Shutdown must occur synchronously on the platform thread.
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(platform_task_runner,
+                                    [&shell, &latch]() mutable {
+                                      shell.reset();
+                                      latch.Signal();
+                                    });
+  latch.Wait();
+}
+
 static void StartupAndShutdownShell(benchmark::State& state,
                                     bool measure_startup,
                                     bool measure_shutdown) {
@@ -20,38 +81,7 @@ static void StartupAndShutdownShell(benchmark::State& state,
   std::unique_ptr<ThreadHost> thread_host;
   {
     benchmarking::ScopedPauseTiming pause(state, !measure_startup);
-    Settings settings = {};
-    settings.task_observer_add = [](intptr_t, fml::closure) {};
-    settings.task_observer_remove = [](intptr_t) {};
-
-    if (DartVM::IsRunningPrecompiledCode()) {
-      settings.vm_snapshot_data = [&]() {
-        return fml::FileMapping::CreateReadOnly(assets_dir, "vm_snapshot_data");
-      };
-
-      settings.isolate_snapshot_data = [&]() {
-        return fml::FileMapping::CreateReadOnly(assets_dir,
-                                                "isolate_snapshot_data");
-      };
-
-      settings.vm_snapshot_instr = [&]() {
-        return fml::FileMapping::CreateReadExecute(assets_dir,
-                                                   "vm_snapshot_instr");
-      };
-
-      settings.isolate_snapshot_instr = [&]() {
-        return fml::FileMapping::CreateReadExecute(assets_dir,
-                                                   "isolate_snapshot_instr");
-      };
-
-    } else {
-      settings.application_kernels = [&]() {
-        std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
-        kernel_mappings.emplace_back(
-            fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
-        return kernel_mappings;
-      };
-    }
+    Settings settings = CreateSettingsForBenchmark(assets_dir);
 
     thread_host = std::make_unique<ThreadHost>(
         "io.flutter.bench.", ThreadHost::Type::Platform |
@@ -64,14 +94,8 @@ static void StartupAndShutdownShell(benchmark::State& state,
                              thread_host->ui_thread->GetTaskRunner(),
                              thread_host->io_thread->GetTaskRunner());
 
-    shell = Shell::Create(
-        std::move(task_runners), settings,
-        [](Shell& shell) {
-          return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
-        },
-        [](Shell& shell) {
-          return std::make_unique<Rasterizer>(shell, shell.GetTaskRunners());
-        });
+    shell = Shell::Create(std::move(task_runners), settings,
+                          CreatePlatformView, CreateRasterizer);
   }
 
   FML_CHECK(shell);
@@ -117,4 +141,124 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+// Measures shell creation like |BM_ShellInitialization| and reports the
+// average time spent in each phase of the startup as counters (in
+// milliseconds).
+static void BM_ShellStartupPhases(benchmark::State& state) {
+  auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
+                                       fml::FilePermission::kRead);
+  Settings settings = CreateSettingsForBenchmark(assets_dir);
+
+  Shell::StartupTimings totals;
+  while (state.KeepRunning()) {
+    std::unique_ptr<ThreadHost> thread_host;
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      thread_host = std::make_unique<ThreadHost>(
+          "io.flutter.bench.",
+          ThreadHost::Type::Platform | ThreadHost::Type::GPU |
+              ThreadHost::Type::IO | ThreadHost::Type::UI);
+    }
+
+    TaskRunners task_runners("test",
+                             thread_host->platform_thread->GetTaskRunner(),
+                             thread_host->gpu_thread->GetTaskRunner(),
+                             thread_host->ui_thread->GetTaskRunner(),
+                             thread_host->io_thread->GetTaskRunner());
+    auto shell = Shell::Create(std::move(task_runners), settings,
+                               CreatePlatformView, CreateRasterizer);
+    FML_CHECK(shell);
+
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      const auto& timings = shell->GetStartupTimings();
+      totals.vm = totals.vm + timings.vm;
+      totals.platform_view = totals.platform_view + timings.platform_view;
+      totals.rasterizer = totals.rasterizer + timings.rasterizer;
+      totals.io_manager = totals.io_manager + timings.io_manager;
+      totals.resource_context =
+          totals.resource_context + timings.resource_context;
+      totals.font_collection = totals.font_collection + timings.font_collection;
+      totals.engine = totals.engine + timings.engine;
+      totals.total = totals.total + timings.total;
+
+      DestroyShell(std::move(shell),
+                   thread_host->platform_thread->GetTaskRunner());
+      thread_host.reset();
+    }
+  }
+
+  auto report = [&state](const char* name, fml::TimeDelta duration) {
+    state.counters[name] = benchmark::Counter(
+        duration.ToMillisecondsF(), benchmark::Counter::kAvgIterations);
+  };
+  report("VM", totals.vm);
+  report("PlatformView", totals.platform_view);
+  report("Rasterizer", totals.rasterizer);
+  report("IOManager", totals.io_manager);
+  report("ResourceContext", totals.resource_context);
+  report("FontCollection", totals.font_collection);
+  report("Engine", totals.engine);
+  report("Total", totals.total);
+}
+
+BENCHMARK(BM_ShellStartupPhases);
+
+// Measures creating a shell from an existing one. Compare with
+// |BM_ShellInitialization|, which creates every shell from scratch.
+static void BM_ShellSpawn(benchmark::State& state) {
+  auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
+                                       fml::FilePermission::kRead);
+  Settings settings = CreateSettingsForBenchmark(assets_dir);
+
+  ThreadHost thread_host("io.flutter.bench.",
+                         ThreadHost::Type::Platform | ThreadHost::Type::GPU |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  auto platform_task_runner = thread_host.platform_thread->GetTaskRunner();
+  TaskRunners task_runners("test", platform_task_runner,
+                           thread_host.gpu_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+
+  auto shell = Shell::Create(std::move(task_runners), settings,
+                             CreatePlatformView, CreateRasterizer);
+  FML_CHECK(shell);
+
+  // All spawned shells share the asset manager just like they would share the
+  // one the parent was launched with.
+  auto asset_manager = std::make_shared<AssetManager>();
+
+  while (state.KeepRunning()) {
+    std::unique_ptr<Shell> spawned_shell;
+    {
+      std::optional<RunConfiguration> configuration;
+      {
+        benchmarking::ScopedPauseTiming pause(state);
+        configuration.emplace(
+            IsolateConfiguration::InferFromSettings(settings, asset_manager),
+            asset_manager);
+      }
+
+      fml::AutoResetWaitableEvent latch;
+      fml::TaskRunner::RunNowOrPostTask(platform_task_runner, [&]() {
+        spawned_shell = shell->Spawn(std::move(configuration.value()),
+                                     CreatePlatformView, CreateRasterizer);
+        latch.Signal();
+      });
+      latch.Wait();
+    }
+
+    FML_CHECK(spawned_shell);
+
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      DestroyShell(std::move(spawned_shell), platform_task_runner);
+    }
+  }
+
+  DestroyShell(std::move(shell), platform_task_runner);
+}
+
+BENCHMARK(BM_ShellSpawn);
+
 }  // namespace flutter
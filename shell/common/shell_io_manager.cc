@@ -7,6 +7,7 @@
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/shell/common/persistent_cache.h"
+#include "flutter/shell/common/platform_view.h"
 #include "third_party/skia/include/gpu/gl/GrGLInterface.h"
 
 namespace flutter {
@@ -65,21 +66,29 @@ ShellIOManager::ShellIOManager(
           fml::TimeDelta::FromMilliseconds(8),
           GetResourceContext())),
       weak_factory_(this),
-      is_gpu_disabled_sync_switch_(is_gpu_disabled_sync_switch) {
-  if (!resource_context_) {
-#ifndef OS_FUCHSIA
-    FML_DLOG(WARNING) << "The IO manager was initialized without a resource "
-                         "context. Async texture uploads will be disabled. "
-                         "Expect performance degradation.";
-#endif  // OS_FUCHSIA
-  }
-}
+      is_gpu_disabled_sync_switch_(is_gpu_disabled_sync_switch) {}
 
 ShellIOManager::~ShellIOManager() {
   // Last chance to drain the IO queue as the platform side reference to the
   // underlying OpenGL context may be going away.
   is_gpu_disabled_sync_switch_->Execute(
       fml::SyncSwitch::Handlers().SetIfFalse([&] { unref_queue_->Drain(); }));
+  ReleaseResourceContext();
+}
+
+void ShellIOManager::ReleaseResourceContext() {
+  // The platform may only collect its counterparts of the resource context
+  // once the context itself is gone.
+  resource_context_weak_factory_.reset();
+  resource_context_.reset();
+  if (resource_context_creator_) {
+    resource_context_creator_->ReleaseResourceContext();
+    resource_context_creator_ = nullptr;
+  }
+  if (resource_context_releaser_) {
+    resource_context_releaser_();
+    resource_context_releaser_ = nullptr;
+  }
 }
 
 void ShellIOManager::NotifyResourceContextAvailable(
@@ -98,6 +107,31 @@ void ShellIOManager::UpdateResourceContext(sk_sp<GrContext> resource_context) {
       resource_context_ ? std::make_unique<fml::WeakPtrFactory<GrContext>>(
                               resource_context_.get())
                         : nullptr;
+  unref_queue_->UpdateResourceContext(GetResourceContext());
+}
+
+void ShellIOManager::CreateResourceContext(const PlatformView& platform_view) {
+  if (resource_context_) {
+    return;
+  }
+  UpdateResourceContext(platform_view.CreateResourceContext());
+  if (resource_context_) {
+    resource_context_creator_ = &platform_view;
+  }
+}
+
+bool ShellIOManager::IsResourceContextCreator(
+    const PlatformView* platform_view) const {
+  return platform_view != nullptr && platform_view == resource_context_creator_;
+}
+
+void ShellIOManager::DetachResourceContextCreator(
+    const PlatformView& platform_view) {
+  if (!IsResourceContextCreator(&platform_view)) {
+    return;
+  }
+  resource_context_releaser_ = platform_view.GetResourceContextReleaser();
+  resource_context_creator_ = nullptr;
 }
 
 fml::WeakPtr<ShellIOManager> ShellIOManager::GetWeakPtr() {
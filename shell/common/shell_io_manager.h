@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/lib/ui/io_manager.h"
@@ -15,6 +16,8 @@
 
 namespace flutter {
 
+class PlatformView;
+
 class ShellIOManager final : public IOManager {
  public:
   // Convenience methods for platforms to create a GrContext used to supply to
@@ -41,6 +44,37 @@ class ShellIOManager final : public IOManager {
   // resource context, but may be called if the Dart VM is restarted.
   void UpdateResourceContext(sk_sp<GrContext> resource_context);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the platform view to create the resource context unless
+  ///             the IO manager already has one. If the context is created,
+  ///             the IO manager owns it and releases it via the platform view
+  ///             once the IO manager is collected. The IO manager may be shared
+  ///             by the shells spawned from the shell that created it, and so
+  ///             may outlive the platform view. The shell owning the platform
+  ///             view must then call |DetachResourceContextCreator| before the
+  ///             platform view is collected.
+  ///
+  /// @param[in]  platform_view  The platform view to create the context with.
+  ///
+  void CreateResourceContext(const PlatformView& platform_view);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the resource context was created by |platform_view|.
+  ///
+  bool IsResourceContextCreator(const PlatformView* platform_view) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stops referencing the platform view that created the resource
+  ///             context, and releases the context via the closure returned
+  ///             by its |PlatformView::GetResourceContextReleaser| instead.
+  ///             Used when the shell owning the platform view is collected
+  ///             while other shells still use this IO manager. Does nothing
+  ///             if the platform view didn't create the resource context.
+  ///
+  /// @param[in]  platform_view  The platform view about to be collected.
+  ///
+  void DetachResourceContextCreator(const PlatformView& platform_view);
+
   fml::WeakPtr<ShellIOManager> GetWeakPtr();
 
   // |IOManager|
@@ -60,6 +94,10 @@ class ShellIOManager final : public IOManager {
   sk_sp<GrContext> resource_context_;
   std::unique_ptr<fml::WeakPtrFactory<GrContext>>
       resource_context_weak_factory_;
+  // The platform view that created |resource_context_|, if any, while the
+  // shell owning it is alive. Then the closure releasing the context.
+  const PlatformView* resource_context_creator_ = nullptr;
+  fml::closure resource_context_releaser_;
 
   // Unref queue management.
   fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue_;
@@ -68,6 +106,8 @@ class ShellIOManager final : public IOManager {
 
   std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
 
+  void ReleaseResourceContext();
+
   FML_DISALLOW_COPY_AND_ASSIGN(ShellIOManager);
 };
 
@@ -224,6 +224,10 @@ std::shared_ptr<txt::FontCollection> ShellTest::GetFontCollection(
   return shell->weak_engine_->GetFontCollection().GetFontCollection();
 }
 
+fml::WeakPtr<GrContext> ShellTest::GetResourceContext(Shell* shell) {
+  return shell->io_manager_->GetResourceContext();
+}
+
 Settings ShellTest::CreateSettingsForFixture() {
   Settings settings;
   settings.leak_vm = false;
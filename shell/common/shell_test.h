@@ -74,6 +74,9 @@ class ShellTest : public ThreadTest {
 
   std::shared_ptr<txt::FontCollection> GetFontCollection(Shell* shell);
 
+  // Must be called on the IO task runner.
+  static fml::WeakPtr<GrContext> GetResourceContext(Shell* shell);
+
   // Do not assert |UnreportedTimingsCount| to be positive in any tests.
   // Otherwise those tests will be flaky as the clearing of unreported timings
   // is unpredictive.
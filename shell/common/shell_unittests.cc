@@ -5,10 +5,12 @@
 #define FML_USED_ON_EMBEDDER
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <future>
 #include <memory>
 
+#include "flutter/flow/display_list.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/layers/picture_layer.h"
 #include "flutter/flow/layers/transform_layer.h"
@@ -19,6 +21,7 @@
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/isolate_configuration.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/shell_test.h"
@@ -26,6 +29,7 @@
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/shell/common/vsync_waiter_fallback.h"
 #include "flutter/testing/testing.h"
+#include "third_party/skia/include/gpu/GrContext.h"
 #include "third_party/tonic/converter/dart_converter.h"
 
 namespace flutter {
@@ -238,6 +242,196 @@ TEST_F(ShellTest, LastEntrypoint) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, SpawnedShellSharesFontCollectionAndAssets) {
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  auto settings = CreateSettingsForFixture();
+  auto shell = CreateShell(settings);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  ASSERT_TRUE(configuration.IsValid());
+  configuration.SetEntrypoint("fixturesAreFunctionalMain");
+  auto asset_manager = configuration.GetAssetManager();
+
+  fml::CountDownLatch main_latch(2);
+  AddNativeCallback("SayHiFromFixturesAreFunctionalMain",
+                    CREATE_NATIVE_ENTRY(
+                        [&main_latch](auto args) { main_latch.CountDown(); }));
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  auto task_runners = GetTaskRunnersForFixture();
+  std::unique_ptr<Shell> spawned_shell;
+  fml::AutoResetWaitableEvent spawn_latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners.GetPlatformTaskRunner(), [&]() {
+        auto spawn_configuration = RunConfiguration(
+            IsolateConfiguration::InferFromSettings(settings, asset_manager),
+            asset_manager);
+        spawn_configuration.SetEntrypoint("fixturesAreFunctionalMain");
+        const auto vsync_clock = std::make_shared<ShellTestVsyncClock>();
+        spawned_shell = shell->Spawn(
+            std::move(spawn_configuration),
+            [vsync_clock](Shell& shell) {
+              return std::make_unique<ShellTestPlatformView>(
+                  shell, shell.GetTaskRunners(), vsync_clock,
+                  [task_runners = shell.GetTaskRunners()]() {
+                    return static_cast<std::unique_ptr<VsyncWaiter>>(
+                        std::make_unique<VsyncWaiterFallback>(task_runners));
+                  });
+            },
+            [](Shell& shell) {
+              return std::make_unique<Rasterizer>(shell,
+                                                  shell.GetTaskRunners());
+            });
+        spawn_latch.Signal();
+      });
+  spawn_latch.Wait();
+  ASSERT_TRUE(ValidateShell(spawned_shell.get()));
+
+  // Both root isolates run their entrypoint.
+  main_latch.Wait();
+
+  fml::AutoResetWaitableEvent ui_latch;
+  fml::TaskRunner::RunNowOrPostTask(task_runners.GetUITaskRunner(), [&]() {
+    EXPECT_EQ(GetFontCollection(shell.get()),
+              GetFontCollection(spawned_shell.get()));
+    ui_latch.Signal();
+  });
+  ui_latch.Wait();
+
+  DestroyShell(std::move(shell));
+  ASSERT_TRUE(DartVMRef::IsInstanceRunning());
+  DestroyShell(std::move(spawned_shell));
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+}
+
+namespace {
+
+struct ResourceContextEvents {
+  std::atomic<size_t> create_count = 0;
+  std::atomic<size_t> release_count = 0;
+  std::atomic<size_t> collect_count = 0;
+};
+
+// A platform view that creates a mock resource context and records what is
+// done with it.
+class ResourceContextPlatformView : public ShellTestPlatformView {
+ public:
+  ResourceContextPlatformView(Shell& shell,
+                              std::shared_ptr<ResourceContextEvents> events)
+      : ShellTestPlatformView(
+            shell,
+            shell.GetTaskRunners(),
+            std::make_shared<ShellTestVsyncClock>(),
+            [task_runners = shell.GetTaskRunners()]() {
+              return static_cast<std::unique_ptr<VsyncWaiter>>(
+                  std::make_unique<VsyncWaiterFallback>(task_runners));
+            }),
+        events_(std::move(events)) {}
+
+  ~ResourceContextPlatformView() override { events_->collect_count++; }
+
+  // |PlatformView|
+  sk_sp<GrContext> CreateResourceContext() const override {
+    events_->create_count++;
+    return GrContext::MakeMock(nullptr);
+  }
+
+  // |PlatformView|
+  void ReleaseResourceContext() const override { events_->release_count++; }
+
+  // |PlatformView|
+  fml::closure GetResourceContextReleaser() const override {
+    return [events = events_]() { events->release_count++; };
+  }
+
+ private:
+  std::shared_ptr<ResourceContextEvents> events_;
+};
+
+}  // namespace
+
+TEST_F(ShellTest, SpawnedShellOutlivesTheResourceContextOfItsParent) {
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  auto settings = CreateSettingsForFixture();
+  auto task_runners = GetTaskRunnersForFixture();
+  auto parent_events = std::make_shared<ResourceContextEvents>();
+  auto spawned_events = std::make_shared<ResourceContextEvents>();
+
+  auto shell = Shell::Create(
+      task_runners, settings,
+      [parent_events](Shell& shell) {
+        return std::make_unique<ResourceContextPlatformView>(shell,
+                                                             parent_events);
+      },
+      [](Shell& shell) {
+        return std::make_unique<Rasterizer>(shell, shell.GetTaskRunners());
+      });
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  ASSERT_EQ(parent_events->create_count, 1u);
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  ASSERT_TRUE(configuration.IsValid());
+  configuration.SetEntrypoint("emptyMain");
+  auto asset_manager = configuration.GetAssetManager();
+  RunEngine(shell.get(), std::move(configuration));
+
+  std::unique_ptr<Shell> spawned_shell;
+  fml::AutoResetWaitableEvent spawn_latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners.GetPlatformTaskRunner(), [&]() {
+        auto spawn_configuration = RunConfiguration(
+            IsolateConfiguration::InferFromSettings(settings, asset_manager),
+            asset_manager);
+        spawn_configuration.SetEntrypoint("emptyMain");
+        spawned_shell = shell->Spawn(
+            std::move(spawn_configuration),
+            [spawned_events](Shell& shell) {
+              return std::make_unique<ResourceContextPlatformView>(
+                  shell, spawned_events);
+            },
+            [](Shell& shell) {
+              return std::make_unique<Rasterizer>(shell,
+                                                  shell.GetTaskRunners());
+            });
+        spawn_latch.Signal();
+      });
+  spawn_latch.Wait();
+  ASSERT_TRUE(ValidateShell(spawned_shell.get()));
+
+  // The parent goes first. Its platform view created the resource context the
+  // spawned shell still uses, so nothing may be released yet. The platform
+  // view still goes along with the parent, whose delegate it references.
+  DestroyShell(std::move(shell));
+  ASSERT_EQ(parent_events->release_count, 0u);
+  ASSERT_EQ(parent_events->collect_count, 1u);
+
+  // The spawned shell keeps working, including with the resource context.
+  ASSERT_TRUE(ValidateShell(spawned_shell.get()));
+  PumpOneFrame(spawned_shell.get());
+  fml::AutoResetWaitableEvent io_latch;
+  fml::TaskRunner::RunNowOrPostTask(task_runners.GetIOTaskRunner(), [&]() {
+    auto resource_context = GetResourceContext(spawned_shell.get());
+    EXPECT_TRUE(resource_context);
+    if (resource_context) {
+      resource_context->flush();
+    }
+    io_latch.Signal();
+  });
+  io_latch.Wait();
+
+  // The context is released the way the platform view of the parent, which
+  // created it, releases it once the last shell using it is gone.
+  DestroyShell(std::move(spawned_shell));
+  ASSERT_EQ(parent_events->release_count, 1u);
+  ASSERT_EQ(spawned_events->create_count, 0u);
+  ASSERT_EQ(spawned_events->release_count, 0u);
+  ASSERT_EQ(spawned_events->collect_count, 1u);
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+  ASSERT_EQ(parent_events.use_count(), 1);
+}
+
 TEST(ShellTestNoFixture, EnableMirrorsIsWhitelisted) {
   if (DartVM::IsRunningPrecompiledCode()) {
     // This covers profile and release modes which use AOT (where this flag does
@@ -1006,17 +1200,16 @@ TEST_F(ShellTest, Screenshot) {
   RunEngine(shell.get(), std::move(configuration));
 
   LayerTreeBuilder builder = [&](std::shared_ptr<ContainerLayer> root) {
-    SkPictureRecorder recorder;
-    SkCanvas* recording_canvas =
-        recorder.beginRecording(SkRect::MakeXYWH(0, 0, 80, 80));
-    recording_canvas->drawRect(SkRect::MakeXYWH(0, 0, 80, 80),
-                               SkPaint(SkColor4f::FromColor(SK_ColorRED)));
-    auto sk_picture = recorder.finishRecordingAsPicture();
+    DisplayListRecorder recorder(SkRect::MakeXYWH(0, 0, 80, 80));
+    recorder.drawRect(SkRect::MakeXYWH(0, 0, 80, 80),
+                      SkPaint(SkColor4f::FromColor(SK_ColorRED)));
+    auto display_list = recorder.Build();
     fml::RefPtr<SkiaUnrefQueue> queue = fml::MakeRefCounted<SkiaUnrefQueue>(
         this->GetCurrentTaskRunner(), fml::TimeDelta::FromSeconds(0));
     auto picture_layer = std::make_shared<PictureLayer>(
         SkPoint::Make(10, 10),
-        flutter::SkiaGPUObject<SkPicture>({sk_picture, queue}), false, false);
+        flutter::SkiaGPUObject<DisplayList>({display_list, queue}), false,
+        false);
     root->Add(picture_layer);
   };
 
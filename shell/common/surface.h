@@ -25,6 +25,15 @@ class SurfaceFrame {
                bool supports_readback,
                const SubmitCallback& submit_callback);
 
+  // Like the constructor above, but the frame is drawn into |canvas| instead
+  // of the canvas of |surface|. The submit callback is responsible for getting
+  // the contents of the canvas into the surface. The canvas must outlive the
+  // frame.
+  SurfaceFrame(sk_sp<SkSurface> surface,
+               SkCanvas* canvas,
+               bool supports_readback,
+               const SubmitCallback& submit_callback);
+
   ~SurfaceFrame();
 
   bool Submit();
@@ -38,6 +47,7 @@ class SurfaceFrame {
  private:
   bool submitted_;
   sk_sp<SkSurface> surface_;
+  SkCanvas* canvas_ = nullptr;
   bool supports_readback_;
   SubmitCallback submit_callback_;
 
@@ -269,6 +269,12 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.trace_systrace =
       command_line.HasOption(FlagForSwitch(Switch::TraceSystrace));
 
+  settings.enable_trace_recorder =
+      command_line.HasOption(FlagForSwitch(Switch::EnableTraceRecorder));
+
+  command_line.GetOptionValue(FlagForSwitch(Switch::TraceRecorderDumpPath),
+                              &settings.trace_recorder_dump_path);
+
   settings.skia_deterministic_rendering_on_cpu =
       command_line.HasOption(FlagForSwitch(Switch::SkiaDeterministicRendering));
 
@@ -278,6 +284,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   command_line.GetOptionValue(FlagForSwitch(Switch::FlutterAssetsDir),
                               &settings.assets_path);
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::AssetPrefetchManifestPath),
+                              &settings.asset_prefetch_manifest_path);
+
   std::vector<std::string_view> aot_shared_library_name =
       command_line.GetOptionValues(FlagForSwitch(Switch::AotSharedLibraryName));
 
@@ -368,6 +377,36 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.cache_sksl =
       command_line.HasOption(FlagForSwitch(Switch::CacheSkSL));
 
+  settings.enable_yuv_image_decoding =
+      command_line.HasOption(FlagForSwitch(Switch::EnableYUVImageDecoding));
+
+  std::string frame_scheduling_policy;
+  if (command_line.GetOptionValue(FlagForSwitch(Switch::FrameSchedulingPolicy),
+                                  &frame_scheduling_policy)) {
+    if (frame_scheduling_policy == "low-latency") {
+      settings.frame_scheduling_policy = FrameSchedulingPolicy::kLowLatency;
+    } else if (frame_scheduling_policy == "high-throughput") {
+      settings.frame_scheduling_policy = FrameSchedulingPolicy::kHighThroughput;
+    } else if (frame_scheduling_policy != "default") {
+      FML_LOG(ERROR) << "Unknown frame scheduling policy: "
+                     << frame_scheduling_policy;
+    }
+  }
+
+  settings.resample_pointer_events_to_vsync = command_line.HasOption(
+      FlagForSwitch(Switch::ResamplePointerEventsToVsync));
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::SoftwareRasterThreadCount))) {
+    if (!GetSwitchValue(command_line, Switch::SoftwareRasterThreadCount,
+                        &settings.software_raster_thread_count) ||
+        settings.software_raster_thread_count == 0) {
+      FML_LOG(ERROR) << "Invalid software raster thread count. Rasterizing "
+                        "on a single thread.";
+      settings.software_raster_thread_count = 1;
+    }
+  }
+
   return settings;
 }
 
@@ -106,6 +106,12 @@ DEF_SWITCH(SkiaDeterministicRendering,
 DEF_SWITCH(FlutterAssetsDir,
            "flutter-assets-dir",
            "Path to the Flutter assets directory.")
+DEF_SWITCH(AssetPrefetchManifestPath,
+           "asset-prefetch-manifest-path",
+           "Path to a file in which the engine records the assets used before "
+           "the first frame. On subsequent launches, these assets are "
+           "prefetched on a worker thread so that they don't cause disk "
+           "stalls on the UI thread.")
 DEF_SWITCH(Help, "help", "Display this help text.")
 DEF_SWITCH(LogTag, "log-tag", "Tag associated with log messages.")
 DEF_SWITCH(DisableServiceAuthCodes,
@@ -136,12 +142,46 @@ DEF_SWITCH(CacheSkSL,
            "should only be used during development phases. The generated SkSLs "
            "can later be used in the release build for shader precompilation "
            "at launch in order to eliminate the shader-compile jank.")
+DEF_SWITCH(EnableYUVImageDecoding,
+           "enable-yuv-image-decoding",
+           "Decode JPEG images into YUV planes and perform the conversion to "
+           "RGB on the GPU at draw time. This reduces the CPU time spent "
+           "decoding and the number of bytes uploaded for photographic "
+           "images. Has no effect when rendering in software.")
+DEF_SWITCH(FrameSchedulingPolicy,
+           "frame-scheduling-policy",
+           "How frames are scheduled. \"low-latency\" keeps a single frame in "
+           "flight and starts each frame as late as the measured build and "
+           "raster times allow. \"high-throughput\" lets the UI thread run "
+           "further ahead of the raster thread. Defaults to \"default\".")
+DEF_SWITCH(ResamplePointerEventsToVsync,
+           "resample-pointer-events-to-vsync",
+           "Deliver pointer events to the framework once per frame, with the "
+           "position of moving pointers resampled to a fixed latency before "
+           "the vsync. Smooths out input devices that sample at rates other "
+           "than the display refresh rate.")
+DEF_SWITCH(SoftwareRasterThreadCount,
+           "software-raster-thread-count",
+           "The number of threads frames are rasterized on when rendering in "
+           "software. Frames are split into horizontal bands that are "
+           "rasterized in parallel. Defaults to 1.")
 DEF_SWITCH(
     TraceSystrace,
     "trace-systrace",
     "Trace to the system tracer (instead of the timeline) on platforms where "
     "such a tracer is available. Currently only supported on Android and "
     "Fuchsia.")
+DEF_SWITCH(EnableTraceRecorder,
+           "enable-trace-recorder",
+           "Record the most recent trace events of each thread in memory, "
+           "independently of the timeline. The recording can be retrieved "
+           "via the service protocol. The overhead is low enough for this to "
+           "be enabled in production.")
+DEF_SWITCH(TraceRecorderDumpPath,
+           "trace-recorder-dump-path",
+           "Directory in which the trace recorder writes its recording, in the "
+           "Chrome trace event format, when a frame takes more than twice the "
+           "frame budget. Requires --enable-trace-recorder.")
 DEF_SWITCH(UseTestFonts,
            "use-test-fonts",
            "Running tests that layout and measure text will not yield "
@@ -0,0 +1,139 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/tiled_rasterizer.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/utils/SkNWayCanvas.h"
+
+namespace flutter {
+
+// The number of bands each thread rasterizes on average.
+static constexpr size_t kBandsPerThread = 4;
+
+// Bands thinner than this cost more in picture playback overhead than they
+// gain in parallelism.
+static constexpr int kMinBandHeight = 32;
+
+// Forwards draw calls to the picture recorder while noting whether any layer
+// reads back from the surface.
+class TiledRasterizer::Recorder::BackdropDetectingCanvas final
+    : public SkNWayCanvas {
+ public:
+  BackdropDetectingCanvas(int width, int height)
+      : SkNWayCanvas(width, height) {}
+
+  bool HasBackdrop() const { return has_backdrop_; }
+
+ private:
+  bool has_backdrop_ = false;
+
+  // |SkNWayCanvas|
+  SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec& rec) override {
+    if (rec.fBackdrop != nullptr) {
+      has_backdrop_ = true;
+    }
+    return SkNWayCanvas::getSaveLayerStrategy(rec);
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BackdropDetectingCanvas);
+};
+
+TiledRasterizer::Recorder::Recorder(const SkISize& size)
+    : canvas_(std::make_unique<BackdropDetectingCanvas>(size.width(),
+                                                        size.height())) {
+  canvas_->addCanvas(picture_recorder_.beginRecording(
+      SkRect::MakeIWH(size.width(), size.height()), &rtree_factory_));
+}
+
+TiledRasterizer::Recorder::~Recorder() = default;
+
+SkCanvas* TiledRasterizer::Recorder::GetCanvas() {
+  return canvas_.get();
+}
+
+sk_sp<SkPicture> TiledRasterizer::Recorder::FinishRecording() {
+  canvas_->removeAll();
+  return picture_recorder_.finishRecordingAsPicture();
+}
+
+bool TiledRasterizer::Recorder::CanRasterizeInBands() const {
+  return !canvas_->HasBackdrop();
+}
+
+TiledRasterizer::TiledRasterizer(size_t thread_count)
+    : thread_count_(std::max<size_t>(thread_count, 1)) {
+  // The thread calling |Rasterize| rasterizes bands too.
+  if (thread_count_ > 1) {
+    loop_ = fml::ConcurrentMessageLoop::Create(thread_count_ - 1);
+    task_runner_ = loop_->GetTaskRunner();
+  }
+}
+
+TiledRasterizer::~TiledRasterizer() = default;
+
+size_t TiledRasterizer::GetThreadCount() const {
+  return thread_count_;
+}
+
+bool TiledRasterizer::Rasterize(const SkPicture& picture,
+                                SkSurface* surface) const {
+  TRACE_EVENT0("flutter", "TiledRasterizer::Rasterize");
+  SkPixmap pixmap;
+  if (surface == nullptr || !surface->peekPixels(&pixmap)) {
+    FML_LOG(ERROR) << "Could not access the pixels of the surface to "
+                      "rasterize into.";
+    return false;
+  }
+
+  // The pixels are written without going through the canvas of the surface.
+  surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+
+  const int height = pixmap.height();
+  const int band_height = std::max<int>(
+      kMinBandHeight,
+      (height + thread_count_ * kBandsPerThread - 1) /
+          (thread_count_ * kBandsPerThread));
+  const int band_count = (height + band_height - 1) / band_height;
+
+  std::atomic_int next_band = {0};
+  auto rasterize_bands = [&]() {
+    for (int band = next_band++; band < band_count; band = next_band++) {
+      const int top = band * band_height;
+      const auto info =
+          pixmap.info().makeWH(pixmap.width(),
+                               std::min(band_height, height - top));
+      auto canvas = SkCanvas::MakeRasterDirect(
+          info, pixmap.writable_addr(0, top), pixmap.rowBytes());
+      if (!canvas) {
+        continue;
+      }
+      canvas->translate(0, -top);
+      canvas->drawPicture(&picture);
+    }
+  };
+
+  // The calling thread takes one of the bands.
+  const size_t worker_count =
+      task_runner_ ? std::min<size_t>(thread_count_ - 1,
+                                      std::max(band_count - 1, 0))
+                   : 0;
+  fml::CountDownLatch latch(worker_count);
+  for (size_t i = 0; i < worker_count; i++) {
+    task_runner_->PostTask([&rasterize_bands, &latch]() {
+      rasterize_bands();
+      latch.CountDown();
+    });
+  }
+  rasterize_bands();
+  latch.Wait();
+  return true;
+}
+
+}  // namespace flutter
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_TILED_RASTERIZER_H_
+#define FLUTTER_SHELL_COMMON_TILED_RASTERIZER_H_
+
+#include <memory>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkBBHFactory.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Rasterizes pictures into raster surfaces on multiple threads. The surface
+/// is split into horizontal bands that are rasterized in parallel by replaying
+/// the picture into each of them. There are more bands than threads so that
+/// the threads stay busy when the content is not spread evenly.
+///
+class TiledRasterizer {
+ public:
+  //----------------------------------------------------------------------------
+  /// Records the draw calls of a frame so that it can be rasterized in bands.
+  ///
+  class Recorder {
+   public:
+    explicit Recorder(const SkISize& size);
+
+    ~Recorder();
+
+    SkCanvas* GetCanvas();
+
+    sk_sp<SkPicture> FinishRecording();
+
+    //--------------------------------------------------------------------------
+    /// @brief      Whether the recorded picture may be rasterized in bands.
+    ///             Backdrop filters read back what was drawn before them. A
+    ///             band can't read back beyond its bounds, so pictures that
+    ///             contain backdrop filters must be rasterized in one piece.
+    ///
+    bool CanRasterizeInBands() const;
+
+   private:
+    class BackdropDetectingCanvas;
+
+    SkRTreeFactory rtree_factory_;
+    SkPictureRecorder picture_recorder_;
+    std::unique_ptr<BackdropDetectingCanvas> canvas_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(Recorder);
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a rasterizer that uses |thread_count| threads,
+  ///             including the thread that calls |Rasterize|.
+  ///
+  explicit TiledRasterizer(size_t thread_count);
+
+  ~TiledRasterizer();
+
+  size_t GetThreadCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Replays a picture into a raster surface and returns once all
+  ///             the bands have been rasterized.
+  ///
+  /// @return     If the pixels of the surface could be accessed.
+  ///
+  bool Rasterize(const SkPicture& picture, SkSurface* surface) const;
+
+ private:
+  const size_t thread_count_;
+  std::shared_ptr<fml::ConcurrentMessageLoop> loop_;
+  std::shared_ptr<fml::ConcurrentTaskRunner> task_runner_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TiledRasterizer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_TILED_RASTERIZER_H_
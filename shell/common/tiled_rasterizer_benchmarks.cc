@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+#include "flutter/shell/common/tiled_rasterizer.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPath.h"
+
+namespace flutter {
+
+// Records a frame with enough anti-aliased geometry spread over the whole
+// surface that rasterization dominates the cost of playing the picture back.
+static sk_sp<SkPicture> RecordFrame(const SkISize& size) {
+  TiledRasterizer::Recorder recorder(size);
+  SkCanvas* canvas = recorder.GetCanvas();
+  canvas->clear(SK_ColorWHITE);
+  SkPaint paint;
+  paint.setAntiAlias(true);
+  for (int i = 0; i < 2000; i++) {
+    const SkScalar x = (i * 137) % size.width();
+    const SkScalar y = (i * 251) % size.height();
+    paint.setColor(SkColorSetARGB(160, i % 255, (i * 7) % 255, (i * 13) % 255));
+    if (i % 3 == 0) {
+      canvas->drawCircle(x, y, 4 + i % 40, paint);
+    } else if (i % 3 == 1) {
+      canvas->drawRRect(
+          SkRRect::MakeRectXY(SkRect::MakeXYWH(x, y, 60, 30), 8, 8), paint);
+    } else {
+      SkPath path;
+      path.moveTo(x, y);
+      path.quadTo(x + 40, y - 30, x + 80, y);
+      path.lineTo(x + 40, y + 50);
+      path.close();
+      canvas->drawPath(path, paint);
+    }
+  }
+  auto picture = recorder.FinishRecording();
+  FML_CHECK(picture);
+  return picture;
+}
+
+static void BM_TiledRasterizerRasterize(benchmark::State& state) {
+  const auto size = SkISize::Make(1920, 1080);
+  const auto picture = RecordFrame(size);
+  auto surface = SkSurface::MakeRasterN32Premul(size.width(), size.height());
+  FML_CHECK(surface);
+  TiledRasterizer rasterizer(state.range(0));
+  while (state.KeepRunning()) {
+    FML_CHECK(rasterizer.Rasterize(*picture, surface.get()));
+  }
+  // Reported as frames per second.
+  state.counters["frames"] =
+      benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_TiledRasterizerRasterize)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace flutter
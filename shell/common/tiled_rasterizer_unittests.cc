@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+
+#include "flutter/shell/common/tiled_rasterizer.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/effects/SkBlurImageFilter.h"
+
+namespace flutter {
+namespace testing {
+
+// Draws overlapping translucent shapes that straddle the band boundaries.
+static void DrawContent(SkCanvas* canvas, const SkISize& size) {
+  SkPaint paint;
+  paint.setAntiAlias(true);
+  for (int i = 0; i < 64; i++) {
+    paint.setColor(SkColorSetARGB(128 + i, i * 4, 255 - i * 4, i * 2));
+    canvas->drawCircle((i * 37) % size.width(), (i * 53) % size.height(),
+                       10 + i, paint);
+  }
+  canvas->save();
+  canvas->rotate(15);
+  paint.setColor(SK_ColorBLUE);
+  canvas->drawRect(SkRect::MakeXYWH(20, 20, size.width() / 2, 40), paint);
+  canvas->restore();
+}
+
+static sk_sp<SkSurface> MakeSurface(const SkISize& size) {
+  return SkSurface::MakeRasterN32Premul(size.width(), size.height());
+}
+
+static bool HaveSamePixels(SkSurface* a, SkSurface* b) {
+  SkPixmap pixmap_a, pixmap_b;
+  if (!a->peekPixels(&pixmap_a) || !b->peekPixels(&pixmap_b) ||
+      pixmap_a.info() != pixmap_b.info()) {
+    return false;
+  }
+  for (int y = 0; y < pixmap_a.height(); y++) {
+    if (::memcmp(pixmap_a.addr(0, y), pixmap_b.addr(0, y),
+                 pixmap_a.info().minRowBytes()) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void CheckMatchesSingleThreadedOutput(const SkISize& size,
+                                             size_t thread_count) {
+  TiledRasterizer::Recorder recorder(size);
+  DrawContent(recorder.GetCanvas(), size);
+  auto picture = recorder.FinishRecording();
+  ASSERT_TRUE(picture);
+  ASSERT_TRUE(recorder.CanRasterizeInBands());
+
+  auto expected = MakeSurface(size);
+  expected->getCanvas()->drawPicture(picture.get());
+
+  auto actual = MakeSurface(size);
+  TiledRasterizer rasterizer(thread_count);
+  ASSERT_EQ(rasterizer.GetThreadCount(), thread_count);
+  ASSERT_TRUE(rasterizer.Rasterize(*picture, actual.get()));
+  ASSERT_TRUE(HaveSamePixels(expected.get(), actual.get()));
+}
+
+TEST(TiledRasterizerTest, MatchesSingleThreadedOutput) {
+  CheckMatchesSingleThreadedOutput(SkISize::Make(400, 600), 1);
+  CheckMatchesSingleThreadedOutput(SkISize::Make(400, 600), 4);
+  // Fewer rows than the minimum band height.
+  CheckMatchesSingleThreadedOutput(SkISize::Make(400, 7), 4);
+  // Not a multiple of the band height.
+  CheckMatchesSingleThreadedOutput(SkISize::Make(301, 1001), 3);
+}
+
+TEST(TiledRasterizerTest, CanRasterizeRepeatedly) {
+  const auto size = SkISize::Make(256, 512);
+  TiledRasterizer rasterizer(4);
+  auto expected = MakeSurface(size);
+  auto actual = MakeSurface(size);
+  for (int frame = 0; frame < 10; frame++) {
+    TiledRasterizer::Recorder recorder(size);
+    recorder.GetCanvas()->translate(frame * 3, frame * 5);
+    DrawContent(recorder.GetCanvas(), size);
+    auto picture = recorder.FinishRecording();
+    expected->getCanvas()->drawPicture(picture.get());
+    ASSERT_TRUE(rasterizer.Rasterize(*picture, actual.get()));
+    ASSERT_TRUE(HaveSamePixels(expected.get(), actual.get()));
+  }
+}
+
+TEST(TiledRasterizerTest, BackdropFiltersPreventRasterizingInBands) {
+  TiledRasterizer::Recorder recorder(SkISize::Make(100, 100));
+  auto filter = SkBlurImageFilter::Make(4, 4, nullptr);
+  recorder.GetCanvas()->saveLayer(
+      SkCanvas::SaveLayerRec{nullptr, nullptr, filter.get(), 0});
+  recorder.GetCanvas()->restore();
+  ASSERT_FALSE(recorder.CanRasterizeInBands());
+  ASSERT_TRUE(recorder.FinishRecording());
+}
+
+TEST(TiledRasterizerTest, FailsWithoutAccessToPixels) {
+  TiledRasterizer::Recorder recorder(SkISize::Make(100, 100));
+  auto picture = recorder.FinishRecording();
+  TiledRasterizer rasterizer(2);
+  ASSERT_FALSE(rasterizer.Rasterize(*picture, nullptr));
+}
+
+}  // namespace testing
+}  // namespace flutter
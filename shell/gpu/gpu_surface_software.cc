@@ -10,10 +10,15 @@
 namespace flutter {
 
 GPUSurfaceSoftware::GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                                       bool render_to_surface)
+                                       bool render_to_surface,
+                                       size_t raster_thread_count)
     : delegate_(delegate),
       render_to_surface_(render_to_surface),
-      weak_factory_(this) {}
+      weak_factory_(this) {
+  if (raster_thread_count > 1) {
+    tiled_rasterizer_ = std::make_unique<TiledRasterizer>(raster_thread_count);
+  }
+}
 
 GPUSurfaceSoftware::~GPUSurfaceSoftware() = default;
 
@@ -69,9 +74,49 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
     return self->delegate_->PresentBackingStore(surface_frame.SkiaSurface());
   };
 
+  if (tiled_rasterizer_) {
+    return AcquireTiledFrame(std::move(backing_store));
+  }
+
   return std::make_unique<SurfaceFrame>(backing_store, true, on_submit);
 }
 
+std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireTiledFrame(
+    sk_sp<SkSurface> backing_store) {
+  // The frame is recorded into a picture and only rasterized into the backing
+  // store on submit, once the whole frame is known.
+  auto recorder = std::make_shared<TiledRasterizer::Recorder>(
+      SkISize::Make(backing_store->width(), backing_store->height()));
+
+  SurfaceFrame::SubmitCallback on_submit =
+      [self = weak_factory_.GetWeakPtr(), recorder](
+          const SurfaceFrame& surface_frame, SkCanvas* canvas) -> bool {
+    auto picture = recorder->FinishRecording();
+
+    // If the surface itself went away, there is nothing more to do.
+    if (!self || !self->IsValid() || canvas == nullptr || !picture) {
+      return false;
+    }
+
+    auto backing_store = surface_frame.SkiaSurface();
+    if (recorder->CanRasterizeInBands()) {
+      if (!self->tiled_rasterizer_->Rasterize(*picture, backing_store.get())) {
+        return false;
+      }
+    } else {
+      backing_store->getCanvas()->drawPicture(picture.get());
+    }
+
+    backing_store->getCanvas()->flush();
+
+    return self->delegate_->PresentBackingStore(backing_store);
+  };
+
+  SkCanvas* canvas = recorder->GetCanvas();
+  return std::make_unique<SurfaceFrame>(std::move(backing_store), canvas, true,
+                                        on_submit);
+}
+
 // |Surface|
 SkMatrix GPUSurfaceSoftware::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
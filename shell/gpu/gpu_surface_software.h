@@ -5,17 +5,27 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 
+#include <memory>
+
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/shell/common/surface.h"
+#include "flutter/shell/common/tiled_rasterizer.h"
 #include "flutter/shell/gpu/gpu_surface_software_delegate.h"
 
 namespace flutter {
 
 class GPUSurfaceSoftware : public Surface {
  public:
+  //----------------------------------------------------------------------------
+  /// @param[in]  raster_thread_count  The number of threads frames are
+  ///                                  rasterized on. When more than one,
+  ///                                  frames are recorded and then rasterized
+  ///                                  in bands by a |TiledRasterizer|.
+  ///
   GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                     bool render_to_surface);
+                     bool render_to_surface,
+                     size_t raster_thread_count = 1);
 
   ~GPUSurfaceSoftware() override;
 
@@ -41,8 +51,12 @@ class GPUSurfaceSoftware : public Surface {
   // hack to make avoid allocating resources for the root surface when an
   // external view embedder is present.
   const bool render_to_surface_;
+  std::unique_ptr<TiledRasterizer> tiled_rasterizer_;
   fml::WeakPtrFactory<GPUSurfaceSoftware> weak_factory_;
 
+  std::unique_ptr<SurfaceFrame> AcquireTiledFrame(
+      sk_sp<SkSurface> backing_store);
+
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftware);
 };
 
@@ -32,4 +32,8 @@ std::unique_ptr<AndroidSurface> AndroidSurface::Create(
 
 AndroidSurface::~AndroidSurface() = default;
 
+fml::closure AndroidSurface::GetResourceContextReleaser() {
+  return nullptr;
+}
+
 }  // namespace flutter
@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/platform/android/jni_util.h"
 #include "flutter/fml/platform/android/jni_weak_ref.h"
@@ -35,6 +36,10 @@ class AndroidSurface {
 
   virtual bool ResourceContextClearCurrent() = 0;
 
+  // Clears the resource context the way |ResourceContextClearCurrent| does,
+  // but may be called after this surface was collected.
+  virtual fml::closure GetResourceContextReleaser();
+
   virtual bool SetNativeWindow(fml::RefPtr<AndroidNativeWindow> window) = 0;
 };
 
@@ -75,6 +75,13 @@ bool AndroidSurfaceGL::ResourceContextClearCurrent() {
   return offscreen_context_->ClearCurrent();
 }
 
+fml::closure AndroidSurfaceGL::GetResourceContextReleaser() {
+  FML_DCHECK(offscreen_context_ && offscreen_context_->IsValid());
+  return [offscreen_context = offscreen_context_]() {
+    offscreen_context->ClearCurrent();
+  };
+}
+
 bool AndroidSurfaceGL::SetNativeWindow(
     fml::RefPtr<AndroidNativeWindow> window) {
   // In any case, we want to get rid of our current onscreen context.
@@ -43,6 +43,9 @@ class AndroidSurfaceGL final : public GPUSurfaceGLDelegate,
   // |AndroidSurface|
   bool ResourceContextClearCurrent() override;
 
+  // |AndroidSurface|
+  fml::closure GetResourceContextReleaser() override;
+
   // |AndroidSurface|
   bool SetNativeWindow(fml::RefPtr<AndroidNativeWindow> window) override;
 
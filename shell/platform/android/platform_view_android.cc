@@ -418,6 +418,12 @@ void PlatformViewAndroid::ReleaseResourceContext() const {
   }
 }
 
+// |PlatformView|
+fml::closure PlatformViewAndroid::GetResourceContextReleaser() const {
+  return android_surface_ ? android_surface_->GetResourceContextReleaser()
+                          : nullptr;
+}
+
 void PlatformViewAndroid::InstallFirstFrameCallback() {
   // On Platform Task Runner.
   SetNextFrameCallback(
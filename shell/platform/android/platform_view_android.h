@@ -105,6 +105,9 @@ class PlatformViewAndroid final : public PlatformView {
   // |PlatformView|
   void ReleaseResourceContext() const override;
 
+  // |PlatformView|
+  fml::closure GetResourceContextReleaser() const override;
+
   void InstallFirstFrameCallback();
 
   void FireFirstFrameCallback();
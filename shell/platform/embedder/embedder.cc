@@ -5,7 +5,13 @@
 #define FML_USED_ON_EMBEDDER
 #define RAPIDJSON_HAS_STDSTRING 1
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/closure.h"
@@ -35,6 +41,7 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/shell/common/frame_statistics.h"
 #include "flutter/shell/common/persistent_cache.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/switches.h"
@@ -100,6 +107,18 @@ static bool IsSoftwareRendererConfigValid(const FlutterRendererConfig* config) {
 
   const FlutterSoftwareRendererConfig* software_config = &config->software;
 
+  const bool has_acquire_buffer =
+      SAFE_ACCESS(software_config, acquire_buffer_callback, nullptr) != nullptr;
+  const bool has_present_buffer =
+      SAFE_ACCESS(software_config, present_buffer_callback, nullptr) != nullptr;
+  const bool has_release_buffer =
+      SAFE_ACCESS(software_config, release_buffer_callback, nullptr) != nullptr;
+
+  if (has_acquire_buffer || has_present_buffer || has_release_buffer) {
+    // Embedder provided buffers need all three callbacks.
+    return has_acquire_buffer && has_present_buffer && has_release_buffer;
+  }
+
   if (SAFE_ACCESS(software_config, surface_present_callback, nullptr) ==
       nullptr) {
     return false;
@@ -249,27 +268,70 @@ InferSoftwarePlatformViewCreationCallback(
     return nullptr;
   }
 
-  auto software_present_backing_store =
-      [ptr = config->software.surface_present_callback, user_data](
-          const void* allocation, size_t row_bytes, size_t height) -> bool {
-    return ptr(user_data, allocation, row_bytes, height);
-  };
+  const FlutterSoftwareRendererConfig* software_config = &config->software;
+
+  std::function<bool(const void*, size_t, size_t)>
+      software_present_backing_store;
+  if (auto ptr = SAFE_ACCESS(software_config, surface_present_callback,
+                             nullptr)) {
+    software_present_backing_store = [ptr, user_data](const void* allocation,
+                                                      size_t row_bytes,
+                                                      size_t height) -> bool {
+      return ptr(user_data, allocation, row_bytes, height);
+    };
+  }
+
+  std::function<bool(const SkISize&, FlutterSoftwareBuffer*)>
+      software_acquire_buffer;
+  std::function<bool(const FlutterSoftwareBuffer&, const FlutterRect*, size_t)>
+      software_present_buffer;
+  std::function<void(const FlutterSoftwareBuffer&)> software_release_buffer;
+  if (auto ptr = SAFE_ACCESS(software_config, acquire_buffer_callback,
+                             nullptr)) {
+    software_acquire_buffer = [ptr, user_data](
+                                  const SkISize& size,
+                                  FlutterSoftwareBuffer* buffer) -> bool {
+      return ptr(user_data, size.width(), size.height(), buffer);
+    };
+  }
+  if (auto ptr = SAFE_ACCESS(software_config, present_buffer_callback,
+                             nullptr)) {
+    software_present_buffer = [ptr, user_data](
+                                  const FlutterSoftwareBuffer& buffer,
+                                  const FlutterRect* damage_rects,
+                                  size_t damage_rects_count) -> bool {
+      return ptr(user_data, &buffer, damage_rects, damage_rects_count);
+    };
+  }
+  if (auto ptr = SAFE_ACCESS(software_config, release_buffer_callback,
+                             nullptr)) {
+    software_release_buffer = [ptr,
+                               user_data](const FlutterSoftwareBuffer& buffer) {
+      ptr(user_data, &buffer);
+    };
+  }
 
   flutter::EmbedderSurfaceSoftware::SoftwareDispatchTable
       software_dispatch_table = {
-          software_present_backing_store,  // required
+          software_present_backing_store,  // required unless using buffers
+          software_acquire_buffer,         // optional
+          software_present_buffer,         // optional
+          software_release_buffer,         // optional
       };
 
   return fml::MakeCopyable(
       [software_dispatch_table, platform_dispatch_table,
        external_view_embedder =
            std::move(external_view_embedder)](flutter::Shell& shell) mutable {
+        const auto raster_thread_count =
+            shell.GetSettings().software_raster_thread_count;
         return std::make_unique<flutter::PlatformViewEmbedder>(
-            shell,                             // delegate
-            shell.GetTaskRunners(),            // task runners
-            software_dispatch_table,           // software dispatch table
-            platform_dispatch_table,           // platform dispatch table
-            std::move(external_view_embedder)  // external view embedder
+            shell,                              // delegate
+            shell.GetTaskRunners(),             // task runners
+            software_dispatch_table,            // software dispatch table
+            platform_dispatch_table,            // platform dispatch table
+            std::move(external_view_embedder),  // external view embedder
+            raster_thread_count                 // raster thread count
         );
       });
 }
@@ -523,9 +585,22 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
             user_data);
       };
 
-  return {std::make_unique<flutter::EmbedderExternalViewEmbedder>(
-              create_render_target_callback, present_callback),
-          false};
+  flutter::EmbedderRenderTargetCache::Options render_target_cache_options;
+  render_target_cache_options.retained_frames =
+      SAFE_ACCESS(compositor, backing_store_retained_frames, 0);
+  render_target_cache_options.max_bytes =
+      SAFE_ACCESS(compositor, backing_store_cache_max_bytes, 0);
+  render_target_cache_options.size_granularity =
+      SAFE_ACCESS(compositor, backing_store_size_granularity, 1);
+
+  auto external_view_embedder =
+      std::make_unique<flutter::EmbedderExternalViewEmbedder>(
+          create_render_target_callback, present_callback,
+          render_target_cache_options);
+  external_view_embedder->SetMergesDisjointOverlays(
+      SAFE_ACCESS(compositor, merge_disjoint_overlays, false));
+
+  return {std::move(external_view_embedder), false};
 }
 
 struct _FlutterPlatformMessageResponseHandle {
@@ -665,6 +740,8 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   settings.assets_path = args->assets_path;
   settings.leak_vm = !SAFE_ACCESS(args, shutdown_dart_vm_when_done, false);
   settings.old_gen_heap_size = SAFE_ACCESS(args, dart_old_gen_heap_size, -1);
+  settings.resample_pointer_events_to_vsync =
+      SAFE_ACCESS(args, resample_pointer_events_to_vsync, false);
 
   if (!flutter::DartVM::IsRunningPrecompiledCode()) {
     // Verify the assets path contains Dart 2 kernel assets.
@@ -1170,6 +1247,101 @@ FlutterEngineResult FlutterEngineSendPointerEvent(
                                   "running Flutter application.");
 }
 
+static_assert(sizeof(FlutterPointerData) == sizeof(flutter::PointerData),
+              "FlutterPointerData must match the layout of PointerData.");
+static_assert(offsetof(FlutterPointerData, buttons) ==
+                  offsetof(flutter::PointerData, buttons),
+              "FlutterPointerData must match the layout of PointerData.");
+static_assert(offsetof(FlutterPointerData, scroll_delta_y) ==
+                  offsetof(flutter::PointerData, scroll_delta_y),
+              "FlutterPointerData must match the layout of PointerData.");
+
+static bool IsValidPointerData(const FlutterPointerData& data) {
+  return data.change >= kFlutterPointerDataChangeCancel &&
+         data.change <= kFlutterPointerDataChangeUp &&
+         data.kind >= kFlutterPointerDataDeviceKindTouch &&
+         data.kind <= kFlutterPointerDataDeviceKindInvertedStylus &&
+         data.signal_kind >= kFlutterPointerSignalKindNone &&
+         data.signal_kind <= kFlutterPointerSignalKindScroll;
+}
+
+static bool IsCoalescablePointerData(const FlutterPointerData& data) {
+  return (data.change == kFlutterPointerDataChangeMove ||
+          data.change == kFlutterPointerDataChangeHover) &&
+         data.signal_kind == kFlutterPointerSignalKindNone;
+}
+
+// Returns the indices of the events that are not superseded by a later move of
+// the same pointer.
+static std::vector<size_t> CoalescePointerData(const FlutterPointerData* events,
+                                               size_t events_count) {
+  std::vector<size_t> retained;
+  retained.reserve(events_count);
+  // The latest event of each device seen so far, walking backwards.
+  std::unordered_map<int64_t, const FlutterPointerData*> next_events;
+  for (size_t i = events_count; i-- > 0;) {
+    const auto& event = events[i];
+    auto& next = next_events[event.device];
+    if (next != nullptr && IsCoalescablePointerData(event) &&
+        next->change == event.change && next->buttons == event.buttons &&
+        next->signal_kind == event.signal_kind) {
+      continue;
+    }
+    next = &event;
+    retained.push_back(i);
+  }
+  std::reverse(retained.begin(), retained.end());
+  return retained;
+}
+
+FlutterEngineResult FlutterEngineSendPointerDataBatch(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPointerDataBatch* batch) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (batch == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid batch argument.");
+  }
+
+  const FlutterPointerData* events = SAFE_ACCESS(batch, events, nullptr);
+  const size_t events_count = SAFE_ACCESS(batch, events_count, 0);
+  if (events == nullptr || events_count == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid pointer events.");
+  }
+
+  for (size_t i = 0; i < events_count; ++i) {
+    if (!IsValidPointerData(events[i])) {
+      return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                "Invalid pointer event in the batch.");
+    }
+  }
+
+  std::unique_ptr<flutter::PointerDataPacket> packet;
+  if (SAFE_ACCESS(batch, flags, 0) &
+      kFlutterPointerDataBatchFlagCoalesceMoves) {
+    const auto retained = CoalescePointerData(events, events_count);
+    packet = std::make_unique<flutter::PointerDataPacket>(retained.size());
+    for (size_t i = 0; i < retained.size(); ++i) {
+      flutter::PointerData pointer_data;
+      memcpy(&pointer_data, &events[retained[i]], sizeof(pointer_data));
+      packet->SetPointerData(i, pointer_data);
+    }
+  } else {
+    packet = std::make_unique<flutter::PointerDataPacket>(
+        reinterpret_cast<const uint8_t*>(events),
+        events_count * sizeof(FlutterPointerData));
+  }
+
+  return reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                 ->DispatchPointerDataPacket(std::move(packet))
+             ? kSuccess
+             : LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                                  "Could not dispatch pointer events to the "
+                                  "running Flutter application.");
+}
+
 FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* flutter_message) {
@@ -1361,6 +1533,93 @@ FlutterEngineResult FlutterEngineMarkExternalTextureFrameAvailable(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineRegisterSharedMemoryTexture(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+  if (texture_identifier == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid texture identifier.");
+  }
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)
+           ->RegisterSharedMemoryTexture(texture_identifier)) {
+    return LOG_EMBEDDER_ERROR(
+        kInternalInconsistency,
+        "Could not register the specified shared memory texture.");
+  }
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEnginePushSharedMemoryTextureFrame(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier,
+    const FlutterSharedMemoryTextureFrame* frame) {
+  if (frame == nullptr ||
+      SAFE_ACCESS(frame, release_callback, nullptr) == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Shared memory texture frame was invalid.");
+  }
+  const flutter::SharedMemoryTexture::ReleaseCallback release =
+      [release_callback = frame->release_callback,
+       user_data = SAFE_ACCESS(frame, user_data, nullptr)]() {
+        release_callback(user_data);
+      };
+
+  if (engine == nullptr) {
+    release();
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+  if (texture_identifier == 0) {
+    release();
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid texture identifier.");
+  }
+
+  SkColorType color_type;
+  switch (SAFE_ACCESS(frame, pixel_format,
+                      kFlutterSharedMemoryPixelFormatRGBA8888)) {
+    case kFlutterSharedMemoryPixelFormatRGBA8888:
+      color_type = kRGBA_8888_SkColorType;
+      break;
+    case kFlutterSharedMemoryPixelFormatBGRA8888:
+      color_type = kBGRA_8888_SkColorType;
+      break;
+    default:
+      release();
+      return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                "Invalid shared memory pixel format.");
+  }
+  const size_t width = SAFE_ACCESS(frame, width, 0);
+  const size_t height = SAFE_ACCESS(frame, height, 0);
+  const void* pixels = SAFE_ACCESS(frame, pixels, nullptr);
+  const size_t row_bytes = SAFE_ACCESS(frame, row_bytes, 0);
+  constexpr size_t kMaxDimension = std::numeric_limits<int>::max();
+  if (pixels == nullptr || width == 0 || height == 0 ||
+      width > kMaxDimension || height > kMaxDimension) {
+    release();
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid shared memory texture frame size.");
+  }
+  const auto info = SkImageInfo::Make(width, height, color_type,
+                                      kPremul_SkAlphaType);
+  if (!info.validRowBytes(row_bytes)) {
+    release();
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid shared memory texture row bytes.");
+  }
+
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)
+           ->PushSharedMemoryTextureFrame(texture_identifier,
+                                          SkPixmap(info, pixels, row_bytes),
+                                          release)) {
+    release();
+    return LOG_EMBEDDER_ERROR(
+        kInternalInconsistency,
+        "Could not push a frame to the specified shared memory texture.");
+  }
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineUpdateSemanticsEnabled(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     bool enabled) {
@@ -1747,3 +2006,52 @@ FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
                    kInternalInconsistency,
                    "Could not dispatch the low memory notification message.");
 }
+
+static FlutterFrameDurationPercentiles ToEmbedderPercentiles(
+    const flutter::FrameStatistics::Percentiles& percentiles) {
+  return {
+      static_cast<uint64_t>(percentiles.p50.ToNanoseconds()),  // p50
+      static_cast<uint64_t>(percentiles.p90.ToNanoseconds()),  // p90
+      static_cast<uint64_t>(percentiles.p99.ToNanoseconds()),  // p99
+      static_cast<uint64_t>(percentiles.max.ToNanoseconds()),  // max
+  };
+}
+
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFrameStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) raw_engine,
+    FlutterFrameStatistics* statistics,
+    bool reset) {
+  auto engine = reinterpret_cast<flutter::EmbedderEngine*>(raw_engine);
+  if (engine == nullptr || !engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine was invalid.");
+  }
+
+  if (statistics == nullptr ||
+      statistics->struct_size < sizeof(FlutterFrameStatistics)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Frame statistics were invalid.");
+  }
+
+  auto& shell = engine->GetShell();
+  const auto summary = shell.GetFrameStatistics();
+  if (reset) {
+    shell.ResetFrameStatistics();
+  }
+
+  statistics->frame_count = summary.frame_count;
+  statistics->missed_frame_count = summary.missed_frame_count;
+  statistics->build = ToEmbedderPercentiles(summary.build);
+  statistics->raster = ToEmbedderPercentiles(summary.raster);
+  statistics->vsync_latency = ToEmbedderPercentiles(summary.vsync_latency);
+  statistics->total = ToEmbedderPercentiles(summary.total);
+  static_assert(kFlutterFrameJankCauseCount ==
+                    static_cast<size_t>(
+                        flutter::FrameStatistics::JankCause::kCount),
+                "The embedder jank causes must match the engine.");
+  for (size_t i = 0; i < kFlutterFrameJankCauseCount; i++) {
+    statistics->missed_frame_count_by_cause[i] =
+        summary.missed_frames_by_cause[i];
+  }
+  return kSuccess;
+}
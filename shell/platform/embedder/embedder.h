@@ -258,6 +258,13 @@ typedef struct {
   VoidCallback destruction_callback;
 } FlutterOpenGLFramebuffer;
 
+typedef struct {
+  double left;
+  double top;
+  double right;
+  double bottom;
+} FlutterRect;
+
 typedef bool (*BoolCallback)(void* /* user data */);
 typedef FlutterTransformation (*TransformationCallback)(void* /* user data */);
 typedef uint32_t (*UIntCallback)(void* /* user data */);
@@ -266,6 +273,35 @@ typedef bool (*SoftwareSurfacePresentCallback)(void* /* user data */,
                                                size_t /* row bytes */,
                                                size_t /* height */);
 typedef void* (*ProcResolver)(void* /* user data */, const char* /* name */);
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterSoftwareBuffer).
+  size_t struct_size;
+  /// The pixels of the buffer in the native 32-bit RGBA format. The engine
+  /// renders directly into this memory.
+  void* allocation;
+  /// The number of bytes per row. Must be at least four times the width.
+  size_t row_bytes;
+  /// The number of rows. Must be the height that was asked for.
+  size_t height;
+  /// An embedder defined value that identifies the buffer. It is returned
+  /// unchanged to the present and release callbacks.
+  void* user_data;
+} FlutterSoftwareBuffer;
+
+typedef bool (*SoftwareBufferAcquireCallback)(
+    void* /* user data */,
+    size_t /* width */,
+    size_t /* height */,
+    FlutterSoftwareBuffer* /* buffer out */);
+typedef bool (*SoftwareBufferPresentCallback)(
+    void* /* user data */,
+    const FlutterSoftwareBuffer* /* buffer */,
+    const FlutterRect* /* damage rects */,
+    size_t /* damage rects count */);
+typedef void (*SoftwareBufferReleaseCallback)(
+    void* /* user data */,
+    const FlutterSoftwareBuffer* /* buffer */);
 typedef bool (*TextureFrameCallback)(void* /* user data */,
                                      int64_t /* texture identifier */,
                                      size_t /* width */,
@@ -317,8 +353,27 @@ typedef struct {
   /// The callback presented to the embedder to present a fully populated buffer
   /// to the user. The pixel format of the buffer is the native 32-bit RGBA
   /// format. The buffer is owned by the Flutter engine and must be copied in
-  /// this callback if needed.
+  /// this callback if needed. This callback is not used and may be null if
+  /// the embedder provides the buffers to render into.
   SoftwareSurfacePresentCallback surface_present_callback;
+  /// Optional. The following callbacks let the embedder provide the buffers
+  /// the engine renders into, for instance from a swapchain of scanout or
+  /// shared memory buffers, so that frames don't have to be copied. All three
+  /// must be specified together.
+  ///
+  /// The engine calls this to get a buffer of the given size in pixels before
+  /// rendering each frame. The embedder must not read from or write to the
+  /// buffer until it is handed back by the present or release callbacks.
+  SoftwareBufferAcquireCallback acquire_buffer_callback;
+  /// Called once a frame has been rendered into a buffer obtained from
+  /// `acquire_buffer_callback`. The buffer is handed back to the embedder,
+  /// which may scan it out directly. The damage rects cover the pixels that
+  /// differ from the previous frame. The engine currently repaints entire
+  /// frames, so this is a single rect covering the whole buffer.
+  SoftwareBufferPresentCallback present_buffer_callback;
+  /// Called to hand back a buffer obtained from `acquire_buffer_callback`
+  /// that will not be presented, for instance because the frame was dropped.
+  SoftwareBufferReleaseCallback release_buffer_callback;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -430,6 +485,89 @@ typedef struct {
   int64_t buttons;
 } FlutterPointerEvent;
 
+/// The change of a `FlutterPointerData`. Unlike `FlutterPointerPhase`, these
+/// match the values used by the engine internally.
+typedef enum {
+  kFlutterPointerDataChangeCancel,
+  kFlutterPointerDataChangeAdd,
+  kFlutterPointerDataChangeRemove,
+  kFlutterPointerDataChangeHover,
+  kFlutterPointerDataChangeDown,
+  kFlutterPointerDataChangeMove,
+  kFlutterPointerDataChangeUp,
+} FlutterPointerDataChange;
+
+/// The device kind of a `FlutterPointerData`. Unlike
+/// `FlutterPointerDeviceKind`, these match the values used by the engine
+/// internally.
+typedef enum {
+  kFlutterPointerDataDeviceKindTouch,
+  kFlutterPointerDataDeviceKindMouse,
+  kFlutterPointerDataDeviceKindStylus,
+  kFlutterPointerDataDeviceKindInvertedStylus,
+} FlutterPointerDataDeviceKind;
+
+/// A pointer event in the layout the engine uses internally, so that arrays of
+/// these can be handed to the engine without converting each event. Every
+/// field is 64 bits wide. Enumerations are stored as `int64_t`.
+typedef struct {
+  /// The timestamp in microseconds, using the clock of
+  /// `FlutterEngineGetCurrentTime`.
+  int64_t timestamp;
+  /// A `FlutterPointerDataChange`.
+  int64_t change;
+  /// A `FlutterPointerDataDeviceKind`.
+  int64_t kind;
+  /// A `FlutterPointerSignalKind`.
+  int64_t signal_kind;
+  int64_t device;
+  /// Assigned by the engine. Ignored.
+  int64_t pointer_identifier;
+  double physical_x;
+  double physical_y;
+  /// Computed by the engine. Ignored.
+  double physical_delta_x;
+  /// Computed by the engine. Ignored.
+  double physical_delta_y;
+  /// The buttons currently pressed, using the masks of `FlutterPointerEvent`.
+  int64_t buttons;
+  int64_t obscured;
+  int64_t synthesized;
+  double pressure;
+  double pressure_min;
+  double pressure_max;
+  double distance;
+  double distance_max;
+  double size;
+  double radius_major;
+  double radius_minor;
+  double radius_min;
+  double radius_max;
+  double orientation;
+  double tilt;
+  int64_t platform_data;
+  double scroll_delta_x;
+  double scroll_delta_y;
+} FlutterPointerData;
+
+typedef enum {
+  kFlutterPointerDataBatchFlagNone = 0,
+  /// Within the batch, drop move and hover events that are followed by another
+  /// event of the same kind from the same device with the same buttons. Only
+  /// the latest position of each pointer is delivered to the framework.
+  kFlutterPointerDataBatchFlagCoalesceMoves = 1 << 0,
+} FlutterPointerDataBatchFlags;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterPointerDataBatch).
+  size_t struct_size;
+  /// A contiguous array of `events_count` events, oldest first.
+  const FlutterPointerData* events;
+  size_t events_count;
+  /// A combination of `FlutterPointerDataBatchFlags`.
+  uint32_t flags;
+} FlutterPointerDataBatch;
+
 struct _FlutterPlatformMessageResponseHandle;
 typedef struct _FlutterPlatformMessageResponseHandle
     FlutterPlatformMessageResponseHandle;
@@ -457,13 +595,6 @@ typedef void (*FlutterDataCallback)(const uint8_t* /* data */,
                                     size_t /* size */,
                                     void* /* user data */);
 
-typedef struct {
-  double left;
-  double top;
-  double right;
-  double bottom;
-} FlutterRect;
-
 typedef struct {
   double x;
   double y;
@@ -835,6 +966,31 @@ typedef struct {
   /// Callback invoked by the engine to composite the contents of each layer
   /// onto the screen.
   FlutterLayersPresentCallback present_layers_callback;
+  /// The engine keeps the backing stores it obtained from the embedder in a
+  /// pool and reuses them for any layer of the same size in later frames. This
+  /// is the number of consecutive frames a backing store may go unused before
+  /// the engine collects it. With 0, backing stores not used in a frame are
+  /// collected before the next frame.
+  size_t backing_store_retained_frames;
+  /// The maximum number of bytes of unused backing stores the engine keeps in
+  /// its pool, assuming 4 bytes per pixel. The least recently used backing
+  /// stores are collected first. 0 means no limit.
+  size_t backing_store_cache_max_bytes;
+  /// If greater than 1, the engine rounds the width and height of the backing
+  /// stores it asks for up to a multiple of this value. Backing stores can
+  /// then be reused when the size of the layers changes slightly, for
+  /// instance while the window is resized. Layers may be smaller than their
+  /// backing store in that case, with their contents in the top left corner.
+  size_t backing_store_size_granularity;
+  /// By default, the contents Flutter renders above each platform view are
+  /// presented in their own layer backed by a backing store. If true, the
+  /// contents above a platform view that intersect neither that platform view
+  /// nor any platform view below it are instead rendered into the root layer,
+  /// as long as doing so does not change the order in which they overlap other
+  /// Flutter contents. This reduces the number of backing stores and layers
+  /// the embedder has to composite, so the layers presented for a frame may
+  /// not correspond one to one to the platform views in it.
+  bool merge_disjoint_overlays;
 } FlutterCompositor;
 
 typedef struct {
@@ -1121,8 +1277,91 @@ typedef struct {
   /// See also:
   /// https://github.com/dart-lang/sdk/blob/ca64509108b3e7219c50d6c52877c85ab6a35ff2/runtime/vm/flag_list.h#L150
   int64_t dart_old_gen_heap_size;
+
+  /// Deliver pointer events to the framework once per frame, with the position
+  /// of moving pointers resampled to a fixed latency before the vsync. This
+  /// smooths out input devices that sample at rates other than the display
+  /// refresh rate. Event timestamps must use the clock of
+  /// `FlutterEngineGetCurrentTime`.
+  bool resample_pointer_events_to_vsync;
 } FlutterProjectArgs;
 
+typedef enum {
+  /// The UI thread took too long to build the frame.
+  kFlutterFrameJankCauseBuild,
+  /// Prerolling the layer tree took too long.
+  kFlutterFrameJankCausePreroll,
+  /// Painting the layer tree took too long.
+  kFlutterFrameJankCausePaint,
+  /// Populating the raster cache took too long.
+  kFlutterFrameJankCauseRasterCache,
+  /// Flushing the frame to the GPU took too long.
+  kFlutterFrameJankCauseGPUFlush,
+  /// New shaders had to be compiled while rasterizing the frame.
+  kFlutterFrameJankCauseShaderCompilation,
+  /// The number of jank causes. Not a valid cause.
+  kFlutterFrameJankCauseCount,
+} FlutterFrameJankCause;
+
+/// Percentiles of a frame phase duration, in nanoseconds. Percentiles are
+/// estimated from a histogram and are accurate to within about 10%.
+typedef struct {
+  uint64_t p50;
+  uint64_t p90;
+  uint64_t p99;
+  uint64_t max;
+} FlutterFrameDurationPercentiles;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameStatistics).
+  size_t struct_size;
+  /// The number of frames rasterized since the statistics were last reset.
+  uint64_t frame_count;
+  /// The number of those frames that missed their deadline.
+  uint64_t missed_frame_count;
+  /// The time taken to build frames on the UI thread.
+  FlutterFrameDurationPercentiles build;
+  /// The time taken to rasterize frames on the GPU thread.
+  FlutterFrameDurationPercentiles raster;
+  /// The time from the vsync signal to the UI thread starting to build frames.
+  FlutterFrameDurationPercentiles vsync_latency;
+  /// The time from the vsync signal to the end of rasterization.
+  FlutterFrameDurationPercentiles total;
+  /// The number of missed frames attributed to each `FlutterFrameJankCause`.
+  uint64_t missed_frame_count_by_cause[kFlutterFrameJankCauseCount];
+} FlutterFrameStatistics;
+
+typedef enum {
+  /// Four 8 bit channels in red, green, blue and alpha order in memory. The
+  /// color channels are premultiplied by alpha.
+  kFlutterSharedMemoryPixelFormatRGBA8888,
+  /// Four 8 bit channels in blue, green, red and alpha order in memory. The
+  /// color channels are premultiplied by alpha.
+  kFlutterSharedMemoryPixelFormatBGRA8888,
+} FlutterSharedMemoryPixelFormat;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterSharedMemoryTextureFrame).
+  size_t struct_size;
+  /// The pixels of the frame. They are drawn without being copied, so they
+  /// must stay valid and unchanged until `release_callback` is called.
+  const void* pixels;
+  /// The width of the frame in pixels.
+  size_t width;
+  /// The height of the frame in pixels.
+  size_t height;
+  /// The number of bytes from the start of one row of pixels to the next.
+  size_t row_bytes;
+  /// The layout of each pixel.
+  FlutterSharedMemoryPixelFormat pixel_format;
+  /// The user data passed to `release_callback`.
+  void* user_data;
+  /// Called once the engine no longer reads the pixels of the frame. Called
+  /// on an internal engine managed thread, or on the thread that pushes a
+  /// frame replacing this one before it was drawn. Required.
+  VoidCallback release_callback;
+} FlutterSharedMemoryTextureFrame;
+
 //------------------------------------------------------------------------------
 /// @brief      Initialize and run a Flutter engine instance and return a handle
 ///             to it. This is a convenience method for the the pair of calls to
@@ -1243,6 +1482,25 @@ FlutterEngineResult FlutterEngineSendPointerEvent(
     const FlutterPointerEvent* events,
     size_t events_count);
 
+//------------------------------------------------------------------------------
+/// @brief      Sends a batch of pointer events to a running engine instance.
+///             Unlike `FlutterEngineSendPointerEvent`, the events are already
+///             in the layout used by the engine, so the batch is handed over
+///             with a single copy instead of being converted field by field.
+///             Embedders with high rate input devices should accumulate events
+///             and send them in batches.
+///
+/// @param[in]  engine  A running engine instance.
+/// @param[in]  batch   The batch of pointer events. The events are copied
+///                     before this call returns.
+///
+/// @return     The result of the call to send the pointer events.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendPointerDataBatch(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPointerDataBatch* batch);
+
 FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
@@ -1396,6 +1654,54 @@ FlutterEngineResult FlutterEngineMarkExternalTextureFrameAvailable(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     int64_t texture_identifier);
 
+//------------------------------------------------------------------------------
+/// @brief      Register a texture whose frames are pixels in memory shared
+///             with the engine, such as the output of a software video
+///             decoder. Unlike external textures, these work with all
+///             rendering backends, and their pixels are drawn without being
+///             copied. Frames are supplied by calling
+///             `FlutterEnginePushSharedMemoryTextureFrame`. The texture is
+///             unregistered by calling
+///             `FlutterEngineUnregisterExternalTexture`.
+///
+/// @see        FlutterEnginePushSharedMemoryTextureFrame()
+/// @see        FlutterEngineUnregisterExternalTexture()
+///
+/// @param[in]  engine              A running engine instance.
+/// @param[in]  texture_identifier  The identifier of the texture to register
+///                                 with the engine.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRegisterSharedMemoryTexture(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier);
+
+//------------------------------------------------------------------------------
+/// @brief      Makes a frame the next one drawn by a shared memory texture and
+///             marks that a new frame is available. May be called on any
+///             thread. A frame pushed before the previous one was drawn
+///             replaces it, and the previous one is released without having
+///             been drawn. Unless `frame` itself is invalid, its release
+///             callback is called once the engine is done with it, including
+///             when the call fails.
+///
+/// @see        FlutterEngineRegisterSharedMemoryTexture()
+///
+/// @param[in]  engine              A running engine instance.
+/// @param[in]  texture_identifier  The identifier of a shared memory texture.
+/// @param[in]  frame               The frame to draw next. Only the pixels it
+///                                 points to are retained.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEnginePushSharedMemoryTextureFrame(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier,
+    const FlutterSharedMemoryTextureFrame* frame);
+
 //------------------------------------------------------------------------------
 /// @brief      Enable or disable accessibility semantics.
 ///
@@ -1667,6 +1973,25 @@ FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
 
+//------------------------------------------------------------------------------
+/// @brief      Gets the frame timing statistics collected by a running engine
+///             instance. Each missed frame is attributed to the phase of the
+///             frame pipeline most likely responsible for it.
+///
+/// @param[in]  engine      A running engine instance.
+/// @param[out] statistics  The statistics. The caller must set the
+///                         `struct_size` field.
+/// @param[in]  reset       Whether to start collecting statistics afresh once
+///                         the current ones have been returned.
+///
+/// @return     The result of the call to get the frame statistics.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFrameStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameStatistics* statistics,
+    bool reset);
+
 #if defined(__cplusplus)
 }  // extern "C"
 #endif
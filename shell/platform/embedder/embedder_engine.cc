@@ -154,7 +154,15 @@ bool EmbedderEngine::RegisterTexture(int64_t texture) {
 }
 
 bool EmbedderEngine::UnregisterTexture(int64_t texture) {
-  if (!IsValid() || !external_texture_callback_) {
+  if (!IsValid()) {
+    return false;
+  }
+  bool was_shared_memory_texture;
+  {
+    std::scoped_lock lock(shared_memory_textures_mutex_);
+    was_shared_memory_texture = shared_memory_textures_.erase(texture) > 0;
+  }
+  if (!was_shared_memory_texture && !external_texture_callback_) {
     return false;
   }
   shell_->GetPlatformView()->UnregisterTexture(texture);
@@ -169,6 +177,50 @@ bool EmbedderEngine::MarkTextureFrameAvailable(int64_t texture) {
   return true;
 }
 
+bool EmbedderEngine::RegisterSharedMemoryTexture(int64_t texture) {
+  if (!IsValid()) {
+    return false;
+  }
+  auto shared_memory_texture = std::make_shared<SharedMemoryTexture>(texture);
+  {
+    std::scoped_lock lock(shared_memory_textures_mutex_);
+    if (!shared_memory_textures_.emplace(texture, shared_memory_texture)
+             .second) {
+      return false;
+    }
+  }
+  shell_->GetPlatformView()->RegisterTexture(std::move(shared_memory_texture));
+  return true;
+}
+
+bool EmbedderEngine::PushSharedMemoryTextureFrame(
+    int64_t texture,
+    const SkPixmap& pixels,
+    const SharedMemoryTexture::ReleaseCallback& release) {
+  if (!IsValid()) {
+    return false;
+  }
+  std::shared_ptr<SharedMemoryTexture> shared_memory_texture;
+  {
+    std::scoped_lock lock(shared_memory_textures_mutex_);
+    auto found = shared_memory_textures_.find(texture);
+    if (found == shared_memory_textures_.end()) {
+      return false;
+    }
+    shared_memory_texture = found->second;
+  }
+  shared_memory_texture->PushFrame(pixels, release);
+  // Textures are only marked on the platform thread.
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetPlatformTaskRunner(),
+      [platform_view = shell_->GetPlatformView(), texture]() {
+        if (platform_view) {
+          platform_view->MarkTextureFrameAvailable(texture);
+        }
+      });
+  return true;
+}
+
 bool EmbedderEngine::SetSemanticsEnabled(bool enabled) {
   if (!IsValid()) {
     return false;
@@ -6,8 +6,10 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_ENGINE_H_
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
+#include "flutter/flow/shared_memory_texture.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/common/shell.h"
 #include "flutter/shell/common/thread_host.h"
@@ -62,6 +64,14 @@ class EmbedderEngine {
 
   bool MarkTextureFrameAvailable(int64_t texture);
 
+  bool RegisterSharedMemoryTexture(int64_t texture);
+
+  // Called on any thread. |release| is not called if this returns false.
+  bool PushSharedMemoryTextureFrame(
+      int64_t texture,
+      const SkPixmap& pixels,
+      const SharedMemoryTexture::ReleaseCallback& release);
+
   bool SetSemanticsEnabled(bool enabled);
 
   bool SetAccessibilityFeatures(int32_t flags);
@@ -90,6 +100,10 @@ class EmbedderEngine {
   std::unique_ptr<Shell> shell_;
   const EmbedderExternalTextureGL::ExternalTextureCallback
       external_texture_callback_;
+  // Frames are pushed on any thread.
+  std::mutex shared_memory_textures_mutex_;
+  std::unordered_map<int64_t, std::shared_ptr<SharedMemoryTexture>>
+      shared_memory_textures_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderEngine);
 };
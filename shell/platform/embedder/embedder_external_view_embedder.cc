@@ -6,17 +6,37 @@
 
 #include <algorithm>
 
+#include "flutter/fml/trace_event.h"
 #include "flutter/shell/platform/embedder/embedder_layers.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
 
 namespace flutter {
 
+static FlutterBackingStoreConfig MakeBackingStoreConfig(
+    const SkISize& backing_store_size) {
+  FlutterBackingStoreConfig config = {};
+
+  config.struct_size = sizeof(config);
+
+  config.size.width = backing_store_size.width();
+  config.size.height = backing_store_size.height();
+
+  return config;
+}
+
 EmbedderExternalViewEmbedder::EmbedderExternalViewEmbedder(
     const CreateRenderTargetCallback& create_render_target_callback,
-    const PresentCallback& present_callback)
-    : create_render_target_callback_(create_render_target_callback),
-      present_callback_(present_callback) {
-  FML_DCHECK(create_render_target_callback_);
+    const PresentCallback& present_callback,
+    const EmbedderRenderTargetCache::Options& render_target_cache_options)
+    : present_callback_(present_callback),
+      render_target_cache_(
+          [create_render_target_callback](GrContext* context,
+                                          const SkISize& size) {
+            return create_render_target_callback(context,
+                                                 MakeBackingStoreConfig(size));
+          },
+          render_target_cache_options) {
+  FML_DCHECK(create_render_target_callback);
   FML_DCHECK(present_callback_);
 }
 
@@ -27,6 +47,16 @@ void EmbedderExternalViewEmbedder::SetSurfaceTransformationCallback(
   surface_transformation_callback_ = surface_transformation_callback;
 }
 
+void EmbedderExternalViewEmbedder::SetMergesDisjointOverlays(
+    bool merges_disjoint_overlays) {
+  merges_disjoint_overlays_ = merges_disjoint_overlays;
+}
+
+EmbedderRenderTargetCache::Statistics
+EmbedderExternalViewEmbedder::GetRenderTargetCacheStatistics() const {
+  return render_target_cache_.GetStatistics();
+}
+
 SkMatrix EmbedderExternalViewEmbedder::GetSurfaceTransformation() const {
   if (!surface_transformation_callback_) {
     return SkMatrix{};
@@ -47,18 +77,6 @@ void EmbedderExternalViewEmbedder::CancelFrame() {
   Reset();
 }
 
-static FlutterBackingStoreConfig MakeBackingStoreConfig(
-    const SkISize& backing_store_size) {
-  FlutterBackingStoreConfig config = {};
-
-  config.struct_size = sizeof(config);
-
-  config.size.width = backing_store_size.width();
-  config.size.height = backing_store_size.height();
-
-  return config;
-}
-
 static SkISize TransformedSurfaceSize(const SkISize& size,
                                       const SkMatrix& transformation) {
   const auto source_rect = SkRect::MakeWH(size.width(), size.height());
@@ -72,6 +90,10 @@ void EmbedderExternalViewEmbedder::BeginFrame(SkISize frame_size,
                                               double device_pixel_ratio) {
   Reset();
 
+  // The render targets used in the last frame may be used for any layer of
+  // this one.
+  render_target_cache_.BeginFrame();
+
   pending_frame_size_ = frame_size;
   pending_device_pixel_ratio_ = device_pixel_ratio;
   pending_surface_transformation_ = GetSurfaceTransformation();
@@ -79,29 +101,9 @@ void EmbedderExternalViewEmbedder::BeginFrame(SkISize frame_size,
   const auto surface_size = TransformedSurfaceSize(
       pending_frame_size_, pending_surface_transformation_);
 
-  // Decide if we want to discard the previous root render target.
-  if (root_render_target_) {
-    auto surface = root_render_target_->GetRenderSurface();
-    // This is unlikely to happen but the embedder could have given the
-    // rasterizer a render target the previous frame that Skia could not
-    // materialize into a renderable surface. Discard the target and try again.
-    if (!surface) {
-      root_render_target_ = nullptr;
-    } else {
-      auto last_surface_size =
-          SkISize::Make(surface->width(), surface->height());
-      if (surface_size != last_surface_size) {
-        root_render_target_ = nullptr;
-      }
-    }
-  }
-
-  // If there is no root render target, create one now.
   // TODO(43778): This should now be moved to be later in the submit call.
-  if (!root_render_target_) {
-    root_render_target_ = create_render_target_callback_(
-        context, MakeBackingStoreConfig(surface_size));
-  }
+  root_render_target_ =
+      render_target_cache_.AcquireRenderTarget(context, surface_size);
 
   root_picture_recorder_ = std::make_unique<SkPictureRecorder>();
   root_picture_recorder_->beginRecording(pending_frame_size_.width(),
@@ -174,9 +176,66 @@ bool EmbedderExternalViewEmbedder::RenderPictureToRenderTarget(
   return true;
 }
 
+// Conservative bounds of a platform view in the coordinate space of the frame.
+static SkRect GetPlatformViewBounds(const EmbeddedViewParams& params,
+                                    double device_pixel_ratio) {
+  // The bounds of the layer presented to the embedder.
+  auto bounds = SkRect::MakeXYWH(
+      params.offsetPixels.x(), params.offsetPixels.y(),
+      params.sizePoints.width() * device_pixel_ratio,
+      params.sizePoints.height() * device_pixel_ratio);
+
+  // The embedder applies the transformation mutations on top of that, which
+  // may place the platform view elsewhere.
+  SkMatrix transformation;
+  const auto& mutators = params.mutatorsStack;
+  for (auto i = mutators.Bottom(); i != mutators.Top(); ++i) {
+    if ((*i)->GetType() == MutatorType::transform) {
+      transformation.postConcat((*i)->GetMatrix());
+    }
+  }
+  bounds.join(transformation.mapRect(SkRect::MakeSize(params.sizePoints)));
+
+  return bounds;
+}
+
+static bool IntersectsAny(const SkRect& bounds,
+                          const std::vector<SkRect>& others) {
+  return std::any_of(others.begin(), others.end(), [&](const SkRect& other) {
+    return SkRect::Intersects(bounds, other);
+  });
+}
+
+std::set<EmbedderExternalViewEmbedder::ViewIdentifier>
+EmbedderExternalViewEmbedder::GetOverlaysToMerge() const {
+  std::set<ViewIdentifier> merged_overlays;
+  std::vector<SkRect> platform_view_bounds;
+  std::vector<SkRect> kept_overlay_bounds;
+
+  for (const auto& view_id : composition_order_) {
+    platform_view_bounds.push_back(GetPlatformViewBounds(
+        pending_params_.at(view_id), pending_device_pixel_ratio_));
+
+    const auto& canvas_spy = pending_canvas_spies_.at(view_id);
+    if (!canvas_spy->DidDrawIntoCanvas()) {
+      // There is no layer for the overlay either way.
+      continue;
+    }
+
+    const auto draw_bounds = canvas_spy->GetDrawBounds();
+    if (IntersectsAny(draw_bounds, platform_view_bounds) ||
+        IntersectsAny(draw_bounds, kept_overlay_bounds)) {
+      kept_overlay_bounds.push_back(draw_bounds);
+    } else {
+      merged_overlays.insert(view_id);
+    }
+  }
+
+  return merged_overlays;
+}
+
 // |ExternalViewEmbedder|
 bool EmbedderExternalViewEmbedder::SubmitFrame(GrContext* context) {
-  Registry render_targets_used;
   EmbedderLayers presented_layers(pending_frame_size_,
                                   pending_device_pixel_ratio_,
                                   pending_surface_transformation_);
@@ -187,10 +246,38 @@ bool EmbedderExternalViewEmbedder::SubmitFrame(GrContext* context) {
     return false;
   }
 
+  std::set<ViewIdentifier> merged_overlays;
+  if (merges_disjoint_overlays_) {
+    TRACE_EVENT0("flutter", "EmbedderExternalViewEmbedder::MergeOverlays");
+    merged_overlays = GetOverlaysToMerge();
+  }
+
+  std::map<ViewIdentifier, sk_sp<SkPicture>> overlay_pictures;
+  for (const auto& view_id : composition_order_) {
+    FML_DCHECK(pending_recorders_.count(view_id) == 1);
+    FML_DCHECK(pending_canvas_spies_.count(view_id) == 1);
+    FML_DCHECK(pending_params_.count(view_id) == 1);
+
+    auto picture = pending_recorders_.at(view_id)->finishRecordingAsPicture();
+    if (!picture) {
+      FML_LOG(ERROR) << "Could not finish recording into the picture before "
+                        "on-screen composition.";
+      return false;
+    }
+
+    if (merged_overlays.count(view_id) == 1) {
+      // Merged overlays are drawn after the contents of the root layer and in
+      // composition order, which is the order in which they overlap.
+      root_picture_recorder_->getRecordingCanvas()->drawPicture(picture);
+    } else {
+      overlay_pictures[view_id] = std::move(picture);
+    }
+  }
+
   // Copy the contents of the root picture recorder onto the root surface.
   if (!RenderPictureToRenderTarget(
           root_picture_recorder_->finishRecordingAsPicture(),
-          root_render_target_.get())) {
+          root_render_target_)) {
     FML_LOG(ERROR) << "Could not render into the the root render target.";
     return false;
   }
@@ -207,22 +294,9 @@ bool EmbedderExternalViewEmbedder::SubmitFrame(GrContext* context) {
       pending_frame_size_, pending_surface_transformation_);
 
   for (const auto& view_id : composition_order_) {
-    FML_DCHECK(pending_recorders_.count(view_id) == 1);
-    FML_DCHECK(pending_canvas_spies_.count(view_id) == 1);
-    FML_DCHECK(pending_params_.count(view_id) == 1);
-
-    const auto& params = pending_params_.at(view_id);
-    auto& recorder = pending_recorders_.at(view_id);
-
-    auto picture = recorder->finishRecordingAsPicture();
-    if (!picture) {
-      FML_LOG(ERROR) << "Could not finish recording into the picture before "
-                        "on-screen composition.";
-      return false;
-    }
-
     // Tell the embedder that a platform view layer is present at this point.
-    presented_layers.PushPlatformViewLayer(view_id, params);
+    presented_layers.PushPlatformViewLayer(view_id,
+                                           pending_params_.at(view_id));
 
     if (!pending_canvas_spies_.at(view_id)->DidDrawIntoCanvas()) {
       // Nothing was drawn into the overlay canvas, we don't need to tell the
@@ -230,31 +304,24 @@ bool EmbedderExternalViewEmbedder::SubmitFrame(GrContext* context) {
       continue;
     }
 
-    const auto backing_store_config = MakeBackingStoreConfig(surface_size);
-
-    RegistryKey registry_key(view_id, backing_store_config);
-
-    auto found_render_target = registry_.find(registry_key);
-
-    // Find a cached render target in the registry. If none exists, ask the
-    // embedder for a new one.
-    std::shared_ptr<EmbedderRenderTarget> render_target;
-    if (found_render_target == registry_.end()) {
-      render_target =
-          create_render_target_callback_(context, backing_store_config);
-    } else {
-      render_target = found_render_target->second;
+    if (merged_overlays.count(view_id) == 1) {
+      // The contents of the overlay were rendered into the root layer.
+      continue;
     }
 
+    // Reuse a render target from the cache if possible. If none exists, the
+    // embedder is asked for a new one.
+    auto* render_target =
+        render_target_cache_.AcquireRenderTarget(context, surface_size);
+
     if (!render_target) {
       FML_LOG(ERROR) << "Could not acquire external render target for "
                         "on-screen composition.";
       return false;
     }
 
-    render_targets_used[registry_key] = render_target;
-
-    if (!RenderPictureToRenderTarget(picture, render_target.get())) {
+    if (!RenderPictureToRenderTarget(overlay_pictures.at(view_id),
+                                     render_target)) {
       FML_LOG(ERROR) << "Could not render into the render target for platform "
                         "view of identifier "
                      << view_id;
@@ -269,10 +336,6 @@ bool EmbedderExternalViewEmbedder::SubmitFrame(GrContext* context) {
   // Flush the layer description down to the embedder for presentation.
   presented_layers.InvokePresentCallback(present_callback_);
 
-  // Keep the previously used render target around in case they are required
-  // next frame.
-  registry_ = std::move(render_targets_used);
-
   return true;
 }
 
@@ -6,12 +6,13 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_VIEW_EMBEDDER_H_
 
 #include <map>
-#include <unordered_map>
+#include <set>
 
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/common/canvas_spy.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
+#include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 
 namespace flutter {
@@ -47,10 +48,15 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///                                     collection of layers (backed by
   ///                                     fulfilled render targets) to the
   ///                                     embedder for presentation.
+  /// @param[in]  render_target_cache_options
+  ///                                     How render targets are pooled for
+  ///                                     reuse across frames.
   ///
   EmbedderExternalViewEmbedder(
       const CreateRenderTargetCallback& create_render_target_callback,
-      const PresentCallback& present_callback);
+      const PresentCallback& present_callback,
+      const EmbedderRenderTargetCache::Options& render_target_cache_options =
+          {});
 
   //----------------------------------------------------------------------------
   /// @brief      Collects the external view embedder.
@@ -68,6 +74,24 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   void SetSurfaceTransformationCallback(
       SurfaceTransformationCallback surface_transformation_callback);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets whether the contents rendered above a platform view are
+  ///             rendered into the root layer instead of a layer of their own
+  ///             when they intersect no platform view below them. Layers that
+  ///             are merged this way don't need a render target and are not
+  ///             presented to the embedder.
+  ///
+  /// @param[in]  merges_disjoint_overlays  Whether to merge overlays that are
+  ///                                       disjoint from the platform views.
+  ///
+  void SetMergesDisjointOverlays(bool merges_disjoint_overlays);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The statistics of the pool of render targets obtained from
+  ///             the embedder. Must be called on the GPU thread.
+  ///
+  EmbedderRenderTargetCache::Statistics GetRenderTargetCacheStatistics() const;
+
  private:
   // |ExternalViewEmbedder|
   void CancelFrame() override;
@@ -96,37 +120,11 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
 
  private:
   using ViewIdentifier = int64_t;
-  struct RegistryKey {
-    ViewIdentifier view_identifier = 0;
-    SkISize size = SkISize::Make(0, 0);
-
-    RegistryKey(ViewIdentifier view_identifier,
-                const FlutterBackingStoreConfig& config)
-        : view_identifier(view_identifier),
-          size(SkISize::Make(config.size.width, config.size.height)) {}
-
-    struct Hash {
-      constexpr std::size_t operator()(RegistryKey const& key) const {
-        return key.view_identifier;
-      };
-    };
-
-    struct Equal {
-      constexpr bool operator()(const RegistryKey& lhs,
-                                const RegistryKey& rhs) const {
-        return lhs.view_identifier == rhs.view_identifier &&
-               lhs.size == rhs.size;
-      }
-    };
-  };
-
-  const CreateRenderTargetCallback create_render_target_callback_;
+
   const PresentCallback present_callback_;
   SurfaceTransformationCallback surface_transformation_callback_;
-  using Registry = std::unordered_map<RegistryKey,
-                                      std::shared_ptr<EmbedderRenderTarget>,
-                                      RegistryKey::Hash,
-                                      RegistryKey::Equal>;
+  bool merges_disjoint_overlays_ = false;
+  EmbedderRenderTargetCache render_target_cache_;
 
   SkISize pending_frame_size_ = SkISize::Make(0, 0);
   double pending_device_pixel_ratio_ = 1.0;
@@ -136,14 +134,28 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   std::map<ViewIdentifier, std::unique_ptr<CanvasSpy>> pending_canvas_spies_;
   std::map<ViewIdentifier, EmbeddedViewParams> pending_params_;
   std::vector<ViewIdentifier> composition_order_;
-  std::shared_ptr<EmbedderRenderTarget> root_render_target_;
+  // Owned by |render_target_cache_| and valid for the current frame only.
+  EmbedderRenderTarget* root_render_target_ = nullptr;
   std::unique_ptr<SkPictureRecorder> root_picture_recorder_;
-  Registry registry_;
 
   void Reset();
 
   SkMatrix GetSurfaceTransformation() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Finds the overlays whose contents can be drawn into the root
+  ///             layer without changing the rendered frame. The contents of an
+  ///             overlay are drawn above the platform view it follows and all
+  ///             layers before it. Drawing them into the root layer instead
+  ///             only puts them under the platform views and overlays they
+  ///             follow, so this is safe if they intersect none of those
+  ///             platform views nor the overlays that are kept.
+  ///
+  /// @return     The identifiers of the platform views whose overlays are
+  ///             merged into the root layer.
+  ///
+  std::set<ViewIdentifier> GetOverlaysToMerge() const;
+
   bool RenderPictureToRenderTarget(
       sk_sp<SkPicture> picture,
       const EmbedderRenderTarget* render_target) const;
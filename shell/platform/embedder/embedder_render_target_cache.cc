@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+EmbedderRenderTargetCache::EmbedderRenderTargetCache(
+    const CreateRenderTargetCallback& create_callback,
+    const Options& options)
+    : create_callback_(create_callback), options_(options) {
+  FML_DCHECK(create_callback_);
+}
+
+EmbedderRenderTargetCache::~EmbedderRenderTargetCache() = default;
+
+SkISize EmbedderRenderTargetCache::GetSizeClass(const SkISize& size) const {
+  const auto granularity =
+      static_cast<int32_t>(std::max<size_t>(options_.size_granularity, 1));
+  auto round_up = [granularity](int32_t value) {
+    return (std::max(value, 0) + granularity - 1) / granularity * granularity;
+  };
+  return SkISize::Make(round_up(size.width()), round_up(size.height()));
+}
+
+void EmbedderRenderTargetCache::BeginFrame() {
+  for (auto& entry : in_use_) {
+    entry.last_used_frame = frame_number_;
+    available_.emplace_back(std::move(entry));
+  }
+  in_use_.clear();
+
+  for (auto it = available_.begin(); it != available_.end();) {
+    if (frame_number_ - it->last_used_frame > options_.retained_frames) {
+      Collect(std::move(*it));
+      it = available_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  // Everything is available at this point so the cap applies to all the
+  // cached render targets.
+  if (options_.max_bytes > 0) {
+    while (!available_.empty() &&
+           statistics_.cached_bytes > options_.max_bytes) {
+      Collect(std::move(available_.front()));
+      available_.pop_front();
+    }
+  }
+
+  frame_number_++;
+
+  TraceStatistics();
+}
+
+EmbedderRenderTarget* EmbedderRenderTargetCache::AcquireRenderTarget(
+    GrContext* context,
+    const SkISize& size) {
+  const auto size_class = GetSizeClass(size);
+
+  // Prefer the most recently used render target of the size class.
+  for (auto it = available_.rbegin(); it != available_.rend(); ++it) {
+    if (it->size_class == size_class) {
+      in_use_.emplace_back(std::move(*it));
+      available_.erase(std::next(it).base());
+      statistics_.reused_count++;
+      return in_use_.back().render_target.get();
+    }
+  }
+
+  TRACE_EVENT0("flutter", "EmbedderRenderTargetCache::CreateRenderTarget");
+  auto render_target = create_callback_(context, size_class);
+  if (!render_target) {
+    return nullptr;
+  }
+
+  Entry entry;
+  entry.render_target = std::move(render_target);
+  entry.size_class = size_class;
+  // Assumes 4 bytes per pixel, which is what all the backing store types the
+  // embedder API supports use.
+  entry.bytes =
+      static_cast<size_t>(size_class.width()) * size_class.height() * 4;
+  statistics_.created_count++;
+  statistics_.cached_count++;
+  statistics_.cached_bytes += entry.bytes;
+  in_use_.emplace_back(std::move(entry));
+  return in_use_.back().render_target.get();
+}
+
+void EmbedderRenderTargetCache::Clear() {
+  for (auto& entry : in_use_) {
+    Collect(std::move(entry));
+  }
+  in_use_.clear();
+  for (auto& entry : available_) {
+    Collect(std::move(entry));
+  }
+  available_.clear();
+}
+
+EmbedderRenderTargetCache::Statistics EmbedderRenderTargetCache::GetStatistics()
+    const {
+  return statistics_;
+}
+
+void EmbedderRenderTargetCache::Collect(Entry entry) {
+  statistics_.collected_count++;
+  statistics_.cached_count--;
+  statistics_.cached_bytes -= entry.bytes;
+  // The embedder is asked to collect the backing store when the render target
+  // is destroyed.
+  entry.render_target.reset();
+}
+
+void EmbedderRenderTargetCache::TraceStatistics() const {
+  FML_TRACE_COUNTER("flutter", "EmbedderBackingStores",
+                    reinterpret_cast<int64_t>(this),                 //
+                    "Created", statistics_.created_count,            //
+                    "Reused", statistics_.reused_count,              //
+                    "Collected", statistics_.collected_count,        //
+                    "CachedCount", statistics_.cached_count,         //
+                    "CachedMBytes", statistics_.cached_bytes * 1e-6  //
+  );
+}
+
+}  // namespace flutter
@@ -0,0 +1,127 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/shell/platform/embedder/embedder_render_target.h"
+#include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/gpu/GrContext.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A pool of the render targets the engine obtained from the
+///             embedder. Render targets are interchangeable as long as they
+///             are of the same size since their contents are redrawn each
+///             frame. So instead of being tied to the layer or platform view
+///             they were created for, render targets are returned to the pool
+///             at the start of the next frame and may be handed out for any
+///             layer of the same size class.
+///
+///             Render targets that have not been used for a number of frames
+///             are collected, as are the least recently used ones once the
+///             pool holds more than its memory cap.
+///
+class EmbedderRenderTargetCache {
+ public:
+  using CreateRenderTargetCallback =
+      std::function<std::unique_ptr<EmbedderRenderTarget>(
+          GrContext* context,
+          const SkISize& size)>;
+
+  struct Options {
+    // The number of consecutive frames a render target may go unused before
+    // it is collected. With 0, render targets not used in a frame are
+    // collected before the next one.
+    size_t retained_frames = 0;
+    // The maximum number of bytes of unused render targets kept in the pool.
+    // 0 means no limit.
+    size_t max_bytes = 0;
+    // Render target sizes are rounded up to a multiple of this so that render
+    // targets can be reused across small size changes. 1 means sizes are not
+    // rounded.
+    size_t size_granularity = 1;
+  };
+
+  struct Statistics {
+    // The number of render targets the embedder was asked to create.
+    size_t created_count = 0;
+    // The number of render targets handed out from the pool.
+    size_t reused_count = 0;
+    // The number of render targets handed back to the embedder.
+    size_t collected_count = 0;
+    // The render targets currently held by the cache, in use or not.
+    size_t cached_count = 0;
+    size_t cached_bytes = 0;
+  };
+
+  EmbedderRenderTargetCache(const CreateRenderTargetCallback& create_callback,
+                            const Options& options);
+
+  ~EmbedderRenderTargetCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the render targets used in the previous frame to the
+  ///             pool and collects the ones that are past their retention or
+  ///             over the memory cap. Must be called at the start of every
+  ///             frame.
+  ///
+  void BeginFrame();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gets a render target for the current frame, from the pool if
+  ///             possible or else from the embedder.
+  ///
+  /// @param[in]  context  The context to create new render targets with.
+  /// @param[in]  size     The minimum size of the render target. The render
+  ///                      target is the size of the size class of |size|.
+  ///
+  /// @return     The render target, or null if the embedder could not create
+  ///             one. It remains valid until the next call to |BeginFrame|.
+  ///
+  EmbedderRenderTarget* AcquireRenderTarget(GrContext* context,
+                                            const SkISize& size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Collects all render targets, including the ones in use.
+  ///
+  void Clear();
+
+  SkISize GetSizeClass(const SkISize& size) const;
+
+  Statistics GetStatistics() const;
+
+ private:
+  struct Entry {
+    std::unique_ptr<EmbedderRenderTarget> render_target;
+    SkISize size_class;
+    size_t bytes = 0;
+    size_t last_used_frame = 0;
+  };
+
+  const CreateRenderTargetCallback create_callback_;
+  const Options options_;
+  size_t frame_number_ = 0;
+  // Ordered from least to most recently used.
+  std::list<Entry> available_;
+  std::vector<Entry> in_use_;
+  Statistics statistics_;
+
+  void Collect(Entry entry);
+
+  void TraceStatistics() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTargetCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
@@ -11,10 +11,13 @@ namespace flutter {
 
 EmbedderSurfaceSoftware::EmbedderSurfaceSoftware(
     SoftwareDispatchTable software_dispatch_table,
-    std::unique_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
+    std::unique_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+    size_t raster_thread_count)
     : software_dispatch_table_(software_dispatch_table),
-      external_view_embedder_(std::move(external_view_embedder)) {
-  if (!software_dispatch_table_.software_present_backing_store) {
+      external_view_embedder_(std::move(external_view_embedder)),
+      raster_thread_count_(raster_thread_count) {
+  if (!software_dispatch_table_.software_present_backing_store &&
+      !UsesEmbedderBuffers()) {
     return;
   }
   valid_ = true;
@@ -22,6 +25,12 @@ EmbedderSurfaceSoftware::EmbedderSurfaceSoftware(
 
 EmbedderSurfaceSoftware::~EmbedderSurfaceSoftware() = default;
 
+bool EmbedderSurfaceSoftware::UsesEmbedderBuffers() const {
+  return software_dispatch_table_.software_acquire_buffer &&
+         software_dispatch_table_.software_present_buffer &&
+         software_dispatch_table_.software_release_buffer;
+}
+
 // |EmbedderSurface|
 bool EmbedderSurfaceSoftware::IsValid() const {
   return valid_;
@@ -33,7 +42,8 @@ std::unique_ptr<Surface> EmbedderSurfaceSoftware::CreateGPUSurface() {
     return nullptr;
   }
   const bool render_to_surface = !external_view_embedder_;
-  auto surface = std::make_unique<GPUSurfaceSoftware>(this, render_to_surface);
+  auto surface = std::make_unique<GPUSurfaceSoftware>(this, render_to_surface,
+                                                      raster_thread_count_);
 
   if (!surface->IsValid()) {
     return nullptr;
@@ -57,6 +67,10 @@ sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireBackingStore(
     return nullptr;
   }
 
+  if (UsesEmbedderBuffers()) {
+    return AcquireEmbedderBuffer(size);
+  }
+
   if (sk_surface_ != nullptr &&
       SkISize::Make(sk_surface_->width(), sk_surface_->height()) == size) {
     // The old and new surface sizes are the same. Nothing to do here.
@@ -83,6 +97,10 @@ bool EmbedderSurfaceSoftware::PresentBackingStore(
     return false;
   }
 
+  if (UsesEmbedderBuffers()) {
+    return PresentEmbedderBuffer(backing_store);
+  }
+
   SkPixmap pixmap;
   if (!backing_store->peekPixels(&pixmap)) {
     FML_LOG(ERROR) << "Could not peek the pixels of the backing store.";
@@ -106,6 +124,76 @@ bool EmbedderSurfaceSoftware::PresentBackingStore(
   );
 }
 
+sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireEmbedderBuffer(
+    const SkISize& size) {
+  auto acquired = std::make_shared<AcquiredBuffer>();
+  acquired->buffer.struct_size = sizeof(FlutterSoftwareBuffer);
+  acquired->release = software_dispatch_table_.software_release_buffer;
+  if (!software_dispatch_table_.software_acquire_buffer(size,
+                                                        &acquired->buffer)) {
+    FML_LOG(ERROR) << "The embedder could not provide a software buffer.";
+    return nullptr;
+  }
+
+  const auto& buffer = acquired->buffer;
+  const size_t min_row_bytes = static_cast<size_t>(size.width()) * 4;
+  if (buffer.allocation == nullptr || buffer.row_bytes < min_row_bytes ||
+      buffer.height != static_cast<size_t>(size.height())) {
+    FML_LOG(ERROR) << "The embedder provided an invalid software buffer.";
+    acquired->release(buffer);
+    return nullptr;
+  }
+
+  // The surface keeps a reference to the buffer until it is collected. That
+  // may happen after the buffer was presented, in which case the embedder
+  // already owns it again.
+  SkImageInfo info = SkImageInfo::MakeN32(
+      size.fWidth, size.fHeight, kPremul_SkAlphaType, SkColorSpace::MakeSRGB());
+  auto surface = SkSurface::MakeRasterDirectReleaseProc(
+      info, buffer.allocation, buffer.row_bytes,
+      [](void* pixels, void* context) {
+        auto acquired = reinterpret_cast<std::shared_ptr<AcquiredBuffer>*>(
+            context);
+        if (!(*acquired)->presented) {
+          (*acquired)->release((*acquired)->buffer);
+        }
+        delete acquired;
+      },
+      new std::shared_ptr<AcquiredBuffer>(acquired));
+
+  if (surface == nullptr) {
+    // The release proc is only adopted by surfaces that could be created.
+    FML_LOG(ERROR) << "Could not wrap the software buffer in a surface.";
+    acquired->release(buffer);
+    return nullptr;
+  }
+
+  acquired->surface = surface.get();
+  acquired_buffer_ = std::move(acquired);
+  return surface;
+}
+
+bool EmbedderSurfaceSoftware::PresentEmbedderBuffer(
+    const sk_sp<SkSurface>& backing_store) {
+  auto acquired = std::move(acquired_buffer_);
+  if (!acquired || acquired->surface != backing_store.get()) {
+    FML_LOG(ERROR) << "Tried to present a software buffer that was not the "
+                      "last one acquired.";
+    return false;
+  }
+
+  // The buffer goes back to the embedder whether or not presenting succeeds.
+  acquired->presented = true;
+  const FlutterRect damage = {
+      0,                                             // left
+      0,                                             // top
+      static_cast<double>(backing_store->width()),   // right
+      static_cast<double>(backing_store->height()),  // bottom
+  };
+  return software_dispatch_table_.software_present_buffer(acquired->buffer,
+                                                          &damage, 1u);
+}
+
 // |GPUSurfaceSoftwareDelegate|
 ExternalViewEmbedder* EmbedderSurfaceSoftware::GetExternalViewEmbedder() {
   return external_view_embedder_.get();
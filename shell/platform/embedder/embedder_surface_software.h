@@ -5,8 +5,12 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 
+#include <functional>
+#include <memory>
+
 #include "flutter/fml/macros.h"
 #include "flutter/shell/gpu/gpu_surface_software.h"
+#include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
 #include "flutter/shell/platform/embedder/embedder_surface.h"
 
@@ -17,20 +21,50 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
  public:
   struct SoftwareDispatchTable {
     std::function<bool(const void* allocation, size_t row_bytes, size_t height)>
-        software_present_backing_store;  // required
+        software_present_backing_store;  // required unless using buffers
+    // If these are specified, frames are rendered directly into buffers
+    // provided by the embedder instead of being copied out of a buffer owned
+    // by the engine. All three must be specified together.
+    std::function<bool(const SkISize& size, FlutterSoftwareBuffer* buffer)>
+        software_acquire_buffer;  // optional
+    std::function<bool(const FlutterSoftwareBuffer& buffer,
+                       const FlutterRect* damage_rects,
+                       size_t damage_rects_count)>
+        software_present_buffer;  // optional
+    std::function<void(const FlutterSoftwareBuffer& buffer)>
+        software_release_buffer;  // optional
   };
 
   EmbedderSurfaceSoftware(
       SoftwareDispatchTable software_dispatch_table,
-      std::unique_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
+      std::unique_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+      size_t raster_thread_count = 1);
 
   ~EmbedderSurfaceSoftware() override;
 
  private:
+  // A buffer provided by the embedder that is being rendered into. Shared with
+  // the release proc of the surface wrapping it, which hands the buffer back
+  // to the embedder if the frame is dropped instead of presented.
+  struct AcquiredBuffer {
+    FlutterSoftwareBuffer buffer = {};
+    std::function<void(const FlutterSoftwareBuffer& buffer)> release;
+    const SkSurface* surface = nullptr;
+    bool presented = false;
+  };
+
   bool valid_ = false;
   SoftwareDispatchTable software_dispatch_table_;
   sk_sp<SkSurface> sk_surface_;
+  std::shared_ptr<AcquiredBuffer> acquired_buffer_;
   std::unique_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
+  const size_t raster_thread_count_;
+
+  bool UsesEmbedderBuffers() const;
+
+  sk_sp<SkSurface> AcquireEmbedderBuffer(const SkISize& size);
+
+  bool PresentEmbedderBuffer(const sk_sp<SkSurface>& backing_store);
 
   // |EmbedderSurface|
   bool IsValid() const override;
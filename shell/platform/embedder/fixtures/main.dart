@@ -349,6 +349,35 @@ void can_composite_platform_views_with_platform_layer_on_bottom() {
   window.scheduleFrame();
 }
 
+@pragma('vm:entry-point')
+void can_merge_disjoint_overlays() {
+  window.onBeginFrame = (Duration duration) {
+    Color red = Color.fromARGB(255, 255, 0, 0);
+    Color blue = Color.fromARGB(255, 0, 0, 255);
+    Size size = Size(200.0, 200.0);
+
+    SceneBuilder builder = SceneBuilder();
+
+    builder.addPlatformView(1, width: size.width, height: size.height);
+
+    // Intersects no platform view.
+    builder.addPicture(Offset(0.0, 300.0), CreateColoredBox(red, Size(100.0, 100.0)));
+
+    builder.pushOffset(400.0, 0.0);
+    builder.addPlatformView(2, width: size.width, height: size.height);
+    builder.pop();
+
+    // Intersects the second platform view.
+    builder.addPicture(Offset(450.0, 50.0), CreateColoredBox(blue, Size(50.0, 50.0)));
+
+    window.render(builder.build());
+
+    signalNativeTest(); // Signal 2
+  };
+  signalNativeTest(); // Signal 1
+  window.scheduleFrame();
+}
+
 @pragma('vm:entry-point')
 void can_render_scene_without_custom_compositor() {
   window.onBeginFrame = (Duration duration) {
@@ -25,11 +25,13 @@ PlatformViewEmbedder::PlatformViewEmbedder(
     flutter::TaskRunners task_runners,
     EmbedderSurfaceSoftware::SoftwareDispatchTable software_dispatch_table,
     PlatformDispatchTable platform_dispatch_table,
-    std::unique_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
+    std::unique_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+    size_t raster_thread_count)
     : PlatformView(delegate, std::move(task_runners)),
       embedder_surface_(std::make_unique<EmbedderSurfaceSoftware>(
           software_dispatch_table,
-          std::move(external_view_embedder))),
+          std::move(external_view_embedder),
+          raster_thread_count)),
       platform_dispatch_table_(platform_dispatch_table) {}
 
 PlatformViewEmbedder::~PlatformViewEmbedder() = default;
@@ -50,7 +50,8 @@ class PlatformViewEmbedder final : public PlatformView {
       flutter::TaskRunners task_runners,
       EmbedderSurfaceSoftware::SoftwareDispatchTable software_dispatch_table,
       PlatformDispatchTable platform_dispatch_table,
-      std::unique_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
+      std::unique_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+      size_t raster_thread_count = 1);
 
   ~PlatformViewEmbedder() override;
 
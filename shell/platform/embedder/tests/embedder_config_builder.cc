@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/embedder/tests/embedder_config_builder.h"
 
+#include <cstdlib>
+
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 
@@ -100,6 +102,41 @@ void EmbedderConfigBuilder::SetSoftwareRendererConfig(SkISize surface_size) {
   context_.SetupOpenGLSurface(surface_size);
 }
 
+void EmbedderConfigBuilder::SetSoftwareRendererBufferConfig(
+    SkISize surface_size) {
+  SetSoftwareRendererConfig(surface_size);
+
+  auto& software_config = renderer_config_.software;
+  software_config.surface_present_callback = nullptr;
+  software_config.acquire_buffer_callback =
+      [](void* context, size_t width, size_t height,
+         FlutterSoftwareBuffer* buffer) {
+        buffer->row_bytes = width * 4;
+        buffer->height = height;
+        buffer->allocation = ::malloc(buffer->row_bytes * height);
+        return buffer->allocation != nullptr;
+      };
+  software_config.present_buffer_callback =
+      [](void* context, const FlutterSoftwareBuffer* buffer,
+         const FlutterRect* damage_rects, size_t damage_rects_count) {
+        auto image_info = SkImageInfo::MakeN32Premul(
+            SkISize::Make(buffer->row_bytes / 4, buffer->height));
+        auto image = SkImage::MakeRasterCopy(
+            SkPixmap(image_info, buffer->allocation, buffer->row_bytes));
+        ::free(buffer->allocation);
+        if (damage_rects == nullptr || damage_rects_count == 0) {
+          FML_LOG(ERROR) << "The engine did not specify the damaged area.";
+          return false;
+        }
+        return reinterpret_cast<EmbedderTestContext*>(context)->SofwarePresent(
+            std::move(image));
+      };
+  software_config.release_buffer_callback =
+      [](void* context, const FlutterSoftwareBuffer* buffer) {
+        ::free(buffer->allocation);
+      };
+}
+
 void EmbedderConfigBuilder::SetOpenGLRendererConfig(SkISize surface_size) {
   renderer_config_.type = FlutterRendererType::kOpenGL;
   renderer_config_.open_gl = opengl_renderer_config_;
@@ -45,6 +45,11 @@ class EmbedderConfigBuilder {
 
   void SetSoftwareRendererConfig(SkISize surface_size = SkISize::Make(1, 1));
 
+  // Like |SetSoftwareRendererConfig| but the engine renders into buffers
+  // provided by the test instead of buffers it owns.
+  void SetSoftwareRendererBufferConfig(
+      SkISize surface_size = SkISize::Make(1, 1));
+
   void SetOpenGLRendererConfig(SkISize surface_size);
 
   void SetAssetsPath();
@@ -0,0 +1,169 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+// Creates raster render targets and keeps track of how many are alive.
+class RenderTargetFactory {
+ public:
+  EmbedderRenderTargetCache::CreateRenderTargetCallback GetCallback() {
+    return [this](GrContext* context, const SkISize& size) {
+      sizes_.push_back(size);
+      live_count_++;
+      FlutterBackingStore backing_store = {};
+      backing_store.struct_size = sizeof(backing_store);
+      backing_store.type = kFlutterBackingStoreTypeSoftware;
+      return std::make_unique<EmbedderRenderTarget>(
+          backing_store,
+          SkSurface::MakeRasterN32Premul(size.width(), size.height()),
+          [this]() { live_count_--; });
+    };
+  }
+
+  size_t GetLiveCount() const { return live_count_; }
+
+  const std::vector<SkISize>& GetCreatedSizes() const { return sizes_; }
+
+ private:
+  size_t live_count_ = 0;
+  std::vector<SkISize> sizes_;
+};
+
+TEST(EmbedderRenderTargetCacheTest, ReusesRenderTargetsOfTheSameSize) {
+  RenderTargetFactory factory;
+  EmbedderRenderTargetCache cache(factory.GetCallback(), {});
+  const auto size = SkISize::Make(800, 600);
+
+  cache.BeginFrame();
+  auto* first = cache.AcquireRenderTarget(nullptr, size);
+  auto* second = cache.AcquireRenderTarget(nullptr, size);
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  ASSERT_NE(first, second);
+
+  cache.BeginFrame();
+  auto* third = cache.AcquireRenderTarget(nullptr, size);
+  auto* fourth = cache.AcquireRenderTarget(nullptr, size);
+  ASSERT_TRUE((third == first && fourth == second) ||
+              (third == second && fourth == first));
+
+  const auto statistics = cache.GetStatistics();
+  ASSERT_EQ(statistics.created_count, 2u);
+  ASSERT_EQ(statistics.reused_count, 2u);
+  ASSERT_EQ(statistics.collected_count, 0u);
+  ASSERT_EQ(statistics.cached_count, 2u);
+  ASSERT_EQ(statistics.cached_bytes, 2u * 800u * 600u * 4u);
+  ASSERT_EQ(factory.GetLiveCount(), 2u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, CollectsRenderTargetsPastRetention) {
+  RenderTargetFactory factory;
+  EmbedderRenderTargetCache::Options options;
+  options.retained_frames = 2;
+  EmbedderRenderTargetCache cache(factory.GetCallback(), options);
+
+  cache.BeginFrame();
+  ASSERT_NE(cache.AcquireRenderTarget(nullptr, SkISize::Make(10, 10)),
+            nullptr);
+
+  cache.BeginFrame();
+
+  // Unused for one and then two frames.
+  cache.BeginFrame();
+  ASSERT_EQ(factory.GetLiveCount(), 1u);
+  cache.BeginFrame();
+  ASSERT_EQ(factory.GetLiveCount(), 1u);
+
+  // Unused for three frames.
+  cache.BeginFrame();
+  ASSERT_EQ(factory.GetLiveCount(), 0u);
+  ASSERT_EQ(cache.GetStatistics().collected_count, 1u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, WithoutRetentionOnlyKeepsTargetsJustUsed) {
+  RenderTargetFactory factory;
+  EmbedderRenderTargetCache cache(factory.GetCallback(), {});
+
+  cache.BeginFrame();
+  cache.AcquireRenderTarget(nullptr, SkISize::Make(10, 10));
+  cache.AcquireRenderTarget(nullptr, SkISize::Make(20, 20));
+
+  cache.BeginFrame();
+  cache.AcquireRenderTarget(nullptr, SkISize::Make(10, 10));
+  ASSERT_EQ(factory.GetLiveCount(), 2u);
+
+  // The 20x20 target went unused for a frame.
+  cache.BeginFrame();
+  ASSERT_EQ(factory.GetLiveCount(), 1u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, EvictsLeastRecentlyUsedOverTheCap) {
+  RenderTargetFactory factory;
+  EmbedderRenderTargetCache::Options options;
+  options.retained_frames = 100;
+  // Room for two 10x10 targets.
+  options.max_bytes = 2 * 10 * 10 * 4;
+  EmbedderRenderTargetCache cache(factory.GetCallback(), options);
+
+  cache.BeginFrame();
+  cache.AcquireRenderTarget(nullptr, SkISize::Make(10, 10));
+  cache.BeginFrame();
+  auto* wide = cache.AcquireRenderTarget(nullptr, SkISize::Make(20, 5));
+  auto* tall = cache.AcquireRenderTarget(nullptr, SkISize::Make(5, 20));
+  // Targets in use are never collected, even over the cap.
+  ASSERT_EQ(factory.GetLiveCount(), 3u);
+
+  cache.BeginFrame();
+  ASSERT_EQ(factory.GetLiveCount(), 2u);
+  ASSERT_EQ(cache.GetStatistics().cached_bytes, options.max_bytes);
+
+  // The most recently used targets were kept.
+  ASSERT_EQ(cache.AcquireRenderTarget(nullptr, SkISize::Make(20, 5)), wide);
+  ASSERT_EQ(cache.AcquireRenderTarget(nullptr, SkISize::Make(5, 20)), tall);
+  cache.AcquireRenderTarget(nullptr, SkISize::Make(10, 10));
+  ASSERT_EQ(cache.GetStatistics().created_count, 4u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, ReusesRenderTargetsOfTheSameSizeClass) {
+  RenderTargetFactory factory;
+  EmbedderRenderTargetCache::Options options;
+  options.size_granularity = 64;
+  EmbedderRenderTargetCache cache(factory.GetCallback(), options);
+  ASSERT_EQ(cache.GetSizeClass(SkISize::Make(800, 600)),
+            SkISize::Make(832, 640));
+
+  cache.BeginFrame();
+  auto* first = cache.AcquireRenderTarget(nullptr, SkISize::Make(800, 600));
+  cache.BeginFrame();
+  auto* second = cache.AcquireRenderTarget(nullptr, SkISize::Make(810, 620));
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(factory.GetCreatedSizes().size(), 1u);
+  ASSERT_EQ(factory.GetCreatedSizes()[0], SkISize::Make(832, 640));
+}
+
+TEST(EmbedderRenderTargetCacheTest, ClearCollectsAllRenderTargets) {
+  RenderTargetFactory factory;
+  EmbedderRenderTargetCache::Options options;
+  options.retained_frames = 100;
+  EmbedderRenderTargetCache cache(factory.GetCallback(), options);
+
+  cache.BeginFrame();
+  cache.AcquireRenderTarget(nullptr, SkISize::Make(10, 10));
+  cache.BeginFrame();
+  cache.AcquireRenderTarget(nullptr, SkISize::Make(20, 20));
+  ASSERT_EQ(factory.GetLiveCount(), 2u);
+
+  cache.Clear();
+  ASSERT_EQ(factory.GetLiveCount(), 0u);
+  ASSERT_EQ(cache.GetStatistics().cached_count, 0u);
+  ASSERT_EQ(cache.GetStatistics().cached_bytes, 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
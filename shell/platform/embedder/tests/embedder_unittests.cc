@@ -1796,6 +1796,106 @@ TEST_F(EmbedderTest, CompositorMustBeAbleToRenderWithPlatformLayerOnBottom) {
   ASSERT_EQ(context.GetCompositor().GetBackingStoresCount(), 1u);
 }
 
+//------------------------------------------------------------------------------
+/// Overlays that intersect no platform view below them must be merged into the
+/// root layer when the embedder opts into it.
+///
+TEST_F(EmbedderTest, CompositorMergesDisjointOverlaysIntoRootLayer) {
+  auto& context = GetEmbedderContext();
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(800, 600));
+  builder.SetCompositor();
+  builder.GetCompositor().merge_disjoint_overlays = true;
+  builder.SetDartEntrypoint("can_merge_disjoint_overlays");
+
+  context.GetCompositor().SetRenderTargetType(
+      EmbedderTestCompositor::RenderTargetType::kOpenGLTexture);
+
+  fml::CountDownLatch latch(3);
+  context.GetCompositor().SetNextPresentCallback(
+      [&](const FlutterLayer** layers, size_t layers_count) {
+        // The overlay of the first platform view is in the root layer.
+        ASSERT_EQ(layers_count, 4u);
+        ASSERT_EQ(layers[0]->type, kFlutterLayerContentTypeBackingStore);
+        ASSERT_EQ(layers[1]->type, kFlutterLayerContentTypePlatformView);
+        ASSERT_EQ(layers[1]->platform_view->identifier, 1);
+        ASSERT_EQ(layers[2]->type, kFlutterLayerContentTypePlatformView);
+        ASSERT_EQ(layers[2]->platform_view->identifier, 2);
+        ASSERT_EQ(layers[3]->type, kFlutterLayerContentTypeBackingStore);
+        latch.CountDown();
+      });
+
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&latch](Dart_NativeArguments args) { latch.CountDown(); }));
+
+  auto engine = builder.LaunchEngine();
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  ASSERT_TRUE(engine.is_valid());
+
+  latch.Wait();
+
+  ASSERT_EQ(context.GetCompositor().GetBackingStoresCount(), 2u);
+}
+
+//------------------------------------------------------------------------------
+/// Without opting into merging, every overlay that was drawn into gets a layer.
+///
+TEST_F(EmbedderTest, CompositorDoesNotMergeOverlaysByDefault) {
+  auto& context = GetEmbedderContext();
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(800, 600));
+  builder.SetCompositor();
+  builder.SetDartEntrypoint("can_merge_disjoint_overlays");
+
+  context.GetCompositor().SetRenderTargetType(
+      EmbedderTestCompositor::RenderTargetType::kOpenGLTexture);
+
+  fml::CountDownLatch latch(3);
+  context.GetCompositor().SetNextPresentCallback(
+      [&](const FlutterLayer** layers, size_t layers_count) {
+        ASSERT_EQ(layers_count, 5u);
+        ASSERT_EQ(layers[0]->type, kFlutterLayerContentTypeBackingStore);
+        ASSERT_EQ(layers[1]->type, kFlutterLayerContentTypePlatformView);
+        ASSERT_EQ(layers[2]->type, kFlutterLayerContentTypeBackingStore);
+        ASSERT_EQ(layers[3]->type, kFlutterLayerContentTypePlatformView);
+        ASSERT_EQ(layers[4]->type, kFlutterLayerContentTypeBackingStore);
+        latch.CountDown();
+      });
+
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&latch](Dart_NativeArguments args) { latch.CountDown(); }));
+
+  auto engine = builder.LaunchEngine();
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  ASSERT_TRUE(engine.is_valid());
+
+  latch.Wait();
+
+  ASSERT_EQ(context.GetCompositor().GetBackingStoresCount(), 3u);
+}
+
 //------------------------------------------------------------------------------
 /// Test the layer structure and pixels rendered when using a custom compositor
 /// with a root surface transformation.
@@ -2033,6 +2133,34 @@ TEST_F(EmbedderTest, CanRenderSceneWithoutCustomCompositorWithTransformation) {
       "scene_without_custom_compositor_with_xform.png", renderered_scene));
 }
 
+TEST_F(EmbedderTest, CanRenderIntoSoftwareBuffersProvidedByEmbedder) {
+  auto& context = GetEmbedderContext();
+
+  EmbedderConfigBuilder builder(context);
+
+  builder.SetDartEntrypoint("can_render_scene_without_custom_compositor");
+  builder.SetSoftwareRendererBufferConfig(SkISize::Make(800, 600));
+
+  auto renderered_scene = context.GetNextSceneImage();
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  auto image = renderered_scene.get();
+  ASSERT_TRUE(image);
+  ASSERT_EQ(image->width(), 800);
+  ASSERT_EQ(image->height(), 600);
+}
+
 TEST_F(EmbedderTest, CanRenderGradientWithoutCompositor) {
   auto& context = GetEmbedderContext();
 
@@ -3904,5 +4032,137 @@ TEST_F(EmbedderTest, CanSendLowMemoryNotification) {
   ASSERT_EQ(FlutterEngineNotifyLowMemoryWarning(engine.get()), kSuccess);
 }
 
+TEST_F(EmbedderTest, CanSendPointerDataBatch) {
+  auto& context = GetEmbedderContext();
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterPointerData events[3] = {};
+  events[0].change = kFlutterPointerDataChangeAdd;
+  events[1].change = kFlutterPointerDataChangeHover;
+  events[1].physical_x = 1.0;
+  events[2].change = kFlutterPointerDataChangeHover;
+  events[2].physical_x = 2.0;
+  for (auto& event : events) {
+    event.kind = kFlutterPointerDataDeviceKindMouse;
+  }
+
+  FlutterPointerDataBatch batch = {};
+  batch.struct_size = sizeof(FlutterPointerDataBatch);
+  batch.events = events;
+  batch.events_count = 3;
+  ASSERT_EQ(FlutterEngineSendPointerDataBatch(engine.get(), &batch), kSuccess);
+
+  batch.flags = kFlutterPointerDataBatchFlagCoalesceMoves;
+  ASSERT_EQ(FlutterEngineSendPointerDataBatch(engine.get(), &batch), kSuccess);
+
+  events[2].change = 42;
+  ASSERT_EQ(FlutterEngineSendPointerDataBatch(engine.get(), &batch),
+            kInvalidArguments);
+
+  batch.events_count = 0;
+  ASSERT_EQ(FlutterEngineSendPointerDataBatch(engine.get(), &batch),
+            kInvalidArguments);
+
+  ASSERT_EQ(FlutterEngineSendPointerDataBatch(engine.get(), nullptr),
+            kInvalidArguments);
+}
+
+TEST_F(EmbedderTest, CanGetFrameStatistics) {
+  auto& context = GetEmbedderContext();
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterFrameStatistics statistics = {};
+  ASSERT_EQ(FlutterEngineGetFrameStatistics(engine.get(), &statistics, false),
+            kInvalidArguments);
+
+  statistics.struct_size = sizeof(FlutterFrameStatistics);
+  ASSERT_EQ(FlutterEngineGetFrameStatistics(engine.get(), &statistics, true),
+            kSuccess);
+  ASSERT_LE(statistics.missed_frame_count, statistics.frame_count);
+  ASSERT_LE(statistics.total.p50, statistics.total.max);
+
+  ASSERT_EQ(FlutterEngineGetFrameStatistics(nullptr, &statistics, false),
+            kInvalidArguments);
+}
+
+TEST_F(EmbedderTest, SharedMemoryTexturesReleaseTheirFrames) {
+  auto& context = GetEmbedderContext();
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+
+  struct Frame {
+    uint32_t pixels[4] = {};
+    fml::AutoResetWaitableEvent released;
+  };
+  Frame first_frame;
+  Frame second_frame;
+  Frame unregistered_frame;
+  auto make_frame = [](Frame& frame) {
+    FlutterSharedMemoryTextureFrame texture_frame = {};
+    texture_frame.struct_size = sizeof(FlutterSharedMemoryTextureFrame);
+    texture_frame.pixels = frame.pixels;
+    texture_frame.width = 2;
+    texture_frame.height = 2;
+    texture_frame.row_bytes = 2 * sizeof(uint32_t);
+    texture_frame.pixel_format = kFlutterSharedMemoryPixelFormatRGBA8888;
+    texture_frame.user_data = &frame;
+    texture_frame.release_callback = [](void* user_data) {
+      reinterpret_cast<Frame*>(user_data)->released.Signal();
+    };
+    return texture_frame;
+  };
+
+  constexpr int64_t kTextureId = 1;
+  ASSERT_EQ(FlutterEngineRegisterSharedMemoryTexture(engine.get(), kTextureId),
+            kSuccess);
+  ASSERT_EQ(FlutterEngineRegisterSharedMemoryTexture(engine.get(), kTextureId),
+            kInternalInconsistency);
+
+  // Frames that are replaced before they are drawn are released right away.
+  auto texture_frame = make_frame(first_frame);
+  ASSERT_EQ(FlutterEnginePushSharedMemoryTextureFrame(
+                engine.get(), kTextureId, &texture_frame),
+            kSuccess);
+  texture_frame = make_frame(second_frame);
+  ASSERT_EQ(FlutterEnginePushSharedMemoryTextureFrame(
+                engine.get(), kTextureId, &texture_frame),
+            kSuccess);
+  ASSERT_TRUE(first_frame.released.IsSignaledForTest());
+
+  // Frames are released once their texture is unregistered.
+  ASSERT_EQ(FlutterEngineUnregisterExternalTexture(engine.get(), kTextureId),
+            kSuccess);
+  second_frame.released.Wait();
+
+  // Frames that can't be pushed are released as well.
+  texture_frame = make_frame(unregistered_frame);
+  ASSERT_EQ(FlutterEnginePushSharedMemoryTextureFrame(
+                engine.get(), kTextureId, &texture_frame),
+            kInternalInconsistency);
+  ASSERT_TRUE(unregistered_frame.released.IsSignaledForTest());
+
+  texture_frame.release_callback = nullptr;
+  ASSERT_EQ(FlutterEnginePushSharedMemoryTextureFrame(
+                engine.get(), kTextureId, &texture_frame),
+            kInvalidArguments);
+}
+
 }  // namespace testing
 }  // namespace flutter
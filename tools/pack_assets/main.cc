@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "flutter/assets/packed_asset_bundle.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+
+void Usage() {
+  std::cout << "Usage:" << std::endl;
+  std::cout << "pack_assets [--compress] [--uncompressed-assets=<manifest>] "
+               "<asset_directory> [<output_directory>]"
+            << std::endl;
+  std::cout << std::endl;
+  std::cout << "Packs all files in the asset directory into a single "
+            << flutter::kPackedAssetBundleFileName
+            << " file in the output directory. If no output directory is "
+               "specified, the bundle is written to the asset directory, "
+               "where the engine picks it up in preference to the individual "
+               "files."
+            << std::endl;
+  std::cout << "With --compress, assets are stored compressed unless that "
+               "doesn't make them meaningfully smaller."
+            << std::endl;
+  std::cout << "--uncompressed-assets names a file listing one asset per line "
+               "that is always stored uncompressed. An asset prefetch manifest "
+               "recorded by the engine can be used to keep the assets needed "
+               "at startup uncompressed."
+            << std::endl;
+}
+
+int main(int argc, char** argv) {
+  const auto command_line = fml::CommandLineFromArgcArgv(argc, argv);
+  const auto& args = command_line.positional_args();
+  if (args.size() != 1 && args.size() != 2) {
+    Usage();
+    return -1;
+  }
+  const std::string& asset_directory_path = args[0];
+  const std::string& output_directory_path =
+      args.size() == 2 ? args[1] : args[0];
+
+  flutter::PackedAssetBundleOptions options;
+  options.compress = command_line.HasOption("compress");
+
+  std::string uncompressed_assets_path;
+  if (command_line.GetOptionValue("uncompressed-assets",
+                                  &uncompressed_assets_path)) {
+    auto manifest = fml::FileMapping::CreateReadOnly(uncompressed_assets_path);
+    if (!manifest) {
+      std::cerr << "Could not read " << uncompressed_assets_path
+                << "; aborting." << std::endl;
+      return -1;
+    }
+    std::istringstream stream(
+        std::string(reinterpret_cast<const char*>(manifest->GetMapping()),
+                    manifest->GetSize()));
+    std::string asset_name;
+    while (std::getline(stream, asset_name)) {
+      if (!asset_name.empty()) {
+        options.uncompressed_assets.insert(asset_name);
+      }
+    }
+  }
+
+  auto asset_directory = fml::OpenDirectory(asset_directory_path.c_str(), false,
+                                            fml::FilePermission::kRead);
+  if (!asset_directory.is_valid()) {
+    std::cerr << "Could not open asset directory " << asset_directory_path
+              << "; aborting." << std::endl;
+    return -1;
+  }
+
+  auto output_directory = fml::OpenDirectory(
+      output_directory_path.c_str(), true, fml::FilePermission::kReadWrite);
+  if (!output_directory.is_valid()) {
+    std::cerr << "Could not open output directory " << output_directory_path
+              << "; aborting." << std::endl;
+    return -1;
+  }
+
+  if (!flutter::WritePackedAssetBundle(asset_directory, output_directory,
+                                       flutter::kPackedAssetBundleFileName,
+                                       options)) {
+    std::cerr << "Could not write packed asset bundle; aborting." << std::endl;
+    return -1;
+  }
+
+  std::cout << "Wrote " << output_directory_path << "/"
+            << flutter::kPackedAssetBundleFileName << std::endl;
+  return 0;
+}